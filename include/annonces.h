@@ -10,28 +10,77 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "tampon.h"
+
+/**
+ * Longest validity that can be given to an announcement
+ */
+#define DUREE_VALIDITE_MAX_JOURS 3650
 
 /**
  * Structure to represent an announcement
+ *
+ * Title, content and author live in the text area of the node as
+ * length-prefixed blobs; the record only keeps their offsets.
  */
 typedef struct {
     int id;
-    char titre[100];
-    char contenu[1000];
-    char auteur[100];
-    char date_creation[20];
+    unsigned int titre;   // Offset of the title in the node's text area
+    unsigned int contenu; // Offset of the content
+    unsigned int auteur;  // Offset of the author
+    time_t date_creation;   // Seconds since the epoch
+    time_t date_expiration; // Archived from this date on, 0 if it never expires
     int id_matiere;  // ID of the related subject, 0 if general announcement
     int id_enseignant; // ID of the teacher who created the announcement
 } Annonce;
 
 /**
- * Node for announcement linked list
+ * Node for announcement linked list, allocated with room for its texts
  */
 typedef struct NodeAnnonce {
     Annonce annonce;
     struct NodeAnnonce* suivant;
+    char textes[]; // Title, content and author, each as a length then its bytes
 } NodeAnnonce;
 
+/**
+ * Allocate an announcement node sized for its texts (other fields zeroed)
+ */
+NodeAnnonce* creer_annonce(const char *titre, const char *contenu, const char *auteur);
+
+/**
+ * Replace the texts of an announcement, NULL keeping the current one;
+ * the node is reallocated and relinked in the list
+ */
+int changer_textes_annonce(NodeAnnonce** tete, NodeAnnonce** annonce,
+                           const char *titre, const char *contenu, const char *auteur);
+
+/**
+ * Get the title of an announcement
+ */
+const char* annonce_titre(const NodeAnnonce* annonce);
+
+/**
+ * Get the content of an announcement
+ */
+const char* annonce_contenu(const NodeAnnonce* annonce);
+
+/**
+ * Get the author of an announcement
+ */
+const char* annonce_auteur(const NodeAnnonce* annonce);
+
+/**
+ * Get the length in bytes of the content of an announcement
+ */
+size_t annonce_longueur_contenu(const NodeAnnonce* annonce);
+
+/**
+ * Read a multi-line content from the keyboard until a line "fin"
+ * Returns the number of lines read
+ */
+int saisir_contenu_annonce(Tampon *contenu);
+
 /**
  * Load announcements from file into a linked list
  */
@@ -42,6 +91,37 @@ int charger_annonces(NodeAnnonce** tete);
  */
 int sauvegarder_annonces(NodeAnnonce* tete);
 
+/**
+ * Move expired announcements from the list to the archive file (data/annonces_archive.txt);
+ * the caller saves the list. Returns the number archived, -1 if error
+ */
+int archiver_annonces_expirees(NodeAnnonce** tete, time_t maintenant);
+
+/**
+ * Check whether an announcement has expired
+ */
+int annonce_expiree(const NodeAnnonce* annonce, time_t maintenant);
+
+/**
+ * Parse a "JJ/MM/AAAA" or "JJ/MM/AAAA HH:MM" local date, -1 if invalid
+ */
+time_t lire_date_annonce(const char *texte);
+
+/**
+ * Format an announcement date as "JJ/MM/AAAA HH:MM" (empty if unknown, static buffer)
+ */
+const char* date_annonce_to_string(time_t date);
+
+/**
+ * Get the n newest announcements, newest first; *resultat stays valid until the list changes
+ */
+int annonces_recentes(NodeAnnonce* tete, int n, NodeAnnonce* const **resultat);
+
+/**
+ * Get the announcements created in [debut, fin), newest first; *resultat stays valid until the list changes
+ */
+int annonces_periode(NodeAnnonce* tete, time_t debut, time_t fin, NodeAnnonce* const **resultat);
+
 /**
  * Add a new announcement to the linked list
  */
@@ -50,7 +130,7 @@ void ajouter_annonce(NodeAnnonce** tete, int id_enseignant);
 /**
  * Modify an existing announcement
  */
-void modifier_annonce(NodeAnnonce* tete, int id_enseignant);
+void modifier_annonce(NodeAnnonce** tete, int id_enseignant);
 
 /**
  * Delete an announcement from the linked list
@@ -62,6 +142,11 @@ void supprimer_annonce(NodeAnnonce** tete, int id_enseignant);
  */
 void afficher_annonces(NodeAnnonce* tete);
 
+/**
+ * Display a selection of announcements in the given order
+ */
+void afficher_selection_annonces(NodeAnnonce* const *annonces, int nb);
+
 /**
  * Display announcements by subject ID
  */
@@ -82,4 +167,16 @@ NodeAnnonce* trouver_annonce_par_id(NodeAnnonce* tete, int id);
  */
 void liberer_annonces(NodeAnnonce** tete);
 
+/**
+ * Get the announcements modification counter (incremented on every load and save),
+ * used by derived indexes to detect stale data
+ */
+unsigned long annonces_generation(void);
+
+/**
+ * Get the revision of the announcements file (incremented on every save and stored in the file),
+ * used by persisted caches to detect stale data
+ */
+unsigned long annonces_revision(void);
+
 #endif /* ANNONCES_H */
\ No newline at end of file
@@ -0,0 +1,54 @@
+/**
+ * @file bulletins.h
+ * @brief Batch generation of the end-of-term transcripts of all students
+ */
+
+#ifndef BULLETINS_H
+#define BULLETINS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "etudiant.h"
+#include "notes.h"
+#include "inscriptions.h"
+#include "matiere.h"
+
+/**
+ * Default directory of the generated transcripts
+ */
+#define REPERTOIRE_BULLETINS "data/bulletins"
+
+/**
+ * @struct ResultatBulletins
+ * @brief Summary of a batch generation
+ */
+typedef struct {
+    int nb_bulletins;   // Transcripts written
+    int nb_erreurs;     // Transcripts that could not be written
+    int nb_threads;
+    double duree_ms;
+} ResultatBulletins;
+
+/**
+ * @brief Generate the transcript of every student
+ *
+ * Grades and enrollments are grouped by student in a single pass, then the
+ * students are split into ranges formatted by parallel workers into memory
+ * buffers, each written with a single call.
+ *
+ * @param repertoire Output directory (created if needed)
+ * @param fichier_unique 1 to write all transcripts to one file, 0 for one file per student
+ * @param nb_threads Number of threads (0 for one per processor)
+ * @param etudiants List of students
+ * @param notes List of grades
+ * @param inscriptions List of enrollments
+ * @param matieres List of subjects
+ * @param resultat Pointer to summary structure to fill
+ * @return 1 if successful, 0 if error
+ */
+int generer_bulletins(const char *repertoire, int fichier_unique, int nb_threads,
+                      NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions,
+                      NodeMatiere* matieres, ResultatBulletins *resultat);
+
+#endif /* BULLETINS_H */
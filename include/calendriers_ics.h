@@ -0,0 +1,68 @@
+/**
+ * @file calendriers_ics.h
+ * @brief iCalendar (RFC 5545) export of the personal timetables
+ *
+ * Every session of the grid and of the planning is formatted once as a
+ * weekly recurring event and appended to the calendar of its teacher, of
+ * its section and of each student enrolled in its subject. Each calendar
+ * is built in a memory buffer and written with a single call.
+ */
+
+#ifndef CALENDRIERS_ICS_H
+#define CALENDRIERS_ICS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "emploi_du_temps.h"
+#include "planning.h"
+#include "etudiant.h"
+#include "enseignant.h"
+#include "matiere.h"
+#include "inscriptions.h"
+
+/**
+ * Default directory of the exported calendars
+ */
+#define REPERTOIRE_CALENDRIERS "data/calendriers"
+
+/**
+ * Maximum number of weeks a session is repeated
+ */
+#define MAX_SEMAINES_CALENDRIER 52
+
+/**
+ * @struct ResultatCalendriers
+ * @brief Summary of a calendar export
+ */
+typedef struct {
+    int nb_fichiers;    // Calendars written
+    int nb_seances;     // Distinct sessions exported
+    int nb_evenements;  // Events written, all calendars together
+    int nb_erreurs;     // Calendars or sessions that could not be written
+    size_t nb_octets;
+    double duree_ms;
+} ResultatCalendriers;
+
+/**
+ * @brief Export one calendar per teacher, per section and per student
+ * @param repertoire Output directory (created if needed)
+ * @param debut Any day of the first week of the term
+ * @param nb_semaines Number of weeks the sessions repeat
+ * @param edt Timetable grid
+ * @param planning Multi-section planning (NULL if none)
+ * @param etudiants List of students
+ * @param enseignants List of teachers
+ * @param matieres List of subjects
+ * @param inscriptions List of enrollments
+ * @param resultat Pointer to summary structure to fill
+ * @return 1 if successful, 0 if error
+ */
+int exporter_calendriers(const char *repertoire, const struct tm *debut, int nb_semaines,
+                         const EmploiDuTemps *edt, const Planning *planning,
+                         NodeEtudiant* etudiants, NodeEnseignant* enseignants,
+                         NodeMatiere* matieres, NodeInscription* inscriptions,
+                         ResultatCalendriers *resultat);
+
+#endif /* CALENDRIERS_ICS_H */
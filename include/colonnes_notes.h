@@ -0,0 +1,106 @@
+/**
+ * @file colonnes_notes.h
+ * @brief Columnar (structure of arrays) copy of the grades for fast scans
+ *
+ * Aggregations only read the IDs and scores, so those are kept in dense
+ * arrays; comments and dates live out of line in a string heap and a full
+ * Note is only rebuilt for display.
+ *
+ * The linked list stays the source of truth and is what gets saved. The
+ * shared columns are built from it once, then each addition, modification
+ * or deletion of a grade is applied to them in place; they are only built
+ * again when the grades are reloaded or a change could not be applied.
+ */
+
+#ifndef COLONNES_NOTES_H
+#define COLONNES_NOTES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "notes.h"
+
+/**
+ * @struct ColonnesNotes
+ * @brief Grades stored column by column
+ */
+typedef struct {
+    int nb;                     // Number of grades
+    int capacite;
+    int *id;
+    int *id_etudiant;
+    int *id_matiere;
+    int *id_enseignant;
+    float *note;
+    size_t *commentaire;        // Offset of the comment in the string heap
+    size_t *date_evaluation;    // Offset of the date in the string heap
+    char *tas;                  // String heap (null-terminated strings)
+    size_t taille_tas;
+    size_t capacite_tas;
+} ColonnesNotes;
+
+/**
+ * @brief Build the columns from a list of grades
+ *
+ * Incomplete records (blank lines in the data file) are skipped.
+ *
+ * @param colonnes Pointer to columns structure to fill
+ * @param notes List of grades
+ * @return 1 if successful, 0 if error
+ */
+int construire_colonnes_notes(ColonnesNotes *colonnes, NodeNote* notes);
+
+/**
+ * @brief Free memory allocated for columns
+ * @param colonnes Pointer to columns structure
+ */
+void vider_colonnes_notes(ColonnesNotes *colonnes);
+
+/**
+ * @brief Get the shared columns of a list of grades, rebuilt only when they are out of sync
+ * @param notes List of grades
+ * @return Pointer to the columns, NULL if error
+ */
+const ColonnesNotes* obtenir_colonnes_notes(NodeNote* notes);
+
+/**
+ * @brief Apply a single grade change to the shared columns instead of rebuilding them
+ *
+ * Rows may be reordered: a deleted grade is replaced by the last row.
+ *
+ * @param notes List of grades after the change
+ * @param ancienne Grade before the change (NULL for an addition)
+ * @param nouvelle Grade after the change (NULL for a deletion)
+ */
+void colonnes_note_modifiee(NodeNote* notes, const Note *ancienne, const Note *nouvelle);
+
+/**
+ * @brief Get the comment of a grade
+ * @param colonnes Pointer to columns structure
+ * @param i Position of the grade
+ * @return Comment string
+ */
+const char* colonnes_notes_commentaire(const ColonnesNotes *colonnes, int i);
+
+/**
+ * @brief Get the evaluation date of a grade
+ * @param colonnes Pointer to columns structure
+ * @param i Position of the grade
+ * @return Date string
+ */
+const char* colonnes_notes_date(const ColonnesNotes *colonnes, int i);
+
+/**
+ * @brief Rebuild the row view of a grade for display
+ * @param colonnes Pointer to columns structure
+ * @param i Position of the grade
+ * @param note Pointer to grade structure to fill
+ */
+void colonnes_notes_ligne(const ColonnesNotes *colonnes, int i, Note *note);
+
+/**
+ * @brief Free memory allocated for the shared columns
+ */
+void liberer_colonnes_notes(void);
+
+#endif /* COLONNES_NOTES_H */
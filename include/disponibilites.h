@@ -0,0 +1,175 @@
+/**
+ * @file disponibilites.h
+ * @brief Weekly availability of teachers, rooms and sections as slot bitsets
+ *
+ * Each resource owns one bit per weekly slot, so checking a conflict is a
+ * single AND and the first slot free for several resources is found with
+ * an OR of their occupations and a count of trailing zeros.
+ */
+
+#ifndef DISPONIBILITES_H
+#define DISPONIBILITES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "index.h"
+#include "generateur_edt.h"
+#include "emploi_du_temps.h"
+#include "planning.h"
+
+/**
+ * Kinds of resources
+ */
+typedef enum {
+    RESSOURCE_ENSEIGNANT = 0,
+    RESSOURCE_SALLE = 1,
+    RESSOURCE_SECTION = 2,
+    NB_TYPES_RESSOURCES = 3
+} TypeRessource;
+
+/**
+ * Conflict flags returned by conflits_creneau()
+ */
+#define CONFLIT_ENSEIGNANT (1 << RESSOURCE_ENSEIGNANT)
+#define CONFLIT_SALLE (1 << RESSOURCE_SALLE)
+#define CONFLIT_SECTION (1 << RESSOURCE_SECTION)
+
+/**
+ * @struct TableRessources
+ * @brief Occupation bitsets of the resources of one kind
+ */
+typedef struct {
+    IndexId index;          // Key of the resource -> handle
+    MasqueCreneaux *occupe; // Per handle
+    int nb;
+    int capacite;
+} TableRessources;
+
+/**
+ * @struct Disponibilites
+ * @brief Occupation of every teacher, room and section over one week
+ */
+typedef struct {
+    int nb_jours;
+    int nb_creneaux_jour;
+    MasqueCreneaux semaine; // Every valid slot
+    TableRessources tables[NB_TYPES_RESSOURCES];
+} Disponibilites;
+
+/**
+ * @brief Initialize empty availabilities for a week
+ * @param dispo Pointer to availability structure
+ * @param nb_jours Number of days per week
+ * @param nb_creneaux_jour Number of slots per day
+ * @return 1 if successful, 0 if the week has more than MAX_CRENEAUX_SEMAINE slots
+ */
+int initialiser_disponibilites(Disponibilites *dispo, int nb_jours, int nb_creneaux_jour);
+
+/**
+ * @brief Free memory allocated for availabilities
+ * @param dispo Pointer to availability structure
+ */
+void liberer_disponibilites(Disponibilites *dispo);
+
+/**
+ * @brief Get the handle of a resource, registering it if needed
+ * @param dispo Pointer to availability structure
+ * @param type Kind of resource
+ * @param cle Key of the resource (ID, or index_cle_chaine() of a name)
+ * @return Handle of the resource, -1 if error
+ */
+int ressource_disponibilites(Disponibilites *dispo, TypeRessource type, long long cle);
+
+/**
+ * @brief Get the handle of a resource without registering it
+ * @param dispo Pointer to availability structure
+ * @param type Kind of resource
+ * @param cle Key of the resource
+ * @return Handle of the resource, -1 if unknown (hence free all week)
+ */
+int chercher_ressource_disponibilites(const Disponibilites *dispo, TypeRessource type, long long cle);
+
+/**
+ * @brief Get the occupied slots of a resource
+ * @param dispo Pointer to availability structure
+ * @param type Kind of resource
+ * @param handle Handle of the resource (-1 for none)
+ * @return Occupied slots
+ */
+MasqueCreneaux occupation_ressource(const Disponibilites *dispo, TypeRessource type, int handle);
+
+/**
+ * @brief Mark several slots of one resource as unavailable
+ * @param dispo Pointer to availability structure
+ * @param type Kind of resource
+ * @param handle Handle of the resource
+ * @param creneaux Slots to block
+ */
+void bloquer_creneaux(Disponibilites *dispo, TypeRessource type, int handle, MasqueCreneaux creneaux);
+
+/**
+ * @brief Mark a slot as used by a teacher, a room and a section
+ * @param dispo Pointer to availability structure
+ * @param handles Handle of each kind of resource (-1 to ignore a kind)
+ * @param creneau Slot (jour * nb_creneaux_jour + heure)
+ */
+void reserver_creneau(Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau);
+
+/**
+ * @brief Free a slot previously reserved
+ * @param dispo Pointer to availability structure
+ * @param handles Handle of each kind of resource (-1 to ignore a kind)
+ * @param creneau Slot (jour * nb_creneaux_jour + heure)
+ */
+void annuler_creneau(Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau);
+
+/**
+ * @brief Check in O(1) which resources are already used at a slot
+ * @param dispo Pointer to availability structure
+ * @param handles Handle of each kind of resource (-1 to ignore a kind)
+ * @param creneau Slot (jour * nb_creneaux_jour + heure)
+ * @return Combination of CONFLIT_* flags, 0 if the slot is free for all of them
+ */
+int conflits_creneau(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau);
+
+/**
+ * @brief Get the slots free for every given resource
+ * @param dispo Pointer to availability structure
+ * @param handles Handle of each kind of resource (-1 to ignore a kind)
+ * @return Common free slots
+ */
+MasqueCreneaux creneaux_libres_communs(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES]);
+
+/**
+ * @brief Find the first slot free for every given resource
+ * @param dispo Pointer to availability structure
+ * @param handles Handle of each kind of resource (-1 to ignore a kind)
+ * @return First common free slot, -1 if none
+ */
+int premier_creneau_libre_commun(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES]);
+
+/**
+ * @brief Add the slots of the timetable grid (one section) to the availabilities
+ * @param dispo Pointer to availability structure (same week shape as the grid)
+ * @param edt Pointer to timetable structure
+ * @param jour_exclu Day of a cell to skip (-1 for none)
+ * @param heure_exclue Slot of the cell to skip
+ * @return 1 if successful, 0 if error
+ */
+int disponibilites_emploi_du_temps(Disponibilites *dispo, const EmploiDuTemps *edt, int jour_exclu, int heure_exclue);
+
+/**
+ * @brief Add the sessions of a planning to the availabilities
+ * @param dispo Pointer to availability structure (same week shape as the planning)
+ * @param planning Pointer to planning structure
+ * @return 1 if successful, 0 if error
+ */
+int disponibilites_planning(Disponibilites *dispo, const Planning *planning);
+
+/**
+ * @brief Key of the timetable grid as a section resource
+ */
+#define SECTION_GRILLE "#grille"
+
+#endif /* DISPONIBILITES_H */
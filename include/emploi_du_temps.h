@@ -17,16 +17,19 @@
 #define CRENEAUX_PAR_JOUR 4
 #define MAX_SALLE_LEN 10
 
+struct Planning;
+
 /**
  * @struct Creneau
  * @brief Structure for storing timetable slot information
+ *
+ * Only IDs are stored; subject and teacher names are looked up when the
+ * slot is displayed, so renaming them never leaves a stale copy.
  */
 typedef struct {
     int id;
     int id_matiere;
-    char nom_matiere[MAX_NOM_MATIERE_LEN];
     int id_enseignant;
-    char nom_enseignant[100];
     char salle[MAX_SALLE_LEN];
     int jour; // 0-4 pour lundi à vendredi
     int heure; // 0-5 pour les créneaux horaires
@@ -43,6 +46,10 @@ typedef struct {
 
 /**
  * @brief Load timetable from file
+ *
+ * Files written with the subject and teacher names of each slot are
+ * converted to the ID-only format and saved back.
+ *
  * @param edt Pointer to timetable structure
  * @return 1 if successful, 0 if error
  */
@@ -67,31 +74,86 @@ void generer_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* enseignants, No
 
 /**
  * @brief Add a new slot to the timetable
+ *
+ * The teacher and the room must be free at that time, both in the grid
+ * and in the planning; otherwise the first slot free for both is proposed.
+ *
  * @param edt Pointer to timetable structure
  * @param enseignants Linked list of teachers
  * @param matieres Linked list of subjects
+ * @param planning Multi-section planning to check as well (NULL if none)
  */
-void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres);
+void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres,
+                     const struct Planning *planning);
 
 /**
  * @brief Modify an existing slot in the timetable
+ *
+ * The change is refused if the new teacher or room is already used at that
+ * time in the grid or in the planning.
+ *
  * @param edt Pointer to timetable structure
  * @param enseignants Linked list of teachers
  * @param matieres Linked list of subjects
+ * @param planning Multi-section planning to check as well (NULL if none)
  */
-void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres);
+void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres,
+                      const struct Planning *planning);
 
 /**
  * @brief Delete a slot from the timetable
  * @param edt Pointer to timetable structure
+ * @param matieres Linked list of subjects
+ * @param enseignants Linked list of teachers
  */
-void supprimer_creneau(EmploiDuTemps *edt);
+void supprimer_creneau(EmploiDuTemps *edt, NodeMatiere* matieres, NodeEnseignant* enseignants);
 
 /**
  * @brief Display the complete timetable
  * @param edt Pointer to timetable structure
+ * @param matieres Linked list of subjects
+ * @param enseignants Linked list of teachers
+ */
+void afficher_emploi_du_temps(const EmploiDuTemps *edt, NodeMatiere* matieres, NodeEnseignant* enseignants);
+
+/**
+ * @brief Convert a day number to its name
+ * @param jour Day (0 to JOURS_PAR_SEMAINE - 1)
+ * @return Name of the day
+ */
+const char* jour_to_string(int jour);
+
+/**
+ * @brief Convert a slot number to its hours
+ * @param heure Slot (0 to CRENEAUX_PAR_JOUR - 1)
+ * @return Hours of the slot
  */
-void afficher_emploi_du_temps(const EmploiDuTemps *edt);
+const char* heure_to_string(int heure);
+
+/**
+ * @brief Choose the teacher of a subject
+ *
+ * Prefers the least loaded teacher whose taught subject matches the subject
+ * name, else the least loaded teacher.
+ *
+ * @param enseignants Linked list of teachers
+ * @param matiere Subject to teach
+ * @param charges Number of sessions already given to each teacher (in list order)
+ * @param position Receives the position of the chosen teacher in the list
+ * @param specialise Receives 1 if the teacher's subject matches, 0 otherwise
+ * @return Pointer to the chosen teacher, NULL if the list is empty
+ */
+NodeEnseignant* choisir_enseignant_matiere(NodeEnseignant* enseignants, const Matiere *matiere,
+                                           const int *charges, int *position, int *specialise);
+
+/**
+ * @brief Split a comma-separated list of rooms
+ * @param liste Comma-separated list
+ * @param salles Array receiving the room names
+ * @param max Size of the array
+ * @return Number of rooms read
+ */
+int lire_liste_salles(const char *liste, char salles[][MAX_SALLE_LEN], int max);
 
 /**
  * @brief Initialize an empty timetable
@@ -99,4 +161,11 @@ void afficher_emploi_du_temps(const EmploiDuTemps *edt);
  */
 void initialiser_emploi_du_temps(EmploiDuTemps *edt);
 
+/**
+ * @brief Get the timetable modification counter (incremented on every load and save),
+ * used by derived caches to detect stale data
+ * @return Current counter value
+ */
+unsigned long emploi_du_temps_generation(void);
+
 #endif /* EMPLOI_DU_TEMPS_H */
@@ -0,0 +1,119 @@
+/**
+ * @file ensemble_bits.h
+ * @brief Growable bitsets over dense integer positions
+ */
+
+#ifndef ENSEMBLE_BITS_H
+#define ENSEMBLE_BITS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct EnsembleBits
+ * @brief Set of positions stored one bit each (zero-initialized means empty)
+ */
+typedef struct {
+    unsigned long long *mots;
+    int nb_mots;
+} EnsembleBits;
+
+/**
+ * @brief Initialize an empty set able to hold positions 0 to nb_bits - 1
+ * @param ensemble Pointer to set
+ * @param nb_bits Number of positions
+ * @return 1 if successful, 0 if error
+ */
+int ensemble_bits_initialiser(EnsembleBits *ensemble, int nb_bits);
+
+/**
+ * @brief Grow a set so it can hold positions 0 to nb_bits - 1 (new positions are absent)
+ * @param ensemble Pointer to set
+ * @param nb_bits Number of positions
+ * @return 1 if successful, 0 if error
+ */
+int ensemble_bits_agrandir(EnsembleBits *ensemble, int nb_bits);
+
+/**
+ * @brief Add a position to a set, growing it if needed
+ * @param ensemble Pointer to set
+ * @param position Position to add
+ * @return 1 if successful, 0 if error
+ */
+int ensemble_bits_ajouter(EnsembleBits *ensemble, int position);
+
+/**
+ * @brief Remove a position from a set
+ * @param ensemble Pointer to set
+ * @param position Position to remove
+ */
+void ensemble_bits_retirer(EnsembleBits *ensemble, int position);
+
+/**
+ * @brief Check whether a position is in a set
+ * @param ensemble Pointer to set
+ * @param position Position to check
+ * @return 1 if present, 0 otherwise
+ */
+int ensemble_bits_contient(const EnsembleBits *ensemble, int position);
+
+/**
+ * @brief Count the positions of a set
+ * @param ensemble Pointer to set
+ * @return Number of positions
+ */
+int ensemble_bits_cardinal(const EnsembleBits *ensemble);
+
+/**
+ * @brief Add every position of a set to another
+ * @param destination Pointer to set receiving the positions
+ * @param source Pointer to set to add
+ * @return 1 if successful, 0 if error
+ */
+int ensemble_bits_union(EnsembleBits *destination, const EnsembleBits *source);
+
+/**
+ * @brief Check whether two sets share a position
+ * @param a Pointer to first set
+ * @param b Pointer to second set
+ * @return 1 if they intersect, 0 otherwise
+ */
+int ensemble_bits_intersecte(const EnsembleBits *a, const EnsembleBits *b);
+
+/**
+ * @brief Check whether every position of a set is in another one
+ * @param a Pointer to the set that may be included
+ * @param b Pointer to the set that may include it
+ * @return 1 if a is a subset of b, 0 otherwise
+ */
+int ensemble_bits_inclus(const EnsembleBits *a, const EnsembleBits *b);
+
+/**
+ * @brief Find the first position of a set not below a given one
+ * @param ensemble Pointer to set
+ * @param depuis First position to consider
+ * @return Position found, -1 if none
+ */
+int ensemble_bits_suivant(const EnsembleBits *ensemble, int depuis);
+
+/**
+ * @brief Find the first position not in a set
+ * @param ensemble Pointer to set
+ * @return First absent position
+ */
+int ensemble_bits_premier_absent(const EnsembleBits *ensemble);
+
+/**
+ * @brief Remove every position of a set, keeping its memory
+ * @param ensemble Pointer to set
+ */
+void ensemble_bits_vider(EnsembleBits *ensemble);
+
+/**
+ * @brief Free memory allocated for a set
+ * @param ensemble Pointer to set
+ */
+void ensemble_bits_liberer(EnsembleBits *ensemble);
+
+#endif /* ENSEMBLE_BITS_H */
@@ -96,4 +96,10 @@ void rechercher_etudiants(NodeEtudiant* tete);
  */
 void liberer_etudiants(NodeEtudiant** tete);
 
+/**
+ * @brief Get the students modification counter (incremented on every load and save)
+ * @return Current counter value, used by derived caches to detect stale data
+ */
+unsigned long etudiants_generation(void);
+
 #endif /* ETUDIANT_H */
@@ -0,0 +1,73 @@
+/**
+ * @file examens.h
+ * @brief Exam scheduling without student conflicts
+ *
+ * Two subjects conflict when a student is actively enrolled in both. The
+ * conflict graph (one bitset of neighbours per subject) is coloured with
+ * DSATUR: each colour is an exam period. A subject only takes a period if
+ * the rooms still free in that period can seat all of its students.
+ */
+
+#ifndef EXAMENS_H
+#define EXAMENS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matiere.h"
+#include "inscriptions.h"
+#include "salle.h"
+
+/**
+ * @struct ExamenPlanifie
+ * @brief Exam of one subject
+ */
+typedef struct {
+    int id_matiere;
+    int inscrits;
+    int nb_conflits;     // Subjects sharing at least one student
+    int periode;         // -1 if no room can seat all its students
+    int premiere_salle;  // Position of its first room in the room assignments
+    int nb_salles;
+} ExamenPlanifie;
+
+/**
+ * @struct PlanningExamens
+ * @brief Exam periods of every subject with enrolled students
+ */
+typedef struct {
+    ExamenPlanifie *examens;        // Sorted by period, then subject
+    int nb_examens;
+    char (*salles)[MAX_SALLE_LEN];  // Rooms of each exam, consecutive
+    int nb_affectations;
+    int nb_periodes;
+    int nb_non_planifies;
+    int nb_aretes;                  // Pairs of conflicting subjects
+    int capacite_ignoree;           // 1 if no room is registered
+    double duree_ms;
+} PlanningExamens;
+
+/**
+ * @brief Assign every subject with enrolled students to an exam period and rooms
+ * @param resultat Pointer to schedule structure to fill
+ * @param inscriptions List of enrollments
+ * @param salles Room catalogue (capacities are ignored if empty)
+ * @return 1 if successful, 0 if error
+ */
+int planifier_examens(PlanningExamens *resultat, NodeInscription* inscriptions, NodeSalle* salles);
+
+/**
+ * @brief Display an exam schedule period by period
+ * @param planning Pointer to schedule structure
+ * @param matieres List of subjects
+ * @param periodes_par_jour Number of exam periods in a day
+ */
+void afficher_planning_examens(const PlanningExamens *planning, NodeMatiere* matieres, int periodes_par_jour);
+
+/**
+ * @brief Free memory allocated for an exam schedule
+ * @param planning Pointer to schedule structure
+ */
+void liberer_planning_examens(PlanningExamens *planning);
+
+#endif /* EXAMENS_H */
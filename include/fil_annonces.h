@@ -0,0 +1,63 @@
+/**
+ * @file fil_annonces.h
+ * @brief Announcement feed of a student
+ *
+ * Announcements, taken newest first from the time index of the list, are
+ * chained by subject once per change of the announcements; the subjects of
+ * a student come from the enrollments index (matieres_inscrites_etudiant).
+ * A student's feed merges the chain of general announcements with the
+ * chains of their subjects, so building it only touches the announcements
+ * it returns.
+ */
+
+#ifndef FIL_ANNONCES_H
+#define FIL_ANNONCES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "annonces.h"
+#include "inscriptions.h"
+#include "matiere.h"
+
+/**
+ * @struct FilAnnonces
+ * @brief Announcements concerning one student, newest first
+ */
+typedef struct {
+    int id_etudiant;
+    NodeAnnonce **annonces;
+    int nb_annonces;
+    int capacite;
+} FilAnnonces;
+
+/**
+ * @brief Build the feed of a student: general announcements and those of their active enrollments
+ * @param id_etudiant ID of the student
+ * @param annonces Linked list of announcements
+ * @param inscriptions Linked list of enrollments
+ * @return Feed (valid until the next call), NULL if error
+ */
+const FilAnnonces* fil_annonces_etudiant(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions);
+
+/**
+ * @brief Fingerprint of the subjects a student actively follows (independent of their order)
+ * @param id_etudiant ID of the student
+ * @param inscriptions Linked list of enrollments
+ * @return Signature, equal for equal sets of enrollments
+ */
+unsigned long long signature_abonnements(int id_etudiant, NodeInscription* inscriptions);
+
+/**
+ * @brief Display a feed
+ * @param fil Feed of a student
+ * @param matieres Linked list of subjects
+ */
+void afficher_fil_annonces(const FilAnnonces *fil, NodeMatiere* matieres);
+
+/**
+ * @brief Free the indexes and the feed
+ */
+void liberer_fil_annonces(void);
+
+#endif /* FIL_ANNONCES_H */
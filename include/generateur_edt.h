@@ -0,0 +1,176 @@
+/**
+ * @file generateur_edt.h
+ * @brief Constraint-solving timetable generator
+ *
+ * Sessions are placed on weekly slots by backtracking. Hard constraints
+ * (a teacher, a section or a room is never used twice at the same time)
+ * are checked with one bitset of weekly slots per resource; soft
+ * preferences only order the candidate slots.
+ */
+
+#ifndef GENERATEUR_EDT_H
+#define GENERATEUR_EDT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "index.h"
+
+/**
+ * Maximum number of slots per week (one bit per slot)
+ */
+#define MAX_CRENEAUX_SEMAINE 64
+
+/**
+ * Default time budget of a search in milliseconds
+ */
+#define BUDGET_GENERATION_MS 2000.0
+
+/**
+ * Maximum number of improvements recorded by a portfolio search
+ */
+#define MAX_POINTS_SUIVI 64
+
+/**
+ * Set of weekly slots, bit (jour * nb_creneaux_jour + heure)
+ */
+typedef unsigned long long MasqueCreneaux;
+
+/**
+ * @struct SeanceAPlacer
+ * @brief One weekly session to schedule
+ */
+typedef struct {
+    int id_matiere;
+    int id_enseignant;
+    int enseignant; // Dense index of the teacher in the problem
+    int section;    // Dense index of the section in the problem
+} SeanceAPlacer;
+
+/**
+ * @struct ProblemeEdt
+ * @brief Timetabling problem: week shape, rooms and sessions to place
+ */
+typedef struct {
+    int nb_jours;
+    int nb_creneaux_jour;
+    int nb_salles;
+    int nb_sections;
+    int nb_enseignants;
+    SeanceAPlacer *seances;
+    int nb_seances;
+    int capacite_seances;
+    IndexId index_enseignants;          // id_enseignant -> dense index
+    MasqueCreneaux *creneaux_a_eviter;  // Per teacher, soft preference (NULL if none)
+    double budget_ms;
+} ProblemeEdt;
+
+/**
+ * @struct SolutionEdt
+ * @brief Slot and room of every session
+ */
+typedef struct {
+    int *creneau;    // Per session: jour * nb_creneaux_jour + heure, -1 if not placed
+    int *salle;      // Per session: room index, -1 if not placed
+    int nb_seances;
+    int nb_placees;
+    int penalite;    // Sum of the soft preference penalties
+    int complete;    // 1 if every session is placed
+    long noeuds;     // Search nodes explored
+    double duree_ms;
+    int nb_threads;  // Search threads used
+} SolutionEdt;
+
+/**
+ * @struct PointSuivi
+ * @brief Best score known at some time of a search
+ */
+typedef struct {
+    double temps_ms;
+    int nb_placees;
+    int penalite;
+    int strategie; // Search strategy that found it
+} PointSuivi;
+
+/**
+ * @struct SuiviScore
+ * @brief Score over time of a portfolio search
+ */
+typedef struct {
+    PointSuivi points[MAX_POINTS_SUIVI];
+    int nb;
+    int borne_penalite; // Lower bound of the penalty; reaching it stops the search
+} SuiviScore;
+
+/**
+ * @brief Initialize an empty problem
+ * @param probleme Pointer to problem structure
+ * @param nb_jours Number of days per week
+ * @param nb_creneaux_jour Number of slots per day
+ * @param nb_salles Number of rooms
+ * @param nb_sections Number of sections
+ * @return 1 if successful, 0 if the week does not fit in MAX_CRENEAUX_SEMAINE or error
+ */
+int initialiser_probleme_edt(ProblemeEdt *probleme, int nb_jours, int nb_creneaux_jour,
+                             int nb_salles, int nb_sections);
+
+/**
+ * @brief Add a session to place
+ * @param probleme Pointer to problem structure
+ * @param id_matiere ID of the subject
+ * @param id_enseignant ID of the teacher
+ * @param section Dense index of the section (0 to nb_sections - 1)
+ * @return 1 if successful, 0 if error
+ */
+int ajouter_seance_probleme(ProblemeEdt *probleme, int id_matiere, int id_enseignant, int section);
+
+/**
+ * @brief Mark slots a teacher would rather not teach (soft preference)
+ * @param probleme Pointer to problem structure
+ * @param id_enseignant ID of the teacher
+ * @param creneaux Slots to avoid
+ * @return 1 if successful, 0 if the teacher has no session or error
+ */
+int eviter_creneaux_enseignant(ProblemeEdt *probleme, int id_enseignant, MasqueCreneaux creneaux);
+
+/**
+ * @brief Free memory allocated for a problem
+ * @param probleme Pointer to problem structure
+ */
+void liberer_probleme_edt(ProblemeEdt *probleme);
+
+/**
+ * @brief Place the sessions of a problem
+ *
+ * The search stops at the first complete placement or when the time budget
+ * is spent; in the latter case the largest partial placement found is kept.
+ *
+ * @param probleme Pointer to problem structure
+ * @param solution Pointer to solution structure to fill
+ * @return 1 if every session is placed, 0 otherwise, -1 if error (the solution is then left empty)
+ */
+int resoudre_edt(const ProblemeEdt *probleme, SolutionEdt *solution);
+
+/**
+ * @brief Place the sessions of a problem with a portfolio of searches run in parallel
+ *
+ * Every thread runs its own strategy (randomized tie-breaking and slot
+ * order, with restarts) and shares the best placement found. The search
+ * keeps improving the penalty until the time budget is spent or the
+ * penalty reaches a lower bound, which stops every thread.
+ *
+ * @param probleme Pointer to problem structure
+ * @param nb_threads Number of threads (0 for one per processor)
+ * @param solution Pointer to solution structure to fill
+ * @param suivi Receives the score over time (NULL if not needed)
+ * @return 1 if every session is placed, 0 otherwise, -1 if error (the solution is then left empty)
+ */
+int resoudre_edt_portfolio(const ProblemeEdt *probleme, int nb_threads, SolutionEdt *solution, SuiviScore *suivi);
+
+/**
+ * @brief Free memory allocated for a solution
+ * @param solution Pointer to solution structure
+ */
+void liberer_solution_edt(SolutionEdt *solution);
+
+#endif /* GENERATEUR_EDT_H */
@@ -9,6 +9,7 @@
 #include "etudiant.h"
 #include "notes.h"
 #include "inscriptions.h"
+#include "matiere.h"
 
 /**
  * @brief Menu for student management
@@ -28,15 +29,19 @@ void afficher_statistiques_etudiants(NodeEtudiant* etudiants, NodeNote* notes);
  * @param etudiants List of students
  * @param notes List of grades
  * @param inscriptions List of course registrations
+ * @param matieres List of subjects (coefficients used for the weighted average)
  */
-void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions);
+void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions,
+                               NodeMatiere* matieres);
 
 /**
  * @brief Manage student registrations for courses
  * @param inscriptions Pointer to the list of course registrations
+ * @param matieres List of subjects (existence and capacities)
+ * @param notes List of grades (subjects passed, for prerequisites)
  * @param id_etudiant ID of the student
  */
-void menu_inscriptions_etudiant(NodeInscription **inscriptions, int id_etudiant);
+void menu_inscriptions_etudiant(NodeInscription **inscriptions, NodeMatiere* matieres, NodeNote* notes, int id_etudiant);
 
 void NewFunction();
 
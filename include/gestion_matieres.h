@@ -34,11 +34,12 @@ void afficher_statistiques_matieres(NodeMatiere* matieres, NodeNote* notes, Node
 void calculer_statistiques_matieres(NodeMatiere* matieres, NodeNote* notes, NodeEtudiant* etudiants);
 
 /**
- * @brief Display detailed information about a subject
+ * @brief Display detailed information and grade distribution of a subject
  * @param matieres List of subjects
  * @param notes List of grades
+ * @param etudiants List of students (used for the per-section breakdown)
  * @param id_matiere ID of the subject
  */
-void afficher_details_matiere(NodeMatiere* matieres, NodeNote* notes, int id_matiere);
+void afficher_details_matiere(NodeMatiere* matieres, NodeNote* notes, NodeEtudiant* etudiants, int id_matiere);
 
 #endif /* GESTION_MATIERES_H */
\ No newline at end of file
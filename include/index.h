@@ -0,0 +1,92 @@
+/**
+ * @file index.h
+ * @brief Hash index mapping entity IDs to positions in dense arrays
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @struct IndexId
+ * @brief Open-addressing hash table (linear probing) from an ID key to an integer value
+ *
+ * Keys are 64-bit so that composite keys (for example student + subject)
+ * can be stored with index_cle_composee().
+ */
+typedef struct {
+    long long *cles;
+    int *valeurs;
+    unsigned char *occupe;
+    size_t capacite;
+    size_t taille;
+} IndexId;
+
+/**
+ * @brief Initialize an empty index
+ * @param index Pointer to index structure
+ * @param capacite_initiale Expected number of entries (0 for default)
+ * @return 1 if successful, 0 if error
+ */
+int index_id_initialiser(IndexId *index, size_t capacite_initiale);
+
+/**
+ * @brief Insert a key or update its value
+ * @param index Pointer to index structure
+ * @param cle Key to insert
+ * @param valeur Value associated with the key
+ * @return 1 if successful, 0 if error
+ */
+int index_id_inserer(IndexId *index, long long cle, int valeur);
+
+/**
+ * @brief Look up a key
+ * @param index Pointer to index structure
+ * @param cle Key to search for
+ * @param valeur Pointer to store the value (may be NULL)
+ * @return 1 if found, 0 if not found
+ */
+int index_id_chercher(const IndexId *index, long long cle, int *valeur);
+
+/**
+ * @brief Remove a key from the index
+ * @param index Pointer to index structure
+ * @param cle Key to remove
+ * @return 1 if removed, 0 if not found
+ */
+int index_id_supprimer(IndexId *index, long long cle);
+
+/**
+ * @brief Remove all entries while keeping the allocated storage
+ * @param index Pointer to index structure
+ */
+void index_id_vider(IndexId *index);
+
+/**
+ * @brief Free memory allocated for the index
+ * @param index Pointer to index structure
+ */
+void index_id_liberer(IndexId *index);
+
+/**
+ * @brief Build a composite key from two IDs
+ * @param a First ID (e.g. student ID)
+ * @param b Second ID (e.g. subject ID)
+ * @return Composite key
+ */
+long long index_cle_composee(int a, int b);
+
+/**
+ * @brief Build a key from a string (64-bit FNV-1a hash)
+ *
+ * Different strings may share a key: callers must check the stored entry.
+ *
+ * @param chaine String to hash
+ * @return Key of the string
+ */
+long long index_cle_chaine(const char *chaine);
+
+#endif /* INDEX_H */
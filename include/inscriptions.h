@@ -10,6 +10,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "matiere.h"
+#include "etudiant.h"
+#include "notes.h"
 
 /**
  * Structure to represent a course enrollment
@@ -19,9 +22,22 @@ typedef struct {
     int id_etudiant;
     int id_matiere;
     char date_inscription[20];
-    int statut; // 1 = enrolled, 0 = unenrolled
+    int statut; // 1 = enrolled, 0 = unenrolled, 2 = on the waitlist
+    int rang_attente; // Order on the subject's waitlist (lowest first) while statut is 2
 } Inscription;
 
+/**
+ * Outcome of a group enrollment
+ */
+typedef struct {
+    int nb_etudiants;          // Students of the group
+    int nb_inscrits;           // Enrollments made
+    int nb_en_attente;         // Students put on a waitlist because the course was full
+    int nb_deja_inscrits;      // Students already enrolled or waitlisted
+    int nb_prerequis_manquants; // Enrollments refused for missing prerequisites
+    int nb_matieres_inconnues; // Subject IDs that do not exist
+} BilanInscriptions;
+
 /**
  * Node for enrollment linked list
  */
@@ -41,14 +57,52 @@ int charger_inscriptions(NodeInscription** tete);
 int sauvegarder_inscriptions(NodeInscription* tete);
 
 /**
- * Enroll a student in a course
+ * Enroll a student in a course, or put them on its waitlist when the course is full;
+ * refused if the student lacks its prerequisites (grades give the subjects passed)
+ */
+void inscrire_etudiant_cours(NodeInscription** tete, NodeMatiere* matieres, NodeNote* notes,
+                             int id_etudiant, int id_matiere);
+
+/**
+ * Unenroll a student from a course (or remove them from its waitlist) and
+ * promote the first students of the waitlist to the freed seats
+ */
+void desinscrire_etudiant_cours(NodeInscription** tete, NodeMatiere* matieres, int id_etudiant, int id_matiere);
+
+/**
+ * Promote waitlisted students to the free seats of a course (after its capacity was raised)
+ * @param id_matiere ID of the subject, 0 for every subject
+ * @return Number of students promoted, -1 if error
+ */
+int promouvoir_liste_attente(NodeInscription** tete, NodeMatiere* matieres, int id_matiere);
+
+/**
+ * Enroll every student of a section and/or field of study in a list of subjects,
+ * skipping existing enrollments and students lacking prerequisites, and saving once
+ * @param section Section of the students, NULL or empty for any
+ * @param filiere Field of study of the students, NULL or empty for any
+ * @param bilan Receives the counts of the operation
+ * @return 1 if successful, 0 if error
  */
-void inscrire_etudiant_cours(NodeInscription** tete, int id_etudiant, int id_matiere);
+int inscrire_groupe_cours(NodeInscription** tete, NodeEtudiant* etudiants, NodeMatiere* matieres,
+                          NodeNote* notes, const char *section, const char *filiere,
+                          const int *ids_matieres, int nb_matieres, BilanInscriptions *bilan);
 
 /**
- * Unenroll a student from a course
+ * Ask for a group of students and a list of subjects and enroll them
  */
-void desinscrire_etudiant_cours(NodeInscription** tete, int id_etudiant, int id_matiere);
+void saisir_inscription_groupe(NodeInscription** tete, NodeEtudiant* etudiants, NodeMatiere* matieres,
+                               NodeNote* notes);
+
+/**
+ * Display the seats taken and the waitlist of a course
+ */
+void afficher_places_matiere(NodeInscription* tete, NodeMatiere* matieres, int id_matiere);
+
+/**
+ * Get the label of an enrollment status
+ */
+const char* statut_inscription_to_string(int statut);
 
 /**
  * Display all enrollments in the linked list
@@ -71,14 +125,27 @@ void afficher_inscriptions_par_matiere(NodeInscription* tete, int id_matiere);
  */
 int est_inscrit(NodeInscription* tete, int id_etudiant, int id_matiere);
 
+/**
+ * Get the subjects a student is enrolled in (status 1), from the enrollments index
+ * @param ids_matieres Receives the subject IDs, to free by the caller
+ * @return Number of subjects, -1 if error
+ */
+int matieres_inscrites_etudiant(NodeInscription* tete, int id_etudiant, int **ids_matieres);
+
 /**
  * Get student enrollment management menu
  */
-void menu_inscriptions_etudiant(NodeInscription** tete, int id_etudiant);
+void menu_inscriptions_etudiant(NodeInscription** tete, NodeMatiere* matieres, NodeNote* notes, int id_etudiant);
 
 /**
  * Free memory allocated for enrollment linked list
  */
 void liberer_inscriptions(NodeInscription** tete);
 
+/**
+ * Get the enrollments modification counter (incremented on every load and save),
+ * used by derived caches to detect stale data
+ */
+unsigned long inscriptions_generation(void);
+
 #endif /* INSCRIPTIONS_H */
\ No newline at end of file
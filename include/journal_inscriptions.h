@@ -0,0 +1,98 @@
+/**
+ * @file journal_inscriptions.h
+ * @brief Append-only log of the enrollment events
+ *
+ * Every change of an enrollment status (enrolled, unenrolled, waitlisted)
+ * is appended to data/inscriptions_journal.txt with its timestamp before
+ * the enrollments table is saved, so the table is only the latest state of
+ * each (student, subject) pair and is reconciled with the log on load.
+ * Events are indexed by subject in chronological order: the history of a
+ * subject and its enrolled students at a past date only read its events.
+ * The history starts when the log is created: earlier states are taken from
+ * the table, one event per pair at the date of its last change.
+ */
+
+#ifndef JOURNAL_INSCRIPTIONS_H
+#define JOURNAL_INSCRIPTIONS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "inscriptions.h"
+
+/**
+ * @struct EvenementInscription
+ * @brief Change of the enrollment status of a student in a subject
+ */
+typedef struct {
+    time_t date;
+    int id_etudiant;
+    int id_matiere;
+    int statut; // New status: 1 = enrolled, 0 = unenrolled, 2 = on the waitlist
+} EvenementInscription;
+
+/**
+ * @brief Load the log, creating it from the enrollments table the first time
+ * @param tete Linked list of enrollments (used only when there is no log yet)
+ * @return 1 if successful, 0 if error
+ */
+int charger_journal_inscriptions(NodeInscription* tete);
+
+/**
+ * @brief Record a status change now (written by the next ecrire_journal_inscriptions)
+ * @param id_etudiant ID of the student
+ * @param id_matiere ID of the subject
+ * @param statut New status of the enrollment
+ * @return 1 if successful, 0 if error
+ */
+int journaliser_inscription(int id_etudiant, int id_matiere, int statut);
+
+/**
+ * @brief Append the events recorded since the last write to the log file
+ * @return 1 if successful, 0 if error
+ */
+int ecrire_journal_inscriptions(void);
+
+/**
+ * @brief Get the latest event of a (student, subject) pair
+ * @param id_etudiant ID of the student
+ * @param id_matiere ID of the subject
+ * @return Latest event, NULL if the pair has none
+ */
+const EvenementInscription* dernier_evenement_inscription(int id_etudiant, int id_matiere);
+
+/**
+ * @brief Call a function on the latest event of every (student, subject) pair
+ * @param fonction Function called with each event and the context
+ * @param contexte Context passed to the function
+ * @return 1 if every call returned 1, 0 otherwise
+ */
+int parcourir_etats_inscriptions(int (*fonction)(const EvenementInscription*, void*), void *contexte);
+
+/**
+ * @brief Get the students enrolled in a subject at a given date
+ * @param id_matiere ID of the subject
+ * @param date Instant of the query (events at this instant included)
+ * @param ids_etudiants Receives the IDs sorted in increasing order, to free by the caller
+ * @return Number of students, -1 if error
+ */
+int inscrits_a_la_date(int id_matiere, time_t date, int **ids_etudiants);
+
+/**
+ * @brief Display the enrollment history of a subject
+ * @param id_matiere ID of the subject
+ */
+void afficher_historique_matiere(int id_matiere);
+
+/**
+ * @brief Ask for a subject and a date and display the students enrolled at the end of that day
+ */
+void afficher_inscrits_a_la_date(void);
+
+/**
+ * @brief Free the log loaded in memory
+ */
+void liberer_journal_inscriptions(void);
+
+#endif /* JOURNAL_INSCRIPTIONS_H */
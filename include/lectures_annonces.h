@@ -0,0 +1,77 @@
+/**
+ * @file lectures_annonces.h
+ * @brief Read markers and unread counters of the students' announcements
+ *
+ * Each student has a bitset of the announcement IDs they have read and a
+ * cached count of the unread announcements of their feed. The count is
+ * stamped with the revision of the announcements file and a signature of
+ * the student's enrollments, so it is answered without scanning anything
+ * until one of them changes; it is then recomputed from the feed once.
+ * Markers and counters are kept in data/lectures_annonces.txt.
+ */
+
+#ifndef LECTURES_ANNONCES_H
+#define LECTURES_ANNONCES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "annonces.h"
+#include "inscriptions.h"
+#include "matiere.h"
+#include "ensemble_bits.h"
+
+/**
+ * @brief Load the read markers from file
+ * @return 1 if successful, 0 if error
+ */
+int charger_lectures_annonces(void);
+
+/**
+ * @brief Save the read markers to file if they changed
+ * @return 1 if successful, 0 if error
+ */
+int sauvegarder_lectures_annonces(void);
+
+/**
+ * @brief Get the number of unread announcements of a student's feed
+ * @param id_etudiant ID of the student
+ * @param annonces Linked list of announcements
+ * @param inscriptions Linked list of enrollments
+ * @return Number of unread announcements, -1 if error
+ */
+int annonces_non_lues(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions);
+
+/**
+ * @brief Check whether a student has read an announcement
+ * @param id_etudiant ID of the student
+ * @param id_annonce ID of the announcement
+ * @return 1 if read, 0 otherwise
+ */
+int annonce_lue(int id_etudiant, int id_annonce);
+
+/**
+ * @brief Mark announcements of a student's feed as read
+ * @param id_etudiant ID of the student
+ * @param annonces Announcements shown to the student
+ * @param nb Number of announcements
+ * @return 1 if successful, 0 if error
+ */
+int marquer_annonces_lues(int id_etudiant, NodeAnnonce* const *annonces, int nb);
+
+/**
+ * @brief Display the unread announcements of a student's feed and mark them as read
+ * @param id_etudiant ID of the student
+ * @param annonces Linked list of announcements
+ * @param inscriptions Linked list of enrollments
+ * @param matieres Linked list of subjects
+ */
+void afficher_annonces_non_lues(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions,
+                                NodeMatiere* matieres);
+
+/**
+ * @brief Free the read markers
+ */
+void liberer_lectures_annonces(void);
+
+#endif /* LECTURES_ANNONCES_H */
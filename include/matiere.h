@@ -22,6 +22,7 @@ typedef struct {
     char code_matiere[MAX_CODE_MATIERE_LEN];
     char nom_matiere[MAX_NOM_MATIERE_LEN];
     float coefficient;
+    int capacite; // Maximum number of enrolled students, 0 = unlimited
 } Matiere;
 
 /**
@@ -91,4 +92,10 @@ void rechercher_matieres(NodeMatiere* tete);
  */
 void liberer_matieres(NodeMatiere** tete);
 
+/**
+ * @brief Get the subjects modification counter (incremented on every load and save)
+ * @return Current counter value, used by derived caches to detect stale data
+ */
+unsigned long matieres_generation(void);
+
 #endif /* MATIERE_H */
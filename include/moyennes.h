@@ -0,0 +1,79 @@
+/**
+ * @file moyennes.h
+ * @brief Weighted average engine (grades weighted by subject coefficient)
+ */
+
+#ifndef MOYENNES_H
+#define MOYENNES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "notes.h"
+#include "matiere.h"
+
+/**
+ * Coefficient used for grades whose subject no longer exists
+ */
+#define COEFFICIENT_PAR_DEFAUT 1.0f
+
+/**
+ * @struct MoyenneMatiereEtudiant
+ * @brief Average of one student in one subject
+ */
+typedef struct {
+    int id_matiere;
+    float moyenne;
+    float coefficient;
+    int nb_notes;
+} MoyenneMatiereEtudiant;
+
+/**
+ * @struct MoyenneEtudiant
+ * @brief Weighted average of a student: sum(coefficient * subject average) / sum(coefficients)
+ */
+typedef struct {
+    int id_etudiant;
+    float moyenne_ponderee;
+    float somme_coefficients;
+    int nb_notes;
+    int nb_matieres;
+    int premier_detail; // Position of the first subject average in the details array
+} MoyenneEtudiant;
+
+/**
+ * @brief Get the cached weighted average of a student, rebuilding the cache if grades or subjects changed
+ * @param notes List of grades
+ * @param matieres List of subjects
+ * @param id_etudiant ID of the student
+ * @return Pointer to the student's averages, NULL if the student has no grades
+ */
+const MoyenneEtudiant* obtenir_moyenne_etudiant(NodeNote* notes, NodeMatiere* matieres, int id_etudiant);
+
+/**
+ * @brief Calculate the weighted average of a student across all subjects
+ * @param notes List of grades
+ * @param matieres List of subjects
+ * @param id_etudiant ID of the student
+ * @return Weighted average, 0 if the student has no grades
+ */
+float calculer_moyenne_ponderee_etudiant(NodeNote* notes, NodeMatiere* matieres, int id_etudiant);
+
+/**
+ * @brief Get the per-subject averages of a student
+ * @param moyenne Averages returned by obtenir_moyenne_etudiant()
+ * @return Array of moyenne->nb_matieres subject averages
+ */
+const MoyenneMatiereEtudiant* details_moyenne_etudiant(const MoyenneEtudiant *moyenne);
+
+/**
+ * @brief Force the next lookup to rebuild the cache
+ */
+void invalider_cache_moyennes(void);
+
+/**
+ * @brief Free memory allocated for the averages cache
+ */
+void liberer_cache_moyennes(void);
+
+#endif /* MOYENNES_H */
@@ -96,4 +96,10 @@ NodeNote* trouver_note_par_id(NodeNote* tete, int id);
  */
 void liberer_notes(NodeNote** tete);
 
+/**
+ * Get the grades modification counter (incremented on every load and save),
+ * used by derived caches to detect stale data
+ */
+unsigned long notes_generation(void);
+
 #endif /* NOTES_H */
\ No newline at end of file
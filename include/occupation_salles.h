@@ -0,0 +1,97 @@
+/**
+ * @file occupation_salles.h
+ * @brief Room occupancy analytics
+ *
+ * Enrollment counts are grouped by subject and by (subject, section) in one
+ * pass over the enrollments, then every session of the grid and of the
+ * planning is visited once to fill the weekly occupancy of its room and to
+ * compare the students expected with the room capacity.
+ */
+
+#ifndef OCCUPATION_SALLES_H
+#define OCCUPATION_SALLES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "salle.h"
+#include "emploi_du_temps.h"
+#include "planning.h"
+#include "etudiant.h"
+#include "matiere.h"
+#include "inscriptions.h"
+
+/**
+ * @struct OccupationSalle
+ * @brief Weekly occupancy of one room
+ */
+typedef struct {
+    char nom[MAX_SALLE_LEN];
+    int capacite;               // 0 if the room is not in the catalogue
+    int enregistree;            // 1 if the room is in the catalogue
+    TypeSalle type;
+    int creneaux_occupes;       // Distinct slots of the week used
+    int creneaux_semaine;       // Slots of the week
+    double taux;                // Percentage of the week used
+    int nb_seances;
+    int max_inscrits;           // Largest group expected in the room
+    int nb_depassements;        // Sessions with more students than seats
+} OccupationSalle;
+
+/**
+ * @struct DepassementCapacite
+ * @brief Session with more enrolled students than seats
+ */
+typedef struct {
+    int id_seance;
+    int depuis_planning;        // 0 for the grid, 1 for the planning
+    int id_matiere;
+    char salle[MAX_SALLE_LEN];
+    char section[MAX_SECTION_LEN]; // Empty for the grid
+    int jour;
+    char horaire[MAX_NOM_CRENEAU_LEN];
+    int inscrits;
+    int capacite;
+} DepassementCapacite;
+
+/**
+ * @struct AnalyseSalles
+ * @brief Occupancy of every room used or registered
+ */
+typedef struct {
+    OccupationSalle *salles;    // Sorted by decreasing occupancy
+    int nb_salles;
+    DepassementCapacite *depassements;
+    int nb_depassements;
+    int nb_hors_catalogue;      // Rooms used but not registered
+    double duree_ms;
+} AnalyseSalles;
+
+/**
+ * @brief Compute the weekly occupancy and capacity overflows of the rooms
+ * @param analyse Pointer to analysis structure to fill
+ * @param salles Room catalogue
+ * @param edt Timetable grid
+ * @param planning Multi-section planning (NULL if none)
+ * @param etudiants List of students
+ * @param inscriptions List of enrollments
+ * @return 1 if successful, 0 if error
+ */
+int analyser_occupation_salles(AnalyseSalles *analyse, NodeSalle* salles, const EmploiDuTemps *edt,
+                               const Planning *planning, NodeEtudiant* etudiants,
+                               NodeInscription* inscriptions);
+
+/**
+ * @brief Display the occupancy of the rooms and the capacity overflows
+ * @param analyse Pointer to analysis structure
+ * @param matieres List of subjects
+ */
+void afficher_occupation_salles(const AnalyseSalles *analyse, NodeMatiere* matieres);
+
+/**
+ * @brief Free memory allocated for an analysis
+ * @param analyse Pointer to analysis structure
+ */
+void liberer_occupation_salles(AnalyseSalles *analyse);
+
+#endif /* OCCUPATION_SALLES_H */
@@ -0,0 +1,44 @@
+/**
+ * @file parallele.h
+ * @brief Worker pool running independent tasks on several threads
+ */
+
+#ifndef PARALLELE_H
+#define PARALLELE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Maximum number of worker threads started for one batch of tasks
+ */
+#define MAX_THREADS 64
+
+/**
+ * @brief Function executed for each task
+ * @param indice Index of the task (0 to nb_taches - 1)
+ * @param contexte Shared context passed to executer_taches_paralleles()
+ */
+typedef void (*FonctionTache)(int indice, void *contexte);
+
+/**
+ * @brief Get the number of online processors
+ * @return Number of processors, at least 1
+ */
+int nombre_processeurs(void);
+
+/**
+ * @brief Run tasks on a pool of worker threads and wait for all of them
+ *
+ * Workers pull the next task index from a shared counter, so uneven tasks
+ * are balanced automatically. The calling thread takes part in the work.
+ *
+ * @param nb_taches Number of tasks
+ * @param nb_threads Number of threads (0 for one per processor)
+ * @param fonction Function executed for each task
+ * @param contexte Shared context passed to every task
+ * @return Number of threads actually used
+ */
+int executer_taches_paralleles(int nb_taches, int nb_threads, FonctionTache fonction, void *contexte);
+
+#endif /* PARALLELE_H */
@@ -0,0 +1,221 @@
+/**
+ * @file planning.h
+ * @brief Multi-section, multi-room timetable holding many sessions per slot
+ *
+ * Unlike the single EmploiDuTemps grid, the planning stores a sparse list
+ * of sessions keyed by section, room and teacher, for a configurable week.
+ */
+
+#ifndef PLANNING_H
+#define PLANNING_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "index.h"
+#include "etudiant.h"
+#include "enseignant.h"
+#include "matiere.h"
+#include "emploi_du_temps.h"
+
+#define MAX_JOURS_PLANNING 7
+#define MAX_CRENEAUX_JOUR_PLANNING 12
+#define MAX_NOM_CRENEAU_LEN 16
+#define MAX_NOM_REGISTRE_LEN 16
+
+/**
+ * @struct Seance
+ * @brief One weekly session of the planning (IDs only, names are resolved for display)
+ */
+typedef struct {
+    int id;
+    int id_matiere;
+    int id_enseignant;
+    char section[MAX_SECTION_LEN];
+    char salle[MAX_SALLE_LEN];
+    int jour;
+    int heure;
+} Seance;
+
+/**
+ * @struct RegistreNoms
+ * @brief Names (rooms, sections) mapped to dense indexes
+ */
+typedef struct {
+    char (*noms)[MAX_NOM_REGISTRE_LEN];
+    int nb;
+    int capacite;
+    IndexId index; // Hash of the name -> dense index
+} RegistreNoms;
+
+/**
+ * @struct Planning
+ * @brief Sparse weekly planning with indexes by room/slot, teacher and section
+ */
+typedef struct Planning {
+    int nb_jours;
+    int nb_creneaux_jour;
+    char noms_creneaux[MAX_CRENEAUX_JOUR_PLANNING][MAX_NOM_CRENEAU_LEN];
+    Seance *seances;
+    int nb_seances;
+    int capacite;
+    int prochain_id;
+    RegistreNoms salles;
+    RegistreNoms sections;
+    int *salle_seance;            // Dense room of each session
+    int *section_seance;          // Dense section of each session
+    int *suivant_enseignant;      // Next session of the same teacher, -1 at the end
+    int *suivant_section;         // Next session of the same section, -1 at the end
+    IndexId index_ids;            // Session ID -> position
+    IndexId index_salle_creneau;  // (room, slot) -> position
+    IndexId index_enseignant_creneau; // (teacher ID, slot) -> position
+    IndexId index_section_creneau;    // (section, slot) -> position
+    IndexId tete_enseignant;      // Teacher ID -> first session
+    IndexId tete_section;         // Section -> first session
+} Planning;
+
+/**
+ * @brief Initialize an empty planning
+ * @param planning Pointer to planning structure
+ * @param nb_jours Number of days per week (1 to MAX_JOURS_PLANNING)
+ * @param nb_creneaux_jour Number of slots per day (1 to MAX_CRENEAUX_JOUR_PLANNING)
+ * @return 1 if successful, 0 if error
+ */
+int initialiser_planning(Planning *planning, int nb_jours, int nb_creneaux_jour);
+
+/**
+ * @brief Free memory allocated for a planning
+ * @param planning Pointer to planning structure
+ */
+void liberer_planning(Planning *planning);
+
+/**
+ * @brief Load the planning from file
+ * @param planning Pointer to planning structure
+ * @return 1 if successful, 0 if error
+ */
+int charger_planning(Planning *planning);
+
+/**
+ * @brief Save the planning to file
+ * @param planning Pointer to planning structure
+ * @return 1 if successful, 0 if error
+ */
+int sauvegarder_planning(const Planning *planning);
+
+/**
+ * @brief Add a session to the planning
+ * @param planning Pointer to planning structure
+ * @param id_matiere ID of the subject
+ * @param id_enseignant ID of the teacher
+ * @param section Section attending the session
+ * @param salle Room of the session
+ * @param jour Day (0 to nb_jours - 1)
+ * @param heure Slot of the day (0 to nb_creneaux_jour - 1)
+ * @return ID of the new session, 0 if the room, the teacher or the section is busy at that time, or error
+ */
+int ajouter_seance(Planning *planning, int id_matiere, int id_enseignant,
+                   const char *section, const char *salle, int jour, int heure);
+
+/**
+ * @brief Remove a session from the planning
+ * @param planning Pointer to planning structure
+ * @param id ID of the session
+ * @return 1 if successful, 0 if not found or error
+ */
+int supprimer_seance(Planning *planning, int id);
+
+/**
+ * @brief Move a session to another room and slot, in O(1)
+ * @param planning Pointer to planning structure
+ * @param id ID of the session
+ * @param salle New room
+ * @param jour New day
+ * @param heure New slot of the day
+ * @return 1 if successful, 0 if the room, the teacher or the section is busy at that time,
+ *         the session is not found or error
+ */
+int deplacer_seance(Planning *planning, int id, const char *salle, int jour, int heure);
+
+/**
+ * @brief Find a session by ID
+ * @param planning Pointer to planning structure
+ * @param id ID of the session
+ * @return Pointer to the session, NULL if not found
+ */
+const Seance* trouver_seance(const Planning *planning, int id);
+
+/**
+ * @brief Get the session held in a room at a given time, in O(1)
+ * @param planning Pointer to planning structure
+ * @param salle Room
+ * @param jour Day
+ * @param heure Slot of the day
+ * @return Pointer to the session, NULL if the room is free
+ */
+const Seance* seance_salle_creneau(const Planning *planning, const char *salle, int jour, int heure);
+
+/**
+ * @brief Get the week of a teacher, in O(k) for k sessions
+ * @param planning Pointer to planning structure
+ * @param id_enseignant ID of the teacher
+ * @param resultat Array receiving the sessions, sorted by day and slot
+ * @param max Size of the array
+ * @return Number of sessions of the teacher
+ */
+int seances_enseignant(const Planning *planning, int id_enseignant, const Seance **resultat, int max);
+
+/**
+ * @brief Get the week of a section, in O(k) for k sessions
+ * @param planning Pointer to planning structure
+ * @param section Section
+ * @param resultat Array receiving the sessions, sorted by day and slot
+ * @param max Size of the array
+ * @return Number of sessions of the section
+ */
+int seances_section(const Planning *planning, const char *section, const Seance **resultat, int max);
+
+/**
+ * @brief Get the name of a day of the planning
+ * @param jour Day (0 to MAX_JOURS_PLANNING - 1)
+ * @return Name of the day
+ */
+const char* nom_jour_planning(int jour);
+
+/**
+ * @brief Display a list of sessions with subject and teacher names
+ * @param planning Pointer to planning structure
+ * @param seances Sessions to display
+ * @param nb Number of sessions
+ * @param matieres Linked list of subjects
+ * @param enseignants Linked list of teachers
+ */
+void afficher_seances(const Planning *planning, const Seance **seances, int nb,
+                      NodeMatiere* matieres, NodeEnseignant* enseignants);
+
+/**
+ * @brief Generate the planning of every section from the students, subjects and teachers
+ * @param planning Pointer to planning structure
+ * @param enseignants Linked list of teachers
+ * @param matieres Linked list of subjects
+ * @param etudiants Linked list of students
+ */
+void generer_planning(Planning *planning, NodeEnseignant* enseignants,
+                      NodeMatiere* matieres, NodeEtudiant* etudiants);
+
+/**
+ * @brief Display the planning of a section, a teacher or a room
+ * @param planning Pointer to planning structure
+ * @param matieres Linked list of subjects
+ * @param enseignants Linked list of teachers
+ */
+void consulter_planning(const Planning *planning, NodeMatiere* matieres, NodeEnseignant* enseignants);
+
+/**
+ * @brief Get the planning modification counter (incremented on every load and save),
+ * used by derived caches to detect stale data
+ * @return Current counter value
+ */
+unsigned long planning_generation(void);
+
+#endif /* PLANNING_H */
@@ -0,0 +1,123 @@
+/**
+ * @file prerequis.h
+ * @brief Prerequisites and co-requisites of the subjects
+ *
+ * A prerequisite must be passed before enrolling in a subject; a
+ * co-requisite must be passed or followed at the same time. Together they
+ * form a directed acyclic graph (links closing a cycle are refused), kept
+ * in data/prerequis.txt. Each subject holds the transitive closure of its
+ * prerequisites as a bitset of subject IDs, recomputed when the graph
+ * changes, so checking an enrollment is a bitset inclusion against the
+ * subjects the student passed.
+ */
+
+#ifndef PREREQUIS_H
+#define PREREQUIS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matiere.h"
+#include "notes.h"
+#include "inscriptions.h"
+#include "ensemble_bits.h"
+
+/**
+ * Subject average needed to pass a subject
+ */
+#define NOTE_VALIDATION 10.0f
+
+/**
+ * @brief Load the prerequisites graph from file
+ * @param matieres List of subjects; links to a subject missing from it are skipped (NULL keeps every link)
+ * @return 1 if successful, 0 if error
+ */
+int charger_prerequis(NodeMatiere* matieres);
+
+/**
+ * @brief Save the prerequisites graph to file
+ * @return 1 if successful, 0 if error
+ */
+int sauvegarder_prerequis(void);
+
+/**
+ * @brief Add a prerequisite or co-requisite link, unless it would close a cycle
+ * @param id_matiere ID of the subject
+ * @param id_requis ID of the subject it requires
+ * @param corequis 1 for a co-requisite, 0 for a prerequisite
+ * @return 1 if added, 0 if refused or error
+ */
+int ajouter_prerequis(int id_matiere, int id_requis, int corequis);
+
+/**
+ * @brief Remove the link between two subjects
+ * @param id_matiere ID of the subject
+ * @param id_requis ID of the subject it requires
+ * @return 1 if removed, 0 if there was no such link
+ */
+int retirer_prerequis(int id_matiere, int id_requis);
+
+/**
+ * @brief Remove and save every link from or to a deleted subject
+ * @param id_matiere ID of the subject
+ * @return Number of links removed, -1 if error
+ */
+int retirer_prerequis_matiere(int id_matiere);
+
+/**
+ * @brief Get every subject that must be passed before a subject (transitive closure)
+ * @param id_matiere ID of the subject
+ * @return Set of subject IDs, NULL if the subject has no prerequisite
+ */
+const EnsembleBits* prerequis_transitifs(int id_matiere);
+
+/**
+ * @brief Get the depth of a subject in the graph (0 if it requires nothing)
+ *
+ * Subjects sorted by increasing depth come after everything they require.
+ *
+ * @param id_matiere ID of the subject
+ * @return Length of the longest chain of links from the subject
+ */
+int profondeur_prerequis(int id_matiere);
+
+/**
+ * @brief Build the set of subjects a student passed (subject average >= NOTE_VALIDATION)
+ * @param notes List of grades
+ * @param matieres List of subjects
+ * @param id_etudiant ID of the student
+ * @param reussies Set receiving the subject IDs (emptied first)
+ * @return 1 if successful, 0 if error
+ */
+int matieres_reussies(NodeNote* notes, NodeMatiere* matieres, int id_etudiant, EnsembleBits *reussies);
+
+/**
+ * @brief Check the prerequisites and co-requisites of a subject for a student
+ * @param id_etudiant ID of the student
+ * @param id_matiere ID of the subject
+ * @param reussies Subjects passed by the student
+ * @param inscriptions List of enrollments (current enrollments satisfy co-requisites)
+ * @param afficher 1 to display what is missing
+ * @return 1 if the student may enroll, 0 otherwise
+ */
+int prerequis_satisfaits(int id_etudiant, int id_matiere, const EnsembleBits *reussies,
+                         NodeInscription* inscriptions, int afficher);
+
+/**
+ * @brief Display the prerequisites and co-requisites of every subject
+ * @param matieres List of subjects
+ */
+void afficher_prerequis(NodeMatiere* matieres);
+
+/**
+ * @brief Prerequisites management menu
+ * @param matieres List of subjects
+ */
+void menu_prerequis(NodeMatiere* matieres);
+
+/**
+ * @brief Free the prerequisites graph
+ */
+void liberer_prerequis(void);
+
+#endif /* PREREQUIS_H */
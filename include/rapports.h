@@ -0,0 +1,84 @@
+/**
+ * @file rapports.h
+ * @brief End-of-term reports computed in parallel over subjects and students
+ */
+
+#ifndef RAPPORTS_H
+#define RAPPORTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "notes.h"
+#include "matiere.h"
+#include "etudiant.h"
+#include "statistiques.h"
+
+/**
+ * @struct RapportMatiere
+ * @brief Grade statistics of one subject
+ */
+typedef struct {
+    int id_matiere;
+    float coefficient;
+    StatistiquesNotes stats;
+} RapportMatiere;
+
+/**
+ * @struct RapportEtudiant
+ * @brief Weighted average of one student
+ */
+typedef struct {
+    int id_etudiant;
+    float moyenne_ponderee;
+    int nb_notes;
+    int nb_matieres;
+} RapportEtudiant;
+
+/**
+ * @struct RapportFinSemestre
+ * @brief Aggregates of the end-of-term reports for the whole population
+ */
+typedef struct {
+    RapportMatiere *matieres;
+    int nb_matieres;
+    RapportEtudiant *etudiants;
+    int nb_etudiants;
+    StatistiquesNotes moyennes_etudiants; // Distribution of the weighted averages
+    int nb_threads;
+    double duree_ms;
+} RapportFinSemestre;
+
+/**
+ * @brief Compute all end-of-term aggregates on a worker pool
+ *
+ * Subject statistics are computed on ranges of grades and the partial
+ * aggregates merged; the weighted averages of the students are taken from
+ * the averages cache (moyennes.h) and their distribution computed on
+ * ranges of students.
+ *
+ * @param rapport Pointer to report structure to fill
+ * @param notes List of grades
+ * @param matieres List of subjects
+ * @param etudiants List of students
+ * @param nb_threads Number of threads (0 for one per processor)
+ * @return 1 if successful, 0 if error
+ */
+int generer_rapport_fin_semestre(RapportFinSemestre *rapport, NodeNote* notes,
+                                 NodeMatiere* matieres, NodeEtudiant* etudiants, int nb_threads);
+
+/**
+ * @brief Display the subject statistics, student statistics and student averages of a report
+ * @param rapport Pointer to report structure
+ * @param matieres List of subjects
+ * @param etudiants List of students
+ */
+void afficher_rapport_fin_semestre(const RapportFinSemestre *rapport, NodeMatiere* matieres, NodeEtudiant* etudiants);
+
+/**
+ * @brief Free memory allocated for a report
+ * @param rapport Pointer to report structure
+ */
+void liberer_rapport_fin_semestre(RapportFinSemestre *rapport);
+
+#endif /* RAPPORTS_H */
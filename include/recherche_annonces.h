@@ -0,0 +1,82 @@
+/**
+ * @file recherche_annonces.h
+ * @brief Full-text search over announcement titles and contents
+ *
+ * Titles and contents are cut into lowercase, accent-folded tokens. Each
+ * token keeps a posting list of the announcements containing it, sorted by
+ * ID and stored as variable-length deltas with the (title-weighted) count
+ * of occurrences. The index is built on the first search after a load and
+ * then kept up to date as announcements are added, modified or deleted.
+ */
+
+#ifndef RECHERCHE_ANNONCES_H
+#define RECHERCHE_ANNONCES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "annonces.h"
+
+/**
+ * Longest token kept (longer words are cut)
+ */
+#define MAX_TOKEN_LEN 32
+
+/**
+ * An occurrence in a title counts as many occurrences in a content
+ */
+#define POIDS_TITRE 3
+
+/**
+ * @enum ModeRecherche
+ * @brief How the words of a query are combined
+ */
+typedef enum {
+    RECHERCHE_ET, // Announcements containing every word
+    RECHERCHE_OU  // Announcements containing at least one word
+} ModeRecherche;
+
+/**
+ * @struct ResultatRecherche
+ * @brief Announcement found by a search and its relevance
+ */
+typedef struct {
+    NodeAnnonce *annonce;
+    double score;
+} ResultatRecherche;
+
+/**
+ * @brief Search announcements, most relevant first (tf-idf, newest first on ties)
+ * @param tete Linked list of announcements (indexed on the first search)
+ * @param requete Words to look for
+ * @param mode RECHERCHE_ET or RECHERCHE_OU
+ * @param resultats Receives an array of results to free by the caller
+ * @return Number of results, -1 if error
+ */
+int rechercher_annonces(NodeAnnonce* tete, const char *requete, ModeRecherche mode, ResultatRecherche **resultats);
+
+/**
+ * @brief Add an announcement to the index (no-op until the index is built)
+ * @param annonce Announcement added or whose texts changed
+ * @return 1 if successful, 0 if error
+ */
+int recherche_indexer_annonce(NodeAnnonce* annonce);
+
+/**
+ * @brief Remove an announcement from the index, using its current texts (no-op until the index is built)
+ * @param annonce Announcement about to be deleted or modified
+ */
+void recherche_retirer_annonce(const NodeAnnonce* annonce);
+
+/**
+ * @brief Drop the index (after a load or when the list is freed); the next search rebuilds it
+ */
+void recherche_invalider(void);
+
+/**
+ * @brief Ask for a query and display the matching announcements
+ * @param tete Linked list of announcements
+ */
+void rechercher_et_afficher_annonces(NodeAnnonce* tete);
+
+#endif /* RECHERCHE_ANNONCES_H */
@@ -0,0 +1,64 @@
+/**
+ * @file reparation_edt.h
+ * @brief Incremental repair of a timetable after a teacher becomes unavailable
+ *
+ * Only the sessions placed on slots that became forbidden are moved; every
+ * other session stays where it is, except a neighbour that may be shifted
+ * once to free a slot (local search with one ejection).
+ */
+
+#ifndef REPARATION_EDT_H
+#define REPARATION_EDT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "generateur_edt.h"
+#include "emploi_du_temps.h"
+#include "planning.h"
+#include "enseignant.h"
+
+/**
+ * @struct ResultatReparation
+ * @brief Outcome of a repair
+ */
+typedef struct {
+    int nb_concernees; // Sessions on slots that became unavailable
+    int nb_deplacees;  // Of those, sessions moved to a valid slot
+    int nb_ejections;  // Other sessions shifted to make room
+    int nb_echecs;     // Sessions left in place, no valid slot found
+    double duree_ms;
+} ResultatReparation;
+
+/**
+ * @brief Move the sessions of a teacher out of slots where they became unavailable
+ * @param planning Pointer to planning structure
+ * @param id_enseignant ID of the teacher
+ * @param indisponibles Forbidden slots (jour * nb_creneaux_jour + heure of the planning)
+ * @param resultat Receives the outcome of the repair
+ * @return 1 if every concerned session was moved, 0 otherwise
+ */
+int reparer_planning(Planning *planning, int id_enseignant, MasqueCreneaux indisponibles,
+                     ResultatReparation *resultat);
+
+/**
+ * @brief Move the slots of a teacher out of the grid where they became unavailable
+ * @param edt Pointer to timetable structure
+ * @param planning Multi-section planning whose teachers and rooms must stay free (NULL if none)
+ * @param id_enseignant ID of the teacher
+ * @param indisponibles Forbidden slots (jour * CRENEAUX_PAR_JOUR + heure)
+ * @param resultat Receives the outcome of the repair
+ * @return 1 if every concerned slot was moved, 0 otherwise
+ */
+int reparer_emploi_du_temps(EmploiDuTemps *edt, const Planning *planning, int id_enseignant,
+                            MasqueCreneaux indisponibles, ResultatReparation *resultat);
+
+/**
+ * @brief Ask for the unavailability of a teacher and repair the grid and the planning
+ * @param edt Pointer to timetable structure
+ * @param planning Pointer to planning structure
+ * @param enseignants Linked list of teachers
+ */
+void reparer_apres_indisponibilite(EmploiDuTemps *edt, Planning *planning, NodeEnseignant* enseignants);
+
+#endif /* REPARATION_EDT_H */
@@ -0,0 +1,103 @@
+/**
+ * @file salle.h
+ * @brief Room catalogue for the school management system
+ */
+
+#ifndef SALLE_H
+#define SALLE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "emploi_du_temps.h"
+
+/**
+ * @enum TypeSalle
+ * @brief Kind of sessions a room is equipped for
+ */
+typedef enum {
+    SALLE_COURS = 0,
+    SALLE_TP = 1
+} TypeSalle;
+
+/**
+ * @struct Salle
+ * @brief Structure for storing room information
+ *
+ * Rooms are identified by the name used in the timetable slots.
+ */
+typedef struct {
+    char nom[MAX_SALLE_LEN];
+    int capacite;
+    TypeSalle type;
+} Salle;
+
+/**
+ * @struct NodeSalle
+ * @brief Node structure for room linked list
+ */
+typedef struct NodeSalle {
+    Salle salle;
+    struct NodeSalle *suivant;
+} NodeSalle;
+
+/**
+ * @brief Load rooms from file into a linked list
+ * @param tete Pointer to head of linked list
+ * @return 1 if successful, 0 if error
+ */
+int charger_salles(NodeSalle** tete);
+
+/**
+ * @brief Save rooms from linked list to file
+ * @param tete Head of linked list
+ * @return 1 if successful, 0 if error
+ */
+int sauvegarder_salles(NodeSalle* tete);
+
+/**
+ * @brief Add a new room to the linked list
+ * @param tete Pointer to head of linked list
+ */
+void ajouter_salle(NodeSalle** tete);
+
+/**
+ * @brief Modify the capacity or type of an existing room
+ * @param tete Head of linked list
+ */
+void modifier_salle(NodeSalle* tete);
+
+/**
+ * @brief Delete a room from the linked list
+ * @param tete Pointer to head of linked list
+ */
+void supprimer_salle(NodeSalle** tete);
+
+/**
+ * @brief Display all rooms in the linked list
+ * @param tete Head of linked list
+ */
+void afficher_salles(NodeSalle* tete);
+
+/**
+ * @brief Find a room by name
+ * @param tete Head of linked list
+ * @param nom Name of the room
+ * @return Pointer to found room node, NULL if not found
+ */
+NodeSalle* trouver_salle(NodeSalle* tete, const char *nom);
+
+/**
+ * @brief Convert a room type to its name
+ * @param type Room type
+ * @return Name of the type
+ */
+const char* type_salle_to_string(TypeSalle type);
+
+/**
+ * @brief Free memory allocated for room linked list
+ * @param tete Pointer to head of linked list
+ */
+void liberer_salles(NodeSalle** tete);
+
+#endif /* SALLE_H */
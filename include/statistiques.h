@@ -0,0 +1,127 @@
+/**
+ * @file statistiques.h
+ * @brief Grade distribution statistics per subject and per section
+ */
+
+#ifndef STATISTIQUES_H
+#define STATISTIQUES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "notes.h"
+#include "etudiant.h"
+
+/**
+ * Number of histogram buckets: [0,1), [1,2), ..., [19,20) and exactly 20
+ */
+#define NB_TRANCHES_NOTES 21
+
+/**
+ * @struct StatistiquesNotes
+ * @brief Streaming aggregate of a set of grades (Welford mean/variance + fixed histogram)
+ */
+typedef struct {
+    int nb;
+    double moyenne;
+    double m2;      // Sum of squared deviations from the mean
+    float min;
+    float max;
+    int nb_reussites; // Grades >= 10
+    int histogramme[NB_TRANCHES_NOTES];
+    int extremes_perimes; // 1 once min or max was removed, until recomputed from the grades
+} StatistiquesNotes;
+
+/**
+ * @brief Initialize an empty aggregate
+ * @param stats Pointer to aggregate
+ */
+void stats_initialiser(StatistiquesNotes *stats);
+
+/**
+ * @brief Add a grade to an aggregate
+ * @param stats Pointer to aggregate
+ * @param note Grade between 0 and 20
+ */
+void stats_ajouter(StatistiquesNotes *stats, float note);
+
+/**
+ * @brief Remove a grade previously added to an aggregate
+ *
+ * Removing the minimum or the maximum marks the extremes as stale: they can
+ * only be found again from the remaining grades.
+ *
+ * @param stats Pointer to aggregate
+ * @param note Grade to remove
+ */
+void stats_retirer(StatistiquesNotes *stats, float note);
+
+/**
+ * @brief Merge an aggregate into another (parallel Welford combination)
+ * @param dest Aggregate receiving the merge
+ * @param src Aggregate to merge
+ */
+void stats_fusionner(StatistiquesNotes *dest, const StatistiquesNotes *src);
+
+/**
+ * @brief Get the standard deviation of an aggregate
+ * @param stats Pointer to aggregate
+ * @return Population standard deviation, 0 if empty
+ */
+double stats_ecart_type(const StatistiquesNotes *stats);
+
+/**
+ * @brief Estimate a quantile by interpolation inside the histogram buckets
+ * @param stats Pointer to aggregate
+ * @param q Quantile between 0 and 1 (0.5 for the median)
+ * @return Estimated grade, 0 if empty
+ */
+float stats_quantile(const StatistiquesNotes *stats, double q);
+
+/**
+ * @brief Get the statistics of a subject for all sections
+ * @param notes List of grades
+ * @param etudiants List of students
+ * @param id_matiere ID of the subject
+ * @return Pointer to the aggregate, NULL if no grade exists for the subject
+ */
+const StatistiquesNotes* statistiques_matiere(NodeNote* notes, NodeEtudiant* etudiants, int id_matiere);
+
+/**
+ * @brief Get the statistics of a subject restricted to one section
+ * @param notes List of grades
+ * @param etudiants List of students
+ * @param id_matiere ID of the subject
+ * @param section Section name
+ * @return Pointer to the aggregate, NULL if no grade exists for this subject and section
+ */
+const StatistiquesNotes* statistiques_matiere_section(NodeNote* notes, NodeEtudiant* etudiants,
+                                                      int id_matiere, const char *section);
+
+/**
+ * @brief Display count, mean, standard deviation, quartiles and histogram of an aggregate
+ * @param stats Pointer to aggregate
+ */
+void afficher_statistiques_notes(const StatistiquesNotes *stats);
+
+/**
+ * @brief Display the grade distribution of a subject, globally and per section
+ * @param notes List of grades
+ * @param etudiants List of students
+ * @param id_matiere ID of the subject
+ */
+void afficher_distribution_matiere(NodeNote* notes, NodeEtudiant* etudiants, int id_matiere);
+
+/**
+ * @brief Refresh the statistics after a single grade change instead of rebuilding them
+ * @param ancienne Grade before the change (NULL for an addition)
+ * @param nouvelle Grade after the change (NULL for a deletion)
+ */
+void statistiques_note_modifiee(const Note *ancienne, const Note *nouvelle);
+
+/**
+ * @brief Free memory allocated for the statistics
+ */
+void liberer_statistiques(void);
+
+#endif /* STATISTIQUES_H */
@@ -0,0 +1,92 @@
+/**
+ * @file tampon.h
+ * @brief Growable in-memory output buffer, written to a file in one call
+ */
+
+#ifndef TAMPON_H
+#define TAMPON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Initial capacity of a buffer
+ */
+#define TAILLE_TAMPON_INITIALE 4096
+
+/**
+ * @struct Tampon
+ * @brief Growable output buffer (zero-initialized means empty)
+ */
+typedef struct {
+    char *donnees;
+    size_t taille;
+    size_t capacite;
+} Tampon;
+
+/**
+ * @brief Append formatted text to a buffer, growing it if needed
+ * @param tampon Pointer to buffer
+ * @param format printf-style format
+ * @return 1 if successful, 0 if error
+ */
+int tampon_printf(Tampon *tampon, const char *format, ...);
+
+/**
+ * @brief Append raw bytes to a buffer, growing it if needed
+ * @param tampon Pointer to buffer
+ * @param octets Bytes to append
+ * @param taille Number of bytes
+ * @return 1 if successful, 0 if error
+ */
+int tampon_ajouter(Tampon *tampon, const char *octets, size_t taille);
+
+/**
+ * @brief Read one line of any length from a file, replacing the buffer contents
+ * @param tampon Pointer to buffer receiving the line (without the newline)
+ * @param fichier File to read
+ * @return 1 if a line was read, 0 at end of file or on error
+ */
+int tampon_lire_ligne(Tampon *tampon, FILE *fichier);
+
+/**
+ * @brief Append a free-text field, escaping '\\', '|', newlines and carriage returns
+ * @param tampon Pointer to buffer
+ * @param texte Text of the field
+ * @return 1 if successful, 0 if error
+ */
+int tampon_ajouter_champ(Tampon *tampon, const char *texte);
+
+/**
+ * @brief Cut the next '|'-separated field of a record, unescaping it in place
+ * @param curseur Position in the record, moved past the field and its separator
+ * @return Unescaped field (empty fields are kept), NULL when the record is exhausted
+ */
+char* extraire_champ(char **curseur);
+
+/**
+ * @brief Read a record of the old unescaped formats, whose free text may span several lines
+ * @param tampon Pointer to buffer receiving the record (lines joined by newlines, backslashes
+ *               escaped so that extraire_champ reads it like a current record)
+ * @param fichier File to read
+ * @param nb_separateurs Number of '|' of a complete record
+ * @return 1 if a record was read, 0 at end of file or on error
+ */
+int tampon_lire_enregistrement(Tampon *tampon, FILE *fichier, int nb_separateurs);
+
+/**
+ * @brief Write a whole buffer to a file
+ * @param chemin Path of the file (replaced)
+ * @param tampon Pointer to buffer
+ * @return 1 if successful, 0 if error
+ */
+int tampon_ecrire_fichier(const char *chemin, const Tampon *tampon);
+
+/**
+ * @brief Free memory allocated for a buffer
+ * @param tampon Pointer to buffer
+ */
+void tampon_liberer(Tampon *tampon);
+
+#endif /* TAMPON_H */
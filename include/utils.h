@@ -89,6 +89,13 @@ int validate_email(const char *email);
  */
 int create_data_dir();
 
+/**
+ * @brief Create a directory if it doesn't exist
+ * @param path Path of the directory
+ * @return 1 if successful, 0 if error
+ */
+int create_dir(const char *path);
+
 /**
  * @brief Case-insensitive substring search (like strcasestr)
  * @param haystack String to be searched
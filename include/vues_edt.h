@@ -0,0 +1,87 @@
+/**
+ * @file vues_edt.h
+ * @brief Personal timetables of students and teachers
+ *
+ * Sessions of the grid and of the planning are indexed by subject and by
+ * teacher once per timetable change. A student's week is the join of
+ * their active enrollments with the sessions of their subjects (planning
+ * sessions restricted to their section); a teacher's week is their own
+ * sessions. Each personal week is cached until the timetable, the planning
+ * or the enrollments change.
+ */
+
+#ifndef VUES_EDT_H
+#define VUES_EDT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "emploi_du_temps.h"
+#include "planning.h"
+#include "etudiant.h"
+#include "inscriptions.h"
+
+/**
+ * @struct SeancePersonnelle
+ * @brief One session of a personal timetable
+ */
+typedef struct {
+    int id_matiere;
+    int id_enseignant;
+    char salle[MAX_SALLE_LEN];
+    char section[MAX_SECTION_LEN]; // Empty for the grid
+    int jour;
+    int heure;
+    char horaire[MAX_NOM_CRENEAU_LEN];
+} SeancePersonnelle;
+
+/**
+ * @struct EmploiDuTempsPersonnel
+ * @brief Week of one student or teacher, sorted by day and slot
+ */
+typedef struct {
+    int id_personne;
+    int est_enseignant;
+    SeancePersonnelle *seances;
+    int nb_seances;
+    int capacite;
+    unsigned long version_seances;        // Version of the session indexes it was built from
+    unsigned long generation_inscriptions;
+} EmploiDuTempsPersonnel;
+
+/**
+ * @brief Get the timetable of a student
+ * @param etudiant Student
+ * @param edt Timetable grid
+ * @param planning Multi-section planning (NULL if none)
+ * @param inscriptions Linked list of enrollments
+ * @return Cached personal timetable, NULL if error
+ */
+const EmploiDuTempsPersonnel* emploi_du_temps_etudiant(const Etudiant *etudiant, const EmploiDuTemps *edt,
+                                                       const Planning *planning, NodeInscription* inscriptions);
+
+/**
+ * @brief Get the timetable of a teacher
+ * @param id_enseignant ID of the teacher
+ * @param edt Timetable grid
+ * @param planning Multi-section planning (NULL if none)
+ * @return Cached personal timetable, NULL if error
+ */
+const EmploiDuTempsPersonnel* emploi_du_temps_enseignant(int id_enseignant, const EmploiDuTemps *edt,
+                                                         const Planning *planning);
+
+/**
+ * @brief Display a personal timetable day by day
+ * @param vue Personal timetable
+ * @param matieres Linked list of subjects
+ * @param enseignants Linked list of teachers
+ */
+void afficher_emploi_du_temps_personnel(const EmploiDuTempsPersonnel *vue, NodeMatiere* matieres,
+                                        NodeEnseignant* enseignants);
+
+/**
+ * @brief Free the session indexes and every cached personal timetable
+ */
+void liberer_emplois_du_temps_personnels(void);
+
+#endif /* VUES_EDT_H */
@@ -4,12 +4,175 @@
  */
 
 #include "../include/annonces.h"
+#include "../include/recherche_annonces.h"
 #include "../include/matiere.h"
 #include "../include/enseignant.h"
 #include "../include/utils.h"
 #include <time.h>
+#include <limits.h>
 
 #define ANNONCES_FILE "data/annonces.txt"
+#define ARCHIVE_ANNONCES_FILE "data/annonces_archive.txt"
+
+// First line of the current format (epoch dates), followed by the revision and the last ID given;
+// version 2 stored dates as text, files without a version line are in the old raw format
+#define EN_TETE_ANNONCES "#annonces 3"
+#define EN_TETE_ANNONCES_V2 "#annonces 2"
+
+// Incremented whenever the announcements are (re)loaded or saved
+static unsigned long generation_annonces = 0;
+
+// Incremented on every save and kept in the file, unlike the generation
+static unsigned long revision_annonces = 0;
+
+// Highest ID ever given, so that IDs of deleted or archived announcements are not reused
+static int dernier_id_annonces = 0;
+
+/**
+ * Announcements sorted newest first, rebuilt when the list changes
+ */
+static struct {
+    NodeAnnonce **annonces;
+    int nb;
+    int capacite;
+    NodeAnnonce *liste;
+    unsigned long generation;
+    int construit;
+} chronologie;
+
+// Bytes taken by a text stored as a length followed by its bytes and a terminating zero
+static size_t taille_blob(const char *texte) {
+    return sizeof(unsigned int) + strlen(texte) + 1;
+}
+
+// Store a text at an offset of the text area, returning the offset after it
+static unsigned int ecrire_blob(char *textes, unsigned int position, const char *texte) {
+    unsigned int longueur = (unsigned int)strlen(texte);
+    memcpy(textes + position, &longueur, sizeof(longueur));
+    memcpy(textes + position + sizeof(longueur), texte, longueur + 1);
+    return position + sizeof(longueur) + longueur + 1;
+}
+
+// Text stored at an offset of the text area
+static const char* lire_blob(const NodeAnnonce* annonce, unsigned int position) {
+    return annonce->textes + position + sizeof(unsigned int);
+}
+
+/**
+ * Allocate an announcement node sized for its texts (other fields zeroed)
+ */
+NodeAnnonce* creer_annonce(const char *titre, const char *contenu, const char *auteur) {
+    size_t taille = taille_blob(titre) + taille_blob(contenu) + taille_blob(auteur);
+    NodeAnnonce *annonce = (NodeAnnonce*)malloc(sizeof(NodeAnnonce) + taille);
+    if (annonce == NULL) {
+        return NULL;
+    }
+    
+    memset(annonce, 0, sizeof(NodeAnnonce));
+    annonce->annonce.titre = 0;
+    annonce->annonce.contenu = ecrire_blob(annonce->textes, annonce->annonce.titre, titre);
+    annonce->annonce.auteur = ecrire_blob(annonce->textes, annonce->annonce.contenu, contenu);
+    ecrire_blob(annonce->textes, annonce->annonce.auteur, auteur);
+    return annonce;
+}
+
+/**
+ * Replace the texts of an announcement, NULL keeping the current one
+ */
+int changer_textes_annonce(NodeAnnonce** tete, NodeAnnonce** annonce,
+                           const char *titre, const char *contenu, const char *auteur) {
+    NodeAnnonce *ancienne = *annonce;
+    NodeAnnonce *nouvelle = creer_annonce(titre != NULL ? titre : annonce_titre(ancienne),
+                                          contenu != NULL ? contenu : annonce_contenu(ancienne),
+                                          auteur != NULL ? auteur : annonce_auteur(ancienne));
+    if (nouvelle == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    
+    // Old texts leave the search index, the new ones enter it below
+    recherche_retirer_annonce(ancienne);
+    
+    // Same record with the new text offsets, at the same place in the list
+    unsigned int titre_pos = nouvelle->annonce.titre;
+    unsigned int contenu_pos = nouvelle->annonce.contenu;
+    unsigned int auteur_pos = nouvelle->annonce.auteur;
+    nouvelle->annonce = ancienne->annonce;
+    nouvelle->annonce.titre = titre_pos;
+    nouvelle->annonce.contenu = contenu_pos;
+    nouvelle->annonce.auteur = auteur_pos;
+    nouvelle->suivant = ancienne->suivant;
+    
+    NodeAnnonce **lien = tete;
+    while (*lien != NULL && *lien != ancienne) {
+        lien = &(*lien)->suivant;
+    }
+    if (*lien == ancienne) {
+        *lien = nouvelle;
+    }
+    
+    free(ancienne);
+    *annonce = nouvelle;
+    recherche_indexer_annonce(nouvelle);
+    return 1;
+}
+
+/**
+ * Get the title of an announcement
+ */
+const char* annonce_titre(const NodeAnnonce* annonce) {
+    return lire_blob(annonce, annonce->annonce.titre);
+}
+
+/**
+ * Get the content of an announcement
+ */
+const char* annonce_contenu(const NodeAnnonce* annonce) {
+    return lire_blob(annonce, annonce->annonce.contenu);
+}
+
+/**
+ * Get the author of an announcement
+ */
+const char* annonce_auteur(const NodeAnnonce* annonce) {
+    return lire_blob(annonce, annonce->annonce.auteur);
+}
+
+/**
+ * Get the length in bytes of the content of an announcement
+ */
+size_t annonce_longueur_contenu(const NodeAnnonce* annonce) {
+    unsigned int longueur;
+    memcpy(&longueur, annonce->textes + annonce->annonce.contenu, sizeof(longueur));
+    return longueur;
+}
+
+/**
+ * Read a multi-line content from the keyboard until a line "fin"
+ */
+int saisir_contenu_annonce(Tampon *contenu) {
+    Tampon ligne = {0};
+    int nb_lignes = 0;
+    
+    contenu->taille = 0;
+    if (!tampon_ajouter(contenu, "", 0)) {
+        return 0;
+    }
+    
+    while (tampon_lire_ligne(&ligne, stdin)) {
+        if (strcmp(ligne.donnees, "fin") == 0) {
+            break;
+        }
+        if (!tampon_ajouter(contenu, ligne.donnees, ligne.taille) || !tampon_ajouter(contenu, "\n", 1)) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            break;
+        }
+        nb_lignes++;
+    }
+    
+    tampon_liberer(&ligne);
+    return nb_lignes;
+}
 
 /**
  * Load announcements from file into a linked list
@@ -35,48 +198,74 @@ int charger_annonces(NodeAnnonce** tete) {
         return 0;
     }
     
-    char line[1200]; // Buffer for reading lines (increased for long announcement content)
+    generation_annonces++;
+    recherche_invalider();
+    
+    Tampon ligne = {0}; // Grows with the longest line, nothing is truncated
     NodeAnnonce *dernier = NULL;
     
-    while (fgets(line, sizeof(line), file)) {
-        // Create a new node
-        NodeAnnonce *nouveau_node = (NodeAnnonce*)malloc(sizeof(NodeAnnonce));
+    // Old files wrote contents raw, so one announcement may span several lines
+    int version = 1;
+    revision_annonces = 0;
+    dernier_id_annonces = 0;
+    if (tampon_lire_ligne(&ligne, file)) {
+        size_t longueur_en_tete = strlen(EN_TETE_ANNONCES);
+        if (strncmp(ligne.donnees, EN_TETE_ANNONCES, longueur_en_tete) == 0 &&
+            (ligne.donnees[longueur_en_tete] == '\0' || ligne.donnees[longueur_en_tete] == ' ')) {
+            version = 3;
+            sscanf(ligne.donnees + longueur_en_tete, "%lu %d", &revision_annonces, &dernier_id_annonces);
+        } else if (strcmp(ligne.donnees, EN_TETE_ANNONCES_V2) == 0) {
+            version = 2;
+        }
+    }
+    if (version == 1) {
+        rewind(file);
+    }
+    
+    while (version == 1 ? tampon_lire_enregistrement(&ligne, file, 6) : tampon_lire_ligne(&ligne, file)) {
+        // Split the record (id|titre|contenu|auteur|creation|expiration|id_matiere|id_enseignant,
+        // without expiration and with a textual date before version 3)
+        char *champs[8] = {NULL};
+        char *curseur = ligne.donnees;
+        for (int i = 0; i < 8; i++) {
+            champs[i] = extraire_champ(&curseur);
+        }
+        if (champs[0] == NULL || champs[0][0] == '\0') {
+            continue;
+        }
+        
+        // Fragments left by earlier saves of split records carry no ID
+        if (version == 1 && atoi(champs[0]) <= 0) {
+            continue;
+        }
+        
+        // Create a new node sized for its texts
+        NodeAnnonce *nouveau_node = creer_annonce(champs[1] ? champs[1] : "",
+                                                  champs[2] ? champs[2] : "",
+                                                  champs[3] ? champs[3] : "");
         if (nouveau_node == NULL) {
             printf("Erreur: Échec d'allocation de mémoire.\n");
+            tampon_liberer(&ligne);
             fclose(file);
             return 0;
         }
         
-        // Parse the line
-        char *token = strtok(line, "|");
-        if (token) {
-            nouveau_node->annonce.id = atoi(token);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->annonce.titre, token, sizeof(nouveau_node->annonce.titre) - 1);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->annonce.contenu, token, sizeof(nouveau_node->annonce.contenu) - 1);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->annonce.auteur, token, sizeof(nouveau_node->annonce.auteur) - 1);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->annonce.date_creation, token, sizeof(nouveau_node->annonce.date_creation) - 1);
-            
-            token = strtok(NULL, "|");
-            if (token) nouveau_node->annonce.id_matiere = atoi(token);
-            
-            token = strtok(NULL, "|");
-            if (token) nouveau_node->annonce.id_enseignant = atoi(token);
-            else nouveau_node->annonce.id_enseignant = 0; // Default value if not present in file
-            
-            // Ensure null termination of strings
-            nouveau_node->annonce.titre[sizeof(nouveau_node->annonce.titre) - 1] = '\0';
-            nouveau_node->annonce.contenu[sizeof(nouveau_node->annonce.contenu) - 1] = '\0';
-            nouveau_node->annonce.auteur[sizeof(nouveau_node->annonce.auteur) - 1] = '\0';
-            nouveau_node->annonce.date_creation[sizeof(nouveau_node->annonce.date_creation) - 1] = '\0';
+        nouveau_node->annonce.id = atoi(champs[0]);
+        if (nouveau_node->annonce.id > dernier_id_annonces) {
+            dernier_id_annonces = nouveau_node->annonce.id;
         }
+        if (version == 3) {
+            if (champs[4]) nouveau_node->annonce.date_creation = (time_t)strtoll(champs[4], NULL, 10);
+            if (champs[5]) nouveau_node->annonce.date_expiration = (time_t)strtoll(champs[5], NULL, 10);
+        } else {
+            // Old announcements had no expiry
+            time_t date = champs[4] ? lire_date_annonce(champs[4]) : (time_t)-1;
+            nouveau_node->annonce.date_creation = (date == (time_t)-1) ? 0 : date;
+            memmove(&champs[6], &champs[5], 2 * sizeof(char*));
+        }
+        if (champs[6]) nouveau_node->annonce.id_matiere = atoi(champs[6]);
+        if (champs[7]) nouveau_node->annonce.id_enseignant = atoi(champs[7]);
+        else nouveau_node->annonce.id_enseignant = 0; // Default value if not present in file
         
         nouveau_node->suivant = NULL;
         
@@ -90,50 +279,256 @@ int charger_annonces(NodeAnnonce** tete) {
         dernier = nouveau_node;
     }
     
+    tampon_liberer(&ligne);
     fclose(file);
+    
+    // Keep only live announcements in memory, then convert an old file
+    int nb_archivees = archiver_annonces_expirees(tete, time(NULL));
+    if (nb_archivees < 0) {
+        return 0;
+    }
+    if ((version != 3 || nb_archivees > 0) && !sauvegarder_annonces(*tete)) {
+        return 0;
+    }
     return 1;
 }
 
+// Append one announcement as a line of the current format
+static int ecrire_enregistrement(Tampon *contenu, const NodeAnnonce *annonce) {
+    return tampon_printf(contenu, "%d|", annonce->annonce.id) &&
+           tampon_ajouter_champ(contenu, annonce_titre(annonce)) && tampon_ajouter(contenu, "|", 1) &&
+           tampon_ajouter_champ(contenu, annonce_contenu(annonce)) && tampon_ajouter(contenu, "|", 1) &&
+           tampon_ajouter_champ(contenu, annonce_auteur(annonce)) &&
+           tampon_printf(contenu, "|%lld|%lld|%d|%d\n",
+                         (long long)annonce->annonce.date_creation, (long long)annonce->annonce.date_expiration,
+                         annonce->annonce.id_matiere, annonce->annonce.id_enseignant);
+}
+
 /**
  * Save announcements from linked list to file
  */
 int sauvegarder_annonces(NodeAnnonce* tete) {
-    FILE *file = fopen(ANNONCES_FILE, "w");
-    if (file == NULL) {
-        printf("Erreur: Impossible d'ouvrir le fichier des annonces en écriture.\n");
-        return 0;
-    }
+    generation_annonces++;
+    
+    // Free texts are escaped so that each announcement stays on one line
+    Tampon contenu = {0};
+    revision_annonces++;
+    int ok = tampon_printf(&contenu, "%s %lu %d\n", EN_TETE_ANNONCES, revision_annonces, dernier_id_annonces);
     
     NodeAnnonce* courant = tete;
-    while (courant != NULL) {
-        fprintf(file, "%d|%s|%s|%s|%s|%d|%d\n",
-                courant->annonce.id,
-                courant->annonce.titre,
-                courant->annonce.contenu,
-                courant->annonce.auteur,
-                courant->annonce.date_creation,
-                courant->annonce.id_matiere,
-                courant->annonce.id_enseignant);
-        
+    while (courant != NULL && ok) {
+        ok = ecrire_enregistrement(&contenu, courant);
         courant = courant->suivant;
     }
     
-    fclose(file);
+    if (!ok || !tampon_ecrire_fichier(ANNONCES_FILE, &contenu)) {
+        printf("Erreur: Impossible d'ouvrir le fichier des annonces en écriture.\n");
+        tampon_liberer(&contenu);
+        return 0;
+    }
+    
+    tampon_liberer(&contenu);
     return 1;
 }
 
 /**
- * Add a new announcement to the linked list
+ * Move expired announcements from the list to the archive file
  */
-void ajouter_annonce(NodeAnnonce** tete, int id_enseignant) {
-    NodeAnnonce *nouveau_node = (NodeAnnonce*)malloc(sizeof(NodeAnnonce));
-    if (nouveau_node == NULL) {
+int archiver_annonces_expirees(NodeAnnonce** tete, time_t maintenant) {
+    // Expired announcements are appended to the archive in one write, in the format of the live file
+    Tampon archive = {0};
+    int ok = 1;
+    int nb_archivees = 0;
+    
+    if (!file_exists(ARCHIVE_ANNONCES_FILE)) {
+        ok = tampon_printf(&archive, "%s\n", EN_TETE_ANNONCES);
+    }
+    for (NodeAnnonce *courant = *tete; courant != NULL && ok; courant = courant->suivant) {
+        if (annonce_expiree(courant, maintenant)) {
+            ok = ecrire_enregistrement(&archive, courant);
+            nb_archivees++;
+        }
+    }
+    if (!ok) {
         printf("Erreur: Échec d'allocation de mémoire.\n");
-        return;
+        tampon_liberer(&archive);
+        return -1;
+    }
+    if (nb_archivees == 0) {
+        tampon_liberer(&archive);
+        return 0;
     }
     
-    // Generate a new ID
-    int new_id = 1;
+    FILE *file = fopen(ARCHIVE_ANNONCES_FILE, "a");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier d'archive des annonces.\n");
+        tampon_liberer(&archive);
+        return -1;
+    }
+    ok = fwrite(archive.donnees, 1, archive.taille, file) == archive.taille;
+    ok = (fclose(file) == 0) && ok;
+    tampon_liberer(&archive);
+    if (!ok) {
+        printf("Erreur: Impossible d'écrire le fichier d'archive des annonces.\n");
+        return -1;
+    }
+    
+    // Only unlink them once they are safely archived
+    NodeAnnonce **lien = tete;
+    while (*lien != NULL) {
+        NodeAnnonce *courant = *lien;
+        if (annonce_expiree(courant, maintenant)) {
+            *lien = courant->suivant;
+            recherche_retirer_annonce(courant);
+            free(courant);
+        } else {
+            lien = &courant->suivant;
+        }
+    }
+    generation_annonces++;
+    return nb_archivees;
+}
+
+/**
+ * Check whether an announcement has expired
+ */
+int annonce_expiree(const NodeAnnonce* annonce, time_t maintenant) {
+    return annonce->annonce.date_expiration != 0 && annonce->annonce.date_expiration <= maintenant;
+}
+
+/**
+ * Parse a "JJ/MM/AAAA" or "JJ/MM/AAAA HH:MM" local date
+ */
+time_t lire_date_annonce(const char *texte) {
+    int jour, mois, annee, heure = 0, minute = 0;
+    int nb = sscanf(texte, "%d/%d/%d %d:%d", &jour, &mois, &annee, &heure, &minute);
+    if ((nb != 3 && nb != 5) || jour < 1 || jour > 31 || mois < 1 || mois > 12 || annee < 1970 ||
+        heure < 0 || heure > 23 || minute < 0 || minute > 59) {
+        return (time_t)-1;
+    }
+    
+    struct tm date;
+    memset(&date, 0, sizeof(date));
+    date.tm_mday = jour;
+    date.tm_mon = mois - 1;
+    date.tm_year = annee - 1900;
+    date.tm_hour = heure;
+    date.tm_min = minute;
+    date.tm_isdst = -1;
+    return mktime(&date);
+}
+
+/**
+ * Format an announcement date as "JJ/MM/AAAA HH:MM" (empty if unknown)
+ */
+const char* date_annonce_to_string(time_t date) {
+    static char texte[20];
+    texte[0] = '\0';
+    if (date > 0) {
+        strftime(texte, sizeof(texte), "%d/%m/%Y %H:%M", localtime(&date));
+    }
+    return texte;
+}
+
+// Order announcements newest first, then by decreasing ID
+static int comparer_chronologie(const void *a, const void *b) {
+    const Annonce *aa = &(*(NodeAnnonce* const*)a)->annonce;
+    const Annonce *ab = &(*(NodeAnnonce* const*)b)->annonce;
+    if (aa->date_creation != ab->date_creation) {
+        return (aa->date_creation < ab->date_creation) ? 1 : -1;
+    }
+    return ab->id - aa->id;
+}
+
+// Rebuild the time index if the list changed
+static int actualiser_chronologie(NodeAnnonce* tete) {
+    if (chronologie.construit && chronologie.liste == tete && chronologie.generation == generation_annonces) {
+        return 1;
+    }
+    
+    int nb = 0;
+    for (NodeAnnonce* courant = tete; courant != NULL; courant = courant->suivant) {
+        nb++;
+    }
+    if (nb > chronologie.capacite) {
+        NodeAnnonce **annonces = (NodeAnnonce**)realloc(chronologie.annonces, nb * sizeof(NodeAnnonce*));
+        if (annonces == NULL) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            chronologie.construit = 0;
+            return 0;
+        }
+        chronologie.annonces = annonces;
+        chronologie.capacite = nb;
+    }
+    
+    // New announcements are added at the head, so the list is usually already in order
+    int trie = 1;
+    nb = 0;
+    for (NodeAnnonce* courant = tete; courant != NULL; courant = courant->suivant) {
+        chronologie.annonces[nb] = courant;
+        if (nb > 0 && comparer_chronologie(&chronologie.annonces[nb - 1], &chronologie.annonces[nb]) > 0) {
+            trie = 0;
+        }
+        nb++;
+    }
+    if (!trie) {
+        qsort(chronologie.annonces, nb, sizeof(NodeAnnonce*), comparer_chronologie);
+    }
+    
+    chronologie.nb = nb;
+    chronologie.liste = tete;
+    chronologie.generation = generation_annonces;
+    chronologie.construit = 1;
+    return 1;
+}
+
+// First position of the time index created before a date
+static int premiere_avant(time_t date) {
+    int debut = 0;
+    int fin = chronologie.nb;
+    while (debut < fin) {
+        int milieu = debut + (fin - debut) / 2;
+        if (chronologie.annonces[milieu]->annonce.date_creation >= date) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu;
+        }
+    }
+    return debut;
+}
+
+/**
+ * Get the n newest announcements
+ */
+int annonces_recentes(NodeAnnonce* tete, int n, NodeAnnonce* const **resultat) {
+    if (!actualiser_chronologie(tete)) {
+        *resultat = NULL;
+        return 0;
+    }
+    *resultat = chronologie.annonces;
+    return (n < chronologie.nb) ? n : chronologie.nb;
+}
+
+/**
+ * Get the announcements created in [debut, fin), newest first
+ */
+int annonces_periode(NodeAnnonce* tete, time_t debut, time_t fin, NodeAnnonce* const **resultat) {
+    if (!actualiser_chronologie(tete)) {
+        *resultat = NULL;
+        return 0;
+    }
+    int premiere = premiere_avant(fin);
+    int derniere = premiere_avant(debut);
+    *resultat = chronologie.annonces + premiere;
+    return (derniere > premiere) ? derniere - premiere : 0;
+}
+
+/**
+ * Add a new announcement to the linked list
+ */
+void ajouter_annonce(NodeAnnonce** tete, int id_enseignant) {
+    // Generate a new ID, never reusing one (read markers refer to announcements by ID)
+    int new_id = dernier_id_annonces + 1;
     NodeAnnonce *courant = *tete;
     while (courant != NULL) {
         if (courant->annonce.id >= new_id) {
@@ -142,46 +537,34 @@ void ajouter_annonce(NodeAnnonce** tete, int id_enseignant) {
         courant = courant->suivant;
     }
     
-    nouveau_node->annonce.id = new_id;
-    
     // Get announcement details
     printf("\n=== Ajouter une nouvelle annonce ===\n");
     
-    get_input("Titre: ", nouveau_node->annonce.titre, sizeof(nouveau_node->annonce.titre));
+    char titre[256];
+    get_input("Titre: ", titre, sizeof(titre));
     printf("Contenu (tapez 'fin' sur une nouvelle ligne pour terminer):\n");
     
-    char buffer[1024] = {0};
-    char line[100];
-    while (1) {
-        fgets(line, sizeof(line), stdin);
-        line[strcspn(line, "\n")] = 0; // Remove trailing newline
-        
-        if (strcmp(line, "fin") == 0) {
-            break;
-        }
-        
-        strcat(buffer, line);
-        strcat(buffer, "\n");
-        
-        if (strlen(buffer) + 10 >= sizeof(nouveau_node->annonce.contenu)) {
-            printf("Contenu trop long, arrêt.\n");
-            break;
-        }
-    }
-    
-    strncpy(nouveau_node->annonce.contenu, buffer, sizeof(nouveau_node->annonce.contenu) - 1);
-    nouveau_node->annonce.contenu[sizeof(nouveau_node->annonce.contenu) - 1] = '\0';
+    Tampon contenu = {0};
+    saisir_contenu_annonce(&contenu);
     
     // Get author information from teacher ID
     // In a real implementation, you'd query the teacher's name
     // For now, we'll use a placeholder
-    snprintf(nouveau_node->annonce.auteur, sizeof(nouveau_node->annonce.auteur), "Enseignant ID: %d", id_enseignant);
+    char auteur[100];
+    snprintf(auteur, sizeof(auteur), "Enseignant ID: %d", id_enseignant);
+    
+    NodeAnnonce *nouveau_node = creer_annonce(titre, contenu.donnees != NULL ? contenu.donnees : "", auteur);
+    tampon_liberer(&contenu);
+    if (nouveau_node == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return;
+    }
+    
+    nouveau_node->annonce.id = new_id;
+    dernier_id_annonces = new_id;
     
     // Set creation date
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(nouveau_node->annonce.date_creation, sizeof(nouveau_node->annonce.date_creation), 
-             "%d/%m/%Y %H:%M", t);
+    nouveau_node->annonce.date_creation = time(NULL);
     
     // Get subject ID
     // You need to implement a way to list available subjects and select one
@@ -189,12 +572,19 @@ void ajouter_annonce(NodeAnnonce** tete, int id_enseignant) {
     scanf("%d", &nouveau_node->annonce.id_matiere);
     getchar(); // Clear the newline from input buffer
     
+    // Expired announcements are moved to the archive at the next load
+    int jours = get_int_input("Durée de validité en jours (0 pour illimitée): ", 0, DUREE_VALIDITE_MAX_JOURS);
+    if (jours > 0) {
+        nouveau_node->annonce.date_expiration = nouveau_node->annonce.date_creation + (time_t)jours * 24 * 3600;
+    }
+    
     // Set the teacher ID
     nouveau_node->annonce.id_enseignant = id_enseignant;
     
     // Add to the beginning of the list
     nouveau_node->suivant = *tete;
     *tete = nouveau_node;
+    recherche_indexer_annonce(nouveau_node);
     
     // Save to file
     if (sauvegarder_annonces(*tete)) {
@@ -207,8 +597,8 @@ void ajouter_annonce(NodeAnnonce** tete, int id_enseignant) {
 /**
  * Modify an existing announcement
  */
-void modifier_annonce(NodeAnnonce* tete, int id_enseignant) {
-    if (tete == NULL) {
+void modifier_annonce(NodeAnnonce** tete, int id_enseignant) {
+    if (*tete == NULL) {
         printf("Aucune annonce n'est enregistrée.\n");
         return;
     }
@@ -219,15 +609,15 @@ void modifier_annonce(NodeAnnonce* tete, int id_enseignant) {
            "ID", "Titre", "Date", "Matière");
     printf("---------------------------------------------------------------------------\n");
     
-    NodeAnnonce* courant = tete;
+    NodeAnnonce* courant = *tete;
     int found = 0;
     while (courant != NULL) {
         // Check if this announcement belongs to the current teacher using id_enseignant field
         if (courant->annonce.id_enseignant == id_enseignant) {
             printf("%-4d | %-30s | %-20s | %-15d\n", 
                    courant->annonce.id,
-                   courant->annonce.titre,
-                   courant->annonce.date_creation,
+                   annonce_titre(courant),
+                   date_annonce_to_string(courant->annonce.date_creation),
                    courant->annonce.id_matiere);
             found = 1;
         }
@@ -250,7 +640,7 @@ void modifier_annonce(NodeAnnonce* tete, int id_enseignant) {
     }
     
     // Find the announcement
-    NodeAnnonce* annonce = trouver_annonce_par_id(tete, id);
+    NodeAnnonce* annonce = trouver_annonce_par_id(*tete, id);
     if (annonce == NULL) {
         printf("Annonce avec ID %d non trouvée.\n", id);
         return;
@@ -266,46 +656,21 @@ void modifier_annonce(NodeAnnonce* tete, int id_enseignant) {
     printf("Laissez vide pour garder la valeur actuelle.\n");
     
     // Get new values or keep current ones
-    char buffer[1024];
+    char buffer[256];
     
-    get_input_formatted("Titre [actuel: %s]: ", buffer, sizeof(buffer), annonce->annonce.titre);
-    if (strlen(buffer) > 0) {
-        strcpy(annonce->annonce.titre, buffer);
-    }
+    get_input_formatted("Titre [actuel: %s]: ", buffer, sizeof(buffer), annonce_titre(annonce));
     
-    printf("Contenu actuel:\n%s\n", annonce->annonce.contenu);
+    printf("Contenu actuel:\n%s\n", annonce_contenu(annonce));
     printf("Nouveau contenu (tapez 'fin' sur une nouvelle ligne pour terminer, ou juste 'fin' pour garder l'actuel):\n");
     
-    char content_buffer[1024] = {0};
-    char line[100];
-    fgets(line, sizeof(line), stdin); // Clear any previous input
-    line[strcspn(line, "\n")] = 0; // Remove trailing newline
+    Tampon contenu = {0};
+    int nouveau_contenu = saisir_contenu_annonce(&contenu) > 0;
     
-    if (strcmp(line, "fin") != 0) {
-        strcat(content_buffer, line);
-        strcat(content_buffer, "\n");
-        
-        while (1) {
-            fgets(line, sizeof(line), stdin);
-            line[strcspn(line, "\n")] = 0; // Remove trailing newline
-            
-            if (strcmp(line, "fin") == 0) {
-                break;
-            }
-            
-            strcat(content_buffer, line);
-            strcat(content_buffer, "\n");
-            
-            if (strlen(content_buffer) + 10 >= sizeof(annonce->annonce.contenu)) {
-                printf("Contenu trop long, arrêt.\n");
-                break;
-            }
-        }
-        
-        if (strlen(content_buffer) > 0) {
-            strncpy(annonce->annonce.contenu, content_buffer, sizeof(annonce->annonce.contenu) - 1);
-            annonce->annonce.contenu[sizeof(annonce->annonce.contenu) - 1] = '\0';
-        }
+    int ok = changer_textes_annonce(tete, &annonce, strlen(buffer) > 0 ? buffer : NULL,
+                                    nouveau_contenu ? contenu.donnees : NULL, NULL);
+    tampon_liberer(&contenu);
+    if (!ok) {
+        return;
     }
     
     // Update matière
@@ -318,13 +683,10 @@ void modifier_annonce(NodeAnnonce* tete, int id_enseignant) {
     }
     
     // Update creation date
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(annonce->annonce.date_creation, sizeof(annonce->annonce.date_creation), 
-             "%d/%m/%Y %H:%M", t);
+    annonce->annonce.date_creation = time(NULL);
     
     // Save changes
-    if (sauvegarder_annonces(tete)) {
+    if (sauvegarder_annonces(*tete)) {
         printf("Annonce modifiée avec succès.\n");
     } else {
         printf("Erreur lors de la sauvegarde des modifications.\n");
@@ -353,8 +715,8 @@ void supprimer_annonce(NodeAnnonce** tete, int id_enseignant) {
         if (courant->annonce.id_enseignant == id_enseignant) {
             printf("%-4d | %-30s | %-20s | %-15d\n", 
                    courant->annonce.id,
-                   courant->annonce.titre,
-                   courant->annonce.date_creation,
+                   annonce_titre(courant),
+                   date_annonce_to_string(courant->annonce.date_creation),
                    courant->annonce.id_matiere);
             found = 1;
         }
@@ -397,7 +759,7 @@ void supprimer_annonce(NodeAnnonce** tete, int id_enseignant) {
     }
     
     // Confirmation
-    printf("Êtes-vous sûr de vouloir supprimer l'annonce '%s'?\n", courant_del->annonce.titre);
+    printf("Êtes-vous sûr de vouloir supprimer l'annonce '%s'?\n", annonce_titre(courant_del));
     int confirmation = get_int_input("1. Oui, 2. Non: ", 1, 2);
     
     if (confirmation == 1) {
@@ -409,6 +771,7 @@ void supprimer_annonce(NodeAnnonce** tete, int id_enseignant) {
             precedent->suivant = courant_del->suivant;
         }
         
+        recherche_retirer_annonce(courant_del);
         free(courant_del);
         
         // Save changes
@@ -433,21 +796,31 @@ void afficher_annonces(NodeAnnonce* tete) {
     
     printf("\n=== Liste des Annonces ===\n");
     
-    NodeAnnonce* courant = tete;
-    while (courant != NULL) {
+    NodeAnnonce* const *annonces;
+    int nb = annonces_recentes(tete, INT_MAX, &annonces);
+    afficher_selection_annonces(annonces, nb);
+}
+
+/**
+ * Display a selection of announcements in the given order
+ */
+void afficher_selection_annonces(NodeAnnonce* const *annonces, int nb) {
+    for (int i = 0; i < nb; i++) {
+        const NodeAnnonce* courant = annonces[i];
         printf("=== Annonce #%d ===\n", courant->annonce.id);
-        printf("Titre: %s\n", courant->annonce.titre);
-        printf("Date: %s\n", courant->annonce.date_creation);
-        printf("Auteur: %s\n", courant->annonce.auteur);
+        printf("Titre: %s\n", annonce_titre(courant));
+        printf("Date: %s\n", date_annonce_to_string(courant->annonce.date_creation));
+        if (courant->annonce.date_expiration != 0) {
+            printf("Expire le: %s\n", date_annonce_to_string(courant->annonce.date_expiration));
+        }
+        printf("Auteur: %s\n", annonce_auteur(courant));
         if (courant->annonce.id_matiere > 0) {
             printf("Matière ID: %d\n", courant->annonce.id_matiere);
         } else {
             printf("Matière: Générale\n");
         }
-        printf("Contenu:\n%s\n", courant->annonce.contenu);
+        printf("Contenu:\n%s\n", annonce_contenu(courant));
         printf("------------------------\n\n");
-        
-        courant = courant->suivant;
     }
 }
 
@@ -468,10 +841,10 @@ void afficher_annonces_par_matiere(NodeAnnonce* tete, int id_matiere) {
     while (courant != NULL) {
         if (courant->annonce.id_matiere == id_matiere) {
             printf("=== Annonce #%d ===\n", courant->annonce.id);
-            printf("Titre: %s\n", courant->annonce.titre);
-            printf("Date: %s\n", courant->annonce.date_creation);
-            printf("Auteur: %s\n", courant->annonce.auteur);
-            printf("Contenu:\n%s\n", courant->annonce.contenu);
+            printf("Titre: %s\n", annonce_titre(courant));
+            printf("Date: %s\n", date_annonce_to_string(courant->annonce.date_creation));
+            printf("Auteur: %s\n", annonce_auteur(courant));
+            printf("Contenu:\n%s\n", annonce_contenu(courant));
             printf("------------------------\n\n");
             found = 1;
         }
@@ -502,14 +875,14 @@ void afficher_annonces_par_enseignant(NodeAnnonce* tete, int id_enseignant) {
         // Check if this announcement belongs to the current teacher using the id_enseignant field
         if (courant->annonce.id_enseignant == id_enseignant) {
             printf("=== Annonce #%d ===\n", courant->annonce.id);
-            printf("Titre: %s\n", courant->annonce.titre);
-            printf("Date: %s\n", courant->annonce.date_creation);
+            printf("Titre: %s\n", annonce_titre(courant));
+            printf("Date: %s\n", date_annonce_to_string(courant->annonce.date_creation));
             if (courant->annonce.id_matiere > 0) {
                 printf("Matière ID: %d\n", courant->annonce.id_matiere);
             } else {
                 printf("Matière: Générale\n");
             }
-            printf("Contenu:\n%s\n", courant->annonce.contenu);
+            printf("Contenu:\n%s\n", annonce_contenu(courant));
             printf("------------------------\n\n");
             found = 1;
         }
@@ -552,4 +925,23 @@ void liberer_annonces(NodeAnnonce** tete) {
     }
     
     *tete = NULL;
-}
\ No newline at end of file
+    
+    // The time and search indexes point into the freed list
+    free(chronologie.annonces);
+    memset(&chronologie, 0, sizeof(chronologie));
+    recherche_invalider();
+}
+
+/**
+ * Get the announcements modification counter
+ */
+unsigned long annonces_generation(void) {
+    return generation_annonces;
+}
+
+/**
+ * Get the revision of the announcements file
+ */
+unsigned long annonces_revision(void) {
+    return revision_annonces;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file bulletins.c
+ * @brief Implementation of the batch transcript generator
+ */
+
+#include <time.h>
+#include "../include/bulletins.h"
+#include "../include/moyennes.h"
+#include "../include/parallele.h"
+#include "../include/index.h"
+#include "../include/utils.h"
+#include "../include/colonnes_notes.h"
+#include "../include/tampon.h"
+
+#define ETUDIANTS_PAR_TACHE 64
+
+/**
+ * Snapshot shared by the workers
+ */
+typedef struct {
+    const char *repertoire;
+    int fichier_unique;
+    int nb_etudiants;
+    const Etudiant **etudiants;
+    const ColonnesNotes *colonnes;
+    int *ordre_notes;              // Positions in the grade store, grouped by student
+    int *note_matiere;             // Dense subject position of each grouped grade
+    int *debut_notes;              // Grades of student e are ordre_notes[debut_notes[e] .. debut_notes[e + 1]]
+    const MoyenneEtudiant **moyennes; // Cached averages of each student, NULL without grades
+    const Inscription **inscriptions;
+    int *debut_inscriptions;
+    int nb_matieres;
+    const char **nom_matieres;
+    IndexId index_matieres;
+    Tampon *tampons;               // One per task when writing a single file
+    int *nb_ecrits;                // Per task
+    int *nb_erreurs;               // Per task
+} ContexteBulletins;
+
+// Assessment of a weighted average
+static const char* appreciation(float moyenne) {
+    if (moyenne >= 16) return "Très bien";
+    if (moyenne >= 14) return "Bien";
+    if (moyenne >= 12) return "Assez bien";
+    if (moyenne >= 10) return "Passable";
+    return "Insuffisant";
+}
+
+// Name of a subject, "(inconnue)" for a deleted one
+static const char* nom_matiere(const ContexteBulletins *ctx, int id_matiere) {
+    int m;
+    return index_id_chercher(&ctx->index_matieres, id_matiere, &m) ? ctx->nom_matieres[m] : "(inconnue)";
+}
+
+// Format the transcript of one student
+static int formater_bulletin(const ContexteBulletins *ctx, int e, Tampon *tampon) {
+    const Etudiant *etudiant = ctx->etudiants[e];
+    int ok = 1;
+
+    ok &= tampon_printf(tampon, "==================================================\n");
+    ok &= tampon_printf(tampon, "BULLETIN DE NOTES\n");
+    ok &= tampon_printf(tampon, "==================================================\n");
+    ok &= tampon_printf(tampon, "Étudiant: %s %s (ID: %d)\n", etudiant->prenom, etudiant->nom, etudiant->id);
+    ok &= tampon_printf(tampon, "Email: %s\n", etudiant->email);
+    ok &= tampon_printf(tampon, "CNE: %s\n", etudiant->cne);
+    ok &= tampon_printf(tampon, "Section: %s\n", etudiant->section);
+    ok &= tampon_printf(tampon, "Filière: %s\n\n", etudiant->filiere);
+
+    ok &= tampon_printf(tampon, "--- Notes ---\n");
+    for (int k = ctx->debut_notes[e]; k < ctx->debut_notes[e + 1]; k++) {
+        Note note;
+        colonnes_notes_ligne(ctx->colonnes, ctx->ordre_notes[k], &note);
+        ok &= tampon_printf(tampon, "%-20s | %5.2f | %-10s | %s\n", ctx->nom_matieres[ctx->note_matiere[k]],
+                            note.note, note.date_evaluation, note.commentaire);
+    }
+
+    // Averages from the shared cache, the same ones shown everywhere else
+    const MoyenneEtudiant *moyenne = ctx->moyennes[e];
+    if (moyenne == NULL) {
+        ok &= tampon_printf(tampon, "Aucune note enregistrée pour cet étudiant.\n");
+    } else {
+        ok &= tampon_printf(tampon, "\n--- Moyennes par Matière ---\n");
+        ok &= tampon_printf(tampon, "%-20s | %-8s | %-6s | %-9s\n", "Matière", "Moyenne", "Coef.", "Nb. notes");
+
+        const MoyenneMatiereEtudiant *details = details_moyenne_etudiant(moyenne);
+        for (int j = 0; j < moyenne->nb_matieres; j++) {
+            ok &= tampon_printf(tampon, "%-20s | %-8.2f | %-6.2f | %-9d\n",
+                                nom_matiere(ctx, details[j].id_matiere), details[j].moyenne,
+                                details[j].coefficient, details[j].nb_notes);
+        }
+
+        ok &= tampon_printf(tampon, "\nMoyenne générale pondérée: %.2f\n", moyenne->moyenne_ponderee);
+        ok &= tampon_printf(tampon, "Évaluation: %s\n", appreciation(moyenne->moyenne_ponderee));
+    }
+
+    // Enrollments
+    ok &= tampon_printf(tampon, "\n--- Inscriptions aux Cours ---\n");
+    if (ctx->debut_inscriptions[e] == ctx->debut_inscriptions[e + 1]) {
+        ok &= tampon_printf(tampon, "Aucune inscription aux cours pour cet étudiant.\n");
+    }
+    for (int k = ctx->debut_inscriptions[e]; k < ctx->debut_inscriptions[e + 1]; k++) {
+        const Inscription *inscription = ctx->inscriptions[k];
+        ok &= tampon_printf(tampon, "- %s (ID: %d), Date: %s, Statut: %s\n",
+                            nom_matiere(ctx, inscription->id_matiere), inscription->id_matiere,
+                            inscription->date_inscription, statut_inscription_to_string(inscription->statut));
+    }
+    ok &= tampon_printf(tampon, "\n");
+
+    return ok;
+}
+
+// Task: transcripts of one range of students
+static void tache_bulletins(int tache, void *arg) {
+    ContexteBulletins *ctx = (ContexteBulletins*)arg;
+
+    int debut = tache * ETUDIANTS_PAR_TACHE;
+    int fin = debut + ETUDIANTS_PAR_TACHE;
+    if (fin > ctx->nb_etudiants) {
+        fin = ctx->nb_etudiants;
+    }
+
+    if (ctx->fichier_unique) {
+        // Appended to this task's buffer, written in order once all tasks are done
+        for (int e = debut; e < fin; e++) {
+            if (formater_bulletin(ctx, e, &ctx->tampons[tache])) {
+                ctx->nb_ecrits[tache]++;
+            } else {
+                ctx->nb_erreurs[tache]++;
+            }
+        }
+    } else {
+        // One buffer reused for every file of the range
+        Tampon tampon = {0};
+        char chemin[256];
+        for (int e = debut; e < fin; e++) {
+            tampon.taille = 0;
+            snprintf(chemin, sizeof(chemin), "%s/bulletin_%d.txt", ctx->repertoire, ctx->etudiants[e]->id);
+            if (formater_bulletin(ctx, e, &tampon) && tampon_ecrire_fichier(chemin, &tampon)) {
+                ctx->nb_ecrits[tache]++;
+            } else {
+                ctx->nb_erreurs[tache]++;
+            }
+        }
+        tampon_liberer(&tampon);
+    }
+}
+
+// Dense subject position of an ID, registering unknown subjects
+static int position_matiere(ContexteBulletins *ctx, int id_matiere) {
+    int pos;
+    if (!index_id_chercher(&ctx->index_matieres, id_matiere, &pos)) {
+        pos = ctx->nb_matieres++;
+        ctx->nom_matieres[pos] = "(inconnue)";
+        index_id_inserer(&ctx->index_matieres, id_matiere, pos);
+    }
+    return pos;
+}
+
+/**
+ * Generate the transcript of every student
+ */
+int generer_bulletins(const char *repertoire, int fichier_unique, int nb_threads,
+                      NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions,
+                      NodeMatiere* matieres, ResultatBulletins *resultat) {
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    memset(resultat, 0, sizeof(ResultatBulletins));
+
+    if (!create_dir(repertoire)) {
+        printf("Erreur: Impossible de créer le répertoire %s.\n", repertoire);
+        return 0;
+    }
+
+    const ColonnesNotes *colonnes = obtenir_colonnes_notes(notes);
+    if (colonnes == NULL) {
+        return 0;
+    }
+
+    int nb_etudiants = 0, nb_notes = colonnes->nb, nb_inscriptions = 0, nb_matieres = 0;
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) nb_etudiants++;
+    for (NodeInscription* i = inscriptions; i != NULL; i = i->suivant) nb_inscriptions++;
+    for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) nb_matieres++;
+
+    ContexteBulletins ctx = {0};
+    ctx.repertoire = repertoire;
+    ctx.fichier_unique = fichier_unique;
+    ctx.nb_etudiants = nb_etudiants;
+    int nb_taches = (nb_etudiants + ETUDIANTS_PAR_TACHE - 1) / ETUDIANTS_PAR_TACHE;
+
+    ctx.etudiants = (const Etudiant**)malloc((nb_etudiants + 1) * sizeof(Etudiant*));
+    ctx.colonnes = colonnes;
+    ctx.ordre_notes = (int*)malloc((nb_notes + 1) * sizeof(int));
+    ctx.note_matiere = (int*)malloc((nb_notes + 1) * sizeof(int));
+    ctx.debut_notes = (int*)calloc(nb_etudiants + 2, sizeof(int));
+    ctx.moyennes = (const MoyenneEtudiant**)malloc((nb_etudiants + 1) * sizeof(MoyenneEtudiant*));
+    ctx.inscriptions = (const Inscription**)malloc((nb_inscriptions + 1) * sizeof(Inscription*));
+    ctx.debut_inscriptions = (int*)calloc(nb_etudiants + 2, sizeof(int));
+    ctx.nom_matieres = (const char**)malloc((nb_matieres + nb_notes + 1) * sizeof(char*));
+    ctx.tampons = (Tampon*)calloc(nb_taches + 1, sizeof(Tampon));
+    ctx.nb_ecrits = (int*)calloc(nb_taches + 1, sizeof(int));
+    ctx.nb_erreurs = (int*)calloc(nb_taches + 1, sizeof(int));
+    int *pos_notes = (int*)malloc((nb_notes + 1) * sizeof(int));
+    int *pos_inscriptions = (int*)malloc((nb_inscriptions + 1) * sizeof(int));
+
+    IndexId index_etudiants = {0};
+    int ok = ctx.etudiants != NULL && ctx.ordre_notes != NULL && ctx.note_matiere != NULL &&
+             ctx.debut_notes != NULL && ctx.moyennes != NULL && ctx.inscriptions != NULL &&
+             ctx.debut_inscriptions != NULL && ctx.nom_matieres != NULL &&
+             ctx.tampons != NULL && ctx.nb_ecrits != NULL && ctx.nb_erreurs != NULL &&
+             pos_notes != NULL && pos_inscriptions != NULL &&
+             index_id_initialiser(&index_etudiants, nb_etudiants) &&
+             index_id_initialiser(&ctx.index_matieres, nb_matieres);
+
+    if (ok) {
+        int k = 0;
+        for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant, k++) {
+            ctx.etudiants[k] = &e->etudiant;
+            index_id_inserer(&index_etudiants, e->etudiant.id, k);
+        }
+        for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+            int pos = position_matiere(&ctx, m->matiere.id);
+            ctx.nom_matieres[pos] = m->matiere.nom_matiere;
+        }
+
+        // Single pass over grades and enrollments: count per student (slot nb_etudiants = unknown)
+        for (k = 0; k < nb_notes; k++) {
+            int e;
+            pos_notes[k] = index_id_chercher(&index_etudiants, colonnes->id_etudiant[k], &e) ? e : nb_etudiants;
+            ctx.debut_notes[pos_notes[k] + 1]++;
+        }
+        k = 0;
+        for (NodeInscription* i = inscriptions; i != NULL; i = i->suivant, k++) {
+            int e;
+            pos_inscriptions[k] = index_id_chercher(&index_etudiants, i->inscription.id_etudiant, &e) ? e : nb_etudiants;
+            ctx.debut_inscriptions[pos_inscriptions[k] + 1]++;
+        }
+        for (int e = 0; e < nb_etudiants; e++) {
+            ctx.debut_notes[e + 1] += ctx.debut_notes[e];
+            ctx.debut_inscriptions[e + 1] += ctx.debut_inscriptions[e];
+        }
+
+        // Place the records, reusing the position arrays as cursors
+        int *curseur_notes = (int*)malloc((nb_etudiants + 1) * sizeof(int));
+        int *curseur_inscriptions = (int*)malloc((nb_etudiants + 1) * sizeof(int));
+        ok = curseur_notes != NULL && curseur_inscriptions != NULL;
+        if (ok) {
+            memcpy(curseur_notes, ctx.debut_notes, (nb_etudiants + 1) * sizeof(int));
+            memcpy(curseur_inscriptions, ctx.debut_inscriptions, (nb_etudiants + 1) * sizeof(int));
+
+            for (k = 0; k < nb_notes; k++) {
+                if (pos_notes[k] < nb_etudiants) {
+                    int place = curseur_notes[pos_notes[k]]++;
+                    ctx.ordre_notes[place] = k;
+                    ctx.note_matiere[place] = position_matiere(&ctx, colonnes->id_matiere[k]);
+                }
+            }
+            k = 0;
+            for (NodeInscription* i = inscriptions; i != NULL; i = i->suivant, k++) {
+                if (pos_inscriptions[k] < nb_etudiants) {
+                    ctx.inscriptions[curseur_inscriptions[pos_inscriptions[k]]++] = &i->inscription;
+                }
+            }
+        }
+        free(curseur_notes);
+        free(curseur_inscriptions);
+
+        // Averages come from the shared cache, built here before the workers only read it
+        if (ok && nb_notes > 0 && obtenir_moyenne_etudiant(notes, matieres, colonnes->id_etudiant[0]) == NULL) {
+            ok = 0;
+        }
+        for (int e = 0; ok && e < nb_etudiants; e++) {
+            ctx.moyennes[e] = obtenir_moyenne_etudiant(notes, matieres, ctx.etudiants[e]->id);
+        }
+    }
+
+    if (ok) {
+        resultat->nb_threads = executer_taches_paralleles(nb_taches, nb_threads, tache_bulletins, &ctx);
+
+        for (int t = 0; t < nb_taches; t++) {
+            resultat->nb_bulletins += ctx.nb_ecrits[t];
+            resultat->nb_erreurs += ctx.nb_erreurs[t];
+        }
+
+        if (fichier_unique) {
+            char chemin[256];
+            snprintf(chemin, sizeof(chemin), "%s/bulletins.txt", repertoire);
+            FILE *fichier = fopen(chemin, "w");
+            int ecrit = fichier != NULL;
+            for (int t = 0; ecrit && t < nb_taches; t++) {
+                ecrit = fwrite(ctx.tampons[t].donnees, 1, ctx.tampons[t].taille, fichier) == ctx.tampons[t].taille;
+            }
+            if (fichier != NULL && fclose(fichier) != 0) {
+                ecrit = 0;
+            }
+            if (!ecrit) {
+                printf("Erreur: Impossible d'écrire le fichier %s.\n", chemin);
+                resultat->nb_erreurs += resultat->nb_bulletins;
+                resultat->nb_bulletins = 0;
+            }
+        }
+    } else {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+
+    if (ctx.tampons != NULL) {
+        for (int t = 0; t < nb_taches; t++) {
+            tampon_liberer(&ctx.tampons[t]);
+        }
+    }
+    free(ctx.etudiants);
+    free(ctx.ordre_notes);
+    free(ctx.note_matiere);
+    free(ctx.debut_notes);
+    free(ctx.moyennes);
+    free(ctx.inscriptions);
+    free(ctx.debut_inscriptions);
+    free(ctx.nom_matieres);
+    free(ctx.tampons);
+    free(ctx.nb_ecrits);
+    free(ctx.nb_erreurs);
+    free(pos_notes);
+    free(pos_inscriptions);
+    index_id_liberer(&index_etudiants);
+    index_id_liberer(&ctx.index_matieres);
+
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    resultat->duree_ms = (fin.tv_sec - debut.tv_sec) * 1000.0 + (fin.tv_nsec - debut.tv_nsec) / 1000000.0;
+    return ok;
+}
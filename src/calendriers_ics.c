@@ -0,0 +1,523 @@
+/**
+ * @file calendriers_ics.c
+ * @brief Implementation of the iCalendar export
+ */
+
+#include <ctype.h>
+#include "../include/calendriers_ics.h"
+#include "../include/index.h"
+#include "../include/tampon.h"
+#include "../include/utils.h"
+
+#define LONGUEUR_LIGNE_ICS 75   // Octets per content line before folding (RFC 5545, 3.1)
+#define TAILLE_EVENEMENT 2048
+#define TAILLE_EN_TETE 512
+
+/**
+ * Calendar being built in memory
+ */
+typedef struct {
+    Tampon tampon;
+    char fichier[64];
+} Calendrier;
+
+/**
+ * State of one export
+ */
+typedef struct {
+    Calendrier *calendriers;        // Teachers, then sections, then students
+    int nb_calendriers;
+    int capacite_calendriers;
+    IndexId calendrier_enseignant;  // Teacher ID -> calendar
+    IndexId calendrier_section;     // Section name key -> calendar
+    const Enseignant **enseignant;  // Teacher of each teacher calendar
+    const Matiere **matieres;
+    IndexId index_matieres;         // Subject ID -> position in matieres
+    int *inscrit_calendrier;        // Calendar of each enrolled student
+    int *inscrit_section;           // Calendar of the section of each enrolled student, -1 if none
+    int *suivant_inscrit;           // Next student enrolled in the same subject, -1 at the end
+    IndexId premier_inscrit;        // Subject ID -> first enrolled student
+    char dates[MAX_JOURS_PLANNING][9];
+    char horodatage[17];
+    int nb_semaines;
+    ResultatCalendriers *resultat;
+} ExportIcs;
+
+// Append one content line, escaping TEXT values and folding at 75 octets
+static int ligne_ics(char *sortie, size_t taille, size_t *pos, const char *nom, const char *valeur, int texte) {
+    size_t p = *pos;
+    size_t longueur = 0;
+
+    for (const char *c = nom; *c != '\0'; c++) {
+        if (p + 1 >= taille) return 0;
+        sortie[p++] = *c;
+        longueur++;
+    }
+    if (p + 1 >= taille) return 0;
+    sortie[p++] = ':';
+    longueur++;
+
+    const unsigned char *v = (const unsigned char*)valeur;
+    while (*v != '\0') {
+        char motif[4];
+        size_t n = 0;
+
+        if (texte && (*v == '\\' || *v == ';' || *v == ',')) {
+            motif[n++] = '\\';
+            motif[n++] = (char)*v++;
+        } else if (texte && *v == '\n') {
+            motif[n++] = '\\';
+            motif[n++] = 'n';
+            v++;
+        } else {
+            // Never split a UTF-8 sequence across two lines
+            size_t octets = (*v >= 0xF0) ? 4 : (*v >= 0xE0) ? 3 : (*v >= 0xC0) ? 2 : 1;
+            for (size_t k = 0; k < octets && *v != '\0'; k++) {
+                motif[n++] = (char)*v++;
+            }
+        }
+
+        if (longueur + n > LONGUEUR_LIGNE_ICS) {
+            if (p + 3 >= taille) return 0;
+            sortie[p++] = '\r';
+            sortie[p++] = '\n';
+            sortie[p++] = ' ';
+            longueur = 1;
+        }
+        if (p + n >= taille) return 0;
+        memcpy(sortie + p, motif, n);
+        p += n;
+        longueur += n;
+    }
+
+    if (p + 2 >= taille) return 0;
+    sortie[p++] = '\r';
+    sortie[p++] = '\n';
+    sortie[p] = '\0';
+    *pos = p;
+    return 1;
+}
+
+// Read a slot name such as "8h-10h" or "8h30-10h" as minutes since midnight
+static int lire_horaire(const char *nom, int *debut, int *fin) {
+    int bornes[2];
+    const char *c = nom;
+
+    for (int b = 0; b < 2; b++) {
+        char *suite;
+        long heures = strtol(c, &suite, 10);
+        if (suite == c || *suite != 'h' || heures < 0 || heures > 23) {
+            return 0;
+        }
+        c = suite + 1;
+        long minutes = 0;
+        if (*c >= '0' && *c <= '9') {
+            minutes = strtol(c, &suite, 10);
+            if (minutes > 59) return 0;
+            c = suite;
+        }
+        bornes[b] = (int)(heures * 60 + minutes);
+        if (b == 0) {
+            if (*c != '-') return 0;
+            c++;
+        }
+    }
+
+    if (bornes[1] <= bornes[0]) {
+        return 0;
+    }
+    *debut = bornes[0];
+    *fin = bornes[1];
+    return 1;
+}
+
+// Start and end of every slot of a day, two-hour slots from 8h when the name cannot be read
+static void horaires_creneaux(const char *noms[], int nb, int debut[], int fin[]) {
+    for (int h = 0; h < nb; h++) {
+        if (!lire_horaire(noms[h], &debut[h], &fin[h])) {
+            debut[h] = 8 * 60 + h * 120;
+            fin[h] = debut[h] + 120;
+        }
+    }
+}
+
+// Create an empty calendar with its header
+static int nouveau_calendrier(ExportIcs *ex, const char *fichier, const char *titre) {
+    if (ex->nb_calendriers == ex->capacite_calendriers) {
+        int capacite = ex->capacite_calendriers ? ex->capacite_calendriers * 2 : 64;
+        Calendrier *calendriers = (Calendrier*)realloc(ex->calendriers, capacite * sizeof(Calendrier));
+        if (calendriers == NULL) {
+            return -1;
+        }
+        ex->calendriers = calendriers;
+        ex->capacite_calendriers = capacite;
+    }
+
+    char en_tete[TAILLE_EN_TETE];
+    size_t pos = 0;
+    if (!ligne_ics(en_tete, sizeof(en_tete), &pos, "BEGIN", "VCALENDAR", 0) ||
+        !ligne_ics(en_tete, sizeof(en_tete), &pos, "VERSION", "2.0", 0) ||
+        !ligne_ics(en_tete, sizeof(en_tete), &pos, "PRODID", "-//SGU//Emploi du temps//FR", 0) ||
+        !ligne_ics(en_tete, sizeof(en_tete), &pos, "CALSCALE", "GREGORIAN", 0) ||
+        !ligne_ics(en_tete, sizeof(en_tete), &pos, "METHOD", "PUBLISH", 0) ||
+        !ligne_ics(en_tete, sizeof(en_tete), &pos, "X-WR-CALNAME", titre, 1)) {
+        return -1;
+    }
+
+    int c = ex->nb_calendriers;
+    Calendrier *calendrier = &ex->calendriers[c];
+    memset(calendrier, 0, sizeof(Calendrier));
+    snprintf(calendrier->fichier, sizeof(calendrier->fichier), "%s", fichier);
+    if (!tampon_ajouter(&calendrier->tampon, en_tete, pos)) {
+        tampon_liberer(&calendrier->tampon);
+        return -1;
+    }
+    ex->nb_calendriers++;
+    return c;
+}
+
+// Get the calendar of a section, creating it on first use
+static int calendrier_section(ExportIcs *ex, const char *section) {
+    long long cle = index_cle_chaine(section);
+    int c;
+    if (index_id_chercher(&ex->calendrier_section, cle, &c)) {
+        return c;
+    }
+
+    // Keep file names portable whatever the section is called
+    char fichier[64];
+    int n = snprintf(fichier, sizeof(fichier), "section_");
+    for (const char *s = section; *s != '\0' && n < (int)sizeof(fichier) - 5; s++) {
+        unsigned char ch = (unsigned char)*s;
+        fichier[n++] = (ch < 128 && (isalnum(ch) || ch == '-')) ? (char)ch : '_';
+    }
+    strcpy(fichier + n, ".ics");
+
+    char titre[MAX_SECTION_LEN + 32];
+    snprintf(titre, sizeof(titre), "Emploi du temps - Section %s", section);
+
+    c = nouveau_calendrier(ex, fichier, titre);
+    if (c < 0 || !index_id_inserer(&ex->calendrier_section, cle, c)) {
+        return -1;
+    }
+    return c;
+}
+
+// Create the calendars of the teachers, sections and students, and chain the students by subject
+static int preparer_calendriers(ExportIcs *ex, const Planning *planning, NodeEtudiant* etudiants,
+                                NodeEnseignant* enseignants, NodeMatiere* matieres, NodeInscription* inscriptions) {
+    char fichier[64];
+    char titre[160];
+
+    int nb = 0;
+    for (NodeEnseignant *courant = enseignants; courant != NULL; courant = courant->suivant) nb++;
+    ex->enseignant = (const Enseignant**)malloc((nb + 1) * sizeof(Enseignant*));
+    if (ex->enseignant == NULL) return 0;
+    for (NodeEnseignant *courant = enseignants; courant != NULL; courant = courant->suivant) {
+        const Enseignant *enseignant = &courant->enseignant;
+        int c;
+        if (index_id_chercher(&ex->calendrier_enseignant, enseignant->id, &c)) continue;
+        snprintf(fichier, sizeof(fichier), "enseignant_%d.ics", enseignant->id);
+        snprintf(titre, sizeof(titre), "Emploi du temps - %s %s", enseignant->prenom, enseignant->nom);
+        c = nouveau_calendrier(ex, fichier, titre);
+        if (c < 0 || !index_id_inserer(&ex->calendrier_enseignant, enseignant->id, c)) return 0;
+        ex->enseignant[c] = enseignant;
+    }
+
+    if (planning != NULL) {
+        for (int i = 0; i < planning->nb_seances; i++) {
+            if (calendrier_section(ex, planning->seances[i].section) < 0) return 0;
+        }
+    }
+
+    nb = 0;
+    for (NodeMatiere *courant = matieres; courant != NULL; courant = courant->suivant) nb++;
+    ex->matieres = (const Matiere**)malloc((nb + 1) * sizeof(Matiere*));
+    if (ex->matieres == NULL) return 0;
+    nb = 0;
+    for (NodeMatiere *courant = matieres; courant != NULL; courant = courant->suivant) {
+        ex->matieres[nb] = &courant->matiere;
+        if (!index_id_inserer(&ex->index_matieres, courant->matiere.id, nb++)) return 0;
+    }
+
+    // Student calendars, remembered by ID to join them with the enrollments
+    IndexId calendrier_etudiant = {0};
+    IndexId section_etudiant = {0};
+    int ok = 1;
+    for (NodeEtudiant *courant = etudiants; courant != NULL && ok; courant = courant->suivant) {
+        const Etudiant *etudiant = &courant->etudiant;
+        int c;
+        if (index_id_chercher(&calendrier_etudiant, etudiant->id, &c)) continue;
+        int s = etudiant->section[0] != '\0' ? calendrier_section(ex, etudiant->section) : -1;
+        snprintf(fichier, sizeof(fichier), "etudiant_%d.ics", etudiant->id);
+        snprintf(titre, sizeof(titre), "Emploi du temps - %s %s", etudiant->prenom, etudiant->nom);
+        c = nouveau_calendrier(ex, fichier, titre);
+        ok = c >= 0 && (etudiant->section[0] == '\0' || s >= 0) &&
+             index_id_inserer(&calendrier_etudiant, etudiant->id, c) &&
+             index_id_inserer(&section_etudiant, etudiant->id, s);
+    }
+
+    nb = 0;
+    for (NodeInscription *courant = inscriptions; courant != NULL; courant = courant->suivant) nb++;
+    ex->inscrit_calendrier = (int*)malloc((nb + 1) * sizeof(int));
+    ex->inscrit_section = (int*)malloc((nb + 1) * sizeof(int));
+    ex->suivant_inscrit = (int*)malloc((nb + 1) * sizeof(int));
+    ok = ok && ex->inscrit_calendrier != NULL && ex->inscrit_section != NULL && ex->suivant_inscrit != NULL;
+
+    // A student enrolled twice in a subject still gets each session once
+    IndexId deja_vu = {0};
+    nb = 0;
+    for (NodeInscription *courant = inscriptions; courant != NULL && ok; courant = courant->suivant) {
+        const Inscription *inscription = &courant->inscription;
+        int c, s, tete;
+        long long cle = index_cle_composee(inscription->id_etudiant, inscription->id_matiere);
+        if (inscription->statut != 1 || index_id_chercher(&deja_vu, cle, &tete) ||
+            !index_id_chercher(&calendrier_etudiant, inscription->id_etudiant, &c)) {
+            continue;
+        }
+        index_id_chercher(&section_etudiant, inscription->id_etudiant, &s);
+        ex->inscrit_calendrier[nb] = c;
+        ex->inscrit_section[nb] = s;
+        ex->suivant_inscrit[nb] = index_id_chercher(&ex->premier_inscrit, inscription->id_matiere, &tete) ? tete : -1;
+        ok = index_id_inserer(&ex->premier_inscrit, inscription->id_matiere, nb) &&
+             index_id_inserer(&deja_vu, cle, nb);
+        nb++;
+    }
+
+    index_id_liberer(&calendrier_etudiant);
+    index_id_liberer(&section_etudiant);
+    index_id_liberer(&deja_vu);
+    return ok;
+}
+
+// Format one session as a weekly recurring event
+static int formater_evenement(const ExportIcs *ex, char *sortie, size_t taille, const char *origine, int id,
+                              int id_matiere, int id_enseignant, const char *salle, const char *section,
+                              int jour, int debut, int fin) {
+    char valeur[256];
+    size_t pos = 0;
+    int m, c;
+
+    const Matiere *matiere = index_id_chercher(&ex->index_matieres, id_matiere, &m) ? ex->matieres[m] : NULL;
+    const Enseignant *enseignant = index_id_chercher(&ex->calendrier_enseignant, id_enseignant, &c)
+                                   ? ex->enseignant[c] : NULL;
+
+    if (!ligne_ics(sortie, taille, &pos, "BEGIN", "VEVENT", 0)) return 0;
+    snprintf(valeur, sizeof(valeur), "%s-%d@sgu", origine, id);
+    if (!ligne_ics(sortie, taille, &pos, "UID", valeur, 0)) return 0;
+    if (!ligne_ics(sortie, taille, &pos, "DTSTAMP", ex->horodatage, 0)) return 0;
+    // Floating local times: the sessions follow the wall clock of the school
+    snprintf(valeur, sizeof(valeur), "%sT%02d%02d00", ex->dates[jour], debut / 60, debut % 60);
+    if (!ligne_ics(sortie, taille, &pos, "DTSTART", valeur, 0)) return 0;
+    snprintf(valeur, sizeof(valeur), "%sT%02d%02d00", ex->dates[jour], fin / 60, fin % 60);
+    if (!ligne_ics(sortie, taille, &pos, "DTEND", valeur, 0)) return 0;
+    snprintf(valeur, sizeof(valeur), "FREQ=WEEKLY;COUNT=%d", ex->nb_semaines);
+    if (!ligne_ics(sortie, taille, &pos, "RRULE", valeur, 0)) return 0;
+
+    if (matiere != NULL) {
+        snprintf(valeur, sizeof(valeur), "%s (%s)", matiere->nom_matiere, matiere->code_matiere);
+    } else {
+        snprintf(valeur, sizeof(valeur), "Matière %d", id_matiere);
+    }
+    if (!ligne_ics(sortie, taille, &pos, "SUMMARY", valeur, 1)) return 0;
+    if (salle[0] != '\0' && !ligne_ics(sortie, taille, &pos, "LOCATION", salle, 1)) return 0;
+
+    if (enseignant != NULL) {
+        snprintf(valeur, sizeof(valeur), "Enseignant: %s %s%s%s", enseignant->prenom, enseignant->nom,
+                 section[0] != '\0' ? "\nSection: " : "", section);
+    } else {
+        snprintf(valeur, sizeof(valeur), "Enseignant: %d%s%s", id_enseignant,
+                 section[0] != '\0' ? "\nSection: " : "", section);
+    }
+    if (!ligne_ics(sortie, taille, &pos, "DESCRIPTION", valeur, 1)) return 0;
+    if (!ligne_ics(sortie, taille, &pos, "END", "VEVENT", 0)) return 0;
+    return (int)pos;
+}
+
+// Append an event to one calendar
+static int ajouter_evenement(ExportIcs *ex, int c, const char *evenement, size_t taille) {
+    if (c < 0) {
+        return 1;
+    }
+    if (!tampon_ajouter(&ex->calendriers[c].tampon, evenement, taille)) {
+        return 0;
+    }
+    ex->resultat->nb_evenements++;
+    return 1;
+}
+
+// Format a session once and append it to every calendar it belongs to
+static int exporter_seance(ExportIcs *ex, const char *origine, int id, int id_matiere, int id_enseignant,
+                           const char *salle, const char *section, int jour, int debut, int fin) {
+    char evenement[TAILLE_EVENEMENT];
+    int taille = formater_evenement(ex, evenement, sizeof(evenement), origine, id, id_matiere,
+                                    id_enseignant, salle, section, jour, debut, fin);
+    if (taille <= 0) {
+        return 0;
+    }
+
+    int c;
+    int ok = ajouter_evenement(ex, index_id_chercher(&ex->calendrier_enseignant, id_enseignant, &c) ? c : -1,
+                               evenement, taille);
+
+    // Grid sessions are shared by all sections, planning sessions belong to one
+    int s = -1;
+    if (section[0] != '\0') {
+        s = index_id_chercher(&ex->calendrier_section, index_cle_chaine(section), &c) ? c : -1;
+        ok = ajouter_evenement(ex, s, evenement, taille) && ok;
+    }
+
+    int i;
+    if (index_id_chercher(&ex->premier_inscrit, id_matiere, &i)) {
+        for (; i >= 0; i = ex->suivant_inscrit[i]) {
+            if (section[0] == '\0' || ex->inscrit_section[i] == s) {
+                ok = ajouter_evenement(ex, ex->inscrit_calendrier[i], evenement, taille) && ok;
+            }
+        }
+    }
+
+    ex->resultat->nb_seances++;
+    return ok;
+}
+
+// Dates of the days of the first week, from the Monday of the given day
+static int dates_premiere_semaine(ExportIcs *ex, const struct tm *debut) {
+    struct tm jour = *debut;
+    jour.tm_hour = 12; // Midday keeps daylight saving changes away from the date
+    jour.tm_min = 0;
+    jour.tm_sec = 0;
+    jour.tm_isdst = -1;
+    if (mktime(&jour) == (time_t)-1) {
+        return 0;
+    }
+    jour.tm_mday -= (jour.tm_wday + 6) % 7;
+
+    for (int j = 0; j < MAX_JOURS_PLANNING; j++) {
+        struct tm date = jour;
+        date.tm_mday += j;
+        date.tm_isdst = -1;
+        if (mktime(&date) == (time_t)-1) {
+            return 0;
+        }
+        strftime(ex->dates[j], sizeof(ex->dates[j]), "%Y%m%d", &date);
+    }
+
+    time_t maintenant = time(NULL);
+    strftime(ex->horodatage, sizeof(ex->horodatage), "%Y%m%dT%H%M%SZ", gmtime(&maintenant));
+    return 1;
+}
+
+// Free memory allocated for an export
+static void liberer_export(ExportIcs *ex) {
+    for (int c = 0; c < ex->nb_calendriers; c++) {
+        tampon_liberer(&ex->calendriers[c].tampon);
+    }
+    free(ex->calendriers);
+    free(ex->enseignant);
+    free(ex->matieres);
+    free(ex->inscrit_calendrier);
+    free(ex->inscrit_section);
+    free(ex->suivant_inscrit);
+    index_id_liberer(&ex->calendrier_enseignant);
+    index_id_liberer(&ex->calendrier_section);
+    index_id_liberer(&ex->index_matieres);
+    index_id_liberer(&ex->premier_inscrit);
+}
+
+/**
+ * Export one calendar per teacher, per section and per student
+ */
+int exporter_calendriers(const char *repertoire, const struct tm *debut, int nb_semaines,
+                         const EmploiDuTemps *edt, const Planning *planning,
+                         NodeEtudiant* etudiants, NodeEnseignant* enseignants,
+                         NodeMatiere* matieres, NodeInscription* inscriptions,
+                         ResultatCalendriers *resultat) {
+    struct timespec chrono_debut, chrono_fin;
+    clock_gettime(CLOCK_MONOTONIC, &chrono_debut);
+    memset(resultat, 0, sizeof(ResultatCalendriers));
+
+    if (nb_semaines < 1 || nb_semaines > MAX_SEMAINES_CALENDRIER) {
+        printf("Erreur: Le nombre de semaines doit être entre 1 et %d.\n", MAX_SEMAINES_CALENDRIER);
+        return 0;
+    }
+    if (!create_dir(repertoire)) {
+        printf("Erreur: Impossible de créer le répertoire %s.\n", repertoire);
+        return 0;
+    }
+
+    ExportIcs ex;
+    memset(&ex, 0, sizeof(ExportIcs));
+    ex.nb_semaines = nb_semaines;
+    ex.resultat = resultat;
+
+    if (!dates_premiere_semaine(&ex, debut)) {
+        printf("Erreur: Date de début invalide.\n");
+        return 0;
+    }
+    if (!preparer_calendriers(&ex, planning, etudiants, enseignants, matieres, inscriptions)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        liberer_export(&ex);
+        return 0;
+    }
+
+    // Grid sessions
+    const char *noms[MAX_CRENEAUX_JOUR_PLANNING];
+    int debuts[MAX_CRENEAUX_JOUR_PLANNING], fins[MAX_CRENEAUX_JOUR_PLANNING];
+    for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
+        noms[h] = heure_to_string(h);
+    }
+    horaires_creneaux(noms, CRENEAUX_PAR_JOUR, debuts, fins);
+
+    for (int j = 0; j < JOURS_PAR_SEMAINE; j++) {
+        for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
+            const Creneau *creneau = &edt->creneaux[j][h];
+            if (creneau->id == 0) continue;
+            if (!exporter_seance(&ex, "grille", creneau->id, creneau->id_matiere, creneau->id_enseignant,
+                                 creneau->salle, "", j, debuts[h], fins[h])) {
+                resultat->nb_erreurs++;
+            }
+        }
+    }
+
+    // Planning sessions
+    if (planning != NULL && planning->nb_seances > 0) {
+        for (int h = 0; h < planning->nb_creneaux_jour; h++) {
+            noms[h] = planning->noms_creneaux[h];
+        }
+        horaires_creneaux(noms, planning->nb_creneaux_jour, debuts, fins);
+
+        for (int i = 0; i < planning->nb_seances; i++) {
+            const Seance *seance = &planning->seances[i];
+            if (seance->jour < 0 || seance->jour >= MAX_JOURS_PLANNING ||
+                seance->heure < 0 || seance->heure >= planning->nb_creneaux_jour) {
+                continue;
+            }
+            if (!exporter_seance(&ex, "planning", seance->id, seance->id_matiere, seance->id_enseignant,
+                                 seance->salle, seance->section, seance->jour,
+                                 debuts[seance->heure], fins[seance->heure])) {
+                resultat->nb_erreurs++;
+            }
+        }
+    }
+
+    char chemin[256];
+    for (int c = 0; c < ex.nb_calendriers; c++) {
+        Calendrier *calendrier = &ex.calendriers[c];
+        snprintf(chemin, sizeof(chemin), "%s/%s", repertoire, calendrier->fichier);
+        if (tampon_ajouter(&calendrier->tampon, "END:VCALENDAR\r\n", 15) &&
+            tampon_ecrire_fichier(chemin, &calendrier->tampon)) {
+            resultat->nb_fichiers++;
+            resultat->nb_octets += calendrier->tampon.taille;
+        } else {
+            printf("Erreur: Impossible d'écrire le fichier %s.\n", chemin);
+            resultat->nb_erreurs++;
+        }
+    }
+
+    liberer_export(&ex);
+
+    clock_gettime(CLOCK_MONOTONIC, &chrono_fin);
+    resultat->duree_ms = (chrono_fin.tv_sec - chrono_debut.tv_sec) * 1000.0 +
+                         (chrono_fin.tv_nsec - chrono_debut.tv_nsec) / 1000000.0;
+    return 1;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file colonnes_notes.c
+ * @brief Implementation of the columnar grade store
+ */
+
+#include "../include/colonnes_notes.h"
+#include "../include/index.h"
+
+/**
+ * Shared columns, patched on each grade change and rebuilt only when the
+ * list is reloaded or a change could not be applied
+ */
+static ColonnesNotes partagees = {0};
+static NodeNote* partagees_notes = NULL;
+static unsigned long partagees_generation = 0;
+static int partagees_valides = 0;
+static IndexId partagees_par_id = {0}; // Grade ID -> position in the shared columns
+static size_t partagees_tas_perdu = 0; // Heap bytes of replaced or deleted strings
+
+// Copy a string to the heap and return its offset
+static size_t ajouter_chaine(ColonnesNotes *colonnes, const char *chaine, size_t taille_champ) {
+    size_t longueur = strnlen(chaine, taille_champ - 1) + 1;
+    memcpy(colonnes->tas + colonnes->taille_tas, chaine, longueur - 1);
+    colonnes->tas[colonnes->taille_tas + longueur - 1] = '\0';
+
+    size_t offset = colonnes->taille_tas;
+    colonnes->taille_tas += longueur;
+    return offset;
+}
+
+/**
+ * Build the columns from a list of grades
+ */
+int construire_colonnes_notes(ColonnesNotes *colonnes, NodeNote* notes) {
+    vider_colonnes_notes(colonnes);
+
+    // Size everything up front so each column is allocated once
+    int nb_notes = 0;
+    size_t taille_tas = 1;
+    for (NodeNote* n = notes; n != NULL; n = n->suivant) {
+        nb_notes++;
+        taille_tas += strnlen(n->note.commentaire, sizeof(n->note.commentaire) - 1) + 1;
+        taille_tas += strnlen(n->note.date_evaluation, sizeof(n->note.date_evaluation) - 1) + 1;
+    }
+
+    colonnes->capacite = nb_notes;
+    colonnes->id = (int*)malloc((nb_notes + 1) * sizeof(int));
+    colonnes->id_etudiant = (int*)malloc((nb_notes + 1) * sizeof(int));
+    colonnes->id_matiere = (int*)malloc((nb_notes + 1) * sizeof(int));
+    colonnes->id_enseignant = (int*)malloc((nb_notes + 1) * sizeof(int));
+    colonnes->note = (float*)malloc((nb_notes + 1) * sizeof(float));
+    colonnes->commentaire = (size_t*)malloc((nb_notes + 1) * sizeof(size_t));
+    colonnes->date_evaluation = (size_t*)malloc((nb_notes + 1) * sizeof(size_t));
+    colonnes->tas = (char*)malloc(taille_tas);
+    colonnes->capacite_tas = taille_tas;
+
+    if (colonnes->id == NULL || colonnes->id_etudiant == NULL || colonnes->id_matiere == NULL ||
+        colonnes->id_enseignant == NULL || colonnes->note == NULL || colonnes->commentaire == NULL ||
+        colonnes->date_evaluation == NULL || colonnes->tas == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        vider_colonnes_notes(colonnes);
+        return 0;
+    }
+
+    // Offset 0 is the empty string
+    colonnes->tas[0] = '\0';
+    colonnes->taille_tas = 1;
+
+    for (NodeNote* n = notes; n != NULL; n = n->suivant) {
+        if (n->note.id_etudiant <= 0 || n->note.id_matiere <= 0) {
+            continue; // Incomplete record (blank line in the data file)
+        }
+
+        int i = colonnes->nb++;
+        colonnes->id[i] = n->note.id;
+        colonnes->id_etudiant[i] = n->note.id_etudiant;
+        colonnes->id_matiere[i] = n->note.id_matiere;
+        colonnes->id_enseignant[i] = n->note.id_enseignant;
+        colonnes->note[i] = n->note.note;
+        colonnes->commentaire[i] = ajouter_chaine(colonnes, n->note.commentaire, sizeof(n->note.commentaire));
+        colonnes->date_evaluation[i] = ajouter_chaine(colonnes, n->note.date_evaluation, sizeof(n->note.date_evaluation));
+    }
+
+    return 1;
+}
+
+/**
+ * Free memory allocated for columns
+ */
+void vider_colonnes_notes(ColonnesNotes *colonnes) {
+    free(colonnes->id);
+    free(colonnes->id_etudiant);
+    free(colonnes->id_matiere);
+    free(colonnes->id_enseignant);
+    free(colonnes->note);
+    free(colonnes->commentaire);
+    free(colonnes->date_evaluation);
+    free(colonnes->tas);
+    memset(colonnes, 0, sizeof(ColonnesNotes));
+}
+
+// Rebuild the shared columns and their ID index
+static int reconstruire_partagees(NodeNote* notes) {
+    partagees_valides = 0;
+    index_id_liberer(&partagees_par_id);
+    if (!construire_colonnes_notes(&partagees, notes)) {
+        return 0;
+    }
+    if (!index_id_initialiser(&partagees_par_id, partagees.nb)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+
+    int unique = 1;
+    for (int i = 0; i < partagees.nb; i++) {
+        int pos;
+        if (index_id_chercher(&partagees_par_id, partagees.id[i], &pos)) {
+            unique = 0; // Duplicate IDs in the data file: changes cannot be located by ID
+        }
+        if (!index_id_inserer(&partagees_par_id, partagees.id[i], i)) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            return 0;
+        }
+    }
+    if (!unique) {
+        index_id_liberer(&partagees_par_id);
+    }
+
+    partagees_notes = notes;
+    partagees_generation = notes_generation();
+    partagees_tas_perdu = 0;
+    partagees_valides = 1;
+    return 1;
+}
+
+/**
+ * Get the shared columns of a list of grades, rebuilt only when grades change
+ */
+const ColonnesNotes* obtenir_colonnes_notes(NodeNote* notes) {
+    if (!partagees_valides || partagees_notes != notes || partagees_generation != notes_generation()) {
+        if (!reconstruire_partagees(notes)) {
+            return NULL;
+        }
+    }
+
+    return &partagees;
+}
+
+// Make room for one more row and two more strings in the shared columns
+static int reserver_ligne(const Note *note) {
+    ColonnesNotes *c = &partagees;
+    if (c->nb == c->capacite) {
+        int capacite = c->capacite ? c->capacite * 2 : 64;
+        int *id = (int*)realloc(c->id, (capacite + 1) * sizeof(int));
+        if (id != NULL) c->id = id;
+        int *id_etudiant = (int*)realloc(c->id_etudiant, (capacite + 1) * sizeof(int));
+        if (id_etudiant != NULL) c->id_etudiant = id_etudiant;
+        int *id_matiere = (int*)realloc(c->id_matiere, (capacite + 1) * sizeof(int));
+        if (id_matiere != NULL) c->id_matiere = id_matiere;
+        int *id_enseignant = (int*)realloc(c->id_enseignant, (capacite + 1) * sizeof(int));
+        if (id_enseignant != NULL) c->id_enseignant = id_enseignant;
+        float *valeurs = (float*)realloc(c->note, (capacite + 1) * sizeof(float));
+        if (valeurs != NULL) c->note = valeurs;
+        size_t *commentaire = (size_t*)realloc(c->commentaire, (capacite + 1) * sizeof(size_t));
+        if (commentaire != NULL) c->commentaire = commentaire;
+        size_t *date = (size_t*)realloc(c->date_evaluation, (capacite + 1) * sizeof(size_t));
+        if (date != NULL) c->date_evaluation = date;
+
+        if (id == NULL || id_etudiant == NULL || id_matiere == NULL || id_enseignant == NULL ||
+            valeurs == NULL || commentaire == NULL || date == NULL) {
+            return 0;
+        }
+        c->capacite = capacite;
+    }
+
+    size_t besoin = c->taille_tas + sizeof(note->commentaire) + sizeof(note->date_evaluation);
+    if (besoin > c->capacite_tas) {
+        size_t capacite = c->capacite_tas * 2;
+        if (capacite < besoin) {
+            capacite = besoin;
+        }
+        char *tas = (char*)realloc(c->tas, capacite);
+        if (tas == NULL) {
+            return 0;
+        }
+        c->tas = tas;
+        c->capacite_tas = capacite;
+    }
+    return 1;
+}
+
+// Write a grade at a position of the shared columns (room reserved by reserver_ligne)
+static void ecrire_ligne(int i, const Note *note) {
+    ColonnesNotes *c = &partagees;
+    c->id[i] = note->id;
+    c->id_etudiant[i] = note->id_etudiant;
+    c->id_matiere[i] = note->id_matiere;
+    c->id_enseignant[i] = note->id_enseignant;
+    c->note[i] = note->note;
+    c->commentaire[i] = ajouter_chaine(c, note->commentaire, sizeof(note->commentaire));
+    c->date_evaluation[i] = ajouter_chaine(c, note->date_evaluation, sizeof(note->date_evaluation));
+}
+
+// Bytes used in the heap by the strings of a row
+static size_t taille_chaines(int i) {
+    return strlen(colonnes_notes_commentaire(&partagees, i)) + 1 +
+           strlen(colonnes_notes_date(&partagees, i)) + 1;
+}
+
+/**
+ * Apply a single grade change to the shared columns
+ */
+void colonnes_note_modifiee(NodeNote* notes, const Note *ancienne, const Note *nouvelle) {
+    // Only columns that were in sync right before this change can be patched
+    if (!partagees_valides || partagees_generation + 1 != notes_generation() ||
+        partagees_par_id.capacite == 0) {
+        partagees_valides = 0;
+        return;
+    }
+
+    int pos = -1;
+    if (ancienne != NULL && !index_id_chercher(&partagees_par_id, ancienne->id, &pos)) {
+        partagees_valides = 0;
+        return;
+    }
+    if (nouvelle != NULL && (nouvelle->id_etudiant <= 0 || nouvelle->id_matiere <= 0)) {
+        partagees_valides = 0; // Would be skipped by a rebuild
+        return;
+    }
+
+    if (nouvelle != NULL && !reserver_ligne(nouvelle)) {
+        partagees_valides = 0;
+        return;
+    }
+
+    if (pos >= 0) {
+        partagees_tas_perdu += taille_chaines(pos);
+    }
+
+    if (ancienne != NULL && nouvelle != NULL) {
+        // Modification: the grade keeps its row
+        ecrire_ligne(pos, nouvelle);
+    } else if (nouvelle != NULL) {
+        pos = partagees.nb;
+        if (!index_id_inserer(&partagees_par_id, nouvelle->id, pos)) {
+            partagees_valides = 0;
+            return;
+        }
+        ecrire_ligne(pos, nouvelle);
+        partagees.nb++;
+    } else if (ancienne != NULL) {
+        // Deletion: the last row takes the place of the deleted one
+        int dernier = --partagees.nb;
+        index_id_supprimer(&partagees_par_id, ancienne->id);
+        if (pos != dernier) {
+            ColonnesNotes *c = &partagees;
+            c->id[pos] = c->id[dernier];
+            c->id_etudiant[pos] = c->id_etudiant[dernier];
+            c->id_matiere[pos] = c->id_matiere[dernier];
+            c->id_enseignant[pos] = c->id_enseignant[dernier];
+            c->note[pos] = c->note[dernier];
+            c->commentaire[pos] = c->commentaire[dernier];
+            c->date_evaluation[pos] = c->date_evaluation[dernier];
+            index_id_inserer(&partagees_par_id, c->id[pos], pos);
+        }
+    }
+
+    partagees_notes = notes;
+    partagees_generation = notes_generation();
+
+    // Compact the heap with a rebuild once it is mostly dead strings
+    if (partagees_tas_perdu > partagees.taille_tas / 2) {
+        partagees_valides = 0;
+    }
+}
+
+/**
+ * Get the comment of a grade
+ */
+const char* colonnes_notes_commentaire(const ColonnesNotes *colonnes, int i) {
+    return colonnes->tas + colonnes->commentaire[i];
+}
+
+/**
+ * Get the evaluation date of a grade
+ */
+const char* colonnes_notes_date(const ColonnesNotes *colonnes, int i) {
+    return colonnes->tas + colonnes->date_evaluation[i];
+}
+
+/**
+ * Rebuild the row view of a grade for display
+ */
+void colonnes_notes_ligne(const ColonnesNotes *colonnes, int i, Note *note) {
+    note->id = colonnes->id[i];
+    note->id_etudiant = colonnes->id_etudiant[i];
+    note->id_matiere = colonnes->id_matiere[i];
+    note->id_enseignant = colonnes->id_enseignant[i];
+    note->note = colonnes->note[i];
+
+    strncpy(note->commentaire, colonnes_notes_commentaire(colonnes, i), sizeof(note->commentaire) - 1);
+    note->commentaire[sizeof(note->commentaire) - 1] = '\0';
+    strncpy(note->date_evaluation, colonnes_notes_date(colonnes, i), sizeof(note->date_evaluation) - 1);
+    note->date_evaluation[sizeof(note->date_evaluation) - 1] = '\0';
+}
+
+/**
+ * Free memory allocated for the shared columns
+ */
+void liberer_colonnes_notes(void) {
+    vider_colonnes_notes(&partagees);
+    index_id_liberer(&partagees_par_id);
+    partagees_notes = NULL;
+    partagees_tas_perdu = 0;
+    partagees_valides = 0;
+}
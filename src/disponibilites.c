@@ -0,0 +1,210 @@
+/**
+ * @file disponibilites.c
+ * @brief Implementation of the teacher, room and section availability bitsets
+ */
+
+#include "../include/disponibilites.h"
+
+/**
+ * Initialize empty availabilities for a week
+ */
+int initialiser_disponibilites(Disponibilites *dispo, int nb_jours, int nb_creneaux_jour) {
+    memset(dispo, 0, sizeof(Disponibilites));
+
+    if (nb_jours <= 0 || nb_creneaux_jour <= 0 || nb_jours * nb_creneaux_jour > MAX_CRENEAUX_SEMAINE) {
+        printf("Erreur: La semaine doit compter entre 1 et %d créneaux.\n", MAX_CRENEAUX_SEMAINE);
+        return 0;
+    }
+
+    int nb_creneaux = nb_jours * nb_creneaux_jour;
+    dispo->nb_jours = nb_jours;
+    dispo->nb_creneaux_jour = nb_creneaux_jour;
+    dispo->semaine = (nb_creneaux == MAX_CRENEAUX_SEMAINE) ? ~0ULL : (1ULL << nb_creneaux) - 1;
+    return 1;
+}
+
+/**
+ * Free memory allocated for availabilities
+ */
+void liberer_disponibilites(Disponibilites *dispo) {
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        free(dispo->tables[t].occupe);
+        index_id_liberer(&dispo->tables[t].index);
+    }
+    memset(dispo, 0, sizeof(Disponibilites));
+}
+
+/**
+ * Get the handle of a resource, registering it if needed
+ */
+int ressource_disponibilites(Disponibilites *dispo, TypeRessource type, long long cle) {
+    TableRessources *table = &dispo->tables[type];
+
+    int handle;
+    if (index_id_chercher(&table->index, cle, &handle)) {
+        return handle;
+    }
+
+    if (table->nb == table->capacite) {
+        int capacite = table->capacite ? table->capacite * 2 : 16;
+        MasqueCreneaux *occupe = (MasqueCreneaux*)realloc(table->occupe, capacite * sizeof(MasqueCreneaux));
+        if (occupe == NULL) {
+            return -1;
+        }
+        table->occupe = occupe;
+        table->capacite = capacite;
+    }
+
+    handle = table->nb;
+    if (!index_id_inserer(&table->index, cle, handle)) {
+        return -1;
+    }
+    table->occupe[handle] = 0;
+    table->nb++;
+    return handle;
+}
+
+/**
+ * Get the handle of a resource without registering it
+ */
+int chercher_ressource_disponibilites(const Disponibilites *dispo, TypeRessource type, long long cle) {
+    int handle;
+    return index_id_chercher(&dispo->tables[type].index, cle, &handle) ? handle : -1;
+}
+
+/**
+ * Get the occupied slots of a resource
+ */
+MasqueCreneaux occupation_ressource(const Disponibilites *dispo, TypeRessource type, int handle) {
+    return handle >= 0 ? dispo->tables[type].occupe[handle] : 0;
+}
+
+// Union of the occupations of the given resources
+static MasqueCreneaux occupation_ressources(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES]) {
+    MasqueCreneaux occupe = 0;
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        occupe |= occupation_ressource(dispo, (TypeRessource)t, handles[t]);
+    }
+    return occupe;
+}
+
+/**
+ * Mark several slots of one resource as unavailable
+ */
+void bloquer_creneaux(Disponibilites *dispo, TypeRessource type, int handle, MasqueCreneaux creneaux) {
+    if (handle >= 0) {
+        dispo->tables[type].occupe[handle] |= creneaux & dispo->semaine;
+    }
+}
+
+/**
+ * Mark a slot as used by a teacher, a room and a section
+ */
+void reserver_creneau(Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau) {
+    MasqueCreneaux bit = 1ULL << creneau;
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        if (handles[t] >= 0) {
+            dispo->tables[t].occupe[handles[t]] |= bit;
+        }
+    }
+}
+
+/**
+ * Free a slot previously reserved
+ */
+void annuler_creneau(Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau) {
+    MasqueCreneaux bit = 1ULL << creneau;
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        if (handles[t] >= 0) {
+            dispo->tables[t].occupe[handles[t]] &= ~bit;
+        }
+    }
+}
+
+/**
+ * Check in O(1) which resources are already used at a slot
+ */
+int conflits_creneau(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES], int creneau) {
+    int conflits = 0;
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        if (occupation_ressource(dispo, (TypeRessource)t, handles[t]) >> creneau & 1ULL) {
+            conflits |= 1 << t;
+        }
+    }
+    return conflits;
+}
+
+/**
+ * Get the slots free for every given resource
+ */
+MasqueCreneaux creneaux_libres_communs(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES]) {
+    return dispo->semaine & ~occupation_ressources(dispo, handles);
+}
+
+/**
+ * Find the first slot free for every given resource
+ */
+int premier_creneau_libre_commun(const Disponibilites *dispo, const int handles[NB_TYPES_RESSOURCES]) {
+    MasqueCreneaux libres = creneaux_libres_communs(dispo, handles);
+    return libres ? __builtin_ctzll(libres) : -1;
+}
+
+// Reserve one session given by IDs and names
+static int reserver_seance(Disponibilites *dispo, int id_enseignant, const char *salle,
+                           const char *section, int jour, int heure) {
+    if (jour < 0 || jour >= dispo->nb_jours || heure < 0 || heure >= dispo->nb_creneaux_jour) {
+        return 1; // Outside of the week, nothing to block
+    }
+
+    int handles[NB_TYPES_RESSOURCES];
+    handles[RESSOURCE_ENSEIGNANT] = ressource_disponibilites(dispo, RESSOURCE_ENSEIGNANT, id_enseignant);
+    handles[RESSOURCE_SALLE] = salle[0] != '\0' ?
+        ressource_disponibilites(dispo, RESSOURCE_SALLE, index_cle_chaine(salle)) : -1;
+    handles[RESSOURCE_SECTION] = ressource_disponibilites(dispo, RESSOURCE_SECTION, index_cle_chaine(section));
+
+    if (handles[RESSOURCE_ENSEIGNANT] < 0 || handles[RESSOURCE_SECTION] < 0 ||
+        (salle[0] != '\0' && handles[RESSOURCE_SALLE] < 0)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+
+    reserver_creneau(dispo, handles, jour * dispo->nb_creneaux_jour + heure);
+    return 1;
+}
+
+/**
+ * Add the slots of the timetable grid (one section) to the availabilities
+ */
+int disponibilites_emploi_du_temps(Disponibilites *dispo, const EmploiDuTemps *edt, int jour_exclu, int heure_exclue) {
+    for (int j = 0; j < JOURS_PAR_SEMAINE; j++) {
+        for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
+            const Creneau *creneau = &edt->creneaux[j][h];
+            if (creneau->id == 0 || (j == jour_exclu && h == heure_exclue)) {
+                continue;
+            }
+            if (!reserver_seance(dispo, creneau->id_enseignant, creneau->salle, SECTION_GRILLE, j, h)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Add the sessions of a planning to the availabilities
+ */
+int disponibilites_planning(Disponibilites *dispo, const Planning *planning) {
+    // Slots only line up when the days are cut the same way
+    if (planning->nb_creneaux_jour != dispo->nb_creneaux_jour) {
+        return 0;
+    }
+
+    for (int i = 0; i < planning->nb_seances; i++) {
+        const Seance *seance = &planning->seances[i];
+        if (!reserver_seance(dispo, seance->id_enseignant, seance->salle, seance->section,
+                             seance->jour, seance->heure)) {
+            return 0;
+        }
+    }
+    return 1;
+}
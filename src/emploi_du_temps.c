@@ -5,9 +5,81 @@
 
 #include "../include/emploi_du_temps.h"
 #include "../include/utils.h"
+#include "../include/generateur_edt.h"
+#include "../include/disponibilites.h"
+#include "../include/index.h"
 
 #define EDT_FILE "data/emploi_du_temps.txt"
 
+// Incremented whenever the timetable is (re)loaded or saved
+static unsigned long generation_edt = 0;
+
+/**
+ * Subjects and teachers indexed by ID, to name the slots when displayed
+ */
+typedef struct {
+    const Matiere **matieres;
+    const Enseignant **enseignants;
+    IndexId index_matieres;
+    IndexId index_enseignants;
+} NomsCreneaux;
+
+// Index the subjects and teachers by ID (unknown names are shown as such on failure)
+static void indexer_noms(NomsCreneaux *noms, NodeMatiere* matieres, NodeEnseignant* enseignants) {
+    memset(noms, 0, sizeof(NomsCreneaux));
+    
+    int nb = 0;
+    for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) nb++;
+    noms->matieres = (const Matiere**)malloc((nb + 1) * sizeof(Matiere*));
+    if (noms->matieres != NULL) {
+        nb = 0;
+        for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+            noms->matieres[nb] = &m->matiere;
+            index_id_inserer(&noms->index_matieres, m->matiere.id, nb++);
+        }
+    }
+    
+    nb = 0;
+    for (NodeEnseignant* e = enseignants; e != NULL; e = e->suivant) nb++;
+    noms->enseignants = (const Enseignant**)malloc((nb + 1) * sizeof(Enseignant*));
+    if (noms->enseignants != NULL) {
+        nb = 0;
+        for (NodeEnseignant* e = enseignants; e != NULL; e = e->suivant) {
+            noms->enseignants[nb] = &e->enseignant;
+            index_id_inserer(&noms->index_enseignants, e->enseignant.id, nb++);
+        }
+    }
+}
+
+// Free the name indexes
+static void liberer_noms(NomsCreneaux *noms) {
+    free(noms->matieres);
+    free(noms->enseignants);
+    index_id_liberer(&noms->index_matieres);
+    index_id_liberer(&noms->index_enseignants);
+}
+
+// Name of the subject of a slot
+static const char* nom_matiere_creneau(const NomsCreneaux *noms, const Creneau *creneau) {
+    int pos;
+    if (noms->matieres != NULL && index_id_chercher(&noms->index_matieres, creneau->id_matiere, &pos)) {
+        return noms->matieres[pos]->nom_matiere;
+    }
+    return "Inconnue";
+}
+
+// Full name of the teacher of a slot, written to `nom`
+static const char* nom_enseignant_creneau(const NomsCreneaux *noms, const Creneau *creneau,
+                                          char *nom, size_t taille) {
+    int pos;
+    if (noms->enseignants != NULL && index_id_chercher(&noms->index_enseignants, creneau->id_enseignant, &pos)) {
+        snprintf(nom, taille, "%s %s", noms->enseignants[pos]->prenom, noms->enseignants[pos]->nom);
+    } else {
+        snprintf(nom, taille, "Inconnu");
+    }
+    return nom;
+}
+
 // Helper function to convert day number to string
 const char* jour_to_string(int jour) {
     static const char* jours[] = {"Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi"};
@@ -40,6 +112,7 @@ int charger_emploi_du_temps(EmploiDuTemps *edt) {
     
     // Initialize empty timetable
     initialiser_emploi_du_temps(edt);
+    generation_edt++;
     
     if (!file_exists(EDT_FILE)) {
         // Create empty file if it doesn't exist
@@ -55,24 +128,56 @@ int charger_emploi_du_temps(EmploiDuTemps *edt) {
     
     char line[256];
     edt->nb_creneaux = 0;
+    int ancien_format = 0;
+    int nb_anciens_rejetes = 0;
     
     while (fgets(line, sizeof(line), file)) {
         line[strcspn(line, "\n")] = '\0'; // Remove newline
         
         Creneau creneau;
-        // Parse the line (id|id_matiere|nom_matiere|id_enseignant|nom_enseignant|salle|jour|heure)
-        sscanf(line, "%d|%d|%[^|]|%d|%[^|]|%[^|]|%d|%d",
-               &creneau.id,
-               &creneau.id_matiere,
-               creneau.nom_matiere,
-               &creneau.id_enseignant,
-               creneau.nom_enseignant,
-               creneau.salle,
-               &creneau.jour,
-               &creneau.heure);
+        memset(&creneau, 0, sizeof(Creneau));
+        
+        int nb_separateurs = 0;
+        for (const char *c = line; *c != '\0'; c++) {
+            nb_separateurs += (*c == '|');
+        }
+        
+        int lus;
+        if (nb_separateurs == 7) {
+            // Old format: id|id_matiere|nom_matiere|id_enseignant|nom_enseignant|salle|jour|heure
+            // Split on '|' so that empty names (dropped anyway) do not reject the slot
+            char *champs[8];
+            char *debut = line;
+            for (int i = 0; i < 8; i++) {
+                champs[i] = debut;
+                debut = strchr(debut, '|');
+                if (debut != NULL) {
+                    *debut++ = '\0';
+                }
+            }
+            lus = sscanf(champs[0], "%d", &creneau.id) == 1 &&
+                  sscanf(champs[1], "%d", &creneau.id_matiere) == 1 &&
+                  sscanf(champs[3], "%d", &creneau.id_enseignant) == 1 &&
+                  sscanf(champs[5], "%9[^|]", creneau.salle) == 1 &&
+                  sscanf(champs[6], "%d", &creneau.jour) == 1 &&
+                  sscanf(champs[7], "%d", &creneau.heure) == 1;
+            ancien_format = 1;
+            if (!lus) {
+                nb_anciens_rejetes++;
+            }
+        } else {
+            // Parse the line (id|id_matiere|id_enseignant|salle|jour|heure)
+            lus = sscanf(line, "%d|%d|%d|%9[^|]|%d|%d",
+                         &creneau.id,
+                         &creneau.id_matiere,
+                         &creneau.id_enseignant,
+                         creneau.salle,
+                         &creneau.jour,
+                         &creneau.heure) == 6;
+        }
         
         // Place in the right spot in the timetable
-        if (creneau.jour >= 0 && creneau.jour < JOURS_PAR_SEMAINE &&
+        if (lus && creneau.jour >= 0 && creneau.jour < JOURS_PAR_SEMAINE &&
             creneau.heure >= 0 && creneau.heure < CRENEAUX_PAR_JOUR) {
             edt->creneaux[creneau.jour][creneau.heure] = creneau;
             edt->nb_creneaux++;
@@ -80,6 +185,14 @@ int charger_emploi_du_temps(EmploiDuTemps *edt) {
     }
     
     fclose(file);
+    
+    // Rewrite old files without the copied names, unless that would lose unreadable slots
+    if (nb_anciens_rejetes > 0) {
+        printf("Attention: %d créneau(x) illisible(s) dans l'emploi du temps; le fichier n'est pas converti.\n",
+               nb_anciens_rejetes);
+    } else if (ancien_format && !sauvegarder_emploi_du_temps(edt)) {
+        printf("Erreur: Impossible de convertir le fichier d'emploi du temps.\n");
+    }
     return 1;
 }
 
@@ -87,6 +200,8 @@ int charger_emploi_du_temps(EmploiDuTemps *edt) {
  * Save timetable to file
  */
 int sauvegarder_emploi_du_temps(const EmploiDuTemps *edt) {
+    generation_edt++;
+    
     FILE *file = fopen(EDT_FILE, "w");
     if (file == NULL) {
         printf("Erreur: Impossible d'ouvrir le fichier d'emploi du temps en écriture.\n");
@@ -100,12 +215,10 @@ int sauvegarder_emploi_du_temps(const EmploiDuTemps *edt) {
             
             // Only save non-empty slots
             if (creneau.id != 0) {
-                fprintf(file, "%d|%d|%s|%d|%s|%s|%d|%d\n",
+                fprintf(file, "%d|%d|%d|%s|%d|%d\n",
                         creneau.id,
                         creneau.id_matiere,
-                        creneau.nom_matiere,
                         creneau.id_enseignant,
-                        creneau.nom_enseignant,
                         creneau.salle,
                         creneau.jour,
                         creneau.heure);
@@ -117,9 +230,168 @@ int sauvegarder_emploi_du_temps(const EmploiDuTemps *edt) {
     return 1;
 }
 
+/**
+ * Choose the teacher of a subject
+ */
+NodeEnseignant* choisir_enseignant_matiere(NodeEnseignant* enseignants, const Matiere *matiere,
+                                           const int *charges, int *position, int *specialise) {
+    NodeEnseignant* choisi = NULL;
+    int pos_choisi = -1;
+    int choisi_specialise = 0;
+    int i = 0;
+
+    // Least loaded teacher of the subject, else least loaded teacher overall
+    for (NodeEnseignant* e = enseignants; e != NULL; e = e->suivant, i++) {
+        const char *enseignee = e->enseignant.matiere_enseignee;
+        int correspond = enseignee[0] != '\0' &&
+                         (str_case_search(matiere->nom_matiere, enseignee) != NULL ||
+                          str_case_search(enseignee, matiere->nom_matiere) != NULL);
+
+        if (choisi == NULL || correspond > choisi_specialise ||
+            (correspond == choisi_specialise && charges[i] < charges[pos_choisi])) {
+            choisi = e;
+            pos_choisi = i;
+            choisi_specialise = correspond;
+        }
+    }
+
+    *position = pos_choisi;
+    *specialise = choisi_specialise;
+    return choisi;
+}
+
+/**
+ * Split a comma-separated list of rooms
+ */
+int lire_liste_salles(const char *liste, char salles[][MAX_SALLE_LEN], int max) {
+    int nb = 0;
+    const char *debut = liste;
+
+    while (*debut != '\0' && nb < max) {
+        while (*debut == ' ' || *debut == ',') debut++;
+        size_t longueur = strcspn(debut, ",");
+        while (longueur > 0 && debut[longueur - 1] == ' ') longueur--;
+        if (longueur > 0) {
+            if (longueur >= MAX_SALLE_LEN) longueur = MAX_SALLE_LEN - 1;
+            memcpy(salles[nb], debut, longueur);
+            salles[nb][longueur] = '\0';
+            nb++;
+        }
+        debut += strcspn(debut, ",");
+    }
+
+    return nb;
+}
+
 /**
  * Generate an automatic timetable
  */
+void generer_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres) {
+    if (matieres == NULL) {
+        printf("Erreur: Aucune matière n'est enregistrée. Veuillez d'abord ajouter des matières.\n");
+        return;
+    }
+    
+    if (enseignants == NULL) {
+        printf("Erreur: Aucun enseignant n'est enregistré. Veuillez d'abord ajouter des enseignants.\n");
+        return;
+    }
+    
+    printf("\n=== Générer un emploi du temps ===\n");
+    
+    if (edt->nb_creneaux > 0) {
+        int confirmation = get_int_input("L'emploi du temps actuel sera remplacé. Continuer? (1: Oui, 0: Non): ", 0, 1);
+        if (!confirmation) {
+            printf("Opération annulée.\n");
+            return;
+        }
+    }
+    
+    int seances_par_matiere = get_int_input("Nombre de séances par matière et par semaine (1-4): ", 1, 4);
+    
+    char liste_salles[100];
+    get_input("Salles disponibles, séparées par des virgules (ex: S1,S2): ", liste_salles, sizeof(liste_salles));
+    
+    char salles[JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR][MAX_SALLE_LEN];
+    int nb_salles = lire_liste_salles(liste_salles, salles, JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR);
+    if (nb_salles == 0) {
+        strcpy(salles[0], "S1");
+        nb_salles = 1;
+    }
+    
+    int nb_enseignants = 0;
+    for (NodeEnseignant* e = enseignants; e != NULL; e = e->suivant) nb_enseignants++;
+    int *charges = (int*)calloc(nb_enseignants, sizeof(int));
+    
+    // The grid holds one class per slot: a single section
+    ProblemeEdt probleme;
+    if (charges == NULL || !initialiser_probleme_edt(&probleme, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR, nb_salles, 1)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        free(charges);
+        return;
+    }
+    
+    for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+        int position, specialise;
+        NodeEnseignant* enseignant = choisir_enseignant_matiere(enseignants, &m->matiere, charges, &position, &specialise);
+        if (!specialise) {
+            printf("Aucun enseignant spécialisé pour %s: attribuée à %s %s.\n", m->matiere.nom_matiere,
+                   enseignant->enseignant.prenom, enseignant->enseignant.nom);
+        }
+        
+        for (int k = 0; k < seances_par_matiere; k++) {
+            ajouter_seance_probleme(&probleme, m->matiere.id, enseignant->enseignant.id, 0);
+            charges[position]++;
+        }
+    }
+    free(charges);
+    
+    SolutionEdt solution;
+    if (resoudre_edt(&probleme, &solution) < 0) {
+        printf("Erreur: La génération de l'emploi du temps a échoué. L'emploi du temps actuel est conservé.\n");
+        liberer_probleme_edt(&probleme);
+        return;
+    }
+    
+    // Fill the grid with the placed sessions
+    initialiser_emploi_du_temps(edt);
+    for (int s = 0; s < probleme.nb_seances; s++) {
+        if (solution.creneau[s] < 0) {
+            continue;
+        }
+        
+        int jour = solution.creneau[s] / CRENEAUX_PAR_JOUR;
+        int heure = solution.creneau[s] % CRENEAUX_PAR_JOUR;
+        NodeMatiere* matiere = trouver_matiere_par_id(matieres, probleme.seances[s].id_matiere);
+        NodeEnseignant* enseignant = trouver_enseignant_par_id(enseignants, probleme.seances[s].id_enseignant);
+        
+        Creneau *creneau = &edt->creneaux[jour][heure];
+        creneau->id = ++edt->nb_creneaux;
+        creneau->id_matiere = matiere->matiere.id;
+        creneau->id_enseignant = enseignant->enseignant.id;
+        strcpy(creneau->salle, salles[solution.salle[s]]);
+        creneau->jour = jour;
+        creneau->heure = heure;
+    }
+    
+    printf("\n%d/%d séances placées en %.2f ms (%ld nœuds explorés, pénalité %d).\n",
+           solution.nb_placees, probleme.nb_seances, solution.duree_ms, solution.noeuds, solution.penalite);
+    if (!solution.complete) {
+        printf("Attention: certaines séances n'ont pas pu être placées (pas assez de créneaux libres).\n");
+    }
+    
+    liberer_solution_edt(&solution);
+    liberer_probleme_edt(&probleme);
+    
+    afficher_emploi_du_temps(edt, matieres, enseignants);
+    
+    if (sauvegarder_emploi_du_temps(edt)) {
+        printf("Emploi du temps généré avec succès.\n");
+    } else {
+        printf("Erreur lors de la sauvegarde de l'emploi du temps.\n");
+    }
+}
+
 // Fonction pour créer manuellement l'emploi du temps
 void creation_manuelle_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* enseignants) {
     // Initialiser l'emploi du temps
@@ -136,9 +408,10 @@ void creation_manuelle_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* ensei
             
             // Vérification de la disponibilité du créneau
             if (edt->creneaux[jour][heure].id != 0) {
-                printf("⚠️ Ce créneau est déjà occupé par %s (%s).\n", 
-                       edt->creneaux[jour][heure].nom_enseignant, 
-                       edt->creneaux[jour][heure].nom_matiere);
+                NodeEnseignant* occupant = trouver_enseignant_par_id(enseignants, edt->creneaux[jour][heure].id_enseignant);
+                printf("⚠️ Ce créneau est déjà occupé par %s (salle %s).\n", 
+                       occupant != NULL ? occupant->enseignant.prenom : "Inconnu", 
+                       edt->creneaux[jour][heure].salle);
                 continue; // Passer au créneau suivant
             }
             
@@ -172,9 +445,7 @@ void creation_manuelle_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* ensei
             Creneau creneau;
             creneau.id = generate_id(); // Générer un nouvel ID
             creneau.id_matiere = enseignant->enseignant.id; // Associer la matière
-            strcpy(creneau.nom_matiere, enseignant->enseignant.matiere_enseignee);
             creneau.id_enseignant = enseignant->enseignant.id;
-            strcpy(creneau.nom_enseignant, enseignant->enseignant.prenom);
             strcpy(creneau.salle, salle);
             creneau.jour = jour;
             creneau.heure = heure;
@@ -192,10 +463,46 @@ void creation_manuelle_emploi_du_temps(EmploiDuTemps *edt, NodeEnseignant* ensei
         printf("Erreur lors de la sauvegarde de l'emploi du temps.\n");
     }
 }
+// Availabilities of the grid (minus one cell) and of the planning
+static int disponibilites_grille(Disponibilites *dispo, const EmploiDuTemps *edt,
+                                 const Planning *planning, int jour_exclu, int heure_exclue) {
+    if (!initialiser_disponibilites(dispo, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR)) {
+        return 0;
+    }
+    if (!disponibilites_emploi_du_temps(dispo, edt, jour_exclu, heure_exclue)) {
+        liberer_disponibilites(dispo);
+        return 0;
+    }
+    if (planning != NULL) {
+        disponibilites_planning(dispo, planning); // Skipped if the slots differ
+    }
+    return 1;
+}
+
+// Handles of a teacher and a room, plus the grid itself if requested
+static void ressources_grille(const Disponibilites *dispo, int id_enseignant, const char *salle,
+                              int avec_grille, int handles[NB_TYPES_RESSOURCES]) {
+    handles[RESSOURCE_ENSEIGNANT] = chercher_ressource_disponibilites(dispo, RESSOURCE_ENSEIGNANT, id_enseignant);
+    handles[RESSOURCE_SALLE] = chercher_ressource_disponibilites(dispo, RESSOURCE_SALLE, index_cle_chaine(salle));
+    handles[RESSOURCE_SECTION] = avec_grille ?
+        chercher_ressource_disponibilites(dispo, RESSOURCE_SECTION, index_cle_chaine(SECTION_GRILLE)) : -1;
+}
+
+// Explain which resources are already taken
+static void afficher_conflits(int conflits, const char *nom_enseignant, const char *salle) {
+    if (conflits & CONFLIT_ENSEIGNANT) {
+        printf("Conflit: %s enseigne déjà à ce créneau.\n", nom_enseignant);
+    }
+    if (conflits & CONFLIT_SALLE) {
+        printf("Conflit: La salle %s est déjà occupée à ce créneau.\n", salle);
+    }
+}
+
 /**
  * Add a new slot to the timetable
  */
-void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres) {
+void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres,
+                     const Planning *planning) {
     // Check if there are subjects and teachers
     if (matieres == NULL) {
         printf("Erreur: Aucune matière n'est enregistrée. Veuillez d'abord ajouter des matières.\n");
@@ -210,7 +517,7 @@ void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatier
     printf("\n=== Ajouter un nouveau créneau ===\n");
     
     // Display the current timetable
-    afficher_emploi_du_temps(edt);
+    afficher_emploi_du_temps(edt, matieres, enseignants);
     
     // Get the day and time for the new slot
     int jour = get_int_input("Jour (0: Lundi, 1: Mardi, 2: Mercredi, 3: Jeudi, 4: Vendredi): ", 
@@ -249,6 +556,41 @@ void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatier
     char salle[MAX_SALLE_LEN];
     get_input("Salle: ", salle, sizeof(salle));
     
+    // Check that the teacher and the room are free at that time
+    Disponibilites dispo;
+    if (!disponibilites_grille(&dispo, edt, planning, -1, -1)) {
+        return;
+    }
+    
+    char nom_enseignant[100];
+    snprintf(nom_enseignant, sizeof(nom_enseignant), "%s %s",
+             enseignant->enseignant.prenom, enseignant->enseignant.nom);
+    
+    int handles[NB_TYPES_RESSOURCES];
+    ressources_grille(&dispo, id_enseignant, salle, 1, handles);
+    int conflits = conflits_creneau(&dispo, handles, jour * CRENEAUX_PAR_JOUR + heure);
+    
+    if (conflits) {
+        afficher_conflits(conflits, nom_enseignant, salle);
+        
+        int libre = premier_creneau_libre_commun(&dispo, handles);
+        if (libre < 0) {
+            printf("Aucun créneau libre pour cet enseignant et cette salle.\n");
+            liberer_disponibilites(&dispo);
+            return;
+        }
+        
+        printf("Premier créneau libre pour cet enseignant et cette salle: %s, %s\n",
+               jour_to_string(libre / CRENEAUX_PAR_JOUR), heure_to_string(libre % CRENEAUX_PAR_JOUR));
+        if (!get_int_input("Utiliser ce créneau? (1: Oui, 0: Non): ", 0, 1)) {
+            liberer_disponibilites(&dispo);
+            return;
+        }
+        jour = libre / CRENEAUX_PAR_JOUR;
+        heure = libre % CRENEAUX_PAR_JOUR;
+    }
+    liberer_disponibilites(&dispo);
+    
     // Generate a new ID for the slot
     int new_id = 1;
     for (int j = 0; j < JOURS_PAR_SEMAINE; j++) {
@@ -263,10 +605,7 @@ void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatier
     Creneau creneau;
     creneau.id = new_id;
     creneau.id_matiere = matiere->matiere.id;
-    strcpy(creneau.nom_matiere, matiere->matiere.nom_matiere);
     creneau.id_enseignant = enseignant->enseignant.id;
-    snprintf(creneau.nom_enseignant, sizeof(creneau.nom_enseignant), 
-            "%s %s", enseignant->enseignant.prenom, enseignant->enseignant.nom);
     strcpy(creneau.salle, salle);
     creneau.jour = jour;
     creneau.heure = heure;
@@ -286,7 +625,8 @@ void ajouter_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatier
 /**
  * Modify an existing slot in the timetable
  */
-void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres) {
+void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatiere* matieres,
+                      const Planning *planning) {
     if (edt->nb_creneaux == 0) {
         printf("Aucun créneau n'est enregistré dans l'emploi du temps.\n");
         return;
@@ -295,7 +635,7 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
     printf("\n=== Modifier un créneau ===\n");
     
     // Display the current timetable
-    afficher_emploi_du_temps(edt);
+    afficher_emploi_du_temps(edt, matieres, enseignants);
     
     // Get the day and time of the slot to modify
     int jour = get_int_input("Jour du créneau à modifier (0: Lundi, 1: Mardi, 2: Mercredi, 3: Jeudi, 4: Vendredi): ", 
@@ -312,14 +652,26 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
     
     Creneau *creneau = &edt->creneaux[jour][heure];
     
+    NodeMatiere* matiere_actuelle = trouver_matiere_par_id(matieres, creneau->id_matiere);
+    NodeEnseignant* enseignant_actuel = trouver_enseignant_par_id(enseignants, creneau->id_enseignant);
+    char nom_enseignant[100] = "Inconnu";
+    if (enseignant_actuel != NULL) {
+        snprintf(nom_enseignant, sizeof(nom_enseignant), "%s %s",
+                 enseignant_actuel->enseignant.prenom, enseignant_actuel->enseignant.nom);
+    }
+    const char *nom_matiere = matiere_actuelle != NULL ? matiere_actuelle->matiere.nom_matiere : "Inconnue";
+    
     printf("\nModification du créneau: %s, %s - %s avec %s en salle %s\n",
            jour_to_string(jour), heure_to_string(heure),
-           creneau->nom_matiere, creneau->nom_enseignant, creneau->salle);
+           nom_matiere, nom_enseignant, creneau->salle);
     
     printf("Laissez vide pour garder la valeur actuelle.\n");
     
+    // Work on a copy, kept only if it raises no conflict
+    Creneau modifie = *creneau;
+    
     // Choose new subject if needed
-    printf("\nMatière actuelle: %s\n", creneau->nom_matiere);
+    printf("\nMatière actuelle: %s\n", nom_matiere);
     int modifier_matiere = get_int_input("Modifier la matière? (1: Oui, 0: Non): ", 0, 1);
     
     if (modifier_matiere) {
@@ -330,13 +682,12 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
         if (matiere == NULL) {
             printf("Matière avec ID %d non trouvée. La matière n'a pas été modifiée.\n", id_matiere);
         } else {
-            creneau->id_matiere = matiere->matiere.id;
-            strcpy(creneau->nom_matiere, matiere->matiere.nom_matiere);
+            modifie.id_matiere = matiere->matiere.id;
         }
     }
     
     // Choose new teacher if needed
-    printf("\nEnseignant actuel: %s\n", creneau->nom_enseignant);
+    printf("\nEnseignant actuel: %s\n", nom_enseignant);
     int modifier_enseignant = get_int_input("Modifier l'enseignant? (1: Oui, 0: Non): ", 0, 1);
     
     if (modifier_enseignant) {
@@ -347,8 +698,8 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
         if (enseignant == NULL) {
             printf("Enseignant avec ID %d non trouvé. L'enseignant n'a pas été modifié.\n", id_enseignant);
         } else {
-            creneau->id_enseignant = enseignant->enseignant.id;
-            snprintf(creneau->nom_enseignant, sizeof(creneau->nom_enseignant), 
+            modifie.id_enseignant = enseignant->enseignant.id;
+            snprintf(nom_enseignant, sizeof(nom_enseignant), 
                     "%s %s", enseignant->enseignant.prenom, enseignant->enseignant.nom);
         }
     }
@@ -359,9 +710,30 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
     get_input("Nouvelle salle (laisser vide pour garder): ", nouvelle_salle, sizeof(nouvelle_salle));
     
     if (strlen(nouvelle_salle) > 0) {
-        strcpy(creneau->salle, nouvelle_salle);
+        strcpy(modifie.salle, nouvelle_salle);
+    }
+    
+    // The slot itself is left out, so keeping the same teacher or room is not a conflict
+    if (modifie.id_enseignant != creneau->id_enseignant || strcmp(modifie.salle, creneau->salle) != 0) {
+        Disponibilites dispo;
+        if (!disponibilites_grille(&dispo, edt, planning, jour, heure)) {
+            return;
+        }
+        
+        int handles[NB_TYPES_RESSOURCES];
+        ressources_grille(&dispo, modifie.id_enseignant, modifie.salle, 0, handles);
+        int conflits = conflits_creneau(&dispo, handles, jour * CRENEAUX_PAR_JOUR + heure);
+        liberer_disponibilites(&dispo);
+        
+        if (conflits) {
+            afficher_conflits(conflits, nom_enseignant, modifie.salle);
+            printf("Modification annulée.\n");
+            return;
+        }
     }
     
+    *creneau = modifie;
+    
     // Save the updated timetable
     if (sauvegarder_emploi_du_temps(edt)) {
         printf("Créneau modifié avec succès.\n");
@@ -373,7 +745,7 @@ void modifier_creneau(EmploiDuTemps *edt, NodeEnseignant* enseignants, NodeMatie
 /**
  * Delete a slot from the timetable
  */
-void supprimer_creneau(EmploiDuTemps *edt) {
+void supprimer_creneau(EmploiDuTemps *edt, NodeMatiere* matieres, NodeEnseignant* enseignants) {
     if (edt->nb_creneaux == 0) {
         printf("Aucun créneau n'est enregistré dans l'emploi du temps.\n");
         return;
@@ -382,7 +754,7 @@ void supprimer_creneau(EmploiDuTemps *edt) {
     printf("\n=== Supprimer un créneau ===\n");
     
     // Display the current timetable
-    afficher_emploi_du_temps(edt);
+    afficher_emploi_du_temps(edt, matieres, enseignants);
     
     // Get the day and time of the slot to delete
     int jour = get_int_input("Jour du créneau à supprimer (0: Lundi, 1: Mardi, 2: Mercredi, 3: Jeudi, 4: Vendredi): ", 
@@ -398,11 +770,15 @@ void supprimer_creneau(EmploiDuTemps *edt) {
     }
     
     // Confirmation
+    NomsCreneaux noms;
+    char nom_enseignant[100];
+    indexer_noms(&noms, matieres, enseignants);
     printf("\nVous allez supprimer le créneau: %s, %s - %s avec %s en salle %s\n",
            jour_to_string(jour), heure_to_string(heure),
-           edt->creneaux[jour][heure].nom_matiere, 
-           edt->creneaux[jour][heure].nom_enseignant, 
+           nom_matiere_creneau(&noms, &edt->creneaux[jour][heure]), 
+           nom_enseignant_creneau(&noms, &edt->creneaux[jour][heure], nom_enseignant, sizeof(nom_enseignant)), 
            edt->creneaux[jour][heure].salle);
+    liberer_noms(&noms);
     
     int confirmation = get_int_input("Confirmer la suppression? (1: Oui, 0: Non): ", 0, 1);
     
@@ -425,7 +801,11 @@ void supprimer_creneau(EmploiDuTemps *edt) {
 /**
  * Display the complete timetable
  */
-void afficher_emploi_du_temps(const EmploiDuTemps *edt) {
+void afficher_emploi_du_temps(const EmploiDuTemps *edt, NodeMatiere* matieres, NodeEnseignant* enseignants) {
+    NomsCreneaux noms;
+    char nom_enseignant[100];
+    indexer_noms(&noms, matieres, enseignants);
+    
     printf("\n=== Emploi du Temps ===\n\n");
     
     // Column headers (hours)
@@ -447,7 +827,7 @@ void afficher_emploi_du_temps(const EmploiDuTemps *edt) {
         
         for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
             if (edt->creneaux[j][h].id != 0) {
-                printf(" %-10s (%s) |", edt->creneaux[j][h].nom_matiere, edt->creneaux[j][h].salle);
+                printf(" %-10s (%s) |", nom_matiere_creneau(&noms, &edt->creneaux[j][h]), edt->creneaux[j][h].salle);
             } else {
                 printf(" %-20s |", "");
             }
@@ -458,7 +838,8 @@ void afficher_emploi_du_temps(const EmploiDuTemps *edt) {
         printf("%-10s |", "");
         for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
             if (edt->creneaux[j][h].id != 0) {
-                printf(" %-20s |", edt->creneaux[j][h].nom_enseignant);
+                printf(" %-20s |", nom_enseignant_creneau(&noms, &edt->creneaux[j][h],
+                                                          nom_enseignant, sizeof(nom_enseignant)));
             } else {
                 printf(" %-20s |", "");
             }
@@ -473,6 +854,8 @@ void afficher_emploi_du_temps(const EmploiDuTemps *edt) {
     }
     
     printf("\n");
+    
+    liberer_noms(&noms);
 }
 
 /**
@@ -488,3 +871,10 @@ void initialiser_emploi_du_temps(EmploiDuTemps *edt) {
     
     edt->nb_creneaux = 0;
 }
+
+/**
+ * Get the timetable modification counter
+ */
+unsigned long emploi_du_temps_generation(void) {
+    return generation_edt;
+}
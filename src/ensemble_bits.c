@@ -0,0 +1,170 @@
+/**
+ * @file ensemble_bits.c
+ * @brief Implementation of the growable bitsets
+ */
+
+#include "../include/ensemble_bits.h"
+
+#define BITS_PAR_MOT 64
+
+/**
+ * Initialize an empty set able to hold positions 0 to nb_bits - 1
+ */
+int ensemble_bits_initialiser(EnsembleBits *ensemble, int nb_bits) {
+    memset(ensemble, 0, sizeof(EnsembleBits));
+    return ensemble_bits_agrandir(ensemble, nb_bits);
+}
+
+/**
+ * Grow a set so it can hold positions 0 to nb_bits - 1 (new positions are absent)
+ */
+int ensemble_bits_agrandir(EnsembleBits *ensemble, int nb_bits) {
+    int nb_mots = (nb_bits + BITS_PAR_MOT - 1) / BITS_PAR_MOT;
+    if (nb_mots <= ensemble->nb_mots) {
+        return 1;
+    }
+
+    // Grow geometrically so that adding increasing positions stays amortized O(1)
+    if (nb_mots < ensemble->nb_mots * 2) {
+        nb_mots = ensemble->nb_mots * 2;
+    }
+    unsigned long long *mots = (unsigned long long*)realloc(ensemble->mots, nb_mots * sizeof(unsigned long long));
+    if (mots == NULL) {
+        return 0;
+    }
+    memset(mots + ensemble->nb_mots, 0, (nb_mots - ensemble->nb_mots) * sizeof(unsigned long long));
+    ensemble->mots = mots;
+    ensemble->nb_mots = nb_mots;
+    return 1;
+}
+
+/**
+ * Add a position to a set, growing it if needed
+ */
+int ensemble_bits_ajouter(EnsembleBits *ensemble, int position) {
+    if (position < 0 || !ensemble_bits_agrandir(ensemble, position + 1)) {
+        return 0;
+    }
+    ensemble->mots[position / BITS_PAR_MOT] |= 1ULL << (position % BITS_PAR_MOT);
+    return 1;
+}
+
+/**
+ * Remove a position from a set
+ */
+void ensemble_bits_retirer(EnsembleBits *ensemble, int position) {
+    if (position >= 0 && position / BITS_PAR_MOT < ensemble->nb_mots) {
+        ensemble->mots[position / BITS_PAR_MOT] &= ~(1ULL << (position % BITS_PAR_MOT));
+    }
+}
+
+/**
+ * Check whether a position is in a set
+ */
+int ensemble_bits_contient(const EnsembleBits *ensemble, int position) {
+    if (position < 0 || position / BITS_PAR_MOT >= ensemble->nb_mots) {
+        return 0;
+    }
+    return (ensemble->mots[position / BITS_PAR_MOT] >> (position % BITS_PAR_MOT)) & 1ULL;
+}
+
+/**
+ * Count the positions of a set
+ */
+int ensemble_bits_cardinal(const EnsembleBits *ensemble) {
+    int nb = 0;
+    for (int m = 0; m < ensemble->nb_mots; m++) {
+        nb += __builtin_popcountll(ensemble->mots[m]);
+    }
+    return nb;
+}
+
+/**
+ * Add every position of a set to another
+ */
+int ensemble_bits_union(EnsembleBits *destination, const EnsembleBits *source) {
+    if (!ensemble_bits_agrandir(destination, source->nb_mots * BITS_PAR_MOT)) {
+        return 0;
+    }
+    for (int m = 0; m < source->nb_mots; m++) {
+        destination->mots[m] |= source->mots[m];
+    }
+    return 1;
+}
+
+/**
+ * Check whether two sets share a position
+ */
+int ensemble_bits_intersecte(const EnsembleBits *a, const EnsembleBits *b) {
+    int nb_mots = a->nb_mots < b->nb_mots ? a->nb_mots : b->nb_mots;
+    for (int m = 0; m < nb_mots; m++) {
+        if (a->mots[m] & b->mots[m]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Check whether every position of a set is in another one
+ */
+int ensemble_bits_inclus(const EnsembleBits *a, const EnsembleBits *b) {
+    for (int m = 0; m < a->nb_mots; m++) {
+        unsigned long long mot_b = (m < b->nb_mots) ? b->mots[m] : 0;
+        if (a->mots[m] & ~mot_b) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Find the first position of a set not below a given one
+ */
+int ensemble_bits_suivant(const EnsembleBits *ensemble, int depuis) {
+    if (depuis < 0) {
+        depuis = 0;
+    }
+    int m = depuis / BITS_PAR_MOT;
+    if (m >= ensemble->nb_mots) {
+        return -1;
+    }
+
+    unsigned long long mot = ensemble->mots[m] & (~0ULL << (depuis % BITS_PAR_MOT));
+    while (mot == 0) {
+        if (++m >= ensemble->nb_mots) {
+            return -1;
+        }
+        mot = ensemble->mots[m];
+    }
+    return m * BITS_PAR_MOT + __builtin_ctzll(mot);
+}
+
+/**
+ * Find the first position not in a set
+ */
+int ensemble_bits_premier_absent(const EnsembleBits *ensemble) {
+    for (int m = 0; m < ensemble->nb_mots; m++) {
+        if (~ensemble->mots[m] != 0) {
+            return m * BITS_PAR_MOT + __builtin_ctzll(~ensemble->mots[m]);
+        }
+    }
+    return ensemble->nb_mots * BITS_PAR_MOT;
+}
+
+/**
+ * Remove every position of a set, keeping its memory
+ */
+void ensemble_bits_vider(EnsembleBits *ensemble) {
+    if (ensemble->mots != NULL) {
+        memset(ensemble->mots, 0, ensemble->nb_mots * sizeof(unsigned long long));
+    }
+}
+
+/**
+ * Free memory allocated for a set
+ */
+void ensemble_bits_liberer(EnsembleBits *ensemble) {
+    free(ensemble->mots);
+    memset(ensemble, 0, sizeof(EnsembleBits));
+}
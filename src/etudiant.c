@@ -9,12 +9,16 @@
 
 #define ETUDIANTS_FILE "data/etudiants.txt"
 
+// Incremented whenever the students are (re)loaded or saved
+static unsigned long generation_etudiants = 0;
+
 /**
  * Load students from file into a linked list
  */
 int charger_etudiants(NodeEtudiant** tete) {
     FILE *file;
     *tete = NULL;
+    generation_etudiants++;
     
     create_data_dir();
     
@@ -64,6 +68,8 @@ int charger_etudiants(NodeEtudiant** tete) {
  * Save students from linked list to file
  */
 int sauvegarder_etudiants(NodeEtudiant* tete) {
+    generation_etudiants++;
+    
     FILE *file = fopen(ETUDIANTS_FILE, "w");
     if (file == NULL) {
         printf("Erreur: Impossible d'ouvrir le fichier des étudiants en écriture.\n");
@@ -447,3 +453,10 @@ void liberer_etudiants(NodeEtudiant** tete) {
     
     *tete = NULL;
 }
+
+/**
+ * Get the students modification counter
+ */
+unsigned long etudiants_generation(void) {
+    return generation_etudiants;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file examens.c
+ * @brief Implementation of the exam scheduler
+ */
+
+#include <time.h>
+#include "../include/examens.h"
+#include "../include/ensemble_bits.h"
+#include "../include/index.h"
+
+/**
+ * State of one scheduling
+ */
+typedef struct {
+    PlanningExamens *resultat;
+    int nb_matieres;
+    EnsembleBits *voisins;          // Conflicting subjects of each subject
+    EnsembleBits *couleurs_voisines; // Periods already used by the neighbours of each subject
+    int *saturation;                // Number of distinct periods among the neighbours
+    const Salle **salles;           // Rooms by increasing capacity
+    int nb_salles;
+    long capacite_totale;
+    EnsembleBits *salles_periode;   // Rooms already used in each period
+    int capacite_periodes;
+    int capacite_affectations;
+} ContexteExamens;
+
+// Rooms by increasing capacity
+static int comparer_salles(const void *a, const void *b) {
+    const Salle *sa = *(const Salle* const*)a;
+    const Salle *sb = *(const Salle* const*)b;
+    return sa->capacite - sb->capacite;
+}
+
+// Group the active enrollments by student and link every pair of subjects of a student
+static int construire_graphe(ContexteExamens *ctx, NodeInscription* inscriptions) {
+    PlanningExamens *resultat = ctx->resultat;
+    IndexId matiere_position = {0};
+    IndexId deja_vu = {0};
+    IndexId dernier_gardee = {0};   // Student ID -> their latest enrollment kept
+    int nb = 0;
+    for (NodeInscription *courant = inscriptions; courant != NULL; courant = courant->suivant) nb++;
+
+    int *position = (int*)malloc((nb + 1) * sizeof(int));
+    int *suivant = (int*)malloc((nb + 1) * sizeof(int));
+    resultat->examens = (ExamenPlanifie*)calloc(nb + 1, sizeof(ExamenPlanifie));
+    int ok = position != NULL && suivant != NULL && resultat->examens != NULL;
+
+    // One pass: subject positions, enrollment counts and chains per student
+    int nb_gardees = 0;
+    for (NodeInscription *courant = inscriptions; courant != NULL && ok; courant = courant->suivant) {
+        const Inscription *inscription = &courant->inscription;
+        long long cle = index_cle_composee(inscription->id_etudiant, inscription->id_matiere);
+        int m, tete;
+        if (inscription->statut != 1 || index_id_chercher(&deja_vu, cle, &m)) {
+            continue;
+        }
+        if (!index_id_chercher(&matiere_position, inscription->id_matiere, &m)) {
+            m = ctx->nb_matieres++;
+            resultat->examens[m].id_matiere = inscription->id_matiere;
+            ok = index_id_inserer(&matiere_position, inscription->id_matiere, m);
+        }
+        resultat->examens[m].inscrits++;
+
+        position[nb_gardees] = m;
+        suivant[nb_gardees] = index_id_chercher(&dernier_gardee, inscription->id_etudiant, &tete) ? tete : -1;
+        ok = ok && index_id_inserer(&deja_vu, cle, 1) &&
+             index_id_inserer(&dernier_gardee, inscription->id_etudiant, nb_gardees);
+        nb_gardees++;
+    }
+    resultat->nb_examens = ctx->nb_matieres;
+
+    ctx->voisins = (EnsembleBits*)calloc(ctx->nb_matieres + 1, sizeof(EnsembleBits));
+    ctx->couleurs_voisines = (EnsembleBits*)calloc(ctx->nb_matieres + 1, sizeof(EnsembleBits));
+    ctx->saturation = (int*)calloc(ctx->nb_matieres + 1, sizeof(int));
+    ok = ok && ctx->voisins != NULL && ctx->couleurs_voisines != NULL && ctx->saturation != NULL;
+    for (int m = 0; m < ctx->nb_matieres && ok; m++) {
+        ok = ensemble_bits_initialiser(&ctx->voisins[m], ctx->nb_matieres);
+    }
+
+    for (int i = 0; i < nb_gardees && ok; i++) {
+        // Pair each enrollment with the earlier ones of the same student (chained through suivant)
+        for (int j = suivant[i]; j >= 0; j = suivant[j]) {
+            int a = position[i], b = position[j];
+            if (a != b && !ensemble_bits_contient(&ctx->voisins[a], b)) {
+                ensemble_bits_ajouter(&ctx->voisins[a], b);
+                ensemble_bits_ajouter(&ctx->voisins[b], a);
+                resultat->examens[a].nb_conflits++;
+                resultat->examens[b].nb_conflits++;
+                resultat->nb_aretes++;
+            }
+        }
+    }
+
+    free(position);
+    free(suivant);
+    index_id_liberer(&matiere_position);
+    index_id_liberer(&deja_vu);
+    index_id_liberer(&dernier_gardee);
+    return ok;
+}
+
+// Choose free rooms of a period: the smallest that seats everyone, else the largest ones together
+static int choisir_salles(const ContexteExamens *ctx, const EnsembleBits *utilisees, int inscrits,
+                          int *choix, int *nb_choix) {
+    *nb_choix = 0;
+    for (int s = 0; s < ctx->nb_salles; s++) {
+        if (!ensemble_bits_contient(utilisees, s) && ctx->salles[s]->capacite >= inscrits) {
+            choix[(*nb_choix)++] = s;
+            return 1;
+        }
+    }
+
+    int places = 0;
+    for (int s = ctx->nb_salles - 1; s >= 0 && places < inscrits; s--) {
+        if (!ensemble_bits_contient(utilisees, s)) {
+            choix[(*nb_choix)++] = s;
+            places += ctx->salles[s]->capacite;
+        }
+    }
+    return places >= inscrits;
+}
+
+// Give an exam the first period free of its neighbours with enough rooms left
+static int placer_examen(ContexteExamens *ctx, int m, int *choix) {
+    PlanningExamens *resultat = ctx->resultat;
+    ExamenPlanifie *examen = &resultat->examens[m];
+    int nb_choix = 0;
+    int periode = -1;
+
+    for (int p = 0; p < resultat->nb_periodes; p++) {
+        if (ensemble_bits_contient(&ctx->couleurs_voisines[m], p)) {
+            continue;
+        }
+        if (resultat->capacite_ignoree || choisir_salles(ctx, &ctx->salles_periode[p], examen->inscrits,
+                                                         choix, &nb_choix)) {
+            periode = p;
+            break;
+        }
+    }
+
+    if (periode < 0) {
+        // Open a new period, which can seat anyone the rooms together can
+        if (resultat->nb_periodes == ctx->capacite_periodes) {
+            int capacite = ctx->capacite_periodes ? ctx->capacite_periodes * 2 : 8;
+            EnsembleBits *salles_periode = (EnsembleBits*)realloc(ctx->salles_periode, capacite * sizeof(EnsembleBits));
+            if (salles_periode == NULL) {
+                return 0;
+            }
+            memset(salles_periode + ctx->capacite_periodes, 0,
+                   (capacite - ctx->capacite_periodes) * sizeof(EnsembleBits));
+            ctx->salles_periode = salles_periode;
+            ctx->capacite_periodes = capacite;
+        }
+        periode = resultat->nb_periodes++;
+        if (!resultat->capacite_ignoree) {
+            choisir_salles(ctx, &ctx->salles_periode[periode], examen->inscrits, choix, &nb_choix);
+        }
+    }
+
+    if (resultat->nb_affectations + nb_choix > ctx->capacite_affectations) {
+        int capacite = ctx->capacite_affectations ? ctx->capacite_affectations * 2 : 16;
+        while (capacite < resultat->nb_affectations + nb_choix) capacite *= 2;
+        char (*salles)[MAX_SALLE_LEN] = (char (*)[MAX_SALLE_LEN])realloc(resultat->salles, capacite * MAX_SALLE_LEN);
+        if (salles == NULL) {
+            return 0;
+        }
+        resultat->salles = salles;
+        ctx->capacite_affectations = capacite;
+    }
+
+    examen->periode = periode;
+    examen->premiere_salle = resultat->nb_affectations;
+    examen->nb_salles = nb_choix;
+    for (int k = 0; k < nb_choix; k++) {
+        if (!ensemble_bits_ajouter(&ctx->salles_periode[periode], choix[k])) {
+            return 0;
+        }
+        strcpy(resultat->salles[resultat->nb_affectations++], ctx->salles[choix[k]]->nom);
+    }
+
+    // The neighbours still to place can no longer use this period
+    for (int v = ensemble_bits_suivant(&ctx->voisins[m], 0); v >= 0; v = ensemble_bits_suivant(&ctx->voisins[m], v + 1)) {
+        if (!ensemble_bits_contient(&ctx->couleurs_voisines[v], periode)) {
+            if (!ensemble_bits_ajouter(&ctx->couleurs_voisines[v], periode)) {
+                return 0;
+            }
+            ctx->saturation[v]++;
+        }
+    }
+    return 1;
+}
+
+// DSATUR: place first the subject whose neighbours use the most periods, then the most constrained
+static int colorier(ContexteExamens *ctx) {
+    PlanningExamens *resultat = ctx->resultat;
+    int *choix = (int*)malloc((ctx->nb_salles + 1) * sizeof(int));
+    char *place = (char*)calloc(ctx->nb_matieres + 1, 1);
+    int ok = choix != NULL && place != NULL;
+
+    for (int etape = 0; etape < ctx->nb_matieres && ok; etape++) {
+        int m = -1;
+        for (int i = 0; i < ctx->nb_matieres; i++) {
+            if (place[i]) continue;
+            const ExamenPlanifie *a = &resultat->examens[i];
+            if (m < 0 || ctx->saturation[i] > ctx->saturation[m] ||
+                (ctx->saturation[i] == ctx->saturation[m] &&
+                 (a->nb_conflits > resultat->examens[m].nb_conflits ||
+                  (a->nb_conflits == resultat->examens[m].nb_conflits && a->inscrits > resultat->examens[m].inscrits)))) {
+                m = i;
+            }
+        }
+        place[m] = 1;
+
+        if (!resultat->capacite_ignoree && resultat->examens[m].inscrits > ctx->capacite_totale) {
+            resultat->examens[m].periode = -1;
+            resultat->nb_non_planifies++;
+            continue;
+        }
+        ok = placer_examen(ctx, m, choix);
+    }
+
+    free(choix);
+    free(place);
+    return ok;
+}
+
+// Exams by period (unscheduled last), then by subject
+static int comparer_examens(const void *a, const void *b) {
+    const ExamenPlanifie *ea = (const ExamenPlanifie*)a;
+    const ExamenPlanifie *eb = (const ExamenPlanifie*)b;
+    unsigned pa = (unsigned)ea->periode, pb = (unsigned)eb->periode;
+    if (pa != pb) {
+        return pa < pb ? -1 : 1;
+    }
+    return ea->id_matiere - eb->id_matiere;
+}
+
+/**
+ * Assign every subject with enrolled students to an exam period and rooms
+ */
+int planifier_examens(PlanningExamens *resultat, NodeInscription* inscriptions, NodeSalle* salles) {
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    memset(resultat, 0, sizeof(PlanningExamens));
+
+    ContexteExamens ctx;
+    memset(&ctx, 0, sizeof(ContexteExamens));
+    ctx.resultat = resultat;
+
+    for (NodeSalle *courant = salles; courant != NULL; courant = courant->suivant) ctx.nb_salles++;
+    ctx.salles = (const Salle**)malloc((ctx.nb_salles + 1) * sizeof(Salle*));
+    int ok = ctx.salles != NULL;
+    if (ok) {
+        int s = 0;
+        for (NodeSalle *courant = salles; courant != NULL; courant = courant->suivant) {
+            ctx.salles[s++] = &courant->salle;
+            ctx.capacite_totale += courant->salle.capacite;
+        }
+        qsort(ctx.salles, ctx.nb_salles, sizeof(Salle*), comparer_salles);
+    }
+    resultat->capacite_ignoree = ctx.nb_salles == 0;
+
+    ok = ok && construire_graphe(&ctx, inscriptions) && colorier(&ctx);
+    if (ok && resultat->nb_examens > 1) {
+        qsort(resultat->examens, resultat->nb_examens, sizeof(ExamenPlanifie), comparer_examens);
+    }
+
+    if (ctx.voisins != NULL) {
+        for (int m = 0; m < ctx.nb_matieres; m++) {
+            ensemble_bits_liberer(&ctx.voisins[m]);
+            ensemble_bits_liberer(&ctx.couleurs_voisines[m]);
+        }
+    }
+    for (int p = 0; p < ctx.capacite_periodes; p++) {
+        ensemble_bits_liberer(&ctx.salles_periode[p]);
+    }
+    free(ctx.voisins);
+    free(ctx.couleurs_voisines);
+    free(ctx.saturation);
+    free(ctx.salles_periode);
+    free(ctx.salles);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        liberer_planning_examens(resultat);
+        return 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    resultat->duree_ms = (fin.tv_sec - debut.tv_sec) * 1000.0 + (fin.tv_nsec - debut.tv_nsec) / 1000000.0;
+    return 1;
+}
+
+/**
+ * Display an exam schedule period by period
+ */
+void afficher_planning_examens(const PlanningExamens *planning, NodeMatiere* matieres, int periodes_par_jour) {
+    if (planning->nb_examens == 0) {
+        printf("Aucune inscription active: aucun examen à planifier.\n");
+        return;
+    }
+    if (periodes_par_jour < 1) {
+        periodes_par_jour = 1;
+    }
+
+    printf("\n=== Planning des Examens ===\n");
+    int periode = -2;
+    for (int e = 0; e < planning->nb_examens; e++) {
+        const ExamenPlanifie *examen = &planning->examens[e];
+        if (examen->periode != periode) {
+            periode = examen->periode;
+            if (periode < 0) {
+                printf("\nNon planifiés (aucune combinaison de salles assez grande):\n");
+            } else {
+                printf("\nJour %d, période %d:\n", periode / periodes_par_jour + 1, periode % periodes_par_jour + 1);
+            }
+        }
+
+        NodeMatiere *matiere = trouver_matiere_par_id(matieres, examen->id_matiere);
+        printf("  - %-25s %3d étudiant(s)", matiere != NULL ? matiere->matiere.nom_matiere : "Inconnue",
+               examen->inscrits);
+        if (examen->nb_salles > 0) {
+            printf(" | Salle(s): ");
+            for (int s = 0; s < examen->nb_salles; s++) {
+                printf("%s%s", s > 0 ? ", " : "", planning->salles[examen->premiere_salle + s]);
+            }
+        }
+        printf("\n");
+    }
+
+    int nb_jours = (planning->nb_periodes + periodes_par_jour - 1) / periodes_par_jour;
+    printf("\n%d examen(s) en %d période(s) sur %d jour(s), %d paire(s) de matières en conflit, "
+           "calculé en %.2f ms.\n",
+           planning->nb_examens - planning->nb_non_planifies, planning->nb_periodes, nb_jours,
+           planning->nb_aretes, planning->duree_ms);
+    if (planning->capacite_ignoree) {
+        printf("Attention: aucune salle n'est enregistrée, les capacités n'ont pas été vérifiées.\n");
+    }
+    if (planning->nb_non_planifies > 0) {
+        printf("Attention: %d examen(s) n'ont pas pu être planifiés.\n", planning->nb_non_planifies);
+    }
+}
+
+/**
+ * Free memory allocated for an exam schedule
+ */
+void liberer_planning_examens(PlanningExamens *planning) {
+    free(planning->examens);
+    free(planning->salles);
+    memset(planning, 0, sizeof(PlanningExamens));
+}
@@ -0,0 +1,244 @@
+/**
+ * @file fil_annonces.c
+ * @brief Implementation of the announcement feed
+ */
+
+#include "../include/fil_annonces.h"
+#include "../include/index.h"
+#include <limits.h>
+
+/**
+ * Announcements sorted newest first, chained by subject (0 for general ones)
+ */
+static struct {
+    NodeAnnonce **annonces;
+    int *suivant_matiere; // Next (older) announcement of the same subject, -1 at the end
+    int nb;
+    int capacite;
+    IndexId tete_matiere; // Newest announcement of each subject
+    NodeAnnonce *liste;
+    unsigned long generation;
+    int construit;
+} catalogue;
+
+static FilAnnonces fil;
+
+// Rebuild the sorted announcements and their subject chains if the list changed
+static int actualiser_catalogue(NodeAnnonce* annonces) {
+    if (catalogue.construit && catalogue.liste == annonces && catalogue.generation == annonces_generation()) {
+        return 1;
+    }
+
+    // Announcements newest first, from the time index of the list
+    NodeAnnonce* const *tri;
+    int nb = annonces_recentes(annonces, INT_MAX, &tri);
+    if (nb > 0 && tri == NULL) {
+        return 0;
+    }
+
+    if (nb > catalogue.capacite) {
+        NodeAnnonce **tableau = (NodeAnnonce**)realloc(catalogue.annonces, nb * sizeof(NodeAnnonce*));
+        if (tableau != NULL) catalogue.annonces = tableau;
+        int *suivant = (int*)realloc(catalogue.suivant_matiere, nb * sizeof(int));
+        if (suivant != NULL) catalogue.suivant_matiere = suivant;
+        if (tableau == NULL || suivant == NULL) {
+            return 0;
+        }
+        catalogue.capacite = nb;
+    }
+
+    // Chain from the oldest so that each subject's head is its newest announcement
+    catalogue.construit = 0;
+    index_id_vider(&catalogue.tete_matiere);
+    for (int pos = nb - 1; pos >= 0; pos--) {
+        int id_matiere = tri[pos]->annonce.id_matiere;
+        int tete;
+        catalogue.annonces[pos] = tri[pos];
+        catalogue.suivant_matiere[pos] = index_id_chercher(&catalogue.tete_matiere, id_matiere, &tete) ? tete : -1;
+        if (!index_id_inserer(&catalogue.tete_matiere, id_matiere, pos)) {
+            return 0;
+        }
+    }
+
+    catalogue.nb = nb;
+    catalogue.liste = annonces;
+    catalogue.generation = annonces_generation();
+    catalogue.construit = 1;
+    return 1;
+}
+
+// Push a catalogue position on a min-heap (smaller position means newer announcement)
+static void tas_pousser(int *tas, int *taille, int pos) {
+    int i = (*taille)++;
+    while (i > 0 && tas[(i - 1) / 2] > pos) {
+        tas[i] = tas[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    tas[i] = pos;
+}
+
+// Pop the smallest position of a min-heap
+static int tas_extraire(int *tas, int *taille) {
+    int racine = tas[0];
+    int dernier = tas[--(*taille)];
+    int i = 0;
+    while (2 * i + 1 < *taille) {
+        int enfant = 2 * i + 1;
+        if (enfant + 1 < *taille && tas[enfant + 1] < tas[enfant]) {
+            enfant++;
+        }
+        if (tas[enfant] >= dernier) {
+            break;
+        }
+        tas[i] = tas[enfant];
+        i = enfant;
+    }
+    tas[i] = dernier;
+    return racine;
+}
+
+// Order subject IDs
+static int comparer_ids(const void *a, const void *b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+/**
+ * Build the feed of a student: general announcements and those of their active enrollments
+ */
+const FilAnnonces* fil_annonces_etudiant(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions) {
+    if (!actualiser_catalogue(annonces)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+
+    // Subjects to merge: general announcements, then each enrolled subject once
+    int *inscrites;
+    int nb_inscrites = matieres_inscrites_etudiant(inscriptions, id_etudiant, &inscrites);
+    if (nb_inscrites < 0) {
+        return NULL;
+    }
+    int nb_matieres = nb_inscrites + 1;
+    int *matieres = (int*)malloc(2 * nb_matieres * sizeof(int));
+    if (matieres == NULL) {
+        free(inscrites);
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+    int *tas = matieres + nb_matieres;
+
+    matieres[0] = 0;
+    for (int k = 0; k < nb_inscrites; k++) {
+        matieres[k + 1] = inscrites[k];
+    }
+    free(inscrites);
+    qsort(matieres, nb_matieres, sizeof(int), comparer_ids);
+
+    // One heap entry per subject chain: its newest announcement not yet taken
+    int taille_tas = 0;
+    int nb_annonces = 0;
+    int pos;
+    for (int k = 0; k < nb_matieres; k++) {
+        if (k > 0 && matieres[k] == matieres[k - 1]) {
+            continue;
+        }
+        if (index_id_chercher(&catalogue.tete_matiere, matieres[k], &pos)) {
+            tas_pousser(tas, &taille_tas, pos);
+            for (int p = pos; p >= 0; p = catalogue.suivant_matiere[p]) {
+                nb_annonces++;
+            }
+        }
+    }
+
+    if (nb_annonces > fil.capacite) {
+        NodeAnnonce **tableau = (NodeAnnonce**)realloc(fil.annonces, nb_annonces * sizeof(NodeAnnonce*));
+        if (tableau == NULL) {
+            free(matieres);
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            return NULL;
+        }
+        fil.annonces = tableau;
+        fil.capacite = nb_annonces;
+    }
+
+    // k-way merge: positions are in feed order, so the smallest head is the next announcement
+    fil.id_etudiant = id_etudiant;
+    fil.nb_annonces = 0;
+    while (taille_tas > 0) {
+        pos = tas_extraire(tas, &taille_tas);
+        fil.annonces[fil.nb_annonces++] = catalogue.annonces[pos];
+        if (catalogue.suivant_matiere[pos] >= 0) {
+            tas_pousser(tas, &taille_tas, catalogue.suivant_matiere[pos]);
+        }
+    }
+
+    free(matieres);
+    return &fil;
+}
+
+/**
+ * Fingerprint of the subjects a student actively follows (independent of their order)
+ */
+unsigned long long signature_abonnements(int id_etudiant, NodeInscription* inscriptions) {
+    int *inscrites;
+    int nb_inscrites = matieres_inscrites_etudiant(inscriptions, id_etudiant, &inscrites);
+    if (nb_inscrites < 0) {
+        return 0;
+    }
+
+    // Sum of mixed IDs: the index order follows the list, the signature must not
+    unsigned long long signature = 0x9E3779B97F4A7C15ULL;
+    for (int k = 0; k < nb_inscrites; k++) {
+        unsigned long long x = (unsigned long long)inscrites[k] + 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        signature += x ^ (x >> 31);
+    }
+    free(inscrites);
+    return signature;
+}
+
+/**
+ * Display a feed
+ */
+void afficher_fil_annonces(const FilAnnonces *fil, NodeMatiere* matieres) {
+    if (fil == NULL) {
+        return;
+    }
+    if (fil->nb_annonces == 0) {
+        printf("Aucune annonce ne concerne vos matières.\n");
+        return;
+    }
+
+    for (int i = 0; i < fil->nb_annonces; i++) {
+        const NodeAnnonce *annonce = fil->annonces[i];
+        printf("=== Annonce #%d ===\n", annonce->annonce.id);
+        printf("Titre: %s\n", annonce_titre(annonce));
+        printf("Date: %s\n", date_annonce_to_string(annonce->annonce.date_creation));
+        printf("Auteur: %s\n", annonce_auteur(annonce));
+        if (annonce->annonce.id_matiere > 0) {
+            NodeMatiere *matiere = trouver_matiere_par_id(matieres, annonce->annonce.id_matiere);
+            if (matiere != NULL) {
+                printf("Matière: %s\n", matiere->matiere.nom_matiere);
+            } else {
+                printf("Matière ID: %d\n", annonce->annonce.id_matiere);
+            }
+        } else {
+            printf("Matière: Générale\n");
+        }
+        printf("Contenu:\n%s\n", annonce_contenu(annonce));
+        printf("------------------------\n\n");
+    }
+}
+
+/**
+ * Free the indexes and the feed
+ */
+void liberer_fil_annonces(void) {
+    free(catalogue.annonces);
+    free(catalogue.suivant_matiere);
+    index_id_liberer(&catalogue.tete_matiere);
+    memset(&catalogue, 0, sizeof(catalogue));
+
+    free(fil.annonces);
+    memset(&fil, 0, sizeof(fil));
+}
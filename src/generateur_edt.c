@@ -0,0 +1,663 @@
+/**
+ * @file generateur_edt.c
+ * @brief Implementation of the constraint-solving timetable generator
+ */
+
+#include <time.h>
+#include <pthread.h>
+#include "../include/generateur_edt.h"
+#include "../include/disponibilites.h"
+#include "../include/parallele.h"
+
+// Soft preference penalties
+#define PENALITE_DERNIER_CRENEAU 1   // Last slot of the day
+#define PENALITE_MEME_JOUR 5         // Same subject twice the same day for a section
+#define PENALITE_CHARGE_ENSEIGNANT 3 // Third session (or more) of a teacher the same day
+#define PENALITE_CRENEAU_EVITE 4     // Slot the teacher would rather avoid
+
+#define NOEUDS_ENTRE_CONTROLES 1024
+#define NOEUDS_PAR_RELANCE 512 // Node budget unit of a randomized run (times the Luby sequence)
+
+/**
+ * Shared state of a portfolio search
+ */
+typedef struct {
+    const ProblemeEdt *probleme;
+    pthread_mutex_t verrou;
+    int *meilleur_creneau;
+    int *meilleure_salle;
+    int meilleur_nb;
+    int meilleure_penalite;
+    int borne_penalite;
+    int arret;   // Set when the lower bound is reached
+    int echec;   // Set when a thread runs out of memory
+    long noeuds;
+    SuiviScore *suivi;
+    struct timespec debut;
+} Portfolio;
+
+/**
+ * State of a search
+ */
+typedef struct {
+    const ProblemeEdt *probleme;
+    Disponibilites dispo;            // Teachers, sections and rooms keyed by dense index
+    int (*ressources)[NB_TYPES_RESSOURCES]; // Per session: teacher and section handles, no room
+    unsigned char *charge_enseignant; // [enseignant * nb_jours + jour]
+    unsigned char *charge_groupe;     // [(section, matiere) group * nb_jours + jour]
+    int *groupe;                      // Per session
+    int *creneau;
+    int *salle;
+    int nb_placees;
+    int penalite;
+    int *meilleur_creneau;
+    int *meilleure_salle;
+    int meilleur_nb;
+    int meilleure_penalite;
+    long noeuds;
+    int expire;                       // Time budget spent or portfolio stopped
+    int coupe;                        // Node budget of the current run spent
+    long limite_noeuds;               // Node budget of the current run, 0 for none
+    long noeuds_relance;
+    unsigned int aleatoire;           // Random state, 0 for a deterministic search
+    int bruit;                        // Random noise added to slot penalties when ordering
+    Portfolio *portfolio;             // NULL for a single search
+    struct timespec debut;
+} Recherche;
+
+// Milliseconds elapsed since a start time
+static double duree_depuis(const struct timespec *debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) * 1000.0 + (fin.tv_nsec - debut->tv_nsec) / 1000000.0;
+}
+
+// Next number of a xorshift generator (state never 0)
+static unsigned int tirage(unsigned int *etat) {
+    unsigned int x = *etat;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *etat = x;
+    return x;
+}
+
+// Luby sequence 1 1 2 1 1 2 4 ..., used to grow the node budget of restarts
+static long luby(int i) {
+    int k = 1;
+    while ((1L << k) - 1 < i) {
+        k++;
+    }
+    if ((1L << k) - 1 == i) {
+        return 1L << (k - 1);
+    }
+    return luby(i - (1 << (k - 1)) + 1);
+}
+
+// Read the stop flag of a portfolio
+static int portfolio_arrete(Portfolio *portfolio) {
+    pthread_mutex_lock(&portfolio->verrou);
+    int arret = portfolio->arret;
+    pthread_mutex_unlock(&portfolio->verrou);
+    return arret;
+}
+
+/**
+ * Initialize an empty problem
+ */
+int initialiser_probleme_edt(ProblemeEdt *probleme, int nb_jours, int nb_creneaux_jour,
+                             int nb_salles, int nb_sections) {
+    memset(probleme, 0, sizeof(ProblemeEdt));
+
+    if (nb_jours <= 0 || nb_creneaux_jour <= 0 || nb_jours * nb_creneaux_jour > MAX_CRENEAUX_SEMAINE) {
+        printf("Erreur: La semaine doit compter entre 1 et %d créneaux.\n", MAX_CRENEAUX_SEMAINE);
+        return 0;
+    }
+
+    probleme->nb_jours = nb_jours;
+    probleme->nb_creneaux_jour = nb_creneaux_jour;
+    probleme->nb_salles = nb_salles;
+    probleme->nb_sections = nb_sections;
+    probleme->budget_ms = BUDGET_GENERATION_MS;
+    return index_id_initialiser(&probleme->index_enseignants, 16);
+}
+
+/**
+ * Add a session to place
+ */
+int ajouter_seance_probleme(ProblemeEdt *probleme, int id_matiere, int id_enseignant, int section) {
+    if (section < 0 || section >= probleme->nb_sections) {
+        return 0;
+    }
+
+    if (probleme->nb_seances == probleme->capacite_seances) {
+        int capacite = probleme->capacite_seances ? probleme->capacite_seances * 2 : 32;
+        SeanceAPlacer *seances = (SeanceAPlacer*)realloc(probleme->seances, capacite * sizeof(SeanceAPlacer));
+        if (seances == NULL) {
+            return 0;
+        }
+        probleme->seances = seances;
+        probleme->capacite_seances = capacite;
+    }
+
+    int enseignant;
+    if (!index_id_chercher(&probleme->index_enseignants, id_enseignant, &enseignant)) {
+        enseignant = probleme->nb_enseignants;
+        if (probleme->creneaux_a_eviter != NULL) {
+            MasqueCreneaux *masques = (MasqueCreneaux*)realloc(probleme->creneaux_a_eviter,
+                                                                (enseignant + 1) * sizeof(MasqueCreneaux));
+            if (masques == NULL) {
+                return 0;
+            }
+            masques[enseignant] = 0;
+            probleme->creneaux_a_eviter = masques;
+        }
+        if (!index_id_inserer(&probleme->index_enseignants, id_enseignant, enseignant)) {
+            return 0;
+        }
+        probleme->nb_enseignants++;
+    }
+
+    SeanceAPlacer *seance = &probleme->seances[probleme->nb_seances++];
+    seance->id_matiere = id_matiere;
+    seance->id_enseignant = id_enseignant;
+    seance->enseignant = enseignant;
+    seance->section = section;
+    return 1;
+}
+
+/**
+ * Mark slots a teacher would rather not teach
+ */
+int eviter_creneaux_enseignant(ProblemeEdt *probleme, int id_enseignant, MasqueCreneaux creneaux) {
+    int enseignant;
+    if (!index_id_chercher(&probleme->index_enseignants, id_enseignant, &enseignant)) {
+        return 0;
+    }
+
+    if (probleme->creneaux_a_eviter == NULL) {
+        probleme->creneaux_a_eviter = (MasqueCreneaux*)calloc(probleme->nb_enseignants, sizeof(MasqueCreneaux));
+        if (probleme->creneaux_a_eviter == NULL) {
+            return 0;
+        }
+    }
+
+    probleme->creneaux_a_eviter[enseignant] |= creneaux;
+    return 1;
+}
+
+/**
+ * Free memory allocated for a problem
+ */
+void liberer_probleme_edt(ProblemeEdt *probleme) {
+    free(probleme->seances);
+    free(probleme->creneaux_a_eviter);
+    index_id_liberer(&probleme->index_enseignants);
+    memset(probleme, 0, sizeof(ProblemeEdt));
+}
+
+// Slots where a session could go: teacher, section and at least one room free
+static MasqueCreneaux creneaux_candidats(const Recherche *r, int s) {
+    MasqueCreneaux salles_pleines = r->dispo.semaine;
+    for (int k = 0; k < r->probleme->nb_salles; k++) {
+        salles_pleines &= occupation_ressource(&r->dispo, RESSOURCE_SALLE, k);
+    }
+
+    return creneaux_libres_communs(&r->dispo, r->ressources[s]) & ~salles_pleines;
+}
+
+// Soft penalty of placing a session on a slot
+static int penalite_placement(const Recherche *r, int s, int c) {
+    const ProblemeEdt *p = r->probleme;
+    const SeanceAPlacer *seance = &p->seances[s];
+    int jour = c / p->nb_creneaux_jour;
+    int heure = c % p->nb_creneaux_jour;
+    int penalite = 0;
+
+    if (heure == p->nb_creneaux_jour - 1 && p->nb_creneaux_jour > 1) {
+        penalite += PENALITE_DERNIER_CRENEAU;
+    }
+    if (r->charge_groupe[r->groupe[s] * p->nb_jours + jour] > 0) {
+        penalite += PENALITE_MEME_JOUR;
+    }
+    if (r->charge_enseignant[seance->enseignant * p->nb_jours + jour] >= 2) {
+        penalite += PENALITE_CHARGE_ENSEIGNANT;
+    }
+    if (p->creneaux_a_eviter != NULL && (p->creneaux_a_eviter[seance->enseignant] >> c & 1ULL)) {
+        penalite += PENALITE_CRENEAU_EVITE;
+    }
+
+    return penalite;
+}
+
+// Place or remove a session, keeping every bitset and counter in sync
+static void affecter(Recherche *r, int s, int c, int salle, int penalite, int ajout) {
+    const ProblemeEdt *p = r->probleme;
+    const SeanceAPlacer *seance = &p->seances[s];
+    int jour = c / p->nb_creneaux_jour;
+
+    int handles[NB_TYPES_RESSOURCES];
+    memcpy(handles, r->ressources[s], sizeof(handles));
+    handles[RESSOURCE_SALLE] = salle;
+
+    if (ajout) {
+        reserver_creneau(&r->dispo, handles, c);
+        r->charge_enseignant[seance->enseignant * p->nb_jours + jour]++;
+        r->charge_groupe[r->groupe[s] * p->nb_jours + jour]++;
+        r->creneau[s] = c;
+        r->salle[s] = salle;
+        r->nb_placees++;
+        r->penalite += penalite;
+    } else {
+        annuler_creneau(&r->dispo, handles, c);
+        r->charge_enseignant[seance->enseignant * p->nb_jours + jour]--;
+        r->charge_groupe[r->groupe[s] * p->nb_jours + jour]--;
+        r->creneau[s] = -1;
+        r->salle[s] = -1;
+        r->nb_placees--;
+        r->penalite -= penalite;
+    }
+}
+
+// Keep a copy of the largest placement found so far
+static void memoriser_meilleure(Recherche *r) {
+    if (r->nb_placees > r->meilleur_nb ||
+        (r->nb_placees == r->meilleur_nb && r->penalite < r->meilleure_penalite)) {
+        memcpy(r->meilleur_creneau, r->creneau, r->probleme->nb_seances * sizeof(int));
+        memcpy(r->meilleure_salle, r->salle, r->probleme->nb_seances * sizeof(int));
+        r->meilleur_nb = r->nb_placees;
+        r->meilleure_penalite = r->penalite;
+    }
+}
+
+// Backtracking: most constrained session first, cheapest slots first
+static int placer(Recherche *r) {
+    const ProblemeEdt *p = r->probleme;
+
+    if (r->nb_placees == p->nb_seances) {
+        return 1;
+    }
+
+    if (++r->noeuds % NOEUDS_ENTRE_CONTROLES == 0 &&
+        (duree_depuis(&r->debut) > p->budget_ms || (r->portfolio != NULL && portfolio_arrete(r->portfolio)))) {
+        r->expire = 1;
+    }
+    if (r->limite_noeuds > 0 && ++r->noeuds_relance > r->limite_noeuds) {
+        r->coupe = 1;
+    }
+    if (r->expire || r->coupe) {
+        return 0;
+    }
+
+    // Pick the unplaced session with the fewest candidate slots
+    int choisie = -1;
+    int min_candidats = MAX_CRENEAUX_SEMAINE + 1;
+    MasqueCreneaux candidats = 0;
+    for (int s = 0; s < p->nb_seances; s++) {
+        if (r->creneau[s] >= 0) {
+            continue;
+        }
+        MasqueCreneaux masque = creneaux_candidats(r, s);
+        int nb = __builtin_popcountll(masque);
+        // Randomized searches break ties between equally constrained sessions at random
+        if (nb < min_candidats || (nb == min_candidats && r->aleatoire != 0 && (tirage(&r->aleatoire) & 1))) {
+            min_candidats = nb;
+            choisie = s;
+            candidats = masque;
+            if (nb == 0) {
+                return 0; // Dead end
+            }
+        }
+    }
+
+    // Order the candidate slots by soft penalty, plus noise if randomized (insertion sort, at most 64 slots)
+    int ordre[MAX_CRENEAUX_SEMAINE];
+    int penalites[MAX_CRENEAUX_SEMAINE];
+    int cles[MAX_CRENEAUX_SEMAINE];
+    int nb = 0;
+    while (candidats) {
+        int c = __builtin_ctzll(candidats);
+        candidats &= candidats - 1;
+
+        int penalite = penalite_placement(r, choisie, c);
+        int cle = penalite + (r->bruit > 0 ? (int)(tirage(&r->aleatoire) % (unsigned int)(r->bruit + 1)) : 0);
+        int k = nb++;
+        while (k > 0 && cles[k - 1] > cle) {
+            ordre[k] = ordre[k - 1];
+            penalites[k] = penalites[k - 1];
+            cles[k] = cles[k - 1];
+            k--;
+        }
+        ordre[k] = c;
+        penalites[k] = penalite;
+        cles[k] = cle;
+    }
+
+    for (int k = 0; k < nb; k++) {
+        int c = ordre[k];
+        int salle = 0;
+        while (occupation_ressource(&r->dispo, RESSOURCE_SALLE, salle) >> c & 1ULL) {
+            salle++;
+        }
+
+        affecter(r, choisie, c, salle, penalites[k], 1);
+        memoriser_meilleure(r);
+        if (placer(r)) {
+            return 1;
+        }
+        affecter(r, choisie, c, salle, penalites[k], 0);
+
+        if (r->expire || r->coupe) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
+
+// Free the arrays of a search
+static void liberer_recherche(Recherche *r) {
+    liberer_disponibilites(&r->dispo);
+    free(r->ressources);
+    free(r->charge_enseignant);
+    free(r->charge_groupe);
+    free(r->groupe);
+    free(r->creneau);
+    free(r->salle);
+    free(r->meilleur_creneau);
+    free(r->meilleure_salle);
+    memset(r, 0, sizeof(Recherche));
+}
+
+// Allocate the arrays of a search and group the sessions
+static int initialiser_recherche(Recherche *r, const ProblemeEdt *probleme) {
+    memset(r, 0, sizeof(Recherche));
+    r->probleme = probleme;
+
+    int n = probleme->nb_seances;
+    r->ressources = (int (*)[NB_TYPES_RESSOURCES])malloc((n + 1) * sizeof(*r->ressources));
+    r->charge_enseignant = (unsigned char*)calloc((size_t)(probleme->nb_enseignants + 1) * probleme->nb_jours, 1);
+    r->charge_groupe = (unsigned char*)calloc((size_t)(n + 1) * probleme->nb_jours, 1);
+    r->groupe = (int*)malloc((n + 1) * sizeof(int));
+    r->creneau = (int*)malloc((n + 1) * sizeof(int));
+    r->salle = (int*)malloc((n + 1) * sizeof(int));
+    r->meilleur_creneau = (int*)malloc((n + 1) * sizeof(int));
+    r->meilleure_salle = (int*)malloc((n + 1) * sizeof(int));
+
+    IndexId index_groupes = {0};
+    int ok = initialiser_disponibilites(&r->dispo, probleme->nb_jours, probleme->nb_creneaux_jour) &&
+             r->ressources != NULL && r->charge_enseignant != NULL && r->charge_groupe != NULL &&
+             r->groupe != NULL && r->creneau != NULL && r->salle != NULL && r->meilleur_creneau != NULL &&
+             r->meilleure_salle != NULL && index_id_initialiser(&index_groupes, n);
+
+    // Dense indexes are registered in order, so each handle equals its index
+    for (int k = 0; ok && k < probleme->nb_enseignants; k++) {
+        ok = ressource_disponibilites(&r->dispo, RESSOURCE_ENSEIGNANT, k) == k;
+    }
+    for (int k = 0; ok && k < probleme->nb_sections; k++) {
+        ok = ressource_disponibilites(&r->dispo, RESSOURCE_SECTION, k) == k;
+    }
+    for (int k = 0; ok && k < probleme->nb_salles; k++) {
+        ok = ressource_disponibilites(&r->dispo, RESSOURCE_SALLE, k) == k;
+    }
+
+    // Sessions of the same subject for the same section form a group
+    int nb_groupes = 0;
+    for (int s = 0; ok && s < n; s++) {
+        long long cle = index_cle_composee(probleme->seances[s].section, probleme->seances[s].id_matiere);
+        if (!index_id_chercher(&index_groupes, cle, &r->groupe[s])) {
+            r->groupe[s] = nb_groupes++;
+            ok = index_id_inserer(&index_groupes, cle, r->groupe[s]);
+        }
+        r->ressources[s][RESSOURCE_ENSEIGNANT] = probleme->seances[s].enseignant;
+        r->ressources[s][RESSOURCE_SALLE] = -1;
+        r->ressources[s][RESSOURCE_SECTION] = probleme->seances[s].section;
+        r->creneau[s] = -1;
+        r->salle[s] = -1;
+        r->meilleur_creneau[s] = -1;
+        r->meilleure_salle[s] = -1;
+    }
+    index_id_liberer(&index_groupes);
+
+    if (!ok) {
+        liberer_recherche(r);
+    }
+    return ok;
+}
+
+// Remove every placement before a new run, keeping the best one found
+static void recommencer(Recherche *r) {
+    const ProblemeEdt *p = r->probleme;
+    for (int t = 0; t < NB_TYPES_RESSOURCES; t++) {
+        memset(r->dispo.tables[t].occupe, 0, r->dispo.tables[t].nb * sizeof(MasqueCreneaux));
+    }
+    memset(r->charge_enseignant, 0, (size_t)(p->nb_enseignants + 1) * p->nb_jours);
+    memset(r->charge_groupe, 0, (size_t)(p->nb_seances + 1) * p->nb_jours);
+    for (int s = 0; s < p->nb_seances; s++) {
+        r->creneau[s] = -1;
+        r->salle[s] = -1;
+    }
+    r->nb_placees = 0;
+    r->penalite = 0;
+    r->coupe = 0;
+    r->noeuds_relance = 0;
+}
+
+// Copy the best placement of a search into a solution
+static void remplir_solution(const Recherche *r, SolutionEdt *solution) {
+    solution->creneau = r->meilleur_creneau;
+    solution->salle = r->meilleure_salle;
+    solution->nb_seances = r->probleme->nb_seances;
+    solution->nb_placees = r->meilleur_nb;
+    solution->penalite = r->meilleure_penalite;
+    solution->complete = (r->meilleur_nb == r->probleme->nb_seances);
+    solution->noeuds = r->noeuds;
+}
+
+/**
+ * Place the sessions of a problem
+ */
+int resoudre_edt(const ProblemeEdt *probleme, SolutionEdt *solution) {
+    memset(solution, 0, sizeof(SolutionEdt));
+
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    Recherche r;
+    if (!initialiser_recherche(&r, probleme)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+    r.debut = debut;
+
+    if (probleme->nb_salles > 0 && placer(&r)) {
+        memoriser_meilleure(&r);
+    }
+
+    // The solution takes over the best placement arrays
+    remplir_solution(&r, solution);
+    r.meilleur_creneau = NULL;
+    r.meilleure_salle = NULL;
+    liberer_recherche(&r);
+
+    solution->nb_threads = 1;
+    solution->duree_ms = duree_depuis(&debut);
+    return solution->complete;
+}
+
+// Penalty no placement can avoid: more sessions of a group than days,
+// more sessions of a section than early slots, more than two sessions
+// per day for a teacher
+static int borne_penalite(const ProblemeEdt *p) {
+    int *par_section = (int*)calloc(p->nb_sections + 1, sizeof(int));
+    int *par_enseignant = (int*)calloc(p->nb_enseignants + 1, sizeof(int));
+    IndexId groupes = {0};
+    if (par_section == NULL || par_enseignant == NULL || !index_id_initialiser(&groupes, p->nb_seances)) {
+        free(par_section);
+        free(par_enseignant);
+        return 0;
+    }
+
+    int borne = 0;
+    for (int s = 0; s < p->nb_seances; s++) {
+        long long cle = index_cle_composee(p->seances[s].section, p->seances[s].id_matiere);
+        int nb = 0;
+        index_id_chercher(&groupes, cle, &nb);
+        index_id_inserer(&groupes, cle, ++nb);
+        if (nb > p->nb_jours) {
+            borne += PENALITE_MEME_JOUR;
+        }
+        par_section[p->seances[s].section]++;
+        par_enseignant[p->seances[s].enseignant]++;
+    }
+
+    int premiers = p->nb_creneaux_jour > 1 ? p->nb_jours * (p->nb_creneaux_jour - 1) : p->nb_jours;
+    for (int k = 0; k < p->nb_sections; k++) {
+        if (p->nb_creneaux_jour > 1 && par_section[k] > premiers) {
+            borne += (par_section[k] - premiers) * PENALITE_DERNIER_CRENEAU;
+        }
+    }
+    for (int k = 0; k < p->nb_enseignants; k++) {
+        if (par_enseignant[k] > 2 * p->nb_jours) {
+            borne += (par_enseignant[k] - 2 * p->nb_jours) * PENALITE_CHARGE_ENSEIGNANT;
+        }
+    }
+
+    free(par_section);
+    free(par_enseignant);
+    index_id_liberer(&groupes);
+    return borne;
+}
+
+// Share the best placement of a search if it beats the portfolio's
+static void publier(Portfolio *portfolio, const Recherche *r, int strategie) {
+    pthread_mutex_lock(&portfolio->verrou);
+    if (r->meilleur_nb > portfolio->meilleur_nb ||
+        (r->meilleur_nb == portfolio->meilleur_nb && r->meilleure_penalite < portfolio->meilleure_penalite)) {
+        int n = portfolio->probleme->nb_seances;
+        memcpy(portfolio->meilleur_creneau, r->meilleur_creneau, n * sizeof(int));
+        memcpy(portfolio->meilleure_salle, r->meilleure_salle, n * sizeof(int));
+        portfolio->meilleur_nb = r->meilleur_nb;
+        portfolio->meilleure_penalite = r->meilleure_penalite;
+
+        SuiviScore *suivi = portfolio->suivi;
+        if (suivi != NULL) {
+            PointSuivi *point = &suivi->points[suivi->nb < MAX_POINTS_SUIVI ? suivi->nb++ : MAX_POINTS_SUIVI - 1];
+            point->temps_ms = duree_depuis(&portfolio->debut);
+            point->nb_placees = r->meilleur_nb;
+            point->penalite = r->meilleure_penalite;
+            point->strategie = strategie;
+        }
+
+        if (portfolio->meilleur_nb == n && portfolio->meilleure_penalite <= portfolio->borne_penalite) {
+            portfolio->arret = 1;
+        }
+    }
+    pthread_mutex_unlock(&portfolio->verrou);
+}
+
+// One strategy of the portfolio: repeated runs until the budget is spent
+static void tache_portfolio(int indice, void *contexte) {
+    Portfolio *portfolio = (Portfolio*)contexte;
+    const ProblemeEdt *p = portfolio->probleme;
+
+    Recherche r;
+    if (!initialiser_recherche(&r, p)) {
+        pthread_mutex_lock(&portfolio->verrou);
+        portfolio->echec = 1;
+        pthread_mutex_unlock(&portfolio->verrou);
+        return;
+    }
+    r.debut = portfolio->debut;
+    r.portfolio = portfolio;
+
+    // Strategy 0 starts with the deterministic search; the others only randomize
+    for (int relance = 0; !r.expire && p->nb_salles > 0; relance++) {
+        int deterministe = (indice == 0 && relance == 0);
+        recommencer(&r);
+        r.aleatoire = deterministe ? 0 : 2654435761u * (unsigned int)(indice + 1) + (unsigned int)relance;
+        r.bruit = deterministe ? 0 : (indice + relance) % 4 * 2;
+        r.limite_noeuds = deterministe ? 0 : NOEUDS_PAR_RELANCE * luby(relance + 1);
+
+        if (placer(&r)) {
+            memoriser_meilleure(&r);
+        }
+        publier(portfolio, &r, indice);
+
+        if (duree_depuis(&r.debut) > p->budget_ms || portfolio_arrete(portfolio)) {
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&portfolio->verrou);
+    portfolio->noeuds += r.noeuds;
+    pthread_mutex_unlock(&portfolio->verrou);
+    liberer_recherche(&r);
+}
+
+/**
+ * Place the sessions of a problem with a portfolio of searches run in parallel
+ */
+int resoudre_edt_portfolio(const ProblemeEdt *probleme, int nb_threads, SolutionEdt *solution, SuiviScore *suivi) {
+    memset(solution, 0, sizeof(SolutionEdt));
+
+    Portfolio portfolio;
+    memset(&portfolio, 0, sizeof(Portfolio));
+    clock_gettime(CLOCK_MONOTONIC, &portfolio.debut);
+    portfolio.probleme = probleme;
+    portfolio.suivi = suivi;
+    portfolio.borne_penalite = borne_penalite(probleme);
+
+    int n = probleme->nb_seances;
+    portfolio.meilleur_creneau = (int*)malloc((n + 1) * sizeof(int));
+    portfolio.meilleure_salle = (int*)malloc((n + 1) * sizeof(int));
+    if (portfolio.meilleur_creneau == NULL || portfolio.meilleure_salle == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        free(portfolio.meilleur_creneau);
+        free(portfolio.meilleure_salle);
+        return -1;
+    }
+    for (int s = 0; s < n; s++) {
+        portfolio.meilleur_creneau[s] = -1;
+        portfolio.meilleure_salle[s] = -1;
+    }
+    if (suivi != NULL) {
+        suivi->nb = 0;
+        suivi->borne_penalite = portfolio.borne_penalite;
+    }
+
+    // One strategy per thread: they all run for the whole budget
+    if (nb_threads <= 0) {
+        nb_threads = nombre_processeurs();
+    }
+    if (nb_threads > MAX_THREADS) {
+        nb_threads = MAX_THREADS;
+    }
+
+    pthread_mutex_init(&portfolio.verrou, NULL);
+    solution->nb_threads = executer_taches_paralleles(nb_threads, nb_threads, tache_portfolio, &portfolio);
+    pthread_mutex_destroy(&portfolio.verrou);
+
+    if (portfolio.echec) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+
+    solution->creneau = portfolio.meilleur_creneau;
+    solution->salle = portfolio.meilleure_salle;
+    solution->nb_seances = n;
+    solution->nb_placees = portfolio.meilleur_nb;
+    solution->penalite = portfolio.meilleure_penalite;
+    solution->complete = (portfolio.meilleur_nb == n);
+    solution->noeuds = portfolio.noeuds;
+    solution->duree_ms = duree_depuis(&portfolio.debut);
+    return solution->complete;
+}
+
+/**
+ * Free memory allocated for a solution
+ */
+void liberer_solution_edt(SolutionEdt *solution) {
+    free(solution->creneau);
+    free(solution->salle);
+    memset(solution, 0, sizeof(SolutionEdt));
+}
@@ -183,7 +183,7 @@ void menu_gestion_annonces_enseignant(NodeAnnonce** annonces, int id_enseignant)
                 pause_screen();
                 break;
             case 4:
-                modifier_annonce(*annonces, id_enseignant);
+                modifier_annonce(annonces, id_enseignant);
                 pause_screen();
                 break;
             case 5:
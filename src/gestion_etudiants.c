@@ -10,6 +10,7 @@
 #include "etudiant.h"
 #include "notes.h"
 #include "inscriptions.h"
+#include "moyennes.h"
 #include "utils.h"
 
 /**
@@ -152,7 +153,8 @@ void afficher_statistiques_etudiants(NodeEtudiant* etudiants, NodeNote* notes) {
 /**
  * Display performance report for a specific student
  */
-void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions) {
+void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeInscription* inscriptions,
+                               NodeMatiere* matieres) {
     int id_etudiant = get_int_input("Entrez l'ID de l'étudiant: ", 1, 9999);
     
     // Find student
@@ -175,21 +177,38 @@ void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeIns
     printf("=== Notes ===\n");
     afficher_notes_par_etudiant(notes, id_etudiant);
     
-    // Calculate average to determine if there are notes
-    float moyenne = calculer_moyenne_etudiant(notes, id_etudiant);
-    if (moyenne > 0) {
+    // Weighted average from the cached engine
+    const MoyenneEtudiant* moyenne = obtenir_moyenne_etudiant(notes, matieres, id_etudiant);
+    if (moyenne != NULL && moyenne->nb_notes > 0) {
+        // Display averages by subject with their coefficient
+        printf("\n=== Moyennes par Matière ===\n");
+        printf("%-10s | %-20s | %-8s | %-6s | %-8s\n", "ID Matière", "Matière", "Moyenne", "Coef.", "Nb. notes");
+        printf("-----------------------------------------------------------------\n");
+        
+        const MoyenneMatiereEtudiant* details = details_moyenne_etudiant(moyenne);
+        for (int i = 0; i < moyenne->nb_matieres; i++) {
+            NodeMatiere* matiere = trouver_matiere_par_id(matieres, details[i].id_matiere);
+            printf("%-10d | %-20s | %-8.2f | %-6.2f | %-8d\n",
+                   details[i].id_matiere,
+                   matiere != NULL ? matiere->matiere.nom_matiere : "(inconnue)",
+                   details[i].moyenne,
+                   details[i].coefficient,
+                   details[i].nb_notes);
+        }
+        
         // Display average
-        printf("\nMoyenne générale: %.2f\n", moyenne);
+        printf("\nMoyenne générale pondérée: %.2f (somme des coefficients: %.2f)\n",
+               moyenne->moyenne_ponderee, moyenne->somme_coefficients);
         
         // Display performance assessment
         printf("\nÉvaluation: ");
-        if (moyenne >= 16) {
+        if (moyenne->moyenne_ponderee >= 16) {
             printf("Très bien\n");
-        } else if (moyenne >= 14) {
+        } else if (moyenne->moyenne_ponderee >= 14) {
             printf("Bien\n");
-        } else if (moyenne >= 12) {
+        } else if (moyenne->moyenne_ponderee >= 12) {
             printf("Assez bien\n");
-        } else if (moyenne >= 10) {
+        } else if (moyenne->moyenne_ponderee >= 10) {
             printf("Passable\n");
         } else {
             printf("Insuffisant\n");
@@ -208,7 +227,7 @@ void afficher_rapport_etudiant(NodeEtudiant* etudiants, NodeNote* notes, NodeIns
             printf("- Cours ID: %d, Date: %s, Statut: %s\n", 
                    inscription->inscription.id_matiere,
                    inscription->inscription.date_inscription,
-                   inscription->inscription.statut == 1 ? "Inscrit" : "Désinscrit");
+                   statut_inscription_to_string(inscription->inscription.statut));
             nb_inscriptions++;
         }
         inscription = inscription->suivant;
@@ -11,6 +11,7 @@
 #include "notes.h"
 #include "inscriptions.h"
 #include "etudiant.h"
+#include "statistiques.h"
 #include "utils.h"
 
 /**
@@ -160,9 +161,9 @@ void calculer_statistiques_matieres(NodeMatiere* matieres, NodeNote* notes, Node
 }
 
 /**
- * Display detailed information about a subject
+ * Display detailed information and grade distribution of a subject
  */
-void afficher_details_matiere(NodeMatiere* matieres, NodeNote* notes, int id_matiere) {
+void afficher_details_matiere(NodeMatiere* matieres, NodeNote* notes, NodeEtudiant* etudiants, int id_matiere) {
     // Find subject
     NodeMatiere* matiere = trouver_matiere_par_id(matieres, id_matiere);
     if (matiere == NULL) {
@@ -177,52 +178,7 @@ void afficher_details_matiere(NodeMatiere* matieres, NodeNote* notes, int id_mat
     printf("Nom: %s\n", matiere->matiere.nom_matiere);
     printf("Coefficient: %.2f\n\n", matiere->matiere.coefficient);
     
-    // Display grade statistics
+    // Display grade statistics, globally and per section
     printf("=== Statistiques des Notes ===\n");
-    
-    // Count grades and calculate statistics
-    int nb_notes = 0;
-    float somme_notes = 0.0f;
-    float note_min = 20.0f;
-    float note_max = 0.0f;
-    
-    NodeNote* note_courant = notes;
-    while (note_courant != NULL) {
-        if (note_courant->note.id_matiere == id_matiere) {
-            nb_notes++;
-            somme_notes += note_courant->note.note;
-            
-            if (note_courant->note.note < note_min) {
-                note_min = note_courant->note.note;
-            }
-            
-            if (note_courant->note.note > note_max) {
-                note_max = note_courant->note.note;
-            }
-        }
-        note_courant = note_courant->suivant;
-    }
-    
-    if (nb_notes > 0) {
-        float moyenne = somme_notes / nb_notes;
-        printf("Nombre de notes: %d\n", nb_notes);
-        printf("Moyenne: %.2f\n", moyenne);
-        printf("Note minimale: %.2f\n", note_min);
-        printf("Note maximale: %.2f\n", note_max);
-        
-        // Count success rate (note >= 10)
-        int nb_reussites = 0;
-        note_courant = notes;
-        while (note_courant != NULL) {
-            if (note_courant->note.id_matiere == id_matiere && note_courant->note.note >= 10.0f) {
-                nb_reussites++;
-            }
-            note_courant = note_courant->suivant;
-        }
-        
-        float taux_reussite = (float)nb_reussites / nb_notes * 100;
-        printf("Taux de réussite: %.1f%% (%d sur %d)\n", taux_reussite, nb_reussites, nb_notes);
-    } else {
-        printf("Aucune note enregistrée pour cette matière.\n");
-    }
-}
\ No newline at end of file
+    afficher_distribution_matiere(notes, etudiants, id_matiere);
+}
@@ -0,0 +1,214 @@
+/**
+ * @file index.c
+ * @brief Implementation of the ID hash index
+ */
+
+#include "../include/index.h"
+
+#define INDEX_CAPACITE_DEFAUT 16
+
+// Mix the bits of a key (splitmix64 finalizer) so that consecutive IDs spread out
+static size_t hacher_cle(long long cle, size_t capacite) {
+    unsigned long long x = (unsigned long long)cle;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (size_t)(x & (capacite - 1));
+}
+
+// Allocate the storage arrays for a given power-of-two capacity
+static int allouer_tables(IndexId *index, size_t capacite) {
+    index->cles = (long long*)malloc(capacite * sizeof(long long));
+    index->valeurs = (int*)malloc(capacite * sizeof(int));
+    index->occupe = (unsigned char*)calloc(capacite, sizeof(unsigned char));
+
+    if (index->cles == NULL || index->valeurs == NULL || index->occupe == NULL) {
+        free(index->cles);
+        free(index->valeurs);
+        free(index->occupe);
+        index->cles = NULL;
+        index->valeurs = NULL;
+        index->occupe = NULL;
+        return 0;
+    }
+
+    index->capacite = capacite;
+    index->taille = 0;
+    return 1;
+}
+
+// Double the capacity and re-insert every entry
+static int agrandir_index(IndexId *index) {
+    IndexId ancien = *index;
+
+    if (!allouer_tables(index, ancien.capacite * 2)) {
+        *index = ancien;
+        return 0;
+    }
+
+    for (size_t i = 0; i < ancien.capacite; i++) {
+        if (ancien.occupe[i]) {
+            index_id_inserer(index, ancien.cles[i], ancien.valeurs[i]);
+        }
+    }
+
+    free(ancien.cles);
+    free(ancien.valeurs);
+    free(ancien.occupe);
+    return 1;
+}
+
+/**
+ * Initialize an empty index
+ */
+int index_id_initialiser(IndexId *index, size_t capacite_initiale) {
+    size_t capacite = INDEX_CAPACITE_DEFAUT;
+
+    // Keep the load factor under 1/2 for the expected number of entries
+    while (capacite < capacite_initiale * 2) {
+        capacite *= 2;
+    }
+
+    return allouer_tables(index, capacite);
+}
+
+/**
+ * Insert a key or update its value
+ */
+int index_id_inserer(IndexId *index, long long cle, int valeur) {
+    if (index->capacite == 0 && !index_id_initialiser(index, 0)) {
+        return 0;
+    }
+
+    // Grow before the table gets more than 3/4 full
+    if ((index->taille + 1) * 4 > index->capacite * 3) {
+        if (!agrandir_index(index)) {
+            return 0;
+        }
+    }
+
+    size_t i = hacher_cle(cle, index->capacite);
+    while (index->occupe[i]) {
+        if (index->cles[i] == cle) {
+            index->valeurs[i] = valeur;
+            return 1;
+        }
+        i = (i + 1) & (index->capacite - 1);
+    }
+
+    index->occupe[i] = 1;
+    index->cles[i] = cle;
+    index->valeurs[i] = valeur;
+    index->taille++;
+    return 1;
+}
+
+/**
+ * Look up a key
+ */
+int index_id_chercher(const IndexId *index, long long cle, int *valeur) {
+    if (index->capacite == 0) {
+        return 0;
+    }
+
+    size_t i = hacher_cle(cle, index->capacite);
+    while (index->occupe[i]) {
+        if (index->cles[i] == cle) {
+            if (valeur != NULL) {
+                *valeur = index->valeurs[i];
+            }
+            return 1;
+        }
+        i = (i + 1) & (index->capacite - 1);
+    }
+
+    return 0; // Not found
+}
+
+/**
+ * Remove a key from the index
+ */
+int index_id_supprimer(IndexId *index, long long cle) {
+    if (index->capacite == 0) {
+        return 0;
+    }
+
+    size_t masque = index->capacite - 1;
+    size_t i = hacher_cle(cle, index->capacite);
+    while (index->occupe[i] && index->cles[i] != cle) {
+        i = (i + 1) & masque;
+    }
+
+    if (!index->occupe[i]) {
+        return 0; // Not found
+    }
+
+    // Backward-shift deletion: move following entries of the probe chain into the hole
+    size_t trou = i;
+    size_t j = i;
+    while (1) {
+        j = (j + 1) & masque;
+        if (!index->occupe[j]) {
+            break;
+        }
+
+        size_t ideal = hacher_cle(index->cles[j], index->capacite);
+        // Entry j may fill the hole only if its ideal slot is not in (trou, j]
+        int dans_intervalle = (trou <= j) ? (ideal > trou && ideal <= j)
+                                          : (ideal > trou || ideal <= j);
+        if (!dans_intervalle) {
+            index->cles[trou] = index->cles[j];
+            index->valeurs[trou] = index->valeurs[j];
+            trou = j;
+        }
+    }
+
+    index->occupe[trou] = 0;
+    index->taille--;
+    return 1;
+}
+
+/**
+ * Remove all entries while keeping the allocated storage
+ */
+void index_id_vider(IndexId *index) {
+    if (index->occupe != NULL) {
+        memset(index->occupe, 0, index->capacite * sizeof(unsigned char));
+    }
+    index->taille = 0;
+}
+
+/**
+ * Free memory allocated for the index
+ */
+void index_id_liberer(IndexId *index) {
+    free(index->cles);
+    free(index->valeurs);
+    free(index->occupe);
+    index->cles = NULL;
+    index->valeurs = NULL;
+    index->occupe = NULL;
+    index->capacite = 0;
+    index->taille = 0;
+}
+
+/**
+ * Build a composite key from two IDs
+ */
+long long index_cle_composee(int a, int b) {
+    return ((long long)a << 32) ^ (long long)(unsigned int)b;
+}
+
+/**
+ * Build a key from a string (64-bit FNV-1a hash)
+ */
+long long index_cle_chaine(const char *chaine) {
+    unsigned long long hash = 1469598103934665603ULL;
+    for (const unsigned char *c = (const unsigned char*)chaine; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    return (long long)hash;
+}
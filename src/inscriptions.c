@@ -6,11 +6,144 @@
 #include "../include/inscriptions.h"
 #include "../include/matiere.h"
 #include "../include/etudiant.h"
+#include "../include/index.h"
+#include "../include/journal_inscriptions.h"
+#include "../include/prerequis.h"
 #include "../include/utils.h"
 #include <time.h>
 
 #define INSCRIPTIONS_FILE "data/inscriptions.txt"
 
+// Incremented whenever the enrollments are (re)loaded or saved
+static unsigned long generation_inscriptions = 0;
+
+/**
+ * Seat counters and waitlist of one subject
+ */
+typedef struct {
+    int id_matiere;
+    int existe;         // The subject is in the subjects list
+    int capacite;       // 0 = unlimited
+    int nb_inscrits;
+    int nb_attente;
+    int tete_attente;   // First and last waitlisted enrollments (positions), -1 if none
+    int queue_attente;
+} PlacesMatiere;
+
+// Index of the enrollments by (student, subject) pair with the seat counters
+// and waitlists of every subject. Rebuilt when the list is reloaded and kept
+// up to date by the enrollment functions of this file.
+static struct {
+    int valide;
+    NodeInscription *liste;
+    unsigned long generation;
+    NodeMatiere *matieres;
+    unsigned long generation_matieres;
+    
+    NodeInscription **noeuds;   // Enrollments by position
+    int *precedent_attente;     // Waitlist chains over the positions
+    int *suivant_attente;
+    int *suivant_etudiant;      // Next enrollment of the same student, -1 at the end
+    int nb;
+    int capacite;
+    IndexId par_couple;         // index_cle_composee(student, subject) -> position
+    IndexId tete_etudiant;      // Student ID -> latest enrollment position
+    
+    PlacesMatiere *places;
+    int nb_places;
+    int capacite_places;
+    IndexId par_matiere;        // Subject ID -> position in places
+    
+    int dernier_id;
+    int dernier_rang;
+} registre;
+
+// Latest state of the (student, subject) pairs missing from the table
+typedef struct {
+    NodeInscription **tete;
+    IndexId couples;
+    int dernier_id;
+    int dernier_rang;
+    int nb_ajouts;
+} Reconciliation;
+
+// Date of an event as stored in the table
+static void dater_depuis_evenement(Inscription *inscription, const EvenementInscription *e) {
+    strftime(inscription->date_inscription, sizeof(inscription->date_inscription), "%d/%m/%Y",
+             localtime(&e->date));
+}
+
+// Recreate in the table a pair that only the log knows
+static int ajouter_depuis_journal(const EvenementInscription *e, void *contexte) {
+    Reconciliation *r = (Reconciliation*)contexte;
+    if (index_id_chercher(&r->couples, index_cle_composee(e->id_etudiant, e->id_matiere), NULL)) {
+        return 1;
+    }
+    
+    NodeInscription *node = (NodeInscription*)malloc(sizeof(NodeInscription));
+    if (node == NULL) {
+        return 0;
+    }
+    node->inscription.id = ++r->dernier_id;
+    node->inscription.id_etudiant = e->id_etudiant;
+    node->inscription.id_matiere = e->id_matiere;
+    node->inscription.statut = e->statut;
+    node->inscription.rang_attente = (e->statut == 2) ? ++r->dernier_rang : 0;
+    dater_depuis_evenement(&node->inscription, e);
+    node->suivant = *r->tete;
+    *r->tete = node;
+    r->nb_ajouts++;
+    return 1;
+}
+
+// Bring the table in line with the latest event of each pair: the log is
+// appended before the table is written, so after a failed save the table lags
+static int reconcilier_journal(NodeInscription** tete) {
+    Reconciliation r = {tete, {0}, 0, 0, 0};
+    int nb_corrections = 0;
+    int ok = 1;
+    
+    for (NodeInscription *courant = *tete; ok && courant != NULL; courant = courant->suivant) {
+        Inscription *inscription = &courant->inscription;
+        if (inscription->id > r.dernier_id) {
+            r.dernier_id = inscription->id;
+        }
+        if (inscription->rang_attente > r.dernier_rang) {
+            r.dernier_rang = inscription->rang_attente;
+        }
+        long long cle = index_cle_composee(inscription->id_etudiant, inscription->id_matiere);
+        if (index_id_chercher(&r.couples, cle, NULL)) {
+            continue;
+        }
+        ok = index_id_inserer(&r.couples, cle, 0);
+    }
+    
+    for (NodeInscription *courant = *tete; ok && courant != NULL; courant = courant->suivant) {
+        Inscription *inscription = &courant->inscription;
+        const EvenementInscription *e = dernier_evenement_inscription(inscription->id_etudiant,
+                                                                      inscription->id_matiere);
+        if (e == NULL || e->statut == inscription->statut) {
+            continue;
+        }
+        inscription->statut = e->statut;
+        inscription->rang_attente = (e->statut == 2) ? ++r.dernier_rang : 0;
+        dater_depuis_evenement(inscription, e);
+        nb_corrections++;
+    }
+    
+    ok = ok && parcourir_etats_inscriptions(ajouter_depuis_journal, &r);
+    index_id_liberer(&r.couples);
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    
+    if (nb_corrections + r.nb_ajouts > 0) {
+        return sauvegarder_inscriptions(*tete);
+    }
+    return 1;
+}
+
 /**
  * Load enrollments from file into a linked list
  */
@@ -35,6 +168,8 @@ int charger_inscriptions(NodeInscription** tete) {
         return 0;
     }
     
+    generation_inscriptions++;
+    
     char line[100]; // Buffer for reading lines
     NodeInscription *dernier = NULL;
     
@@ -47,7 +182,8 @@ int charger_inscriptions(NodeInscription** tete) {
             return 0;
         }
         
-        // Parse the line
+        // Parse the line (id|id_etudiant|id_matiere|date|statut[|rang_attente])
+        nouveau_node->inscription.rang_attente = 0;
         char *token = strtok(line, "|");
         if (token) {
             nouveau_node->inscription.id = atoi(token);
@@ -64,6 +200,9 @@ int charger_inscriptions(NodeInscription** tete) {
             token = strtok(NULL, "|");
             if (token) nouveau_node->inscription.statut = atoi(token);
             
+            token = strtok(NULL, "|");
+            if (token) nouveau_node->inscription.rang_attente = atoi(token);
+            
             // Ensure null termination of strings
             nouveau_node->inscription.date_inscription[sizeof(nouveau_node->inscription.date_inscription) - 1] = '\0';
         }
@@ -81,13 +220,20 @@ int charger_inscriptions(NodeInscription** tete) {
     }
     
     fclose(file);
-    return 1;
+    
+    // The table is the latest state of the enrollment log
+    if (!charger_journal_inscriptions(*tete)) {
+        return 0;
+    }
+    return reconcilier_journal(tete);
 }
 
 /**
  * Save enrollments from linked list to file
  */
 int sauvegarder_inscriptions(NodeInscription* tete) {
+    generation_inscriptions++;
+    
     FILE *file = fopen(INSCRIPTIONS_FILE, "w");
     if (file == NULL) {
         printf("Erreur: Impossible d'ouvrir le fichier des inscriptions en écriture.\n");
@@ -96,12 +242,13 @@ int sauvegarder_inscriptions(NodeInscription* tete) {
     
     NodeInscription* courant = tete;
     while (courant != NULL) {
-        fprintf(file, "%d|%d|%d|%s|%d\n",
+        fprintf(file, "%d|%d|%d|%s|%d|%d\n",
                 courant->inscription.id,
                 courant->inscription.id_etudiant,
                 courant->inscription.id_matiere,
                 courant->inscription.date_inscription,
-                courant->inscription.statut);
+                courant->inscription.statut,
+                courant->inscription.rang_attente);
         
         courant = courant->suivant;
     }
@@ -110,115 +257,745 @@ int sauvegarder_inscriptions(NodeInscription* tete) {
     return 1;
 }
 
-/**
- * Enroll a student in a course
- */
-void inscrire_etudiant_cours(NodeInscription** tete, int id_etudiant, int id_matiere) {
-    // Check if the student is already enrolled in this course
-    NodeInscription* courant = *tete;
-    while (courant != NULL) {
-        if (courant->inscription.id_etudiant == id_etudiant && 
-            courant->inscription.id_matiere == id_matiere) {
-            if (courant->inscription.statut == 1) {
-                printf("L'étudiant est déjà inscrit à ce cours.\n");
-                return;
-            } else {
-                // The student was previously unenrolled, just update the status
-                courant->inscription.statut = 1;
-                
-                // Update inscription date
-                time_t now = time(NULL);
-                struct tm *t = localtime(&now);
-                strftime(courant->inscription.date_inscription, sizeof(courant->inscription.date_inscription), 
-                         "%d/%m/%Y", t);
-                
-                if (sauvegarder_inscriptions(*tete)) {
-                    printf("Inscription réussie.\n");
-                } else {
-                    printf("Erreur lors de la sauvegarde de l'inscription.\n");
-                }
-                return;
-            }
+// Seat counters of a subject, created empty if needed
+static PlacesMatiere* places_matiere(int id_matiere) {
+    int pos;
+    if (index_id_chercher(&registre.par_matiere, id_matiere, &pos)) {
+        return &registre.places[pos];
+    }
+    
+    if (registre.nb_places == registre.capacite_places) {
+        int capacite = registre.capacite_places ? registre.capacite_places * 2 : 16;
+        PlacesMatiere *places = (PlacesMatiere*)realloc(registre.places, capacite * sizeof(PlacesMatiere));
+        if (places == NULL) {
+            return NULL;
         }
-        courant = courant->suivant;
+        registre.places = places;
+        registre.capacite_places = capacite;
     }
     
-    // Create a new enrollment
-    NodeInscription *nouveau_node = (NodeInscription*)malloc(sizeof(NodeInscription));
-    if (nouveau_node == NULL) {
-        printf("Erreur: Échec d'allocation de mémoire.\n");
-        return;
+    pos = registre.nb_places;
+    if (!index_id_inserer(&registre.par_matiere, id_matiere, pos)) {
+        return NULL;
     }
+    registre.nb_places++;
     
-    // Generate a new ID
-    int new_id = 1;
-    courant = *tete;
-    while (courant != NULL) {
-        if (courant->inscription.id >= new_id) {
-            new_id = courant->inscription.id + 1;
+    PlacesMatiere *p = &registre.places[pos];
+    memset(p, 0, sizeof(PlacesMatiere));
+    p->id_matiere = id_matiere;
+    p->tete_attente = -1;
+    p->queue_attente = -1;
+    return p;
+}
+
+// Make room in the index for a number of enrollments
+static int registre_reserver(int nb) {
+    if (nb <= registre.capacite) {
+        return 1;
+    }
+    int capacite = registre.capacite ? registre.capacite : 64;
+    while (capacite < nb) {
+        capacite *= 2;
+    }
+    NodeInscription **noeuds = (NodeInscription**)realloc(registre.noeuds, capacite * sizeof(NodeInscription*));
+    if (noeuds == NULL) {
+        return 0;
+    }
+    registre.noeuds = noeuds;
+    int *precedent = (int*)realloc(registre.precedent_attente, capacite * sizeof(int));
+    if (precedent == NULL) {
+        return 0;
+    }
+    registre.precedent_attente = precedent;
+    int *suivant = (int*)realloc(registre.suivant_attente, capacite * sizeof(int));
+    if (suivant == NULL) {
+        return 0;
+    }
+    registre.suivant_attente = suivant;
+    int *suivant_etudiant = (int*)realloc(registre.suivant_etudiant, capacite * sizeof(int));
+    if (suivant_etudiant == NULL) {
+        return 0;
+    }
+    registre.suivant_etudiant = suivant_etudiant;
+    registre.capacite = capacite;
+    return 1;
+}
+
+// Give an enrollment the next position of the index
+static int registre_ajouter(NodeInscription *node) {
+    if (!registre_reserver(registre.nb + 1)) {
+        return -1;
+    }
+    
+    int pos = registre.nb;
+    const Inscription *inscription = &node->inscription;
+    int tete;
+    registre.suivant_etudiant[pos] = index_id_chercher(&registre.tete_etudiant, inscription->id_etudiant, &tete)
+                                     ? tete : -1;
+    long long cle = index_cle_composee(inscription->id_etudiant, inscription->id_matiere);
+    if (!index_id_inserer(&registre.par_couple, cle, pos)) {
+        return -1;
+    }
+    if (!index_id_inserer(&registre.tete_etudiant, inscription->id_etudiant, pos)) {
+        index_id_supprimer(&registre.par_couple, cle);
+        return -1;
+    }
+    registre.noeuds[pos] = node;
+    registre.precedent_attente[pos] = -1;
+    registre.suivant_attente[pos] = -1;
+    registre.nb++;
+    
+    if (inscription->id > registre.dernier_id) {
+        registre.dernier_id = inscription->id;
+    }
+    if (inscription->rang_attente > registre.dernier_rang) {
+        registre.dernier_rang = inscription->rang_attente;
+    }
+    return pos;
+}
+
+// Undo the last registre_ajouter
+static void registre_retirer_dernier(void) {
+    int pos = --registre.nb;
+    const Inscription *inscription = &registre.noeuds[pos]->inscription;
+    index_id_supprimer(&registre.par_couple, index_cle_composee(inscription->id_etudiant, inscription->id_matiere));
+    if (registre.suivant_etudiant[pos] >= 0) {
+        index_id_inserer(&registre.tete_etudiant, inscription->id_etudiant, registre.suivant_etudiant[pos]);
+    } else {
+        index_id_supprimer(&registre.tete_etudiant, inscription->id_etudiant);
+    }
+}
+
+// Append an enrollment to the end of its subject's waitlist
+static void attente_ajouter(PlacesMatiere *p, int pos) {
+    registre.precedent_attente[pos] = p->queue_attente;
+    registre.suivant_attente[pos] = -1;
+    if (p->queue_attente >= 0) {
+        registre.suivant_attente[p->queue_attente] = pos;
+    } else {
+        p->tete_attente = pos;
+    }
+    p->queue_attente = pos;
+    p->nb_attente++;
+}
+
+// Unlink an enrollment from its subject's waitlist
+static void attente_retirer(PlacesMatiere *p, int pos) {
+    int precedent = registre.precedent_attente[pos];
+    int suivant = registre.suivant_attente[pos];
+    if (precedent >= 0) {
+        registre.suivant_attente[precedent] = suivant;
+    } else {
+        p->tete_attente = suivant;
+    }
+    if (suivant >= 0) {
+        registre.precedent_attente[suivant] = precedent;
+    } else {
+        p->queue_attente = precedent;
+    }
+    registre.precedent_attente[pos] = -1;
+    registre.suivant_attente[pos] = -1;
+    p->nb_attente--;
+}
+
+// 1-based position of an enrollment on its subject's waitlist
+static int position_attente(const PlacesMatiere *p, int pos) {
+    int position = 1;
+    for (int i = p->tete_attente; i >= 0 && i != pos; i = registre.suivant_attente[i]) {
+        position++;
+    }
+    return position;
+}
+
+// Waitlist order: lowest rank first, then oldest enrollment
+static int comparer_rang_attente(const void *a, const void *b) {
+    const Inscription *ia = &registre.noeuds[*(const int*)a]->inscription;
+    const Inscription *ib = &registre.noeuds[*(const int*)b]->inscription;
+    if (ia->rang_attente != ib->rang_attente) {
+        return (ia->rang_attente < ib->rang_attente) ? -1 : 1;
+    }
+    return (ia->id > ib->id) - (ia->id < ib->id);
+}
+
+// Rebuild the enrollments index and seat counters from the list
+static int reconstruire_registre(NodeInscription *tete) {
+    registre.nb = 0;
+    registre.dernier_id = 0;
+    registre.dernier_rang = 0;
+    index_id_vider(&registre.par_couple);
+    index_id_vider(&registre.tete_etudiant);
+    for (int i = 0; i < registre.nb_places; i++) {
+        registre.places[i].nb_inscrits = 0;
+        registre.places[i].nb_attente = 0;
+        registre.places[i].tete_attente = -1;
+        registre.places[i].queue_attente = -1;
+    }
+    
+    int nb_attente = 0;
+    for (NodeInscription *courant = tete; courant != NULL; courant = courant->suivant) {
+        const Inscription *inscription = &courant->inscription;
+        if (inscription->id > registre.dernier_id) {
+            registre.dernier_id = inscription->id;
+        }
+        // Only the first record of a (student, subject) pair counts, as with a linear search
+        if (index_id_chercher(&registre.par_couple,
+                              index_cle_composee(inscription->id_etudiant, inscription->id_matiere), NULL)) {
+            continue;
+        }
+        PlacesMatiere *p = places_matiere(inscription->id_matiere);
+        if (p == NULL || registre_ajouter(courant) < 0) {
+            return 0;
+        }
+        if (inscription->statut == 1) {
+            p->nb_inscrits++;
+        } else if (inscription->statut == 2) {
+            nb_attente++;
         }
-        courant = courant->suivant;
     }
     
-    // Fill the new enrollment
-    nouveau_node->inscription.id = new_id;
-    nouveau_node->inscription.id_etudiant = id_etudiant;
-    nouveau_node->inscription.id_matiere = id_matiere;
+    // Chain the waitlists in rank order
+    if (nb_attente > 0) {
+        int *attente = (int*)malloc(nb_attente * sizeof(int));
+        if (attente == NULL) {
+            return 0;
+        }
+        int n = 0;
+        for (int pos = 0; pos < registre.nb; pos++) {
+            if (registre.noeuds[pos]->inscription.statut == 2) {
+                attente[n++] = pos;
+            }
+        }
+        qsort(attente, n, sizeof(int), comparer_rang_attente);
+        for (int k = 0; k < n; k++) {
+            attente_ajouter(places_matiere(registre.noeuds[attente[k]]->inscription.id_matiere), attente[k]);
+        }
+        free(attente);
+    }
+    return 1;
+}
+
+// Bring the index up to date with the enrollments list and, if given, the subjects list
+static int preparer_registre(NodeInscription *tete, NodeMatiere *matieres) {
+    if (!registre.valide || registre.liste != tete || registre.generation != generation_inscriptions) {
+        registre.valide = 0;
+        if (!reconstruire_registre(tete)) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            return 0;
+        }
+        registre.liste = tete;
+        registre.generation = generation_inscriptions;
+        registre.valide = 1;
+    }
     
-    // Set enrollment date
+    if (matieres != NULL &&
+        (registre.matieres != matieres || registre.generation_matieres != matieres_generation())) {
+        for (int i = 0; i < registre.nb_places; i++) {
+            registre.places[i].existe = 0;
+            registre.places[i].capacite = 0;
+        }
+        for (NodeMatiere *m = matieres; m != NULL; m = m->suivant) {
+            PlacesMatiere *p = places_matiere(m->matiere.id);
+            if (p == NULL) {
+                printf("Erreur: Échec d'allocation de mémoire.\n");
+                registre.matieres = NULL;
+                return 0;
+            }
+            p->existe = 1;
+            p->capacite = m->matiere.capacite;
+        }
+        registre.matieres = matieres;
+        registre.generation_matieres = matieres_generation();
+    }
+    return 1;
+}
+
+// Save the enrollments after their events; the index already reflects the changes made in memory
+static int enregistrer_inscriptions(NodeInscription* tete) {
+    int ok = ecrire_journal_inscriptions() && sauvegarder_inscriptions(tete);
+    registre.liste = tete;
+    registre.generation = generation_inscriptions;
+    return ok;
+}
+
+// Set the date of an enrollment to today
+static void dater_inscription(Inscription *inscription) {
     time_t now = time(NULL);
     struct tm *t = localtime(&now);
-    strftime(nouveau_node->inscription.date_inscription, sizeof(nouveau_node->inscription.date_inscription), 
-             "%d/%m/%Y", t);
+    strftime(inscription->date_inscription, sizeof(inscription->date_inscription), "%d/%m/%Y", t);
+}
+
+// Give the free seats of a subject to the first students of its waitlist, counting them in nb_promus.
+// Each change is logged before it is made: one missing from the log would be undone by the next load.
+// Returns 0 if a change could not be logged (the previous ones are kept)
+static int promouvoir(PlacesMatiere *p, int *nb_promus) {
+    while (p->existe && p->tete_attente >= 0 && (p->capacite == 0 || p->nb_inscrits < p->capacite)) {
+        int pos = p->tete_attente;
+        Inscription *inscription = &registre.noeuds[pos]->inscription;
+        if (!journaliser_inscription(inscription->id_etudiant, inscription->id_matiere, 1)) {
+            return 0;
+        }
+        
+        attente_retirer(p, pos);
+        inscription->statut = 1;
+        inscription->rang_attente = 0;
+        dater_inscription(inscription);
+        p->nb_inscrits++;
+        (*nb_promus)++;
+        
+        printf("L'étudiant (ID: %d) quitte la liste d'attente et est inscrit au cours (ID: %d).\n",
+               inscription->id_etudiant, inscription->id_matiere);
+    }
+    return 1;
+}
+
+// Enroll a student in a subject, or put them on its waitlist when it is full, without saving;
+// id_nouveau is the ID given to the record if the pair has none yet.
+// Returns the new status (1 or 2), 0 if the student is already enrolled or waitlisted,
+// -1 if error (nothing is changed when the event cannot be logged)
+static int placer_etudiant(NodeInscription** tete, PlacesMatiere *p, int id_etudiant, int id_nouveau) {
+    int pos;
+    NodeInscription *node = NULL;
+    int existe = index_id_chercher(&registre.par_couple, index_cle_composee(id_etudiant, p->id_matiere), &pos);
+    if (existe && registre.noeuds[pos]->inscription.statut != 0) {
+        return 0;
+    }
+    
+    if (existe) {
+        // The student was previously unenrolled, the record is reused
+        node = registre.noeuds[pos];
+    } else {
+        // Create a new enrollment
+        node = (NodeInscription*)malloc(sizeof(NodeInscription));
+        if (node == NULL) {
+            return -1;
+        }
+        node->inscription.id = id_nouveau;
+        node->inscription.id_etudiant = id_etudiant;
+        node->inscription.id_matiere = p->id_matiere;
+        node->inscription.statut = 0;
+        node->inscription.rang_attente = 0;
+        
+        pos = registre_ajouter(node);
+        if (pos < 0) {
+            free(node);
+            return -1;
+        }
+    }
     
-    nouveau_node->inscription.statut = 1; // Enrolled
+    // Logged before the table changes: a change missing from the log would be undone by the next load
+    int statut = (p->capacite > 0 && p->nb_inscrits >= p->capacite) ? 2 : 1;
+    if (!journaliser_inscription(id_etudiant, p->id_matiere, statut)) {
+        if (!existe) {
+            registre_retirer_dernier();
+            free(node);
+        }
+        return -1;
+    }
     
-    // Add to the beginning of the list
-    nouveau_node->suivant = *tete;
-    *tete = nouveau_node;
+    if (!existe) {
+        // Add to the beginning of the list; the index already holds the node, so it stays valid
+        node->suivant = *tete;
+        *tete = node;
+        registre.liste = *tete;
+    }
     
-    // Save to file
-    if (sauvegarder_inscriptions(*tete)) {
-        printf("Inscription réussie.\n");
+    dater_inscription(&node->inscription);
+    node->inscription.statut = statut;
+    if (statut == 2) {
+        node->inscription.rang_attente = ++registre.dernier_rang;
+        attente_ajouter(p, pos);
     } else {
+        p->nb_inscrits++;
+    }
+    return statut;
+}
+
+/**
+ * Enroll a student in a course, or put them on its waitlist when the course is full
+ */
+void inscrire_etudiant_cours(NodeInscription** tete, NodeMatiere* matieres, NodeNote* notes,
+                             int id_etudiant, int id_matiere) {
+    if (!preparer_registre(*tete, matieres)) {
+        return;
+    }
+    
+    int m;
+    if (!index_id_chercher(&registre.par_matiere, id_matiere, &m) || !registre.places[m].existe) {
+        printf("Erreur: La matière avec ID %d n'existe pas.\n", id_matiere);
+        return;
+    }
+    PlacesMatiere *p = &registre.places[m];
+    
+    // Seats freed by a raised capacity go to the waitlist first
+    int promus = 0;
+    if (!promouvoir(p, &promus)) {
+        printf("Erreur: La liste d'attente n'a pas pu être mise à jour.\n");
+        if (promus > 0 && !enregistrer_inscriptions(*tete)) {
+            printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        }
+        return;
+    }
+    
+    // Check if the student already has an enrollment for this course
+    int pos;
+    if (index_id_chercher(&registre.par_couple, index_cle_composee(id_etudiant, id_matiere), &pos) &&
+        registre.noeuds[pos]->inscription.statut != 0) {
+        if (registre.noeuds[pos]->inscription.statut == 1) {
+            printf("L'étudiant est déjà inscrit à ce cours.\n");
+        } else {
+            printf("L'étudiant est déjà sur la liste d'attente de ce cours (position %d).\n",
+                   position_attente(p, pos));
+        }
+        if (promus > 0 && !enregistrer_inscriptions(*tete)) {
+            printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        }
+        return;
+    }
+    
+    // Prerequisites must be passed, co-requisites passed or followed
+    EnsembleBits reussies = {0};
+    int autorise = matieres_reussies(notes, matieres, id_etudiant, &reussies) &&
+                   prerequis_satisfaits(id_etudiant, id_matiere, &reussies, *tete, 1);
+    ensemble_bits_liberer(&reussies);
+    if (!autorise) {
+        printf("Inscription refusée.\n");
+        if (promus > 0 && !enregistrer_inscriptions(*tete)) {
+            printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        }
+        return;
+    }
+    
+    int statut = placer_etudiant(tete, p, id_etudiant, registre.dernier_id + 1);
+    if (statut < 0) {
+        printf("Erreur: L'inscription n'a pas pu être enregistrée.\n");
+        if (promus > 0 && !enregistrer_inscriptions(*tete)) {
+            printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        }
+        return;
+    }
+    int en_attente = (statut == 2);
+    
+    // Save to file
+    if (!enregistrer_inscriptions(*tete)) {
         printf("Erreur lors de la sauvegarde de l'inscription.\n");
+    } else if (en_attente) {
+        printf("Le cours est complet (%d places): inscription sur la liste d'attente en position %d.\n",
+               p->capacite, p->nb_attente);
+    } else {
+        printf("Inscription réussie.\n");
     }
 }
 
 /**
- * Unenroll a student from a course
+ * Unenroll a student from a course and promote the waitlist to the freed seat
  */
-void desinscrire_etudiant_cours(NodeInscription** tete, int id_etudiant, int id_matiere) {
+void desinscrire_etudiant_cours(NodeInscription** tete, NodeMatiere* matieres, int id_etudiant, int id_matiere) {
+    if (!preparer_registre(*tete, matieres)) {
+        return;
+    }
+    
     // Find the enrollment
-    NodeInscription* courant = *tete;
-    while (courant != NULL) {
-        if (courant->inscription.id_etudiant == id_etudiant && 
-            courant->inscription.id_matiere == id_matiere) {
-            if (courant->inscription.statut == 0) {
-                printf("L'étudiant n'est pas inscrit à ce cours.\n");
-                return;
+    int pos;
+    if (!index_id_chercher(&registre.par_couple, index_cle_composee(id_etudiant, id_matiere), &pos) ||
+        registre.noeuds[pos]->inscription.statut == 0) {
+        printf("L'étudiant n'est pas inscrit à ce cours.\n");
+        return;
+    }
+    
+    // Logged first: a change missing from the log would be undone by the next load
+    if (!journaliser_inscription(id_etudiant, id_matiere, 0)) {
+        printf("Erreur: La désinscription n'a pas pu être enregistrée.\n");
+        return;
+    }
+    
+    Inscription *inscription = &registre.noeuds[pos]->inscription;
+    PlacesMatiere *p = places_matiere(id_matiere);
+    int etait_en_attente = (inscription->statut == 2);
+    if (etait_en_attente) {
+        attente_retirer(p, pos);
+    } else {
+        p->nb_inscrits--;
+    }
+    
+    // Update the status and the date (date of unenrollment)
+    inscription->statut = 0;
+    inscription->rang_attente = 0;
+    dater_inscription(inscription);
+    
+    int promus = 0;
+    if (!etait_en_attente && !promouvoir(p, &promus)) {
+        printf("Erreur: La liste d'attente n'a pas pu être mise à jour.\n");
+    }
+    
+    if (!enregistrer_inscriptions(*tete)) {
+        printf("Erreur lors de la sauvegarde de la désinscription.\n");
+    } else if (etait_en_attente) {
+        printf("Retrait de la liste d'attente réussi.\n");
+    } else {
+        printf("Désinscription réussie.\n");
+    }
+}
+
+/**
+ * Promote waitlisted students to the free seats of a course
+ */
+int promouvoir_liste_attente(NodeInscription** tete, NodeMatiere* matieres, int id_matiere) {
+    if (!preparer_registre(*tete, matieres)) {
+        return -1;
+    }
+    
+    int nb = 0;
+    int ok = 1;
+    if (id_matiere == 0) {
+        for (int i = 0; ok && i < registre.nb_places; i++) {
+            ok = promouvoir(&registre.places[i], &nb);
+        }
+    } else {
+        int m;
+        if (index_id_chercher(&registre.par_matiere, id_matiere, &m)) {
+            ok = promouvoir(&registre.places[m], &nb);
+        }
+    }
+    if (!ok) {
+        printf("Erreur: La liste d'attente n'a pas pu être mise à jour.\n");
+    }
+    
+    if (nb > 0 && !enregistrer_inscriptions(*tete)) {
+        printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        return -1;
+    }
+    return ok ? nb : -1;
+}
+
+/**
+ * Enroll every student of a section and/or field of study in a list of subjects, saving once
+ */
+int inscrire_groupe_cours(NodeInscription** tete, NodeEtudiant* etudiants, NodeMatiere* matieres,
+                          NodeNote* notes, const char *section, const char *filiere,
+                          const int *ids_matieres, int nb_matieres, BilanInscriptions *bilan) {
+    memset(bilan, 0, sizeof(BilanInscriptions));
+    if (!preparer_registre(*tete, matieres)) {
+        return 0;
+    }
+    
+    // Students of the group
+    int nb_etudiants = 0;
+    for (NodeEtudiant *e = etudiants; e != NULL; e = e->suivant) {
+        nb_etudiants++;
+    }
+    int *ids_etudiants = (int*)malloc((nb_etudiants > 0 ? nb_etudiants : 1) * sizeof(int));
+    PlacesMatiere **places = (PlacesMatiere**)malloc((nb_matieres > 0 ? nb_matieres : 1) * sizeof(PlacesMatiere*));
+    if (ids_etudiants == NULL || places == NULL) {
+        free(ids_etudiants);
+        free(places);
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    nb_etudiants = 0;
+    for (NodeEtudiant *e = etudiants; e != NULL; e = e->suivant) {
+        if ((section == NULL || section[0] == '\0' || strcmp(e->etudiant.section, section) == 0) &&
+            (filiere == NULL || filiere[0] == '\0' || strcmp(e->etudiant.filiere, filiere) == 0)) {
+            ids_etudiants[nb_etudiants++] = e->etudiant.id;
+        }
+    }
+    bilan->nb_etudiants = nb_etudiants;
+    
+    // Existing subjects, each once, and the number of records to create
+    int nb_places = 0;
+    int nb_nouveaux = 0;
+    for (int k = 0; k < nb_matieres; k++) {
+        int m;
+        if (!index_id_chercher(&registre.par_matiere, ids_matieres[k], &m) || !registre.places[m].existe) {
+            printf("Matière avec ID %d non trouvée, ignorée.\n", ids_matieres[k]);
+            bilan->nb_matieres_inconnues++;
+            continue;
+        }
+        int deja_vue = 0;
+        for (int j = 0; j < nb_places && !deja_vue; j++) {
+            deja_vue = (places[j] == &registre.places[m]);
+        }
+        if (deja_vue) {
+            continue;
+        }
+        places[nb_places++] = &registre.places[m];
+        for (int i = 0; i < nb_etudiants; i++) {
+            if (!index_id_chercher(&registre.par_couple, index_cle_composee(ids_etudiants[i], ids_matieres[k]), NULL)) {
+                nb_nouveaux++;
+            }
+        }
+    }
+    
+    // Subjects come after those they require, so that co-requisites of the same batch are followed
+    for (int j = 1; j < nb_places; j++) {
+        PlacesMatiere *courante = places[j];
+        int profondeur = profondeur_prerequis(courante->id_matiere);
+        int k = j;
+        while (k > 0 && profondeur_prerequis(places[k - 1]->id_matiere) > profondeur) {
+            places[k] = places[k - 1];
+            k--;
+        }
+        places[k] = courante;
+    }
+    
+    // Subjects passed by each student of the group
+    EnsembleBits *reussies = (EnsembleBits*)calloc(nb_etudiants > 0 ? nb_etudiants : 1, sizeof(EnsembleBits));
+    int ok = (reussies != NULL);
+    for (int i = 0; ok && i < nb_etudiants; i++) {
+        ok = matieres_reussies(notes, matieres, ids_etudiants[i], &reussies[i]);
+    }
+    
+    // The new records take a block of consecutive IDs and the index grows once
+    ok = ok && registre_reserver(registre.nb + nb_nouveaux);
+    int prochain_id = registre.dernier_id + 1;
+    int modifie = 0;
+    for (int j = 0; ok && j < nb_places; j++) {
+        ok = promouvoir(places[j], &modifie);
+        for (int i = 0; ok && i < nb_etudiants; i++) {
+            int pos;
+            int deja = index_id_chercher(&registre.par_couple,
+                                         index_cle_composee(ids_etudiants[i], places[j]->id_matiere), &pos) &&
+                       registre.noeuds[pos]->inscription.statut != 0;
+            if (!deja && !prerequis_satisfaits(ids_etudiants[i], places[j]->id_matiere, &reussies[i], *tete, 0)) {
+                bilan->nb_prerequis_manquants++;
+                continue;
+            }
+            int nb_avant = registre.nb;
+            int statut = placer_etudiant(tete, places[j], ids_etudiants[i], prochain_id);
+            if (statut < 0) {
+                ok = 0;
+                break;
+            }
+            if (registre.nb > nb_avant) {
+                prochain_id++;
+            }
+            if (statut == 1) {
+                bilan->nb_inscrits++;
+            } else if (statut == 2) {
+                bilan->nb_en_attente++;
             } else {
-                // Update the status
-                courant->inscription.statut = 0;
-                
-                // Update inscription date (date of unenrollment)
-                time_t now = time(NULL);
-                struct tm *t = localtime(&now);
-                strftime(courant->inscription.date_inscription, sizeof(courant->inscription.date_inscription), 
-                         "%d/%m/%Y", t);
-                
-                if (sauvegarder_inscriptions(*tete)) {
-                    printf("Désinscription réussie.\n");
-                } else {
-                    printf("Erreur lors de la sauvegarde de la désinscription.\n");
-                }
-                return;
+                bilan->nb_deja_inscrits++;
             }
         }
-        courant = courant->suivant;
+    }
+    for (int i = 0; reussies != NULL && i < nb_etudiants; i++) {
+        ensemble_bits_liberer(&reussies[i]);
+    }
+    free(reussies);
+    free(ids_etudiants);
+    free(places);
+    if (!ok) {
+        printf("Erreur: Les inscriptions du groupe n'ont pas toutes pu être enregistrées.\n");
     }
     
-    printf("L'étudiant n'est pas inscrit à ce cours.\n");
+    // Whatever was placed is saved, in one write of the log and of the table
+    if (modifie + bilan->nb_inscrits + bilan->nb_en_attente > 0 && !enregistrer_inscriptions(*tete)) {
+        printf("Erreur lors de la sauvegarde des inscriptions.\n");
+        return 0;
+    }
+    return ok;
+}
+
+/**
+ * Ask for a group of students and a list of subjects and enroll them
+ */
+void saisir_inscription_groupe(NodeInscription** tete, NodeEtudiant* etudiants, NodeMatiere* matieres,
+                               NodeNote* notes) {
+    char section[MAX_SECTION_LEN];
+    char filiere[MAX_FILIERE_LEN];
+    
+    printf("\n=== Inscription d'un Groupe d'Étudiants ===\n");
+    get_input("Section (vide pour toutes): ", section, sizeof(section));
+    get_input("Filière (vide pour toutes): ", filiere, sizeof(filiere));
+    if (section[0] == '\0' && filiere[0] == '\0') {
+        printf("Veuillez indiquer une section ou une filière.\n");
+        return;
+    }
+    
+    afficher_matieres(matieres);
+    char saisie[256];
+    get_input("IDs des matières (séparés par des espaces ou des virgules): ", saisie, sizeof(saisie));
+    
+    // Every ID takes at least one digit and one separator: the input cannot hold more
+    int ids_matieres[sizeof(saisie) / 2 + 1];
+    int nb_matieres = 0;
+    char *curseur = saisie;
+    while (*curseur != '\0') {
+        char *fin;
+        long id = strtol(curseur, &fin, 10);
+        if (fin == curseur) {
+            curseur++;
+            continue;
+        }
+        if (id > 0) {
+            ids_matieres[nb_matieres++] = (int)id;
+        }
+        curseur = fin;
+    }
+    if (nb_matieres == 0) {
+        printf("Aucune matière indiquée.\n");
+        return;
+    }
+    
+    BilanInscriptions bilan;
+    inscrire_groupe_cours(tete, etudiants, matieres, notes, section, filiere, ids_matieres, nb_matieres, &bilan);
+    
+    printf("\nÉtudiants concernés: %d\n", bilan.nb_etudiants);
+    printf("Inscriptions réussies: %d\n", bilan.nb_inscrits);
+    printf("Sur liste d'attente: %d\n", bilan.nb_en_attente);
+    printf("Déjà inscrits ou en attente: %d\n", bilan.nb_deja_inscrits);
+    if (bilan.nb_prerequis_manquants > 0) {
+        printf("Refusées faute de prérequis: %d\n", bilan.nb_prerequis_manquants);
+    }
+    if (bilan.nb_matieres_inconnues > 0) {
+        printf("Matières inconnues ignorées: %d\n", bilan.nb_matieres_inconnues);
+    }
+}
+
+/**
+ * Display the seats taken and the waitlist of a course
+ */
+void afficher_places_matiere(NodeInscription* tete, NodeMatiere* matieres, int id_matiere) {
+    if (!preparer_registre(tete, matieres)) {
+        return;
+    }
+    
+    int m;
+    if (!index_id_chercher(&registre.par_matiere, id_matiere, &m) || !registre.places[m].existe) {
+        printf("Matière avec ID %d non trouvée.\n", id_matiere);
+        return;
+    }
+    const PlacesMatiere *p = &registre.places[m];
+    
+    printf("\n=== Places de la Matière (ID: %d) ===\n", id_matiere);
+    if (p->capacite > 0) {
+        printf("Inscrits: %d / %d (places libres: %d)\n", p->nb_inscrits, p->capacite,
+               (p->nb_inscrits < p->capacite) ? p->capacite - p->nb_inscrits : 0);
+    } else {
+        printf("Inscrits: %d (capacité illimitée)\n", p->nb_inscrits);
+    }
+    
+    if (p->nb_attente == 0) {
+        printf("Liste d'attente vide.\n");
+        return;
+    }
+    printf("Liste d'attente (%d):\n", p->nb_attente);
+    int position = 1;
+    for (int pos = p->tete_attente; pos >= 0; pos = registre.suivant_attente[pos]) {
+        const Inscription *inscription = &registre.noeuds[pos]->inscription;
+        printf("%3d. Étudiant ID: %d (depuis le %s)\n", position++,
+               inscription->id_etudiant, inscription->date_inscription);
+    }
+}
+
+/**
+ * Get the label of an enrollment status
+ */
+const char* statut_inscription_to_string(int statut) {
+    switch (statut) {
+        case 1: return "Inscrit";
+        case 2: return "En attente";
+        default: return "Désinscrit";
+    }
 }
 
 /**
@@ -242,7 +1019,7 @@ void afficher_inscriptions(NodeInscription* tete) {
                courant->inscription.id_etudiant,
                courant->inscription.id_matiere,
                courant->inscription.date_inscription,
-               (courant->inscription.statut == 1) ? "Inscrit" : "Désinscrit");
+               statut_inscription_to_string(courant->inscription.statut));
         
         courant = courant->suivant;
     }
@@ -268,12 +1045,12 @@ void afficher_inscriptions_par_etudiant(NodeInscription* tete, int id_etudiant)
     int found = 0;
     
     while (courant != NULL) {
-        if (courant->inscription.id_etudiant == id_etudiant && courant->inscription.statut == 1) {
+        if (courant->inscription.id_etudiant == id_etudiant && courant->inscription.statut != 0) {
             printf("%-4d | %-10d | %-12s | %-8s\n", 
                    courant->inscription.id,
                    courant->inscription.id_matiere,
                    courant->inscription.date_inscription,
-                   "Inscrit");
+                   statut_inscription_to_string(courant->inscription.statut));
             found = 1;
         }
         
@@ -331,24 +1108,56 @@ void afficher_inscriptions_par_matiere(NodeInscription* tete, int id_matiere) {
  * Check if a student is enrolled in a specific course
  */
 int est_inscrit(NodeInscription* tete, int id_etudiant, int id_matiere) {
-    NodeInscription* courant = tete;
+    if (!preparer_registre(tete, NULL)) {
+        return 0;
+    }
     
-    while (courant != NULL) {
-        if (courant->inscription.id_etudiant == id_etudiant && 
-            courant->inscription.id_matiere == id_matiere &&
-            courant->inscription.statut == 1) {
-            return 1; // Enrolled
-        }
-        courant = courant->suivant;
+    int pos;
+    if (index_id_chercher(&registre.par_couple, index_cle_composee(id_etudiant, id_matiere), &pos) &&
+        registre.noeuds[pos]->inscription.statut == 1) {
+        return 1; // Enrolled
     }
     
     return 0; // Not enrolled
 }
 
+/**
+ * Get the subjects a student is enrolled in
+ */
+int matieres_inscrites_etudiant(NodeInscription* tete, int id_etudiant, int **ids_matieres) {
+    *ids_matieres = NULL;
+    if (!preparer_registre(tete, NULL)) {
+        return -1;
+    }
+    
+    int premier;
+    if (!index_id_chercher(&registre.tete_etudiant, id_etudiant, &premier)) {
+        return 0;
+    }
+    
+    int nb = 0;
+    for (int pos = premier; pos >= 0; pos = registre.suivant_etudiant[pos]) {
+        nb++;
+    }
+    *ids_matieres = (int*)malloc(nb * sizeof(int));
+    if (*ids_matieres == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+    
+    nb = 0;
+    for (int pos = premier; pos >= 0; pos = registre.suivant_etudiant[pos]) {
+        if (registre.noeuds[pos]->inscription.statut == 1) {
+            (*ids_matieres)[nb++] = registre.noeuds[pos]->inscription.id_matiere;
+        }
+    }
+    return nb;
+}
+
 /**
  * Get student enrollment management menu
  */
-void menu_inscriptions_etudiant(NodeInscription** tete, int id_etudiant) {
+void menu_inscriptions_etudiant(NodeInscription** tete, NodeMatiere* matieres, NodeNote* notes, int id_etudiant) {
     int choix = 0;
     
     do {
@@ -367,19 +1176,19 @@ void menu_inscriptions_etudiant(NodeInscription** tete, int id_etudiant) {
                 afficher_inscriptions_par_etudiant(*tete, id_etudiant);
                 pause_screen();
                 break;
-                
+            
             case 2: {
-                // Enroll in a course
-                // In a real app, you'd display a list of available courses here
+                // Enroll in a course (on the waitlist if it is full)
                 printf("\n=== Inscription à un Cours ===\n");
+                afficher_matieres(matieres);
                 printf("Veuillez entrer l'ID de la matière à laquelle vous souhaitez vous inscrire.\n");
                 int id_matiere = get_int_input("ID Matière: ", 1, 9999);
                 
-                inscrire_etudiant_cours(tete, id_etudiant, id_matiere);
+                inscrire_etudiant_cours(tete, matieres, notes, id_etudiant, id_matiere);
                 pause_screen();
                 break;
             }
-                
+            
             case 3: {
                 // Unenroll from a course
                 // First display the courses the student is enrolled in
@@ -390,7 +1199,7 @@ void menu_inscriptions_etudiant(NodeInscription** tete, int id_etudiant) {
                 int id_matiere = get_int_input("ID Matière (0 pour annuler): ", 0, 9999);
                 
                 if (id_matiere != 0) {
-                    desinscrire_etudiant_cours(tete, id_etudiant, id_matiere);
+                    desinscrire_etudiant_cours(tete, matieres, id_etudiant, id_matiere);
                 }
                 pause_screen();
                 break;
@@ -413,4 +1222,23 @@ void liberer_inscriptions(NodeInscription** tete) {
     }
     
     *tete = NULL;
-}
\ No newline at end of file
+    
+    free(registre.noeuds);
+    free(registre.precedent_attente);
+    free(registre.suivant_attente);
+    free(registre.suivant_etudiant);
+    free(registre.places);
+    index_id_liberer(&registre.par_couple);
+    index_id_liberer(&registre.tete_etudiant);
+    index_id_liberer(&registre.par_matiere);
+    memset(&registre, 0, sizeof(registre));
+    
+    liberer_journal_inscriptions();
+}
+
+/**
+ * Get the enrollments modification counter
+ */
+unsigned long inscriptions_generation(void) {
+    return generation_inscriptions;
+}
@@ -0,0 +1,510 @@
+/**
+ * @file journal_inscriptions.c
+ * @brief Implementation of the enrollment events log
+ */
+
+#include "../include/journal_inscriptions.h"
+#include "../include/index.h"
+#include "../include/tampon.h"
+#include "../include/utils.h"
+
+#define JOURNAL_FILE "data/inscriptions_journal.txt"
+#define EN_TETE_JOURNAL "#journal_inscriptions 1"
+#define DEBUT_JOURNAL "#debut|"
+
+/**
+ * Events of one subject, by position in the log (chronological)
+ */
+typedef struct {
+    int id_matiere;
+    int *positions;
+    int nb;
+    int capacite;
+} EvenementsMatiere;
+
+static struct {
+    EvenementInscription *evenements; // Whole log, chronological
+    int nb;
+    int capacite;
+    int nb_ecrits;                    // Events already in the file
+    IndexId par_couple;               // index_cle_composee(student, subject) -> latest event
+    EvenementsMatiere *matieres;
+    int nb_matieres;
+    int capacite_matieres;
+    IndexId par_matiere;              // Subject ID -> position in matieres
+    time_t debut;                     // Creation of the log, 0 if unknown
+} journal;
+
+// Add the event at a position of the log to the indexes
+static int indexer_evenement(int pos) {
+    const EvenementInscription *e = &journal.evenements[pos];
+    if (!index_id_inserer(&journal.par_couple, index_cle_composee(e->id_etudiant, e->id_matiere), pos)) {
+        return 0;
+    }
+
+    int m;
+    if (!index_id_chercher(&journal.par_matiere, e->id_matiere, &m)) {
+        if (journal.nb_matieres == journal.capacite_matieres) {
+            int capacite = journal.capacite_matieres ? journal.capacite_matieres * 2 : 16;
+            EvenementsMatiere *matieres = (EvenementsMatiere*)realloc(journal.matieres,
+                                                                      capacite * sizeof(EvenementsMatiere));
+            if (matieres == NULL) {
+                return 0;
+            }
+            journal.matieres = matieres;
+            journal.capacite_matieres = capacite;
+        }
+        m = journal.nb_matieres;
+        if (!index_id_inserer(&journal.par_matiere, e->id_matiere, m)) {
+            return 0;
+        }
+        journal.nb_matieres++;
+        memset(&journal.matieres[m], 0, sizeof(EvenementsMatiere));
+        journal.matieres[m].id_matiere = e->id_matiere;
+    }
+
+    EvenementsMatiere *em = &journal.matieres[m];
+    if (em->nb == em->capacite) {
+        int capacite = em->capacite ? em->capacite * 2 : 16;
+        int *positions = (int*)realloc(em->positions, capacite * sizeof(int));
+        if (positions == NULL) {
+            return 0;
+        }
+        em->positions = positions;
+        em->capacite = capacite;
+    }
+    em->positions[em->nb++] = pos;
+    return 1;
+}
+
+// Append an event to the log in memory and index it
+static int ajouter_evenement(EvenementInscription e) {
+    if (journal.nb == journal.capacite) {
+        int capacite = journal.capacite ? journal.capacite * 2 : 256;
+        EvenementInscription *evenements = (EvenementInscription*)realloc(journal.evenements,
+                                                                          capacite * sizeof(EvenementInscription));
+        if (evenements == NULL) {
+            return 0;
+        }
+        journal.evenements = evenements;
+        journal.capacite = capacite;
+    }
+    journal.evenements[journal.nb] = e;
+    long long cle = index_cle_composee(e.id_etudiant, e.id_matiere);
+    int precedent;
+    int existait = index_id_chercher(&journal.par_couple, cle, &precedent);
+    if (!indexer_evenement(journal.nb)) {
+        // The pair must not point at an event that is not counted
+        if (existait) {
+            index_id_inserer(&journal.par_couple, cle, precedent);
+        } else {
+            index_id_supprimer(&journal.par_couple, cle);
+        }
+        return 0;
+    }
+    journal.nb++;
+    return 1;
+}
+
+// Events being sorted by comparer_evenements
+static const EvenementInscription *evenements_a_trier;
+
+// Order positions of events by date, then by position
+static int comparer_evenements(const void *a, const void *b) {
+    int pa = *(const int*)a;
+    int pb = *(const int*)b;
+    time_t da = evenements_a_trier[pa].date;
+    time_t db = evenements_a_trier[pb].date;
+    if (da != db) {
+        return (da < db) ? -1 : 1;
+    }
+    return (pa > pb) - (pa < pb);
+}
+
+// Sort events chronologically, keeping their order for equal dates
+static int trier_evenements(EvenementInscription *evenements, int nb) {
+    int *ordre = (int*)malloc(nb * sizeof(int));
+    EvenementInscription *copie = (EvenementInscription*)malloc(nb * sizeof(EvenementInscription));
+    if (ordre == NULL || copie == NULL) {
+        free(ordre);
+        free(copie);
+        return 0;
+    }
+    for (int i = 0; i < nb; i++) {
+        ordre[i] = i;
+    }
+    evenements_a_trier = evenements;
+    qsort(ordre, nb, sizeof(int), comparer_evenements);
+    for (int i = 0; i < nb; i++) {
+        copie[i] = evenements[ordre[i]];
+    }
+    memcpy(evenements, copie, nb * sizeof(EvenementInscription));
+    free(ordre);
+    free(copie);
+    return 1;
+}
+
+// Warn that the log does not know what happened before its creation
+static void signaler_debut_journal(void) {
+    char date[20];
+    strftime(date, sizeof(date), "%d/%m/%Y", localtime(&journal.debut));
+    printf("Attention: l'historique commence le %s (création du journal); avant cette date, "
+           "seul le dernier état connu de chaque inscription est repris et les inscriptions "
+           "terminées plus tôt n'apparaissent pas.\n", date);
+}
+
+// Midnight of a "JJ/MM/AAAA" date, -1 if invalid
+static time_t lire_date_jour(const char *texte) {
+    int jour, mois, annee;
+    if (sscanf(texte, "%d/%d/%d", &jour, &mois, &annee) != 3 ||
+        jour < 1 || jour > 31 || mois < 1 || mois > 12 || annee < 1970) {
+        return (time_t)-1;
+    }
+    struct tm date;
+    memset(&date, 0, sizeof(date));
+    date.tm_mday = jour;
+    date.tm_mon = mois - 1;
+    date.tm_year = annee - 1900;
+    date.tm_isdst = -1;
+    return mktime(&date);
+}
+
+// Build the first log from the enrollments table: one event per record, at the date of its last change.
+// The table only keeps the latest state of each pair, so the history before the creation is incomplete.
+static int creer_journal(NodeInscription* tete) {
+    journal.debut = time(NULL);
+    int nb = 0;
+    for (NodeInscription *courant = tete; courant != NULL; courant = courant->suivant) {
+        nb++;
+    }
+    if (nb == 0) {
+        return ecrire_journal_inscriptions();
+    }
+
+    // The list is newest first: collect it backwards so equal dates keep the order of creation
+    EvenementInscription *evenements = (EvenementInscription*)malloc(nb * sizeof(EvenementInscription));
+    if (evenements == NULL) {
+        return 0;
+    }
+    int i = nb;
+    for (NodeInscription *courant = tete; courant != NULL; courant = courant->suivant) {
+        const Inscription *inscription = &courant->inscription;
+        time_t date = lire_date_jour(inscription->date_inscription);
+        EvenementInscription e = {date > 0 ? date : 0, inscription->id_etudiant,
+                                  inscription->id_matiere, inscription->statut};
+        evenements[--i] = e;
+    }
+    int ok = trier_evenements(evenements, nb);
+    for (i = 0; ok && i < nb; i++) {
+        ok = ajouter_evenement(evenements[i]);
+    }
+    free(evenements);
+    return ok && ecrire_journal_inscriptions();
+}
+
+/**
+ * Load the log, creating it from the enrollments table the first time
+ */
+int charger_journal_inscriptions(NodeInscription* tete) {
+    liberer_journal_inscriptions();
+
+    if (!file_exists(JOURNAL_FILE)) {
+        if (!creer_journal(tete)) {
+            printf("Erreur: Impossible de créer le journal des inscriptions.\n");
+            return 0;
+        }
+        return 1;
+    }
+
+    FILE *file = fopen(JOURNAL_FILE, "r");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le journal des inscriptions.\n");
+        return 0;
+    }
+
+    // date|id_etudiant|id_matiere|statut
+    Tampon ligne = {0};
+    int ok = 1;
+    int trie = 1;
+    while (ok && tampon_lire_ligne(&ligne, file)) {
+        long long debut;
+        if (sscanf(ligne.donnees, DEBUT_JOURNAL "%lld", &debut) == 1) {
+            journal.debut = (time_t)debut;
+            continue;
+        }
+        if (ligne.donnees[0] == '#' || ligne.donnees[0] == '\0') {
+            continue;
+        }
+        long long date;
+        EvenementInscription e;
+        if (sscanf(ligne.donnees, "%lld|%d|%d|%d", &date, &e.id_etudiant, &e.id_matiere, &e.statut) != 4) {
+            continue;
+        }
+        e.date = (time_t)date;
+        if (journal.nb > 0 && e.date < journal.evenements[journal.nb - 1].date) {
+            trie = 0;
+        }
+        ok = ajouter_evenement(e);
+    }
+    tampon_liberer(&ligne);
+    fclose(file);
+
+    // A log edited by hand may be out of order: sort it and index it again
+    if (ok && !trie) {
+        ok = trier_evenements(journal.evenements, journal.nb);
+        index_id_vider(&journal.par_couple);
+        for (int m = 0; m < journal.nb_matieres; m++) {
+            journal.matieres[m].nb = 0;
+        }
+        for (int pos = 0; ok && pos < journal.nb; pos++) {
+            ok = indexer_evenement(pos);
+        }
+    }
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        liberer_journal_inscriptions();
+        return 0;
+    }
+    journal.nb_ecrits = journal.nb;
+    return 1;
+}
+
+/**
+ * Record a status change now
+ */
+int journaliser_inscription(int id_etudiant, int id_matiere, int statut) {
+    // Dates never go back, so that the log stays chronological
+    time_t maintenant = time(NULL);
+    if (journal.nb > 0 && maintenant < journal.evenements[journal.nb - 1].date) {
+        maintenant = journal.evenements[journal.nb - 1].date;
+    }
+
+    EvenementInscription e = {maintenant, id_etudiant, id_matiere, statut};
+    if (!ajouter_evenement(e)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Append the events recorded since the last write to the log file
+ */
+int ecrire_journal_inscriptions(void) {
+    int nouveau = !file_exists(JOURNAL_FILE);
+    if (journal.nb_ecrits == journal.nb && !nouveau) {
+        return 1;
+    }
+
+    Tampon contenu = {0};
+    int ok = 1;
+    if (nouveau) {
+        ok = tampon_printf(&contenu, "%s\n" DEBUT_JOURNAL "%lld\n", EN_TETE_JOURNAL, (long long)journal.debut);
+    }
+    // A file gone since the last write is written again in full
+    for (int i = nouveau ? 0 : journal.nb_ecrits; ok && i < journal.nb; i++) {
+        const EvenementInscription *e = &journal.evenements[i];
+        ok = tampon_printf(&contenu, "%lld|%d|%d|%d\n", (long long)e->date,
+                           e->id_etudiant, e->id_matiere, e->statut);
+    }
+
+    FILE *file = ok ? fopen(JOURNAL_FILE, "a") : NULL;
+    if (file == NULL || fwrite(contenu.donnees, 1, contenu.taille, file) != contenu.taille) {
+        printf("Erreur: Impossible d'écrire le journal des inscriptions.\n");
+        if (file != NULL) {
+            fclose(file);
+        }
+        tampon_liberer(&contenu);
+        return 0;
+    }
+    ok = (fclose(file) == 0);
+    tampon_liberer(&contenu);
+    if (ok) {
+        journal.nb_ecrits = journal.nb;
+    }
+    return ok;
+}
+
+/**
+ * Get the latest event of a (student, subject) pair
+ */
+const EvenementInscription* dernier_evenement_inscription(int id_etudiant, int id_matiere) {
+    int pos;
+    if (!index_id_chercher(&journal.par_couple, index_cle_composee(id_etudiant, id_matiere), &pos)) {
+        return NULL;
+    }
+    return &journal.evenements[pos];
+}
+
+/**
+ * Call a function on the latest event of every (student, subject) pair
+ */
+int parcourir_etats_inscriptions(int (*fonction)(const EvenementInscription*, void*), void *contexte) {
+    for (int m = 0; m < journal.nb_matieres; m++) {
+        const EvenementsMatiere *em = &journal.matieres[m];
+        for (int k = 0; k < em->nb; k++) {
+            const EvenementInscription *e = &journal.evenements[em->positions[k]];
+            if (dernier_evenement_inscription(e->id_etudiant, e->id_matiere) == e && !fonction(e, contexte)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Increasing order of student IDs
+static int comparer_ids(const void *a, const void *b) {
+    int ia = *(const int*)a;
+    int ib = *(const int*)b;
+    return (ia > ib) - (ia < ib);
+}
+
+/**
+ * Get the students enrolled in a subject at a given date
+ */
+int inscrits_a_la_date(int id_matiere, time_t date, int **ids_etudiants) {
+    *ids_etudiants = NULL;
+    int m;
+    if (!index_id_chercher(&journal.par_matiere, id_matiere, &m)) {
+        return 0;
+    }
+    const EvenementsMatiere *em = &journal.matieres[m];
+
+    // Events of the subject up to the date (binary search, they are chronological)
+    int debut = 0, fin = em->nb;
+    while (debut < fin) {
+        int milieu = debut + (fin - debut) / 2;
+        if (journal.evenements[em->positions[milieu]].date <= date) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu;
+        }
+    }
+    int nb_evenements = debut;
+
+    // Replay them: the last status of each student wins
+    int *ids = (int*)malloc((nb_evenements > 0 ? nb_evenements : 1) * sizeof(int));
+    int *statuts = (int*)malloc((nb_evenements > 0 ? nb_evenements : 1) * sizeof(int));
+    IndexId etudiants = {0};
+    if (ids == NULL || statuts == NULL) {
+        free(ids);
+        free(statuts);
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+    int nb = 0;
+    for (int k = 0; k < nb_evenements; k++) {
+        const EvenementInscription *e = &journal.evenements[em->positions[k]];
+        int i;
+        if (!index_id_chercher(&etudiants, e->id_etudiant, &i)) {
+            i = nb;
+            if (!index_id_inserer(&etudiants, e->id_etudiant, i)) {
+                nb = -1;
+                break;
+            }
+            ids[nb++] = e->id_etudiant;
+        }
+        statuts[i] = e->statut;
+    }
+    index_id_liberer(&etudiants);
+    if (nb < 0) {
+        free(ids);
+        free(statuts);
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+
+    int nb_inscrits = 0;
+    for (int i = 0; i < nb; i++) {
+        if (statuts[i] == 1) {
+            ids[nb_inscrits++] = ids[i];
+        }
+    }
+    free(statuts);
+    qsort(ids, nb_inscrits, sizeof(int), comparer_ids);
+    *ids_etudiants = ids;
+    return nb_inscrits;
+}
+
+/**
+ * Display the enrollment history of a subject
+ */
+void afficher_historique_matiere(int id_matiere) {
+    int m;
+    if (!index_id_chercher(&journal.par_matiere, id_matiere, &m)) {
+        printf("Aucun événement d'inscription pour la matière (ID: %d).\n", id_matiere);
+        return;
+    }
+    const EvenementsMatiere *em = &journal.matieres[m];
+
+    printf("\n=== Historique des Inscriptions de la Matière (ID: %d) ===\n", id_matiere);
+    printf("%-16s | %-11s | %-10s\n", "Date", "ID Étudiant", "Statut");
+    printf("-----------------------------------------------\n");
+    for (int k = 0; k < em->nb; k++) {
+        const EvenementInscription *e = &journal.evenements[em->positions[k]];
+        char date[20] = "(inconnue)";
+        if (e->date > 0) {
+            strftime(date, sizeof(date), "%d/%m/%Y %H:%M", localtime(&e->date));
+        }
+        printf("%-16s | %-11d | %-10s\n", date, e->id_etudiant, statut_inscription_to_string(e->statut));
+    }
+    printf("-----------------------------------------------\n");
+    printf("Nombre d'événements: %d\n", em->nb);
+    if (journal.debut > 0 && em->nb > 0 && journal.evenements[em->positions[0]].date < journal.debut) {
+        signaler_debut_journal();
+    }
+}
+
+/**
+ * Ask for a subject and a date and display the students enrolled at the end of that day
+ */
+void afficher_inscrits_a_la_date(void) {
+    int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
+    char texte[20];
+    get_input("Date (JJ/MM/AAAA): ", texte, sizeof(texte));
+    time_t jour = lire_date_jour(texte);
+    if (jour == (time_t)-1) {
+        printf("Date invalide.\n");
+        return;
+    }
+
+    // End of the day: every change made that day counts
+    struct tm fin_jour = *localtime(&jour);
+    fin_jour.tm_hour = 23;
+    fin_jour.tm_min = 59;
+    fin_jour.tm_sec = 59;
+    fin_jour.tm_isdst = -1;
+
+    int *ids;
+    int nb = inscrits_a_la_date(id_matiere, mktime(&fin_jour), &ids);
+    if (nb < 0) {
+        return;
+    }
+    printf("\n=== Inscrits à la Matière (ID: %d) le %s ===\n", id_matiere, texte);
+    if (nb == 0) {
+        printf("Aucun étudiant inscrit à cette date.\n");
+    }
+    for (int i = 0; i < nb; i++) {
+        printf("- Étudiant ID: %d\n", ids[i]);
+    }
+    printf("Nombre total d'inscrits: %d\n", nb);
+    if (journal.debut > 0 && jour < journal.debut) {
+        signaler_debut_journal();
+    }
+    free(ids);
+}
+
+/**
+ * Free the log loaded in memory
+ */
+void liberer_journal_inscriptions(void) {
+    for (int m = 0; m < journal.nb_matieres; m++) {
+        free(journal.matieres[m].positions);
+    }
+    free(journal.matieres);
+    free(journal.evenements);
+    index_id_liberer(&journal.par_couple);
+    index_id_liberer(&journal.par_matiere);
+    memset(&journal, 0, sizeof(journal));
+}
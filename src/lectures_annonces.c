@@ -0,0 +1,277 @@
+/**
+ * @file lectures_annonces.c
+ * @brief Implementation of the read markers and unread counters
+ */
+
+#include "../include/lectures_annonces.h"
+#include "../include/fil_annonces.h"
+#include "../include/index.h"
+#include "../include/tampon.h"
+#include "../include/utils.h"
+
+#define LECTURES_FILE "data/lectures_annonces.txt"
+#define EN_TETE_LECTURES "#lectures 1"
+
+/**
+ * Read markers of one student and their cached unread count
+ */
+typedef struct {
+    int id_etudiant;
+    EnsembleBits lues;                    // IDs of the announcements read
+    int non_lus;                          // Unread announcements of the feed, if valide
+    int valide;
+    unsigned long revision_annonces;      // Revision of the announcements file the count was made for
+    unsigned long long signature;         // Enrollments the count was made for
+} LecturesEtudiant;
+
+static struct {
+    LecturesEtudiant *etudiants;
+    int nb;
+    int capacite;
+    IndexId index; // Student ID -> position
+    int modifie;
+} lectures;
+
+// Markers of a student, created empty if needed
+static LecturesEtudiant* lectures_etudiant(int id_etudiant) {
+    int pos;
+    if (index_id_chercher(&lectures.index, id_etudiant, &pos)) {
+        return &lectures.etudiants[pos];
+    }
+
+    if (lectures.nb == lectures.capacite) {
+        int capacite = lectures.capacite ? lectures.capacite * 2 : 16;
+        LecturesEtudiant *etudiants = (LecturesEtudiant*)realloc(lectures.etudiants,
+                                                                 capacite * sizeof(LecturesEtudiant));
+        if (etudiants == NULL) {
+            return NULL;
+        }
+        lectures.etudiants = etudiants;
+        lectures.capacite = capacite;
+    }
+
+    pos = lectures.nb;
+    if (!index_id_inserer(&lectures.index, id_etudiant, pos)) {
+        return NULL;
+    }
+    lectures.nb++;
+
+    LecturesEtudiant *l = &lectures.etudiants[pos];
+    memset(l, 0, sizeof(LecturesEtudiant));
+    l->id_etudiant = id_etudiant;
+    return l;
+}
+
+/**
+ * Load the read markers from file
+ */
+int charger_lectures_annonces(void) {
+    liberer_lectures_annonces();
+
+    if (!file_exists(LECTURES_FILE)) {
+        return 1;
+    }
+    FILE *file = fopen(LECTURES_FILE, "r");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier des lectures d'annonces.\n");
+        return 0;
+    }
+
+    // id_etudiant|revision|signature|non_lus|words of the bitset in hexadecimal, comma-separated
+    Tampon ligne = {0};
+    int ok = 1;
+    while (ok && tampon_lire_ligne(&ligne, file)) {
+        if (ligne.donnees[0] == '#' || ligne.donnees[0] == '\0') {
+            continue;
+        }
+        char *champs[5] = {NULL};
+        char *curseur = ligne.donnees;
+        for (int i = 0; i < 5; i++) {
+            champs[i] = extraire_champ(&curseur);
+        }
+        if (champs[4] == NULL) {
+            continue;
+        }
+
+        LecturesEtudiant *l = lectures_etudiant(atoi(champs[0]));
+        if (l == NULL) {
+            ok = 0;
+            break;
+        }
+        l->revision_annonces = strtoul(champs[1], NULL, 10);
+        l->signature = strtoull(champs[2], NULL, 16);
+        l->non_lus = atoi(champs[3]);
+        l->valide = (l->non_lus >= 0);
+
+        int nb_mots = (*champs[4] != '\0') ? 1 : 0;
+        for (const char *c = champs[4]; *c != '\0'; c++) {
+            nb_mots += (*c == ',');
+        }
+        if (!ensemble_bits_initialiser(&l->lues, nb_mots * 64)) {
+            ok = 0;
+            break;
+        }
+        char *mot = champs[4];
+        for (int m = 0; m < nb_mots; m++) {
+            l->lues.mots[m] = strtoull(mot, &mot, 16);
+            if (*mot == ',') {
+                mot++;
+            }
+        }
+    }
+
+    tampon_liberer(&ligne);
+    fclose(file);
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+    return ok;
+}
+
+/**
+ * Save the read markers to file if they changed
+ */
+int sauvegarder_lectures_annonces(void) {
+    if (!lectures.modifie) {
+        return 1;
+    }
+
+    Tampon contenu = {0};
+    int ok = tampon_printf(&contenu, "%s\n", EN_TETE_LECTURES);
+    for (int i = 0; ok && i < lectures.nb; i++) {
+        const LecturesEtudiant *l = &lectures.etudiants[i];
+        ok = tampon_printf(&contenu, "%d|%lu|%llx|%d|", l->id_etudiant, l->valide ? l->revision_annonces : 0,
+                           l->signature, l->valide ? l->non_lus : -1);
+
+        // Trailing empty words are not written
+        int nb_mots = l->lues.nb_mots;
+        while (nb_mots > 0 && l->lues.mots[nb_mots - 1] == 0) {
+            nb_mots--;
+        }
+        for (int m = 0; ok && m < nb_mots; m++) {
+            ok = tampon_printf(&contenu, (m > 0) ? ",%llx" : "%llx", l->lues.mots[m]);
+        }
+        ok = ok && tampon_ajouter(&contenu, "\n", 1);
+    }
+
+    if (!ok || !tampon_ecrire_fichier(LECTURES_FILE, &contenu)) {
+        printf("Erreur: Impossible d'écrire le fichier des lectures d'annonces.\n");
+        tampon_liberer(&contenu);
+        return 0;
+    }
+    tampon_liberer(&contenu);
+    lectures.modifie = 0;
+    return 1;
+}
+
+/**
+ * Get the number of unread announcements of a student's feed
+ */
+int annonces_non_lues(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions) {
+    LecturesEtudiant *l = lectures_etudiant(id_etudiant);
+    if (l == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+
+    unsigned long long signature = signature_abonnements(id_etudiant, inscriptions);
+    if (l->valide && l->revision_annonces == annonces_revision() && l->signature == signature) {
+        return l->non_lus;
+    }
+
+    // The announcements or the enrollments changed since the count was made: count the feed once
+    const FilAnnonces *fil = fil_annonces_etudiant(id_etudiant, annonces, inscriptions);
+    if (fil == NULL) {
+        return -1;
+    }
+    l->non_lus = 0;
+    for (int i = 0; i < fil->nb_annonces; i++) {
+        l->non_lus += !ensemble_bits_contient(&l->lues, fil->annonces[i]->annonce.id);
+    }
+    l->revision_annonces = annonces_revision();
+    l->signature = signature;
+    l->valide = 1;
+    lectures.modifie = 1;
+    return l->non_lus;
+}
+
+/**
+ * Check whether a student has read an announcement
+ */
+int annonce_lue(int id_etudiant, int id_annonce) {
+    int pos;
+    if (!index_id_chercher(&lectures.index, id_etudiant, &pos)) {
+        return 0;
+    }
+    return ensemble_bits_contient(&lectures.etudiants[pos].lues, id_annonce);
+}
+
+/**
+ * Mark announcements of a student's feed as read
+ */
+int marquer_annonces_lues(int id_etudiant, NodeAnnonce* const *annonces, int nb) {
+    LecturesEtudiant *l = lectures_etudiant(id_etudiant);
+    if (l == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+
+    for (int i = 0; i < nb; i++) {
+        int id = annonces[i]->annonce.id;
+        if (ensemble_bits_contient(&l->lues, id)) {
+            continue;
+        }
+        if (!ensemble_bits_ajouter(&l->lues, id)) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            return 0;
+        }
+        if (l->valide && l->non_lus > 0) {
+            l->non_lus--;
+        }
+        lectures.modifie = 1;
+    }
+    return 1;
+}
+
+/**
+ * Display the unread announcements of a student's feed and mark them as read
+ */
+void afficher_annonces_non_lues(int id_etudiant, NodeAnnonce* annonces, NodeInscription* inscriptions,
+                                NodeMatiere* matieres) {
+    const FilAnnonces *fil = fil_annonces_etudiant(id_etudiant, annonces, inscriptions);
+    if (fil == NULL) {
+        return;
+    }
+
+    FilAnnonces non_lues = {id_etudiant, NULL, 0, 0};
+    non_lues.annonces = (NodeAnnonce**)malloc((fil->nb_annonces > 0 ? fil->nb_annonces : 1) * sizeof(NodeAnnonce*));
+    if (non_lues.annonces == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return;
+    }
+    for (int i = 0; i < fil->nb_annonces; i++) {
+        if (!annonce_lue(id_etudiant, fil->annonces[i]->annonce.id)) {
+            non_lues.annonces[non_lues.nb_annonces++] = fil->annonces[i];
+        }
+    }
+
+    if (non_lues.nb_annonces == 0) {
+        printf("Aucune nouvelle annonce.\n");
+    } else {
+        afficher_fil_annonces(&non_lues, matieres);
+        marquer_annonces_lues(id_etudiant, non_lues.annonces, non_lues.nb_annonces);
+    }
+    free(non_lues.annonces);
+}
+
+/**
+ * Free the read markers
+ */
+void liberer_lectures_annonces(void) {
+    for (int i = 0; i < lectures.nb; i++) {
+        ensemble_bits_liberer(&lectures.etudiants[i].lues);
+    }
+    free(lectures.etudiants);
+    index_id_liberer(&lectures.index);
+    memset(&lectures, 0, sizeof(lectures));
+}
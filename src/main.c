@@ -17,6 +17,7 @@
 #include "../include/annonces.h"
 #include "../include/notes.h"
 #include "../include/inscriptions.h"
+#include "../include/prerequis.h"
 
 /**
  * Main function - Entry point of the application
@@ -46,6 +47,7 @@ int main() {
     charger_etudiants(&etudiants);
     charger_enseignants(&enseignants);
     charger_matieres(&matieres);
+    charger_prerequis(matieres);
     charger_emploi_du_temps(&edt);
     
     int connected = 0;
@@ -4,16 +4,21 @@
  */
 
 #include "../include/matiere.h"
+#include "../include/prerequis.h"
 #include "../include/utils.h"
 
 #define MATIERES_FILE "data/matieres.txt"
 
+// Incremented whenever the subjects are (re)loaded or saved
+static unsigned long generation_matieres = 0;
+
 /**
  * Load subjects from file into a linked list
  */
 int charger_matieres(NodeMatiere** tete) {
     FILE *file;
     *tete = NULL;
+    generation_matieres++;
     
     create_data_dir();
     
@@ -40,12 +45,14 @@ int charger_matieres(NodeMatiere** tete) {
             return 0;
         }
         
-        // Parse the line (id|code_matiere|nom_matiere|coefficient)
-        sscanf(line, "%d|%[^|]|%[^|]|%f",
+        // Parse the line (id|code_matiere|nom_matiere|coefficient[|capacite])
+        nouveau_node->matiere.capacite = 0;
+        sscanf(line, "%d|%[^|]|%[^|]|%f|%d",
                &nouveau_node->matiere.id,
                nouveau_node->matiere.code_matiere,
                nouveau_node->matiere.nom_matiere,
-               &nouveau_node->matiere.coefficient);
+               &nouveau_node->matiere.coefficient,
+               &nouveau_node->matiere.capacite);
         
         // Add to the beginning of the list
         nouveau_node->suivant = *tete;
@@ -60,6 +67,8 @@ int charger_matieres(NodeMatiere** tete) {
  * Save subjects from linked list to file
  */
 int sauvegarder_matieres(NodeMatiere* tete) {
+    generation_matieres++;
+    
     FILE *file = fopen(MATIERES_FILE, "w");
     if (file == NULL) {
         printf("Erreur: Impossible d'ouvrir le fichier des matières en écriture.\n");
@@ -68,11 +77,12 @@ int sauvegarder_matieres(NodeMatiere* tete) {
     
     NodeMatiere* courant = tete;
     while (courant != NULL) {
-        fprintf(file, "%d|%s|%s|%.2f\n",
+        fprintf(file, "%d|%s|%s|%.2f|%d\n",
                 courant->matiere.id,
                 courant->matiere.code_matiere,
                 courant->matiere.nom_matiere,
-                courant->matiere.coefficient);
+                courant->matiere.coefficient,
+                courant->matiere.capacite);
         
         courant = courant->suivant;
     }
@@ -114,6 +124,8 @@ void ajouter_matiere(NodeMatiere** tete) {
     
     nouveau_node->matiere.coefficient = get_float_input("Coefficient (0.1-10.0): ", 0.1, 10.0);
     
+    nouveau_node->matiere.capacite = get_int_input("Capacité (0 pour illimitée): ", 0, 9999);
+    
     // Add to the beginning of the list
     nouveau_node->suivant = *tete;
     *tete = nouveau_node;
@@ -178,6 +190,13 @@ void modifier_matiere(NodeMatiere* tete) {
         matiere->matiere.coefficient = new_coef;
     }
     
+    snprintf(prompt, sizeof(prompt), "Capacité (0 pour illimitée) [actuelle: %d, -1 pour garder]: ", 
+             matiere->matiere.capacite);
+    int new_capacite = get_int_input(prompt, -1, 9999);
+    if (new_capacite >= 0) {
+        matiere->matiere.capacite = new_capacite;
+    }
+    
     // Save changes
     if (sauvegarder_matieres(tete)) {
         printf("Matière modifiée avec succès.\n");
@@ -241,6 +260,14 @@ void supprimer_matiere(NodeMatiere** tete) {
         } else {
             printf("Erreur lors de la sauvegarde des modifications.\n");
         }
+        
+        // A new subject may get the same ID: it must not inherit the links
+        int nb_liens = retirer_prerequis_matiere(id);
+        if (nb_liens < 0) {
+            printf("Erreur: Les prérequis de la matière n'ont pas pu être retirés.\n");
+        } else if (nb_liens > 0) {
+            printf("%d lien(s) de prérequis retiré(s).\n", nb_liens);
+        }
     } else {
         printf("Opération annulée.\n");
     }
@@ -256,22 +283,29 @@ void afficher_matieres(NodeMatiere* tete) {
     }
     
     printf("\n=== Liste des Matières ===\n");
-    printf("%-4s | %-15s | %-25s | %-10s\n", 
-           "ID", "Code", "Nom", "Coefficient");
-    printf("------------------------------------------------------------\n");
+    printf("%-4s | %-15s | %-25s | %-10s | %-9s\n", 
+           "ID", "Code", "Nom", "Coefficient", "Capacité");
+    printf("------------------------------------------------------------------------\n");
     
     NodeMatiere* courant = tete;
     while (courant != NULL) {
-        printf("%-4d | %-15s | %-25s | %-10.2f\n", 
+        char capacite[12];
+        if (courant->matiere.capacite > 0) {
+            snprintf(capacite, sizeof(capacite), "%d", courant->matiere.capacite);
+        } else {
+            strcpy(capacite, "Illimitée");
+        }
+        printf("%-4d | %-15s | %-25s | %-10.2f | %-9s\n", 
                courant->matiere.id,
                courant->matiere.code_matiere,
                courant->matiere.nom_matiere,
-               courant->matiere.coefficient);
+               courant->matiere.coefficient,
+               capacite);
         
         courant = courant->suivant;
     }
     
-    printf("============================================================\n\n");
+    printf("========================================================================\n\n");
 }
 
 /**
@@ -392,3 +426,10 @@ void liberer_matieres(NodeMatiere** tete) {
     
     *tete = NULL;
 }
+
+/**
+ * Get the subjects modification counter
+ */
+unsigned long matieres_generation(void) {
+    return generation_matieres;
+}
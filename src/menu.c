@@ -5,6 +5,26 @@
 
 #include "../include/menu.h"
 #include "../include/utils.h"
+#include "../include/moyennes.h"
+#include "../include/gestion_etudiants.h"
+#include "../include/gestion_matieres.h"
+#include "../include/statistiques.h"
+#include "../include/rapports.h"
+#include "../include/parallele.h"
+#include "../include/bulletins.h"
+#include "../include/colonnes_notes.h"
+#include "../include/planning.h"
+#include "../include/reparation_edt.h"
+#include "../include/vues_edt.h"
+#include "../include/calendriers_ics.h"
+#include "../include/salle.h"
+#include "../include/occupation_salles.h"
+#include "../include/examens.h"
+#include "../include/fil_annonces.h"
+#include "../include/recherche_annonces.h"
+#include "../include/lectures_annonces.h"
+#include "../include/journal_inscriptions.h"
+#include "../include/prerequis.h"
 
 /**
  * Display the admin menu and handle admin operations
@@ -24,6 +44,12 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
     NodeInscription* inscriptions = NULL;
     charger_inscriptions(&inscriptions);
     
+    Planning planning;
+    charger_planning(&planning);
+    
+    NodeSalle* salles = NULL;
+    charger_salles(&salles);
+    
     do {
         clear_screen();
         printf("\n=== Menu Administrateur ===\n");
@@ -36,9 +62,10 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
         printf("7. Gestion des Notes\n");
         printf("8. Gestion des Inscriptions\n");
         printf("9. Rapports et Statistiques\n");
+        printf("10. Gestion des Salles\n");
         printf("0. Déconnexion\n");
         
-        choix = get_int_input("Choisissez une option: ", 0, 9);
+        choix = get_int_input("Choisissez une option: ", 0, 10);
         
         switch (choix) {
             case 1: {
@@ -211,9 +238,10 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                     printf("3. Ajouter une matière\n");
                     printf("4. Modifier une matière\n");
                     printf("5. Supprimer une matière\n");
+                    printf("6. Prérequis des matières\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 5);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 6);
                     
                     switch (sous_choix) {
                         case 1:
@@ -230,12 +258,17 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             break;
                         case 4:
                             modifier_matiere(*matieres);
+                            // A raised capacity frees seats for the waitlists
+                            promouvoir_liste_attente(&inscriptions, *matieres, 0);
                             pause_screen();
                             break;
                         case 5:
                             supprimer_matiere(matieres);
                             pause_screen();
                             break;
+                        case 6:
+                            menu_prerequis(*matieres);
+                            break;
                     }
                 } while (sous_choix != 0);
                 break;
@@ -251,31 +284,99 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                     printf("3. Ajouter un créneau\n");
                     printf("4. Modifier un créneau\n");
                     printf("5. Supprimer un créneau\n");
+                    printf("6. Création manuelle de l'emploi du temps\n");
+                    printf("7. Générer le planning de toutes les sections\n");
+                    printf("8. Consulter le planning (section, enseignant, salle)\n");
+                    printf("9. Réparer après l'indisponibilité d'un enseignant\n");
+                    printf("10. Exporter les calendriers (.ics)\n");
+                    printf("11. Planifier les examens\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 5);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 11);
                     
                     switch (sous_choix) {
                         case 1:
-                            afficher_emploi_du_temps(edt);
+                            afficher_emploi_du_temps(edt, *matieres, *enseignants);
                             pause_screen();
                             break;
                         case 2:
-                        creation_manuelle_emploi_du_temps(edt,  *enseignants) ;
-                            pause_screen();                          
+                            generer_emploi_du_temps(edt, *enseignants, *matieres);
+                            pause_screen();
                             break;
                         case 3:
-                            ajouter_creneau(edt, *enseignants, *matieres);
+                            ajouter_creneau(edt, *enseignants, *matieres, &planning);
                             pause_screen();
                             break;
                         case 4:
-                            modifier_creneau(edt, *enseignants, *matieres);
+                            modifier_creneau(edt, *enseignants, *matieres, &planning);
                             pause_screen();
                             break;
                         case 5:
-                            supprimer_creneau(edt);
+                            supprimer_creneau(edt, *matieres, *enseignants);
+                            pause_screen();
+                            break;
+                        case 6:
+                        creation_manuelle_emploi_du_temps(edt,  *enseignants) ;
+                            pause_screen();                          
+                            break;
+                        case 7:
+                            generer_planning(&planning, *enseignants, *matieres, *etudiants);
+                            pause_screen();
+                            break;
+                        case 8:
+                            consulter_planning(&planning, *matieres, *enseignants);
+                            pause_screen();
+                            break;
+                        case 9:
+                            reparer_apres_indisponibilite(edt, &planning, *enseignants);
                             pause_screen();
                             break;
+                        case 10: {
+                            // Calendriers iCalendar de chaque enseignant, section et étudiant
+                            char date[20];
+                            time_t maintenant = time(NULL);
+                            struct tm debut = *localtime(&maintenant);
+                            get_input("Date de début du semestre (JJ/MM/AAAA, vide = cette semaine): ", date, sizeof(date));
+                            if (date[0] != '\0') {
+                                int jour, mois, annee;
+                                if (sscanf(date, "%d/%d/%d", &jour, &mois, &annee) != 3 ||
+                                    jour < 1 || jour > 31 || mois < 1 || mois > 12 || annee < 1970) {
+                                    printf("Erreur: Date invalide.\n");
+                                    pause_screen();
+                                    break;
+                                }
+                                memset(&debut, 0, sizeof(debut));
+                                debut.tm_mday = jour;
+                                debut.tm_mon = mois - 1;
+                                debut.tm_year = annee - 1900;
+                            }
+                            int nb_semaines = get_int_input("Nombre de semaines: ", 1, MAX_SEMAINES_CALENDRIER);
+                            
+                            ResultatCalendriers resultat;
+                            if (exporter_calendriers(REPERTOIRE_CALENDRIERS, &debut, nb_semaines, edt, &planning,
+                                                     *etudiants, *enseignants, *matieres, inscriptions, &resultat)) {
+                                printf("\n%d calendrier(s) écrit(s) dans %s/ (%d séance(s), %d événement(s), %zu octets) en %.2f ms.\n",
+                                       resultat.nb_fichiers, REPERTOIRE_CALENDRIERS, resultat.nb_seances,
+                                       resultat.nb_evenements, resultat.nb_octets, resultat.duree_ms);
+                                if (resultat.nb_erreurs > 0) {
+                                    printf("Erreur: %d calendrier(s) ou séance(s) n'ont pas pu être exportés.\n",
+                                           resultat.nb_erreurs);
+                                }
+                            }
+                            pause_screen();
+                            break;
+                        }
+                        case 11: {
+                            // Examens sans conflit pour les étudiants
+                            int periodes_par_jour = get_int_input("Nombre de périodes d'examen par jour (1-4): ", 1, 4);
+                            PlanningExamens examens;
+                            if (planifier_examens(&examens, inscriptions, salles)) {
+                                afficher_planning_examens(&examens, *matieres, periodes_par_jour);
+                                liberer_planning_examens(&examens);
+                            }
+                            pause_screen();
+                            break;
+                        }
                     }
                 } while (sous_choix != 0);
                 break;
@@ -290,9 +391,13 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                     printf("2. Créer une nouvelle annonce\n");
                     printf("3. Modifier une annonce\n");
                     printf("4. Supprimer une annonce\n");
+                    printf("5. Afficher les dernières annonces\n");
+                    printf("6. Afficher les annonces d'une période\n");
+                    printf("7. Archiver les annonces expirées\n");
+                    printf("8. Rechercher des annonces\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 4);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 8);
                     
                     switch (sous_choix) {
                         case 1:
@@ -330,46 +435,23 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             printf("Laissez vide pour garder la valeur actuelle.\n");
                             
                             // Get new values or keep current ones
-                            char buffer[1024];
+                            char buffer[256];
                             
-                            get_input_formatted("Titre [actuel: %s]: ", buffer, sizeof(buffer), annonce->annonce.titre);
-                            if (strlen(buffer) > 0) {
-                                strcpy(annonce->annonce.titre, buffer);
-                            }
+                            get_input_formatted("Titre [actuel: %s]: ", buffer, sizeof(buffer), annonce_titre(annonce));
                             
-                            printf("Contenu actuel:\n%s\n", annonce->annonce.contenu);
+                            printf("Contenu actuel:\n%s\n", annonce_contenu(annonce));
                             printf("Nouveau contenu (tapez 'fin' sur une nouvelle ligne pour terminer, ou juste 'fin' pour garder l'actuel):\n");
                             
-                            char content_buffer[1024] = {0};
-                            char line[100];
-                            fgets(line, sizeof(line), stdin); // Clear any previous input
-                            line[strcspn(line, "\n")] = 0; // Remove trailing newline
+                            Tampon contenu = {0};
+                            int nouveau_contenu = saisir_contenu_annonce(&contenu) > 0;
                             
-                            if (strcmp(line, "fin") != 0) {
-                                strcat(content_buffer, line);
-                                strcat(content_buffer, "\n");
-                                
-                                while (1) {
-                                    fgets(line, sizeof(line), stdin);
-                                    line[strcspn(line, "\n")] = 0; // Remove trailing newline
-                                    
-                                    if (strcmp(line, "fin") == 0) {
-                                        break;
-                                    }
-                                    
-                                    strcat(content_buffer, line);
-                                    strcat(content_buffer, "\n");
-                                    
-                                    if (strlen(content_buffer) + 10 >= sizeof(annonce->annonce.contenu)) {
-                                        printf("Contenu trop long, arrêt.\n");
-                                        break;
-                                    }
-                                }
-                                
-                                if (strlen(content_buffer) > 0) {
-                                    strncpy(annonce->annonce.contenu, content_buffer, sizeof(annonce->annonce.contenu) - 1);
-                                    annonce->annonce.contenu[sizeof(annonce->annonce.contenu) - 1] = '\0';
-                                }
+                            // Update auteur to indicate admin edit
+                            int ok = changer_textes_annonce(&annonces, &annonce, strlen(buffer) > 0 ? buffer : NULL,
+                                                            nouveau_contenu ? contenu.donnees : NULL, "Administrateur");
+                            tampon_liberer(&contenu);
+                            if (!ok) {
+                                pause_screen();
+                                continue;
                             }
                             
                             // Update matière
@@ -381,14 +463,8 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                                 annonce->annonce.id_matiere = new_matiere_id;
                             }
                             
-                            // Update auteur to indicate admin edit
-                            strcpy(annonce->annonce.auteur, "Administrateur");
-                            
                             // Update creation date
-                            time_t now = time(NULL);
-                            struct tm *t = localtime(&now);
-                            strftime(annonce->annonce.date_creation, sizeof(annonce->annonce.date_creation), 
-                                     "%d/%m/%Y %H:%M", t);
+                            annonce->annonce.date_creation = time(NULL);
                             
                             // Save changes
                             if (sauvegarder_annonces(annonces)) {
@@ -429,7 +505,7 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             // Admin can delete any announcement
                             
                             // Confirmation
-                            printf("Êtes-vous sûr de vouloir supprimer l'annonce '%s'?\n", courant->annonce.titre);
+                            printf("Êtes-vous sûr de vouloir supprimer l'annonce '%s'?\n", annonce_titre(courant));
                             int confirmation = get_int_input("1. Oui, 2. Non: ", 1, 2);
                             
                             if (confirmation == 1) {
@@ -441,6 +517,7 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                                     precedent->suivant = courant->suivant;
                                 }
                                 
+                                recherche_retirer_annonce(courant);
                                 free(courant);
                                 
                                 // Save changes
@@ -456,6 +533,57 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             pause_screen();
                             break;
                         }
+                        case 5: {
+                            int n = get_int_input("Nombre d'annonces à afficher: ", 1, 1000);
+                            NodeAnnonce* const *selection;
+                            int nb = annonces_recentes(annonces, n, &selection);
+                            printf("\n=== %d dernière(s) annonce(s) ===\n", nb);
+                            afficher_selection_annonces(selection, nb);
+                            pause_screen();
+                            break;
+                        }
+                        case 6: {
+                            char date[20];
+                            get_input("Du (JJ/MM/AAAA): ", date, sizeof(date));
+                            time_t debut = lire_date_annonce(date);
+                            get_input("Au (JJ/MM/AAAA, inclus, vide = aujourd'hui): ", date, sizeof(date));
+                            time_t fin = (date[0] == '\0') ? time(NULL) : lire_date_annonce(date);
+                            if (debut == (time_t)-1 || fin == (time_t)-1) {
+                                printf("Erreur: Date invalide.\n");
+                                pause_screen();
+                                break;
+                            }
+                            
+                            // The end day is included
+                            struct tm jour_fin = *localtime(&fin);
+                            jour_fin.tm_hour = 0;
+                            jour_fin.tm_min = 0;
+                            jour_fin.tm_sec = 0;
+                            jour_fin.tm_mday++;
+                            jour_fin.tm_isdst = -1;
+                            fin = mktime(&jour_fin);
+                            
+                            NodeAnnonce* const *selection;
+                            int nb = annonces_periode(annonces, debut, fin, &selection);
+                            printf("\n=== %d annonce(s) sur la période ===\n", nb);
+                            afficher_selection_annonces(selection, nb);
+                            pause_screen();
+                            break;
+                        }
+                        case 7: {
+                            int nb = archiver_annonces_expirees(&annonces, time(NULL));
+                            if (nb > 0 && sauvegarder_annonces(annonces)) {
+                                printf("%d annonce(s) expirée(s) archivée(s).\n", nb);
+                            } else if (nb == 0) {
+                                printf("Aucune annonce expirée.\n");
+                            }
+                            pause_screen();
+                            break;
+                        }
+                        case 8:
+                            rechercher_et_afficher_annonces(annonces);
+                            pause_screen();
+                            break;
                     }
                 } while (sous_choix != 0);
                 break;
@@ -520,9 +648,12 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                     printf("3. Afficher les inscriptions par matière\n");
                     printf("4. Inscrire un étudiant à un cours\n");
                     printf("5. Désinscrire un étudiant d'un cours\n");
+                    printf("6. Historique des inscriptions d'une matière\n");
+                    printf("7. Inscrits à une matière à une date\n");
+                    printf("8. Inscrire une section ou une filière\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 5);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 8);
                     
                     switch (sous_choix) {
                         case 1:
@@ -538,23 +669,38 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                         case 3: {
                             int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
                             afficher_inscriptions_par_matiere(inscriptions, id_matiere);
+                            afficher_places_matiere(inscriptions, *matieres, id_matiere);
                             pause_screen();
                             break;
                         }
                         case 4: {
                             int id_etudiant = get_int_input("Entrez l'ID de l'étudiant: ", 1, 9999);
                             int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
-                            inscrire_etudiant_cours(&inscriptions, id_etudiant, id_matiere);
+                            inscrire_etudiant_cours(&inscriptions, *matieres, notes, id_etudiant, id_matiere);
                             pause_screen();
                             break;
                         }
                         case 5: {
                             int id_etudiant = get_int_input("Entrez l'ID de l'étudiant: ", 1, 9999);
                             int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
-                            desinscrire_etudiant_cours(&inscriptions, id_etudiant, id_matiere);
+                            desinscrire_etudiant_cours(&inscriptions, *matieres, id_etudiant, id_matiere);
+                            pause_screen();
+                            break;
+                        }
+                        case 6: {
+                            int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
+                            afficher_historique_matiere(id_matiere);
                             pause_screen();
                             break;
                         }
+                        case 7:
+                            afficher_inscrits_a_la_date();
+                            pause_screen();
+                            break;
+                        case 8:
+                            saisir_inscription_groupe(&inscriptions, *etudiants, *matieres, notes);
+                            pause_screen();
+                            break;
                     }
                 } while (sous_choix != 0);
                 break;
@@ -568,9 +714,13 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                     printf("1. Statistiques des Étudiants\n");
                     printf("2. Statistiques des Matières\n");
                     printf("3. Rapports de Performance\n");
+                    printf("4. Rapport individuel d'un étudiant\n");
+                    printf("5. Distribution des notes d'une matière\n");
+                    printf("6. Rapports de fin de semestre (multi-thread)\n");
+                    printf("7. Générer les bulletins de tous les étudiants\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 3);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 7);
                     
                     switch (sous_choix) {
                         case 1: {
@@ -588,8 +738,8 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             
                             printf("Nombre total d'étudiants: %d\n\n", nombre_etudiants);
                             
-                            // Print top 5 students by average grade
-                            printf("Top 5 des étudiants par moyenne:\n");
+                            // Print top 5 students by weighted average grade
+                            printf("Top 5 des étudiants par moyenne pondérée:\n");
                             printf("%-4s | %-30s | %-10s\n", "ID", "Nom", "Moyenne");
                             printf("----------------------------------------------\n");
                             
@@ -603,7 +753,7 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             etudiant_courant = *etudiants;
                             while (etudiant_courant != NULL && num_students < max_students) {
                                 student_ids[num_students] = etudiant_courant->etudiant.id;
-                                student_averages[num_students] = calculer_moyenne_etudiant(notes, etudiant_courant->etudiant.id);
+                                student_averages[num_students] = calculer_moyenne_ponderee_etudiant(notes, *matieres, etudiant_courant->etudiant.id);
                                 num_students++;
                                 etudiant_courant = etudiant_courant->suivant;
                             }
@@ -709,7 +859,7 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             
                             printf("Moyenne générale de l'établissement: %.2f\n\n", moyenne_generale);
                             
-                            // Count students with average above 10
+                            // Count students with weighted average above 10
                             int nb_etudiants_reussite = 0;
                             int nb_etudiants_total = 0;
                             
@@ -717,7 +867,7 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             while (etudiant_courant != NULL) {
                                 nb_etudiants_total++;
                                 
-                                float moyenne_etudiant = calculer_moyenne_etudiant(notes, etudiant_courant->etudiant.id);
+                                float moyenne_etudiant = calculer_moyenne_ponderee_etudiant(notes, *matieres, etudiant_courant->etudiant.id);
                                 if (moyenne_etudiant >= 10.0f) {
                                     nb_etudiants_reussite++;
                                 }
@@ -727,12 +877,101 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
                             
                             float taux_reussite = (nb_etudiants_total > 0) ? ((float)nb_etudiants_reussite / nb_etudiants_total * 100.0f) : 0.0f;
                             
-                            printf("Taux de réussite (moyenne >= 10): %.2f%% (%d sur %d étudiants)\n", 
+                            printf("Taux de réussite (moyenne pondérée >= 10): %.2f%% (%d sur %d étudiants)\n", 
                                    taux_reussite, nb_etudiants_reussite, nb_etudiants_total);
                             
                             pause_screen();
                             break;
                         }
+                        case 4:
+                            // Rapport individuel d'un étudiant
+                            afficher_rapport_etudiant(*etudiants, notes, inscriptions, *matieres);
+                            pause_screen();
+                            break;
+                        case 5: {
+                            // Distribution des notes d'une matière
+                            int id_matiere = get_int_input("Entrez l'ID de la matière: ", 1, 9999);
+                            afficher_details_matiere(*matieres, notes, *etudiants, id_matiere);
+                            pause_screen();
+                            break;
+                        }
+                        case 6: {
+                            // Rapports de fin de semestre
+                            int nb_threads = get_int_input("Nombre de threads (0 = automatique): ", 0, MAX_THREADS);
+                            RapportFinSemestre rapport;
+                            if (generer_rapport_fin_semestre(&rapport, notes, *matieres, *etudiants, nb_threads)) {
+                                afficher_rapport_fin_semestre(&rapport, *matieres, *etudiants);
+                                liberer_rapport_fin_semestre(&rapport);
+                            }
+                            pause_screen();
+                            break;
+                        }
+                        case 7: {
+                            // Bulletins de tous les étudiants
+                            printf("1. Un fichier par étudiant\n");
+                            printf("2. Un fichier unique\n");
+                            int format = get_int_input("Choisissez le format: ", 1, 2);
+                            int nb_threads = get_int_input("Nombre de threads (0 = automatique): ", 0, MAX_THREADS);
+                            
+                            ResultatBulletins resultat;
+                            if (generer_bulletins(REPERTOIRE_BULLETINS, format == 2, nb_threads, *etudiants,
+                                                  notes, inscriptions, *matieres, &resultat)) {
+                                printf("\n%d bulletin(s) généré(s) dans %s/ avec %d thread(s) en %.2f ms.\n",
+                                       resultat.nb_bulletins, REPERTOIRE_BULLETINS,
+                                       resultat.nb_threads, resultat.duree_ms);
+                                if (resultat.nb_erreurs > 0) {
+                                    printf("Erreur: %d bulletin(s) n'ont pas pu être écrits.\n", resultat.nb_erreurs);
+                                }
+                            }
+                            pause_screen();
+                            break;
+                        }
+                    }
+                } while (sous_choix != 0);
+                break;
+            }
+            case 10: {
+                // Gestion des Salles
+                int sous_choix = 0;
+                do {
+                    clear_screen();
+                    printf("\n=== Gestion des Salles ===\n");
+                    printf("1. Afficher toutes les salles\n");
+                    printf("2. Ajouter une salle\n");
+                    printf("3. Modifier une salle\n");
+                    printf("4. Supprimer une salle\n");
+                    printf("5. Occupation et capacité des salles\n");
+                    printf("0. Retour\n");
+                    
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 5);
+                    
+                    switch (sous_choix) {
+                        case 1:
+                            afficher_salles(salles);
+                            pause_screen();
+                            break;
+                        case 2:
+                            ajouter_salle(&salles);
+                            pause_screen();
+                            break;
+                        case 3:
+                            modifier_salle(salles);
+                            pause_screen();
+                            break;
+                        case 4:
+                            supprimer_salle(&salles);
+                            pause_screen();
+                            break;
+                        case 5: {
+                            AnalyseSalles analyse;
+                            if (analyser_occupation_salles(&analyse, salles, edt, &planning,
+                                                           *etudiants, inscriptions)) {
+                                afficher_occupation_salles(&analyse, *matieres);
+                                liberer_occupation_salles(&analyse);
+                            }
+                            pause_screen();
+                            break;
+                        }
                     }
                 } while (sous_choix != 0);
                 break;
@@ -741,9 +980,14 @@ void menu_admin(Utilisateur utilisateurs[], int *nb_utilisateurs,
     } while (choix != 0);
     
     // Free resources
+    liberer_salles(&salles);
     liberer_annonces(&annonces);
     liberer_notes(&notes);
     liberer_inscriptions(&inscriptions);
+    liberer_planning(&planning);
+    liberer_cache_moyennes();
+    liberer_statistiques();
+    liberer_colonnes_notes();
 }
 
 /**
@@ -769,6 +1013,9 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
     NodeNote* notes = NULL;
     charger_notes(&notes);
     
+    Planning planning;
+    charger_planning(&planning);
+    
     do {
         clear_screen();
         printf("\n=== Menu Enseignant ===\n");
@@ -795,9 +1042,10 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
                     printf("3. Créer une nouvelle annonce\n");
                     printf("4. Modifier une annonce\n");
                     printf("5. Supprimer une annonce\n");
+                    printf("6. Rechercher des annonces\n");
                     printf("0. Retour\n");
                     
-                    sous_choix = get_int_input("Choisissez une option: ", 0, 5);
+                    sous_choix = get_int_input("Choisissez une option: ", 0, 6);
                     
                     switch (sous_choix) {
                         case 1:
@@ -813,13 +1061,17 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
                             pause_screen();
                             break;
                         case 4:
-                            modifier_annonce(annonces, id_enseignant);
+                            modifier_annonce(&annonces, id_enseignant);
                             pause_screen();
                             break;
                         case 5:
                             supprimer_annonce(&annonces, id_enseignant);
                             pause_screen();
                             break;
+                        case 6:
+                            rechercher_et_afficher_annonces(annonces);
+                            pause_screen();
+                            break;
                     }
                 } while (sous_choix != 0);
                 break;
@@ -916,7 +1168,8 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
                                 afficher_notes_par_etudiant(notes, id_etudiant);
                                 
                                 // Afficher la moyenne de l'étudiant
-                                printf("\nMoyenne générale: %.2f\n", calculer_moyenne_etudiant(notes, id_etudiant));
+                                printf("\nMoyenne générale pondérée: %.2f\n",
+                                       calculer_moyenne_ponderee_etudiant(notes, matieres, id_etudiant));
                             } else {
                                 printf("Étudiant avec ID %d non trouvé.\n", id_etudiant);
                             }
@@ -1034,7 +1287,9 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
                 
             case 6:
                 // Consulter l'Emploi du Temps
-                afficher_emploi_du_temps(edt);
+                clear_screen();
+                afficher_emploi_du_temps_personnel(emploi_du_temps_enseignant(id_enseignant, edt, &planning),
+                                                   matieres, enseignants);
                 pause_screen();
                 break;
         }
@@ -1043,6 +1298,11 @@ void menu_enseignant(int id_enseignant, NodeEtudiant* etudiants,
     // Free resources
     liberer_annonces(&annonces);
     liberer_notes(&notes);
+    liberer_cache_moyennes();
+    liberer_statistiques();
+    liberer_colonnes_notes();
+    liberer_planning(&planning);
+    liberer_emplois_du_temps_personnels();
 }
 
 /**
@@ -1071,10 +1331,20 @@ void menu_etudiant(int id_etudiant, NodeEtudiant* etudiants,
     NodeInscription* inscriptions = NULL;
     charger_inscriptions(&inscriptions);
     
+    Planning planning;
+    charger_planning(&planning);
+    
+    charger_lectures_annonces();
+    
     do {
         clear_screen();
         printf("\n=== Menu Étudiant ===\n");
         printf("Bienvenue, %s %s\n", etudiant->etudiant.prenom, etudiant->etudiant.nom);
+        int non_lues = annonces_non_lues(id_etudiant, annonces, inscriptions);
+        if (non_lues > 0) {
+            printf("Vous avez %d nouvelle(s) annonce(s).\n", non_lues);
+        }
+        sauvegarder_lectures_annonces();
         printf("1. Consulter les Annonces\n");
         printf("2. Consulter mes Notes\n");
         printf("3. Gestion des Inscriptions aux Cours\n");
@@ -1082,18 +1352,25 @@ void menu_etudiant(int id_etudiant, NodeEtudiant* etudiants,
         printf("5. Consulter les Enseignants\n");
         printf("6. Consulter les Matières\n");
         printf("7. Consulter l'Emploi du Temps\n");
+        printf("8. Consulter les Annonces non lues\n");
         printf("0. Déconnexion\n");
         
-        choix = get_int_input("Choisissez une option: ", 0, 7);
+        choix = get_int_input("Choisissez une option: ", 0, 8);
         
         switch (choix) {
-            case 1:
+            case 1: {
                 // Consulter les Annonces
                 clear_screen();
                 printf("\n=== Annonces ===\n");
-                afficher_annonces(annonces);
+                const FilAnnonces *fil = fil_annonces_etudiant(id_etudiant, annonces, inscriptions);
+                afficher_fil_annonces(fil, matieres);
+                if (fil != NULL) {
+                    marquer_annonces_lues(id_etudiant, fil->annonces, fil->nb_annonces);
+                    sauvegarder_lectures_annonces();
+                }
                 pause_screen();
                 break;
+            }
                 
             case 2:
                 // Consulter mes Notes
@@ -1105,7 +1382,7 @@ void menu_etudiant(int id_etudiant, NodeEtudiant* etudiants,
                 
             case 3:
                 // Gestion des Inscriptions aux Cours
-                menu_inscriptions_etudiant(&inscriptions, id_etudiant);
+                menu_inscriptions_etudiant(&inscriptions, matieres, notes, id_etudiant);
                 break;
                 
             case 4: {
@@ -1190,7 +1467,19 @@ void menu_etudiant(int id_etudiant, NodeEtudiant* etudiants,
                 
             case 7:
                 // Consulter l'Emploi du Temps
-                afficher_emploi_du_temps(edt);
+                clear_screen();
+                afficher_emploi_du_temps_personnel(emploi_du_temps_etudiant(&etudiant->etudiant, edt, &planning,
+                                                                            inscriptions),
+                                                   matieres, enseignants);
+                pause_screen();
+                break;
+                
+            case 8:
+                // Consulter les Annonces non lues
+                clear_screen();
+                printf("\n=== Annonces non lues ===\n");
+                afficher_annonces_non_lues(id_etudiant, annonces, inscriptions, matieres);
+                sauvegarder_lectures_annonces();
                 pause_screen();
                 break;
         }
@@ -1200,4 +1489,8 @@ void menu_etudiant(int id_etudiant, NodeEtudiant* etudiants,
     liberer_annonces(&annonces);
     liberer_notes(&notes);
     liberer_inscriptions(&inscriptions);
+    liberer_planning(&planning);
+    liberer_emplois_du_temps_personnels();
+    liberer_fil_annonces();
+    liberer_lectures_annonces();
 }
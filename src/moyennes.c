@@ -0,0 +1,232 @@
+/**
+ * @file moyennes.c
+ * @brief Implementation of the weighted average engine
+ */
+
+#include "../include/moyennes.h"
+#include "../include/index.h"
+#include "../include/colonnes_notes.h"
+
+/**
+ * Cache of weighted averages, rebuilt only when grades or subjects change
+ */
+typedef struct {
+    int valide;
+    NodeNote* notes;
+    NodeMatiere* matieres;
+    unsigned long generation_notes;
+    unsigned long generation_matieres;
+    MoyenneEtudiant *etudiants;
+    int nb_etudiants;
+    MoyenneMatiereEtudiant *details;
+    int nb_details;
+    IndexId index_etudiants; // id_etudiant -> position in etudiants
+} CacheMoyennes;
+
+static CacheMoyennes cache = {0};
+
+// Release the arrays of the cache
+static void vider_cache(void) {
+    free(cache.etudiants);
+    free(cache.details);
+    cache.etudiants = NULL;
+    cache.details = NULL;
+    cache.nb_etudiants = 0;
+    cache.nb_details = 0;
+    index_id_liberer(&cache.index_etudiants);
+    cache.valide = 0;
+}
+
+// Rebuild the cache with one pass over the grades
+static int construire_cache(NodeNote* notes, NodeMatiere* matieres) {
+    vider_cache();
+
+    const ColonnesNotes *colonnes = obtenir_colonnes_notes(notes);
+    if (colonnes == NULL) {
+        return 0;
+    }
+    int nb_notes = colonnes->nb;
+
+    // Index subject coefficients by ID
+    IndexId index_matieres = {0};
+    int nb_matieres = 0;
+    for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+        nb_matieres++;
+    }
+
+    float *coefficients = (float*)malloc((nb_matieres + 1) * sizeof(float));
+    // One accumulator per (student, subject) pair, at most one per grade
+    int *paire_etudiant = (int*)malloc((nb_notes + 1) * sizeof(int));
+    int *paire_matiere = (int*)malloc((nb_notes + 1) * sizeof(int));
+    double *paire_somme = (double*)malloc((nb_notes + 1) * sizeof(double));
+    int *paire_nb = (int*)malloc((nb_notes + 1) * sizeof(int));
+    IndexId index_paires = {0};
+
+    cache.etudiants = (MoyenneEtudiant*)calloc(nb_notes + 1, sizeof(MoyenneEtudiant));
+    cache.details = (MoyenneMatiereEtudiant*)malloc((nb_notes + 1) * sizeof(MoyenneMatiereEtudiant));
+
+    int ok = coefficients != NULL && paire_etudiant != NULL && paire_matiere != NULL &&
+             paire_somme != NULL && paire_nb != NULL &&
+             cache.etudiants != NULL && cache.details != NULL &&
+             index_id_initialiser(&index_matieres, nb_matieres) &&
+             index_id_initialiser(&index_paires, nb_notes) &&
+             index_id_initialiser(&cache.index_etudiants, nb_notes);
+
+    int i = 0;
+    for (NodeMatiere* m = matieres; ok && m != NULL; m = m->suivant) {
+        coefficients[i] = m->matiere.coefficient;
+        ok = index_id_inserer(&index_matieres, m->matiere.id, i);
+        i++;
+    }
+
+    // Single pass over the grade columns: accumulate per (student, subject)
+    int nb_paires = 0;
+    for (int n = 0; ok && n < nb_notes; n++) {
+        int id_etudiant = colonnes->id_etudiant[n];
+        int id_matiere = colonnes->id_matiere[n];
+        long long cle = index_cle_composee(id_etudiant, id_matiere);
+        int paire;
+
+        if (!index_id_chercher(&index_paires, cle, &paire)) {
+            paire = nb_paires++;
+            paire_etudiant[paire] = id_etudiant;
+            paire_matiere[paire] = id_matiere;
+            paire_somme[paire] = 0.0;
+            paire_nb[paire] = 0;
+            ok = index_id_inserer(&index_paires, cle, paire);
+
+            int pos;
+            if (ok && !index_id_chercher(&cache.index_etudiants, id_etudiant, &pos)) {
+                pos = cache.nb_etudiants++;
+                cache.etudiants[pos].id_etudiant = id_etudiant;
+                ok = index_id_inserer(&cache.index_etudiants, id_etudiant, pos);
+            }
+            if (ok) {
+                cache.etudiants[pos].nb_matieres++;
+            }
+        }
+
+        paire_somme[paire] += colonnes->note[n];
+        paire_nb[paire]++;
+    }
+
+    if (ok) {
+        // Lay out the subject averages grouped by student
+        int debut = 0;
+        for (int e = 0; e < cache.nb_etudiants; e++) {
+            cache.etudiants[e].premier_detail = debut;
+            debut += cache.etudiants[e].nb_matieres;
+            cache.etudiants[e].nb_matieres = 0;
+        }
+
+        double *somme_ponderee = (double*)calloc(cache.nb_etudiants + 1, sizeof(double));
+        ok = somme_ponderee != NULL;
+
+        for (int p = 0; ok && p < nb_paires; p++) {
+            int e, m;
+            index_id_chercher(&cache.index_etudiants, paire_etudiant[p], &e);
+
+            float coefficient = COEFFICIENT_PAR_DEFAUT;
+            if (index_id_chercher(&index_matieres, paire_matiere[p], &m)) {
+                coefficient = coefficients[m];
+            }
+
+            MoyenneEtudiant *etudiant = &cache.etudiants[e];
+            MoyenneMatiereEtudiant *detail = &cache.details[etudiant->premier_detail + etudiant->nb_matieres];
+            detail->id_matiere = paire_matiere[p];
+            detail->moyenne = (float)(paire_somme[p] / paire_nb[p]);
+            detail->coefficient = coefficient;
+            detail->nb_notes = paire_nb[p];
+
+            etudiant->nb_matieres++;
+            etudiant->nb_notes += paire_nb[p];
+            etudiant->somme_coefficients += coefficient;
+            somme_ponderee[e] += (double)coefficient * detail->moyenne;
+        }
+
+        for (int e = 0; ok && e < cache.nb_etudiants; e++) {
+            MoyenneEtudiant *etudiant = &cache.etudiants[e];
+            etudiant->moyenne_ponderee = (etudiant->somme_coefficients > 0.0f)
+                ? (float)(somme_ponderee[e] / etudiant->somme_coefficients)
+                : 0.0f;
+        }
+
+        cache.nb_details = nb_paires;
+        free(somme_ponderee);
+    }
+
+    free(coefficients);
+    free(paire_etudiant);
+    free(paire_matiere);
+    free(paire_somme);
+    free(paire_nb);
+    index_id_liberer(&index_matieres);
+    index_id_liberer(&index_paires);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        vider_cache();
+        return 0;
+    }
+
+    cache.notes = notes;
+    cache.matieres = matieres;
+    cache.generation_notes = notes_generation();
+    cache.generation_matieres = matieres_generation();
+    cache.valide = 1;
+    return 1;
+}
+
+/**
+ * Get the cached weighted average of a student
+ */
+const MoyenneEtudiant* obtenir_moyenne_etudiant(NodeNote* notes, NodeMatiere* matieres, int id_etudiant) {
+    if (!cache.valide ||
+        cache.notes != notes || cache.matieres != matieres ||
+        cache.generation_notes != notes_generation() ||
+        cache.generation_matieres != matieres_generation()) {
+        if (!construire_cache(notes, matieres)) {
+            return NULL;
+        }
+    }
+
+    int pos;
+    if (!index_id_chercher(&cache.index_etudiants, id_etudiant, &pos)) {
+        return NULL; // No grades for this student
+    }
+
+    return &cache.etudiants[pos];
+}
+
+/**
+ * Calculate the weighted average of a student across all subjects
+ */
+float calculer_moyenne_ponderee_etudiant(NodeNote* notes, NodeMatiere* matieres, int id_etudiant) {
+    const MoyenneEtudiant *moyenne = obtenir_moyenne_etudiant(notes, matieres, id_etudiant);
+    if (moyenne == NULL) {
+        return 0.0f;
+    }
+
+    return moyenne->moyenne_ponderee;
+}
+
+/**
+ * Get the per-subject averages of a student
+ */
+const MoyenneMatiereEtudiant* details_moyenne_etudiant(const MoyenneEtudiant *moyenne) {
+    return &cache.details[moyenne->premier_detail];
+}
+
+/**
+ * Force the next lookup to rebuild the cache
+ */
+void invalider_cache_moyennes(void) {
+    cache.valide = 0;
+}
+
+/**
+ * Free memory allocated for the averages cache
+ */
+void liberer_cache_moyennes(void) {
+    vider_cache();
+}
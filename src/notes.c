@@ -8,10 +8,19 @@
 #include "../include/etudiant.h"
 #include "../include/enseignant.h"
 #include "../include/utils.h"
+#include "../include/statistiques.h"
+#include "../include/colonnes_notes.h"
+#include "../include/tampon.h"
 #include <time.h>
 
 #define NOTES_FILE "data/notes.txt"
 
+// First line of the escaped format; files without it are in the old raw format
+#define EN_TETE_NOTES "#notes 2"
+
+// Incremented whenever the grades are (re)loaded or saved
+static unsigned long generation_notes = 0;
+
 /**
  * Load grades from file into a linked list
  */
@@ -36,42 +45,44 @@ int charger_notes(NodeNote** tete) {
         return 0;
     }
     
-    char line[300]; // Buffer for reading lines
+    generation_notes++;
+    
+    Tampon ligne = {0};
     NodeNote *dernier = NULL;
     
-    while (fgets(line, sizeof(line), file)) {
+    // Old files wrote comments raw, so a '|' or newline in them broke the record
+    int ancien_format = !(tampon_lire_ligne(&ligne, file) && strcmp(ligne.donnees, EN_TETE_NOTES) == 0);
+    if (ancien_format) {
+        rewind(file);
+    }
+    
+    while (ancien_format ? tampon_lire_enregistrement(&ligne, file, 5) : tampon_lire_ligne(&ligne, file)) {
+        // Split the record (id|id_etudiant|id_matiere|note|commentaire|date)
+        char *champs[6] = {NULL};
+        char *curseur = ligne.donnees;
+        for (int i = 0; i < 6; i++) {
+            champs[i] = extraire_champ(&curseur);
+        }
+        if (champs[0] == NULL || champs[0][0] == '\0') {
+            continue;
+        }
+        
         // Create a new node
         NodeNote *nouveau_node = (NodeNote*)malloc(sizeof(NodeNote));
         if (nouveau_node == NULL) {
             printf("Erreur: Échec d'allocation de mémoire.\n");
+            tampon_liberer(&ligne);
             fclose(file);
             return 0;
         }
+        memset(&nouveau_node->note, 0, sizeof(Note));
         
-        // Parse the line
-        char *token = strtok(line, "|");
-        if (token) {
-            nouveau_node->note.id = atoi(token);
-            
-            token = strtok(NULL, "|");
-            if (token) nouveau_node->note.id_etudiant = atoi(token);
-            
-            token = strtok(NULL, "|");
-            if (token) nouveau_node->note.id_matiere = atoi(token);
-            
-            token = strtok(NULL, "|");
-            if (token) nouveau_node->note.note = atof(token);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->note.commentaire, token, sizeof(nouveau_node->note.commentaire) - 1);
-            
-            token = strtok(NULL, "|");
-            if (token) strncpy(nouveau_node->note.date_evaluation, token, sizeof(nouveau_node->note.date_evaluation) - 1);
-            
-            // Ensure null termination of strings
-            nouveau_node->note.commentaire[sizeof(nouveau_node->note.commentaire) - 1] = '\0';
-            nouveau_node->note.date_evaluation[sizeof(nouveau_node->note.date_evaluation) - 1] = '\0';
-        }
+        nouveau_node->note.id = atoi(champs[0]);
+        if (champs[1]) nouveau_node->note.id_etudiant = atoi(champs[1]);
+        if (champs[2]) nouveau_node->note.id_matiere = atoi(champs[2]);
+        if (champs[3]) nouveau_node->note.note = atof(champs[3]);
+        if (champs[4]) strncpy(nouveau_node->note.commentaire, champs[4], sizeof(nouveau_node->note.commentaire) - 1);
+        if (champs[5]) strncpy(nouveau_node->note.date_evaluation, champs[5], sizeof(nouveau_node->note.date_evaluation) - 1);
         
         nouveau_node->suivant = NULL;
         
@@ -85,7 +96,13 @@ int charger_notes(NodeNote** tete) {
         dernier = nouveau_node;
     }
     
+    tampon_liberer(&ligne);
     fclose(file);
+    
+    // Convert an old file once it has been read
+    if (ancien_format && !sauvegarder_notes(*tete)) {
+        return 0;
+    }
     return 1;
 }
 
@@ -93,26 +110,32 @@ int charger_notes(NodeNote** tete) {
  * Save grades from linked list to file
  */
 int sauvegarder_notes(NodeNote* tete) {
-    FILE *file = fopen(NOTES_FILE, "w");
-    if (file == NULL) {
-        printf("Erreur: Impossible d'ouvrir le fichier des notes en écriture.\n");
-        return 0;
-    }
+    generation_notes++;
+    
+    // Comments are escaped so that each grade stays on one line
+    Tampon contenu = {0};
+    int ok = tampon_printf(&contenu, "%s\n", EN_TETE_NOTES);
     
     NodeNote* courant = tete;
-    while (courant != NULL) {
-        fprintf(file, "%d|%d|%d|%.2f|%s|%s\n",
-                courant->note.id,
-                courant->note.id_etudiant,
-                courant->note.id_matiere,
-                courant->note.note,
-                courant->note.commentaire,
-                courant->note.date_evaluation);
+    while (courant != NULL && ok) {
+        ok = tampon_printf(&contenu, "%d|%d|%d|%.2f|",
+                           courant->note.id,
+                           courant->note.id_etudiant,
+                           courant->note.id_matiere,
+                           courant->note.note) &&
+             tampon_ajouter_champ(&contenu, courant->note.commentaire) && tampon_ajouter(&contenu, "|", 1) &&
+             tampon_ajouter_champ(&contenu, courant->note.date_evaluation) && tampon_ajouter(&contenu, "\n", 1);
         
         courant = courant->suivant;
     }
     
-    fclose(file);
+    if (!ok || !tampon_ecrire_fichier(NOTES_FILE, &contenu)) {
+        printf("Erreur: Impossible d'ouvrir le fichier des notes en écriture.\n");
+        tampon_liberer(&contenu);
+        return 0;
+    }
+    
+    tampon_liberer(&contenu);
     return 1;
 }
 
@@ -169,6 +192,9 @@ void ajouter_note(NodeNote** tete, int id_enseignant) {
     } else {
         printf("Erreur lors de la sauvegarde des notes.\n");
     }
+    
+    colonnes_note_modifiee(*tete, NULL, &nouveau_node->note);
+    statistiques_note_modifiee(NULL, &nouveau_node->note);
 }
 
 /**
@@ -220,6 +246,9 @@ void modifier_note(NodeNote* tete, int id_enseignant) {
     printf("\n=== Modifier la note ===\n");
     printf("Laissez vide pour garder la valeur actuelle.\n");
     
+    // Keep the previous values to refresh the statistics
+    Note ancienne = note->note;
+    
     // Get new values or keep current ones
     char buffer[50];
     
@@ -258,6 +287,9 @@ void modifier_note(NodeNote* tete, int id_enseignant) {
     } else {
         printf("Erreur lors de la sauvegarde des modifications.\n");
     }
+    
+    colonnes_note_modifiee(tete, &ancienne, &note->note);
+    statistiques_note_modifiee(&ancienne, &note->note);
 }
 
 /**
@@ -326,6 +358,7 @@ void supprimer_note(NodeNote** tete, int id_enseignant) {
             precedent->suivant = courant_del->suivant;
         }
         
+        Note supprimee = courant_del->note;
         free(courant_del);
         
         // Save changes
@@ -334,6 +367,9 @@ void supprimer_note(NodeNote** tete, int id_enseignant) {
         } else {
             printf("Erreur lors de la sauvegarde des modifications.\n");
         }
+        
+        colonnes_note_modifiee(*tete, &supprimee, NULL);
+        statistiques_note_modifiee(&supprimee, NULL);
     } else {
         printf("Opération annulée.\n");
     }
@@ -535,4 +571,11 @@ void liberer_notes(NodeNote** tete) {
     }
     
     *tete = NULL;
-}
\ No newline at end of file
+}
+
+/**
+ * Get the grades modification counter
+ */
+unsigned long notes_generation(void) {
+    return generation_notes;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file occupation_salles.c
+ * @brief Implementation of the room occupancy analytics
+ */
+
+#include <time.h>
+#include "../include/occupation_salles.h"
+#include "../include/generateur_edt.h"
+#include "../include/index.h"
+
+/**
+ * State of one analysis
+ */
+typedef struct {
+    AnalyseSalles *analyse;
+    int capacite_salles;
+    int capacite_depassements;
+    IndexId index_salles;           // Room name key -> position in analyse->salles
+    MasqueCreneaux *occupe_grille;  // Slots used in the grid, per room
+    MasqueCreneaux *occupe_planning; // Slots used in the planning, per room
+    IndexId section_numero;         // Section name key -> dense number
+    int nb_sections;
+    IndexId inscrits_matiere;       // Subject ID -> active enrollments
+    IndexId inscrits_section;       // (subject, section number) -> active enrollments
+} ContexteOccupation;
+
+// Get the position of a room, adding it if needed
+static int salle_analyse(ContexteOccupation *ctx, const char *nom, const Salle *salle) {
+    AnalyseSalles *analyse = ctx->analyse;
+    long long cle = index_cle_chaine(nom);
+    int pos;
+    if (index_id_chercher(&ctx->index_salles, cle, &pos)) {
+        return pos;
+    }
+
+    if (analyse->nb_salles == ctx->capacite_salles) {
+        int capacite = ctx->capacite_salles ? ctx->capacite_salles * 2 : 16;
+        OccupationSalle *salles = (OccupationSalle*)realloc(analyse->salles, capacite * sizeof(OccupationSalle));
+        if (salles != NULL) analyse->salles = salles;
+        MasqueCreneaux *grille = (MasqueCreneaux*)realloc(ctx->occupe_grille, capacite * sizeof(MasqueCreneaux));
+        if (grille != NULL) ctx->occupe_grille = grille;
+        MasqueCreneaux *plan = (MasqueCreneaux*)realloc(ctx->occupe_planning, capacite * sizeof(MasqueCreneaux));
+        if (plan != NULL) ctx->occupe_planning = plan;
+        if (salles == NULL || grille == NULL || plan == NULL) {
+            return -1;
+        }
+        ctx->capacite_salles = capacite;
+    }
+
+    pos = analyse->nb_salles;
+    OccupationSalle *occupation = &analyse->salles[pos];
+    memset(occupation, 0, sizeof(OccupationSalle));
+    strncpy(occupation->nom, nom, MAX_SALLE_LEN - 1);
+    if (salle != NULL) {
+        occupation->capacite = salle->capacite;
+        occupation->type = salle->type;
+        occupation->enregistree = 1;
+    } else {
+        analyse->nb_hors_catalogue++;
+    }
+    ctx->occupe_grille[pos] = 0;
+    ctx->occupe_planning[pos] = 0;
+
+    if (!index_id_inserer(&ctx->index_salles, cle, pos)) {
+        return -1;
+    }
+    analyse->nb_salles++;
+    return pos;
+}
+
+// Add one to a counter stored in an index
+static int incrementer(IndexId *index, long long cle) {
+    int valeur;
+    return index_id_inserer(index, cle, index_id_chercher(index, cle, &valeur) ? valeur + 1 : 1);
+}
+
+// Count the active enrollments per subject and per (subject, section) in one pass
+static int compter_inscrits(ContexteOccupation *ctx, NodeEtudiant* etudiants, NodeInscription* inscriptions) {
+    IndexId section_etudiant = {0};
+    IndexId deja_vu = {0};
+    int ok = 1;
+
+    for (NodeEtudiant *e = etudiants; e != NULL && ok; e = e->suivant) {
+        if (e->etudiant.section[0] == '\0') continue;
+        long long cle = index_cle_chaine(e->etudiant.section);
+        int numero;
+        if (!index_id_chercher(&ctx->section_numero, cle, &numero)) {
+            numero = ctx->nb_sections++;
+            ok = index_id_inserer(&ctx->section_numero, cle, numero);
+        }
+        ok = ok && index_id_inserer(&section_etudiant, e->etudiant.id, numero);
+    }
+
+    for (NodeInscription *courant = inscriptions; courant != NULL && ok; courant = courant->suivant) {
+        const Inscription *inscription = &courant->inscription;
+        long long cle = index_cle_composee(inscription->id_etudiant, inscription->id_matiere);
+        int numero;
+        if (inscription->statut != 1 || index_id_chercher(&deja_vu, cle, &numero)) {
+            continue;
+        }
+        ok = index_id_inserer(&deja_vu, cle, 1) && incrementer(&ctx->inscrits_matiere, inscription->id_matiere);
+        if (ok && index_id_chercher(&section_etudiant, inscription->id_etudiant, &numero)) {
+            ok = incrementer(&ctx->inscrits_section, index_cle_composee(inscription->id_matiere, numero));
+        }
+    }
+
+    index_id_liberer(&section_etudiant);
+    index_id_liberer(&deja_vu);
+    return ok;
+}
+
+// Record one session: occupancy of its room and capacity check
+static int compter_seance(ContexteOccupation *ctx, int id, int depuis_planning, int id_matiere,
+                          const char *salle, const char *section, int jour, const char *horaire,
+                          MasqueCreneaux bit) {
+    if (salle[0] == '\0') {
+        return 1;
+    }
+    int pos = salle_analyse(ctx, salle, NULL);
+    if (pos < 0) {
+        return 0;
+    }
+
+    // Grid sessions gather every student of the subject, planning sessions one section
+    int inscrits = 0;
+    if (section[0] == '\0') {
+        index_id_chercher(&ctx->inscrits_matiere, id_matiere, &inscrits);
+    } else {
+        int numero;
+        if (index_id_chercher(&ctx->section_numero, index_cle_chaine(section), &numero)) {
+            index_id_chercher(&ctx->inscrits_section, index_cle_composee(id_matiere, numero), &inscrits);
+        }
+    }
+
+    OccupationSalle *occupation = &ctx->analyse->salles[pos];
+    if (depuis_planning) {
+        ctx->occupe_planning[pos] |= bit;
+    } else {
+        ctx->occupe_grille[pos] |= bit;
+    }
+    occupation->nb_seances++;
+    if (inscrits > occupation->max_inscrits) {
+        occupation->max_inscrits = inscrits;
+    }
+    if (!occupation->enregistree || inscrits <= occupation->capacite) {
+        return 1;
+    }
+
+    AnalyseSalles *analyse = ctx->analyse;
+    if (analyse->nb_depassements == ctx->capacite_depassements) {
+        int capacite = ctx->capacite_depassements ? ctx->capacite_depassements * 2 : 16;
+        DepassementCapacite *depassements = (DepassementCapacite*)realloc(analyse->depassements,
+                                                                          capacite * sizeof(DepassementCapacite));
+        if (depassements == NULL) {
+            return 0;
+        }
+        analyse->depassements = depassements;
+        ctx->capacite_depassements = capacite;
+    }
+
+    DepassementCapacite *depassement = &analyse->depassements[analyse->nb_depassements++];
+    memset(depassement, 0, sizeof(DepassementCapacite));
+    depassement->id_seance = id;
+    depassement->depuis_planning = depuis_planning;
+    depassement->id_matiere = id_matiere;
+    strncpy(depassement->salle, salle, MAX_SALLE_LEN - 1);
+    strncpy(depassement->section, section, MAX_SECTION_LEN - 1);
+    depassement->jour = jour;
+    strncpy(depassement->horaire, horaire, MAX_NOM_CRENEAU_LEN - 1);
+    depassement->inscrits = inscrits;
+    depassement->capacite = occupation->capacite;
+    occupation->nb_depassements++;
+    return 1;
+}
+
+// Most used rooms first, then by name
+static int comparer_occupation(const void *a, const void *b) {
+    const OccupationSalle *sa = (const OccupationSalle*)a;
+    const OccupationSalle *sb = (const OccupationSalle*)b;
+    if (sa->taux != sb->taux) {
+        return sa->taux < sb->taux ? 1 : -1;
+    }
+    return strcmp(sa->nom, sb->nom);
+}
+
+/**
+ * Compute the weekly occupancy and capacity overflows of the rooms
+ */
+int analyser_occupation_salles(AnalyseSalles *analyse, NodeSalle* salles, const EmploiDuTemps *edt,
+                               const Planning *planning, NodeEtudiant* etudiants,
+                               NodeInscription* inscriptions) {
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    memset(analyse, 0, sizeof(AnalyseSalles));
+
+    ContexteOccupation ctx;
+    memset(&ctx, 0, sizeof(ContexteOccupation));
+    ctx.analyse = analyse;
+
+    // Registered rooms are listed even when unused
+    int ok = compter_inscrits(&ctx, etudiants, inscriptions);
+    for (NodeSalle *courant = salles; courant != NULL && ok; courant = courant->suivant) {
+        ok = salle_analyse(&ctx, courant->salle.nom, &courant->salle) >= 0;
+    }
+
+    for (int j = 0; j < JOURS_PAR_SEMAINE && ok; j++) {
+        for (int h = 0; h < CRENEAUX_PAR_JOUR && ok; h++) {
+            const Creneau *creneau = &edt->creneaux[j][h];
+            if (creneau->id == 0) continue;
+            ok = compter_seance(&ctx, creneau->id, 0, creneau->id_matiere, creneau->salle, "",
+                                j, heure_to_string(h), 1ULL << (j * CRENEAUX_PAR_JOUR + h));
+        }
+    }
+
+    // When the planning cuts the days like the grid, both share the same week
+    int semaine_grille = JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR;
+    int semaine_planning = 0;
+    int alignes = 0;
+    if (planning != NULL && planning->nb_seances > 0) {
+        alignes = planning->nb_creneaux_jour == CRENEAUX_PAR_JOUR;
+        semaine_planning = planning->nb_jours * planning->nb_creneaux_jour;
+        for (int i = 0; i < planning->nb_seances && ok; i++) {
+            const Seance *seance = &planning->seances[i];
+            int creneau = seance->jour * planning->nb_creneaux_jour + seance->heure;
+            if (seance->heure < 0 || seance->heure >= planning->nb_creneaux_jour ||
+                creneau < 0 || creneau >= MAX_CRENEAUX_SEMAINE) {
+                continue;
+            }
+            ok = compter_seance(&ctx, seance->id, 1, seance->id_matiere, seance->salle, seance->section,
+                                seance->jour, planning->noms_creneaux[seance->heure], 1ULL << creneau);
+        }
+    }
+
+    for (int s = 0; s < analyse->nb_salles && ok; s++) {
+        OccupationSalle *occupation = &analyse->salles[s];
+        if (alignes) {
+            occupation->creneaux_occupes = __builtin_popcountll(ctx.occupe_grille[s] | ctx.occupe_planning[s]);
+            occupation->creneaux_semaine = semaine_grille > semaine_planning ? semaine_grille : semaine_planning;
+        } else {
+            occupation->creneaux_occupes = __builtin_popcountll(ctx.occupe_grille[s]) +
+                                           __builtin_popcountll(ctx.occupe_planning[s]);
+            occupation->creneaux_semaine = semaine_grille + semaine_planning;
+        }
+        occupation->taux = 100.0 * occupation->creneaux_occupes / occupation->creneaux_semaine;
+    }
+    if (ok && analyse->nb_salles > 1) {
+        qsort(analyse->salles, analyse->nb_salles, sizeof(OccupationSalle), comparer_occupation);
+    }
+
+    free(ctx.occupe_grille);
+    free(ctx.occupe_planning);
+    index_id_liberer(&ctx.index_salles);
+    index_id_liberer(&ctx.section_numero);
+    index_id_liberer(&ctx.inscrits_matiere);
+    index_id_liberer(&ctx.inscrits_section);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        liberer_occupation_salles(analyse);
+        return 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    analyse->duree_ms = (fin.tv_sec - debut.tv_sec) * 1000.0 + (fin.tv_nsec - debut.tv_nsec) / 1000000.0;
+    return 1;
+}
+
+/**
+ * Display the occupancy of the rooms and the capacity overflows
+ */
+void afficher_occupation_salles(const AnalyseSalles *analyse, NodeMatiere* matieres) {
+    if (analyse->nb_salles == 0) {
+        printf("Aucune salle n'est enregistrée ni utilisée.\n");
+        return;
+    }
+
+    printf("\n=== Occupation des Salles ===\n");
+    printf("%-10s | %-6s | %-8s | %-9s | %-7s | %-8s | %-11s\n",
+           "Salle", "Type", "Capacité", "Créneaux", "Taux", "Séances", "Max inscrits");
+    printf("--------------------------------------------------------------------------------\n");
+
+    for (int s = 0; s < analyse->nb_salles; s++) {
+        const OccupationSalle *occupation = &analyse->salles[s];
+        char capacite[12] = "?";
+        if (occupation->enregistree) {
+            snprintf(capacite, sizeof(capacite), "%d", occupation->capacite);
+        }
+        printf("%-10s | %-6s | %-8s | %3d / %-3d | %6.1f%% | %-8d | %d%s\n",
+               occupation->nom,
+               occupation->enregistree ? type_salle_to_string(occupation->type) : "-",
+               capacite,
+               occupation->creneaux_occupes, occupation->creneaux_semaine,
+               occupation->taux,
+               occupation->nb_seances,
+               occupation->max_inscrits,
+               occupation->nb_depassements > 0 ? " (dépassement)" : "");
+    }
+    printf("================================================================================\n");
+
+    if (analyse->nb_hors_catalogue > 0) {
+        printf("%d salle(s) utilisée(s) mais absente(s) du catalogue (capacité inconnue).\n",
+               analyse->nb_hors_catalogue);
+    }
+
+    if (analyse->nb_depassements == 0) {
+        printf("Aucun dépassement de capacité.\n");
+    } else {
+        printf("\n%d séance(s) avec plus d'inscrits que de places:\n", analyse->nb_depassements);
+        for (int d = 0; d < analyse->nb_depassements; d++) {
+            const DepassementCapacite *depassement = &analyse->depassements[d];
+            NodeMatiere *matiere = trouver_matiere_par_id(matieres, depassement->id_matiere);
+            printf("- %s, %s: %s en salle %s%s%s, %d inscrits pour %d places\n",
+                   depassement->depuis_planning ? nom_jour_planning(depassement->jour)
+                                                : jour_to_string(depassement->jour),
+                   depassement->horaire,
+                   matiere != NULL ? matiere->matiere.nom_matiere : "Inconnue",
+                   depassement->salle,
+                   depassement->section[0] != '\0' ? ", section " : "",
+                   depassement->section,
+                   depassement->inscrits, depassement->capacite);
+        }
+    }
+
+    printf("\nAnalyse calculée en %.2f ms.\n", analyse->duree_ms);
+}
+
+/**
+ * Free memory allocated for an analysis
+ */
+void liberer_occupation_salles(AnalyseSalles *analyse) {
+    free(analyse->salles);
+    free(analyse->depassements);
+    memset(analyse, 0, sizeof(AnalyseSalles));
+}
@@ -0,0 +1,89 @@
+/**
+ * @file parallele.c
+ * @brief Implementation of the worker pool
+ */
+
+#include "../include/parallele.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/**
+ * Shared queue of task indices
+ */
+typedef struct {
+    FonctionTache fonction;
+    void *contexte;
+    int nb_taches;
+    int prochaine;
+    pthread_mutex_t verrou;
+} FileTaches;
+
+// Worker loop: take the next task until the queue is empty
+static void* travailleur(void *arg) {
+    FileTaches *file = (FileTaches*)arg;
+
+    while (1) {
+        pthread_mutex_lock(&file->verrou);
+        int indice = file->prochaine++;
+        pthread_mutex_unlock(&file->verrou);
+
+        if (indice >= file->nb_taches) {
+            break;
+        }
+        file->fonction(indice, file->contexte);
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the number of online processors
+ */
+int nombre_processeurs(void) {
+    long nb = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb < 1) {
+        return 1;
+    }
+    return (nb > MAX_THREADS) ? MAX_THREADS : (int)nb;
+}
+
+/**
+ * Run tasks on a pool of worker threads and wait for all of them
+ */
+int executer_taches_paralleles(int nb_taches, int nb_threads, FonctionTache fonction, void *contexte) {
+    if (nb_threads <= 0) {
+        nb_threads = nombre_processeurs();
+    }
+    if (nb_threads > MAX_THREADS) {
+        nb_threads = MAX_THREADS;
+    }
+    if (nb_threads > nb_taches) {
+        nb_threads = nb_taches;
+    }
+
+    FileTaches file;
+    file.fonction = fonction;
+    file.contexte = contexte;
+    file.nb_taches = nb_taches;
+    file.prochaine = 0;
+    pthread_mutex_init(&file.verrou, NULL);
+
+    // The calling thread is one of the workers
+    pthread_t threads[MAX_THREADS];
+    int nb_lances = 0;
+    for (int i = 1; i < nb_threads; i++) {
+        if (pthread_create(&threads[nb_lances], NULL, travailleur, &file) != 0) {
+            break; // Continue with the threads already started
+        }
+        nb_lances++;
+    }
+
+    travailleur(&file);
+
+    for (int i = 0; i < nb_lances; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&file.verrou);
+    return nb_lances + 1;
+}
@@ -0,0 +1,774 @@
+/**
+ * @file planning.c
+ * @brief Implementation of the multi-section, multi-room planning
+ */
+
+#include "../include/planning.h"
+#include "../include/generateur_edt.h"
+#include "../include/parallele.h"
+#include "../include/utils.h"
+
+#define PLANNING_FILE "data/planning.txt"
+#define MAX_SALLES_GENERATION 64
+
+// Incremented whenever the planning is (re)loaded or saved
+static unsigned long generation_planning = 0;
+
+// Find a name in a registry, -1 if absent
+static int registre_chercher(const RegistreNoms *registre, const char *nom) {
+    int pos;
+    if (!index_id_chercher(&registre->index, index_cle_chaine(nom), &pos)) {
+        return -1;
+    }
+    if (strncmp(registre->noms[pos], nom, MAX_NOM_REGISTRE_LEN - 1) == 0) {
+        return pos;
+    }
+
+    // Hash collision: scan the names
+    for (int i = 0; i < registre->nb; i++) {
+        if (strncmp(registre->noms[i], nom, MAX_NOM_REGISTRE_LEN - 1) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Dense index of a name, added to the registry if needed (-1 on error)
+static int registre_ajouter(RegistreNoms *registre, const char *nom) {
+    int pos = registre_chercher(registre, nom);
+    if (pos >= 0) {
+        return pos;
+    }
+
+    if (registre->nb == registre->capacite) {
+        int capacite = registre->capacite ? registre->capacite * 2 : 8;
+        char (*noms)[MAX_NOM_REGISTRE_LEN] = realloc(registre->noms, capacite * sizeof(*noms));
+        if (noms == NULL) {
+            return -1;
+        }
+        registre->noms = noms;
+        registre->capacite = capacite;
+    }
+
+    pos = registre->nb++;
+    strncpy(registre->noms[pos], nom, MAX_NOM_REGISTRE_LEN - 1);
+    registre->noms[pos][MAX_NOM_REGISTRE_LEN - 1] = '\0';
+
+    // On a hash collision the first name keeps the slot
+    long long cle = index_cle_chaine(nom);
+    int existant;
+    if (!index_id_chercher(&registre->index, cle, &existant) && !index_id_inserer(&registre->index, cle, pos)) {
+        return -1;
+    }
+    return pos;
+}
+
+// Free memory allocated for a registry
+static void registre_liberer(RegistreNoms *registre) {
+    free(registre->noms);
+    index_id_liberer(&registre->index);
+    memset(registre, 0, sizeof(RegistreNoms));
+}
+
+// Key of a (room, teacher or section, slot) pair
+static long long cle_creneau(const Planning *planning, int ressource, int jour, int heure) {
+    return index_cle_composee(ressource, jour * planning->nb_creneaux_jour + heure);
+}
+
+// Add the session at a position to every index
+static int indexer_seance(Planning *planning, int pos) {
+    const Seance *seance = &planning->seances[pos];
+    int tete;
+
+    planning->suivant_enseignant[pos] = index_id_chercher(&planning->tete_enseignant, seance->id_enseignant, &tete)
+                                        ? tete : -1;
+    planning->suivant_section[pos] = index_id_chercher(&planning->tete_section, planning->section_seance[pos], &tete)
+                                     ? tete : -1;
+
+    return index_id_inserer(&planning->index_ids, seance->id, pos) &&
+           index_id_inserer(&planning->index_salle_creneau,
+                            cle_creneau(planning, planning->salle_seance[pos], seance->jour, seance->heure), pos) &&
+           index_id_inserer(&planning->index_enseignant_creneau,
+                            cle_creneau(planning, seance->id_enseignant, seance->jour, seance->heure), pos) &&
+           index_id_inserer(&planning->index_section_creneau,
+                            cle_creneau(planning, planning->section_seance[pos], seance->jour, seance->heure), pos) &&
+           index_id_inserer(&planning->tete_enseignant, seance->id_enseignant, pos) &&
+           index_id_inserer(&planning->tete_section, planning->section_seance[pos], pos);
+}
+
+// Rebuild every index from the session array
+static int reindexer_planning(Planning *planning) {
+    index_id_vider(&planning->index_ids);
+    index_id_vider(&planning->index_salle_creneau);
+    index_id_vider(&planning->index_enseignant_creneau);
+    index_id_vider(&planning->index_section_creneau);
+    index_id_vider(&planning->tete_enseignant);
+    index_id_vider(&planning->tete_section);
+
+    for (int pos = 0; pos < planning->nb_seances; pos++) {
+        if (!indexer_seance(planning, pos)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Default name of a slot: two-hour slots from 8h, with the usual lunch break for 4 slots
+static void nommer_creneaux(Planning *planning) {
+    for (int h = 0; h < planning->nb_creneaux_jour; h++) {
+        if (planning->nb_creneaux_jour == CRENEAUX_PAR_JOUR) {
+            strcpy(planning->noms_creneaux[h], heure_to_string(h));
+        } else {
+            short debut = 8 + 2 * h;
+            snprintf(planning->noms_creneaux[h], MAX_NOM_CRENEAU_LEN, "%dh-%dh", debut, debut + 2);
+        }
+    }
+}
+
+/**
+ * Initialize an empty planning
+ */
+int initialiser_planning(Planning *planning, int nb_jours, int nb_creneaux_jour) {
+    memset(planning, 0, sizeof(Planning));
+
+    if (nb_jours < 1 || nb_jours > MAX_JOURS_PLANNING ||
+        nb_creneaux_jour < 1 || nb_creneaux_jour > MAX_CRENEAUX_JOUR_PLANNING) {
+        printf("Erreur: Forme de semaine invalide (%d jours, %d créneaux par jour).\n", nb_jours, nb_creneaux_jour);
+        return 0;
+    }
+
+    planning->nb_jours = nb_jours;
+    planning->nb_creneaux_jour = nb_creneaux_jour;
+    planning->prochain_id = 1;
+    nommer_creneaux(planning);
+    return 1;
+}
+
+/**
+ * Free memory allocated for a planning
+ */
+void liberer_planning(Planning *planning) {
+    free(planning->seances);
+    free(planning->salle_seance);
+    free(planning->section_seance);
+    free(planning->suivant_enseignant);
+    free(planning->suivant_section);
+    registre_liberer(&planning->salles);
+    registre_liberer(&planning->sections);
+    index_id_liberer(&planning->index_ids);
+    index_id_liberer(&planning->index_salle_creneau);
+    index_id_liberer(&planning->index_enseignant_creneau);
+    index_id_liberer(&planning->index_section_creneau);
+    index_id_liberer(&planning->tete_enseignant);
+    index_id_liberer(&planning->tete_section);
+    memset(planning, 0, sizeof(Planning));
+}
+
+// Grow the session arrays
+static int agrandir_planning(Planning *planning) {
+    int capacite = planning->capacite ? planning->capacite * 2 : 32;
+
+    Seance *seances = (Seance*)realloc(planning->seances, capacite * sizeof(Seance));
+    if (seances != NULL) planning->seances = seances;
+    int *salle_seance = (int*)realloc(planning->salle_seance, capacite * sizeof(int));
+    if (salle_seance != NULL) planning->salle_seance = salle_seance;
+    int *section_seance = (int*)realloc(planning->section_seance, capacite * sizeof(int));
+    if (section_seance != NULL) planning->section_seance = section_seance;
+    int *suivant_enseignant = (int*)realloc(planning->suivant_enseignant, capacite * sizeof(int));
+    if (suivant_enseignant != NULL) planning->suivant_enseignant = suivant_enseignant;
+    int *suivant_section = (int*)realloc(planning->suivant_section, capacite * sizeof(int));
+    if (suivant_section != NULL) planning->suivant_section = suivant_section;
+
+    if (seances == NULL || salle_seance == NULL || section_seance == NULL ||
+        suivant_enseignant == NULL || suivant_section == NULL) {
+        return 0;
+    }
+
+    planning->capacite = capacite;
+    return 1;
+}
+
+// Session already holding a room, teacher or section at a slot, -1 if free
+static int occupant_creneau(const IndexId *index, long long cle) {
+    int pos;
+    return index_id_chercher(index, cle, &pos) ? pos : -1;
+}
+
+// Check that a room, a teacher and a section are free at a slot, except for the session at position pos;
+// a room not registered yet (-1) holds no session
+static int creneau_libre(const Planning *planning, int salle, int id_enseignant, int section,
+                         int jour, int heure, int pos) {
+    int occupants[3] = {
+        salle >= 0 ? occupant_creneau(&planning->index_salle_creneau, cle_creneau(planning, salle, jour, heure)) : -1,
+        occupant_creneau(&planning->index_enseignant_creneau, cle_creneau(planning, id_enseignant, jour, heure)),
+        occupant_creneau(&planning->index_section_creneau, cle_creneau(planning, section, jour, heure))
+    };
+    for (int r = 0; r < 3; r++) {
+        if (occupants[r] >= 0 && occupants[r] != pos) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Add the room, teacher and section of the session at a position to the slot indexes
+static int indexer_creneau(Planning *planning, int pos) {
+    const Seance *seance = &planning->seances[pos];
+    return index_id_inserer(&planning->index_salle_creneau,
+                            cle_creneau(planning, planning->salle_seance[pos], seance->jour, seance->heure), pos) &&
+           index_id_inserer(&planning->index_enseignant_creneau,
+                            cle_creneau(planning, seance->id_enseignant, seance->jour, seance->heure), pos) &&
+           index_id_inserer(&planning->index_section_creneau,
+                            cle_creneau(planning, planning->section_seance[pos], seance->jour, seance->heure), pos);
+}
+
+// Remove the session at a position from the slot indexes
+static void desindexer_creneau(Planning *planning, int pos) {
+    const Seance *seance = &planning->seances[pos];
+    index_id_supprimer(&planning->index_salle_creneau,
+                       cle_creneau(planning, planning->salle_seance[pos], seance->jour, seance->heure));
+    index_id_supprimer(&planning->index_enseignant_creneau,
+                       cle_creneau(planning, seance->id_enseignant, seance->jour, seance->heure));
+    index_id_supprimer(&planning->index_section_creneau,
+                       cle_creneau(planning, planning->section_seance[pos], seance->jour, seance->heure));
+}
+
+// Insert a session with a known ID
+static int inserer_seance(Planning *planning, const Seance *seance) {
+    if (seance->jour < 0 || seance->jour >= planning->nb_jours ||
+        seance->heure < 0 || seance->heure >= planning->nb_creneaux_jour) {
+        return 0;
+    }
+
+    int salle = registre_ajouter(&planning->salles, seance->salle);
+    int section = registre_ajouter(&planning->sections, seance->section);
+    if (salle < 0 || section < 0) {
+        return 0;
+    }
+
+    // A room, a teacher and a section hold one session at a time
+    if (!creneau_libre(planning, salle, seance->id_enseignant, section, seance->jour, seance->heure, -1)) {
+        return 0;
+    }
+
+    if (planning->nb_seances == planning->capacite && !agrandir_planning(planning)) {
+        return 0;
+    }
+
+    int pos = planning->nb_seances++;
+    planning->seances[pos] = *seance;
+    planning->salle_seance[pos] = salle;
+    planning->section_seance[pos] = section;
+    if (seance->id >= planning->prochain_id) {
+        planning->prochain_id = seance->id + 1;
+    }
+
+    return indexer_seance(planning, pos);
+}
+
+/**
+ * Add a session to the planning
+ */
+int ajouter_seance(Planning *planning, int id_matiere, int id_enseignant,
+                   const char *section, const char *salle, int jour, int heure) {
+    Seance seance;
+    memset(&seance, 0, sizeof(Seance));
+    seance.id = planning->prochain_id;
+    seance.id_matiere = id_matiere;
+    seance.id_enseignant = id_enseignant;
+    strncpy(seance.section, section, MAX_SECTION_LEN - 1);
+    strncpy(seance.salle, salle, MAX_SALLE_LEN - 1);
+    seance.jour = jour;
+    seance.heure = heure;
+
+    return inserer_seance(planning, &seance) ? seance.id : 0;
+}
+
+/**
+ * Remove a session from the planning
+ */
+int supprimer_seance(Planning *planning, int id) {
+    int pos;
+    if (!index_id_chercher(&planning->index_ids, id, &pos)) {
+        return 0;
+    }
+
+    // Move the last session into the hole, then rebuild the chains
+    int dernier = --planning->nb_seances;
+    planning->seances[pos] = planning->seances[dernier];
+    planning->salle_seance[pos] = planning->salle_seance[dernier];
+    planning->section_seance[pos] = planning->section_seance[dernier];
+
+    return reindexer_planning(planning);
+}
+
+/**
+ * Move a session to another room and slot
+ */
+int deplacer_seance(Planning *planning, int id, const char *salle, int jour, int heure) {
+    int pos;
+    if (!index_id_chercher(&planning->index_ids, id, &pos) ||
+        jour < 0 || jour >= planning->nb_jours || heure < 0 || heure >= planning->nb_creneaux_jour) {
+        return 0;
+    }
+
+    // The room is registered only once the move is accepted
+    int nouvelle_salle = registre_chercher(&planning->salles, salle);
+
+    // The session itself does not block its move (same slot, other room)
+    Seance *seance = &planning->seances[pos];
+    int section = planning->section_seance[pos];
+    if (!creneau_libre(planning, nouvelle_salle, seance->id_enseignant, section, jour, heure, pos)) {
+        return 0;
+    }
+    if (nouvelle_salle < 0) {
+        nouvelle_salle = registre_ajouter(&planning->salles, salle);
+        if (nouvelle_salle < 0) {
+            return 0;
+        }
+    }
+
+    // The teacher and section chains do not depend on the slot
+    Seance ancienne = *seance;
+    int ancienne_salle = planning->salle_seance[pos];
+    desindexer_creneau(planning, pos);
+    strncpy(seance->salle, salle, MAX_SALLE_LEN - 1);
+    seance->salle[MAX_SALLE_LEN - 1] = '\0';
+    seance->jour = jour;
+    seance->heure = heure;
+    planning->salle_seance[pos] = nouvelle_salle;
+    if (!indexer_creneau(planning, pos)) {
+        // The new keys were free: removing them only drops what was just added, and the old
+        // entries fit again in the space they left
+        desindexer_creneau(planning, pos);
+        *seance = ancienne;
+        planning->salle_seance[pos] = ancienne_salle;
+        indexer_creneau(planning, pos);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Find a session by ID
+ */
+const Seance* trouver_seance(const Planning *planning, int id) {
+    int pos;
+    if (!index_id_chercher(&planning->index_ids, id, &pos)) {
+        return NULL;
+    }
+    return &planning->seances[pos];
+}
+
+/**
+ * Get the session held in a room at a given time
+ */
+const Seance* seance_salle_creneau(const Planning *planning, const char *salle, int jour, int heure) {
+    int s = registre_chercher(&planning->salles, salle);
+    int pos;
+    if (s < 0 || !index_id_chercher(&planning->index_salle_creneau, cle_creneau(planning, s, jour, heure), &pos)) {
+        return NULL;
+    }
+    return &planning->seances[pos];
+}
+
+// Order sessions by day then slot
+static int comparer_seances(const void *a, const void *b) {
+    const Seance *sa = *(const Seance* const*)a;
+    const Seance *sb = *(const Seance* const*)b;
+    if (sa->jour != sb->jour) {
+        return sa->jour - sb->jour;
+    }
+    return sa->heure - sb->heure;
+}
+
+// Follow a chain of sessions and sort it
+static int parcourir_chaine(const Planning *planning, int pos, const int *suivant, const Seance **resultat, int max) {
+    int nb = 0;
+    for (; pos >= 0; pos = suivant[pos]) {
+        if (nb < max) {
+            resultat[nb] = &planning->seances[pos];
+        }
+        nb++;
+    }
+
+    qsort(resultat, nb < max ? nb : max, sizeof(Seance*), comparer_seances);
+    return nb;
+}
+
+/**
+ * Get the week of a teacher
+ */
+int seances_enseignant(const Planning *planning, int id_enseignant, const Seance **resultat, int max) {
+    int tete;
+    if (!index_id_chercher(&planning->tete_enseignant, id_enseignant, &tete)) {
+        return 0;
+    }
+    return parcourir_chaine(planning, tete, planning->suivant_enseignant, resultat, max);
+}
+
+/**
+ * Get the week of a section
+ */
+int seances_section(const Planning *planning, const char *section, const Seance **resultat, int max) {
+    int s = registre_chercher(&planning->sections, section);
+    int tete;
+    if (s < 0 || !index_id_chercher(&planning->tete_section, s, &tete)) {
+        return 0;
+    }
+    return parcourir_chaine(planning, tete, planning->suivant_section, resultat, max);
+}
+
+/**
+ * Get the name of a day of the planning
+ */
+const char* nom_jour_planning(int jour) {
+    static const char* jours[] = {"Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi", "Dimanche"};
+
+    if (jour >= 0 && jour < MAX_JOURS_PLANNING) {
+        return jours[jour];
+    }
+
+    return "Inconnu";
+}
+
+// Split a line on '|', keeping empty fields
+static int decouper_champs(char *ligne, char *champs[], int max) {
+    int nb = 0;
+    char *debut = ligne;
+
+    while (nb < max) {
+        champs[nb++] = debut;
+        char *separateur = strchr(debut, '|');
+        if (separateur == NULL) {
+            break;
+        }
+        *separateur = '\0';
+        debut = separateur + 1;
+    }
+
+    return nb;
+}
+
+/**
+ * Load the planning from file
+ */
+int charger_planning(Planning *planning) {
+    create_data_dir();
+    initialiser_planning(planning, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR);
+    generation_planning++;
+
+    if (!file_exists(PLANNING_FILE)) {
+        create_file_if_not_exists(PLANNING_FILE);
+        return 1;
+    }
+
+    FILE *file = fopen(PLANNING_FILE, "r");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier du planning.\n");
+        return 0;
+    }
+
+    char line[256];
+    int nb_rejetees = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\n")] = '\0'; // Remove newline
+        if (line[0] == '\0') {
+            continue;
+        }
+
+        char *champs[8];
+        int nb = decouper_champs(line, champs, 8);
+
+        // Header: #|nb_jours|nb_creneaux_jour|slot names separated by ';'
+        if (line[0] == '#') {
+            if (nb >= 3 && planning->nb_seances == 0) {
+                initialiser_planning(planning, atoi(champs[1]), atoi(champs[2]));
+                if (planning->nb_jours == 0) {
+                    initialiser_planning(planning, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR);
+                } else if (nb >= 4) {
+                    char *nom = strtok(champs[3], ";");
+                    for (int h = 0; nom != NULL && h < planning->nb_creneaux_jour; h++) {
+                        strncpy(planning->noms_creneaux[h], nom, MAX_NOM_CRENEAU_LEN - 1);
+                        nom = strtok(NULL, ";");
+                    }
+                }
+            }
+            continue;
+        }
+
+        // Session: id|id_matiere|id_enseignant|section|salle|jour|heure
+        if (nb < 7) {
+            continue;
+        }
+
+        Seance seance;
+        memset(&seance, 0, sizeof(Seance));
+        seance.id = atoi(champs[0]);
+        seance.id_matiere = atoi(champs[1]);
+        seance.id_enseignant = atoi(champs[2]);
+        strncpy(seance.section, champs[3], MAX_SECTION_LEN - 1);
+        strncpy(seance.salle, champs[4], MAX_SALLE_LEN - 1);
+        seance.jour = atoi(champs[5]);
+        seance.heure = atoi(champs[6]);
+
+        if (seance.id > 0 && !inserer_seance(planning, &seance)) {
+            nb_rejetees++;
+        }
+    }
+
+    fclose(file);
+    if (nb_rejetees > 0) {
+        printf("Attention: %d séance(s) du planning ignorée(s) (créneau invalide ou occupé).\n", nb_rejetees);
+    }
+    return 1;
+}
+
+/**
+ * Save the planning to file
+ */
+int sauvegarder_planning(const Planning *planning) {
+    generation_planning++;
+
+    FILE *file = fopen(PLANNING_FILE, "w");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier du planning en écriture.\n");
+        return 0;
+    }
+
+    fprintf(file, "#|%d|%d|", planning->nb_jours, planning->nb_creneaux_jour);
+    for (int h = 0; h < planning->nb_creneaux_jour; h++) {
+        fprintf(file, "%s%s", h > 0 ? ";" : "", planning->noms_creneaux[h]);
+    }
+    fprintf(file, "\n");
+
+    for (int i = 0; i < planning->nb_seances; i++) {
+        const Seance *seance = &planning->seances[i];
+        fprintf(file, "%d|%d|%d|%s|%s|%d|%d\n",
+                seance->id,
+                seance->id_matiere,
+                seance->id_enseignant,
+                seance->section,
+                seance->salle,
+                seance->jour,
+                seance->heure);
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Display a list of sessions with subject and teacher names
+ */
+void afficher_seances(const Planning *planning, const Seance **seances, int nb,
+                      NodeMatiere* matieres, NodeEnseignant* enseignants) {
+    if (nb == 0) {
+        printf("Aucune séance trouvée.\n");
+        return;
+    }
+
+    printf("%-5s | %-10s | %-10s | %-20s | %-25s | %-8s | %-8s\n",
+           "ID", "Jour", "Créneau", "Matière", "Enseignant", "Section", "Salle");
+    printf("------------------------------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < nb; i++) {
+        const Seance *seance = seances[i];
+        NodeMatiere* matiere = trouver_matiere_par_id(matieres, seance->id_matiere);
+        NodeEnseignant* enseignant = trouver_enseignant_par_id(enseignants, seance->id_enseignant);
+
+        char nom_enseignant[101] = "(inconnu)";
+        if (enseignant != NULL) {
+            snprintf(nom_enseignant, sizeof(nom_enseignant), "%s %s",
+                     enseignant->enseignant.prenom, enseignant->enseignant.nom);
+        }
+
+        printf("%-5d | %-10s | %-10s | %-20s | %-25s | %-8s | %-8s\n",
+               seance->id,
+               nom_jour_planning(seance->jour),
+               planning->noms_creneaux[seance->heure],
+               matiere != NULL ? matiere->matiere.nom_matiere : "(inconnue)",
+               nom_enseignant,
+               seance->section,
+               seance->salle);
+    }
+}
+
+/**
+ * Generate the planning of every section
+ */
+void generer_planning(Planning *planning, NodeEnseignant* enseignants,
+                      NodeMatiere* matieres, NodeEtudiant* etudiants) {
+    if (matieres == NULL || enseignants == NULL || etudiants == NULL) {
+        printf("Erreur: Il faut au moins une matière, un enseignant et un étudiant pour générer un planning.\n");
+        return;
+    }
+
+    printf("\n=== Générer le planning de toutes les sections ===\n");
+
+    if (planning->nb_seances > 0) {
+        int confirmation = get_int_input("Le planning actuel sera remplacé. Continuer? (1: Oui, 0: Non): ", 0, 1);
+        if (!confirmation) {
+            printf("Opération annulée.\n");
+            return;
+        }
+    }
+
+    int nb_jours = get_int_input("Nombre de jours par semaine (1-7): ", 1, MAX_JOURS_PLANNING);
+    int nb_creneaux_jour = get_int_input("Nombre de créneaux par jour (1-12): ", 1, MAX_CRENEAUX_JOUR_PLANNING);
+    if (nb_jours * nb_creneaux_jour > MAX_CRENEAUX_SEMAINE) {
+        printf("Erreur: Une semaine ne peut pas dépasser %d créneaux.\n", MAX_CRENEAUX_SEMAINE);
+        return;
+    }
+
+    int seances_par_matiere = get_int_input("Nombre de séances par matière et par semaine (1-4): ", 1, 4);
+    int nb_threads = get_int_input("Nombre de threads de recherche (0 = automatique): ", 0, MAX_THREADS);
+
+    char liste_salles[256];
+    get_input("Salles disponibles, séparées par des virgules (ex: S1,S2,S3): ", liste_salles, sizeof(liste_salles));
+
+    char salles[MAX_SALLES_GENERATION][MAX_SALLE_LEN];
+    int nb_salles = lire_liste_salles(liste_salles, salles, MAX_SALLES_GENERATION);
+    if (nb_salles == 0) {
+        printf("Erreur: Aucune salle indiquée.\n");
+        return;
+    }
+
+    // Sections attended by the students
+    RegistreNoms sections = {0};
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) {
+        registre_ajouter(&sections, e->etudiant.section);
+    }
+
+    int nb_enseignants = 0;
+    for (NodeEnseignant* e = enseignants; e != NULL; e = e->suivant) nb_enseignants++;
+    int *charges = (int*)calloc(nb_enseignants, sizeof(int));
+
+    ProblemeEdt probleme;
+    if (charges == NULL ||
+        !initialiser_probleme_edt(&probleme, nb_jours, nb_creneaux_jour, nb_salles, sections.nb)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        free(charges);
+        registre_liberer(&sections);
+        return;
+    }
+
+    // Every section follows every subject; teachers are balanced across sections
+    for (int s = 0; s < sections.nb; s++) {
+        for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+            int position, specialise;
+            NodeEnseignant* enseignant = choisir_enseignant_matiere(enseignants, &m->matiere, charges,
+                                                                    &position, &specialise);
+            for (int k = 0; k < seances_par_matiere; k++) {
+                ajouter_seance_probleme(&probleme, m->matiere.id, enseignant->enseignant.id, s);
+                charges[position]++;
+            }
+        }
+    }
+    free(charges);
+
+    SolutionEdt solution;
+    SuiviScore suivi;
+    if (resoudre_edt_portfolio(&probleme, nb_threads, &solution, &suivi) < 0) {
+        printf("Erreur: La génération du planning a échoué. Le planning actuel est conservé.\n");
+        liberer_probleme_edt(&probleme);
+        registre_liberer(&sections);
+        return;
+    }
+
+    liberer_planning(planning);
+    initialiser_planning(planning, nb_jours, nb_creneaux_jour);
+    for (int i = 0; i < probleme.nb_seances; i++) {
+        if (solution.creneau[i] < 0) {
+            continue;
+        }
+        ajouter_seance(planning, probleme.seances[i].id_matiere, probleme.seances[i].id_enseignant,
+                       sections.noms[probleme.seances[i].section], salles[solution.salle[i]],
+                       solution.creneau[i] / nb_creneaux_jour, solution.creneau[i] % nb_creneaux_jour);
+    }
+
+    printf("\nÉvolution de la meilleure solution (%d stratégie(s) en parallèle):\n", solution.nb_threads);
+    for (int k = 0; k < suivi.nb; k++) {
+        printf("  %9.2f ms  %4d séances placées  pénalité %4d  (stratégie %d)\n",
+               suivi.points[k].temps_ms, suivi.points[k].nb_placees, suivi.points[k].penalite,
+               suivi.points[k].strategie);
+    }
+
+    printf("\n%d sections, %d/%d séances placées en %.2f ms (%ld nœuds explorés, pénalité %d, minimum possible %d).\n",
+           sections.nb, solution.nb_placees, probleme.nb_seances, solution.duree_ms,
+           solution.noeuds, solution.penalite, suivi.borne_penalite);
+    if (!solution.complete) {
+        printf("Attention: certaines séances n'ont pas pu être placées (salles ou créneaux insuffisants).\n");
+    }
+
+    liberer_solution_edt(&solution);
+    liberer_probleme_edt(&probleme);
+    registre_liberer(&sections);
+
+    if (sauvegarder_planning(planning)) {
+        printf("Planning généré avec succès.\n");
+    } else {
+        printf("Erreur lors de la sauvegarde du planning.\n");
+    }
+}
+
+/**
+ * Display the planning of a section, a teacher or a room
+ */
+void consulter_planning(const Planning *planning, NodeMatiere* matieres, NodeEnseignant* enseignants) {
+    if (planning->nb_seances == 0) {
+        printf("Le planning est vide. Veuillez d'abord le générer.\n");
+        return;
+    }
+
+    printf("\n=== Consulter le planning ===\n");
+    printf("1. Planning d'une section\n");
+    printf("2. Planning d'un enseignant\n");
+    printf("3. Occupation d'une salle à un créneau\n");
+    int choix = get_int_input("Choisissez une option: ", 1, 3);
+
+    const Seance **resultat = (const Seance**)malloc(planning->nb_seances * sizeof(Seance*));
+    if (resultat == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return;
+    }
+
+    if (choix == 1) {
+        char section[MAX_SECTION_LEN];
+        get_input("Section: ", section, sizeof(section));
+        int nb = seances_section(planning, section, resultat, planning->nb_seances);
+        printf("\n=== Planning de la section %s ===\n", section);
+        afficher_seances(planning, resultat, nb, matieres, enseignants);
+    } else if (choix == 2) {
+        afficher_enseignants(enseignants);
+        int id_enseignant = get_int_input("ID de l'enseignant: ", 1, 9999);
+        int nb = seances_enseignant(planning, id_enseignant, resultat, planning->nb_seances);
+        printf("\n=== Planning de l'enseignant %d ===\n", id_enseignant);
+        afficher_seances(planning, resultat, nb, matieres, enseignants);
+    } else {
+        char salle[MAX_SALLE_LEN];
+        get_input("Salle: ", salle, sizeof(salle));
+        int jour = get_int_input("Jour (0: Lundi, 1: Mardi, ...): ", 0, planning->nb_jours - 1);
+        for (int h = 0; h < planning->nb_creneaux_jour; h++) {
+            printf("%d: %s  ", h, planning->noms_creneaux[h]);
+        }
+        printf("\n");
+        int heure = get_int_input("Créneau: ", 0, planning->nb_creneaux_jour - 1);
+
+        const Seance *seance = seance_salle_creneau(planning, salle, jour, heure);
+        if (seance == NULL) {
+            printf("La salle %s est libre %s, %s.\n", salle, nom_jour_planning(jour), planning->noms_creneaux[heure]);
+        } else {
+            afficher_seances(planning, &seance, 1, matieres, enseignants);
+        }
+    }
+
+    free(resultat);
+}
+
+/**
+ * Get the planning modification counter
+ */
+unsigned long planning_generation(void) {
+    return generation_planning;
+}
@@ -0,0 +1,564 @@
+/**
+ * @file prerequis.c
+ * @brief Implementation of the prerequisites graph of the subjects
+ */
+
+#include "../include/prerequis.h"
+#include "../include/moyennes.h"
+#include "../include/index.h"
+#include "../include/tampon.h"
+#include "../include/utils.h"
+
+#define PREREQUIS_FILE "data/prerequis.txt"
+#define EN_TETE_PREREQUIS "#prerequis 1"
+
+/**
+ * Link from a subject to a subject it requires
+ */
+typedef struct {
+    int id_matiere;
+    int id_requis;
+    int corequis; // 1 = co-requisite, 0 = prerequisite
+} LienPrerequis;
+
+/**
+ * Subject of the graph and its closures
+ */
+typedef struct {
+    int id_matiere;
+    int premier_lien;         // First link of the subject, -1 if none
+    EnsembleBits prerequis;   // Every subject to pass first (prerequisites of prerequisites included)
+    EnsembleBits accessibles; // Every subject reachable through any link, used to refuse cycles
+    int profondeur;
+    int etat;                 // 0 = not visited, 1 = being visited, 2 = done
+} NoeudPrerequis;
+
+static struct {
+    int charge;
+    LienPrerequis *liens;
+    int *suivant_lien;        // Next link of the same subject, -1 if none
+    int nb_liens;
+    int capacite_liens;
+    NoeudPrerequis *noeuds;
+    int nb_noeuds;
+    int capacite_noeuds;
+    IndexId index;            // Subject ID -> node
+    int profondeurs_valides;
+} graphe;
+
+// Node of a subject, created if needed; -1 if error
+static int noeud_matiere(int id_matiere) {
+    int n;
+    if (index_id_chercher(&graphe.index, id_matiere, &n)) {
+        return n;
+    }
+
+    if (graphe.nb_noeuds == graphe.capacite_noeuds) {
+        int capacite = graphe.capacite_noeuds ? graphe.capacite_noeuds * 2 : 16;
+        NoeudPrerequis *noeuds = (NoeudPrerequis*)realloc(graphe.noeuds, capacite * sizeof(NoeudPrerequis));
+        if (noeuds == NULL) {
+            return -1;
+        }
+        graphe.noeuds = noeuds;
+        graphe.capacite_noeuds = capacite;
+    }
+
+    n = graphe.nb_noeuds;
+    if (!index_id_inserer(&graphe.index, id_matiere, n)) {
+        return -1;
+    }
+    graphe.nb_noeuds++;
+    memset(&graphe.noeuds[n], 0, sizeof(NoeudPrerequis));
+    graphe.noeuds[n].id_matiere = id_matiere;
+    graphe.noeuds[n].premier_lien = -1;
+    return n;
+}
+
+// Link from a subject to another, -1 if none
+static int chercher_lien(int id_matiere, int id_requis) {
+    int n;
+    if (!index_id_chercher(&graphe.index, id_matiere, &n)) {
+        return -1;
+    }
+    for (int l = graphe.noeuds[n].premier_lien; l >= 0; l = graphe.suivant_lien[l]) {
+        if (graphe.liens[l].id_requis == id_requis) {
+            return l;
+        }
+    }
+    return -1;
+}
+
+// Add the closures of a link to every subject leading to it
+static int propager_lien(int m, int r, int corequis) {
+    int id_matiere = graphe.noeuds[m].id_matiere;
+    int id_requis = graphe.noeuds[r].id_matiere;
+    for (int x = 0; x < graphe.nb_noeuds; x++) {
+        NoeudPrerequis *noeud = &graphe.noeuds[x];
+        if (x == m || ensemble_bits_contient(&noeud->accessibles, id_matiere)) {
+            if (!ensemble_bits_ajouter(&noeud->accessibles, id_requis) ||
+                !ensemble_bits_union(&noeud->accessibles, &graphe.noeuds[r].accessibles)) {
+                return 0;
+            }
+        }
+        if (!corequis && (x == m || ensemble_bits_contient(&noeud->prerequis, id_matiere))) {
+            if (!ensemble_bits_ajouter(&noeud->prerequis, id_requis) ||
+                !ensemble_bits_union(&noeud->prerequis, &graphe.noeuds[r].prerequis)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Compute the closures and depth of a node from those of the subjects it requires
+static int visiter(int n) {
+    if (graphe.noeuds[n].etat == 2) {
+        return 1;
+    }
+    graphe.noeuds[n].etat = 1;
+    for (int l = graphe.noeuds[n].premier_lien; l >= 0; l = graphe.suivant_lien[l]) {
+        int r = noeud_matiere(graphe.liens[l].id_requis);
+        if (r < 0 || !visiter(r)) {
+            return 0;
+        }
+        NoeudPrerequis *noeud = &graphe.noeuds[n];
+        const NoeudPrerequis *requis = &graphe.noeuds[r];
+        if (!ensemble_bits_ajouter(&noeud->accessibles, requis->id_matiere) ||
+            !ensemble_bits_union(&noeud->accessibles, &requis->accessibles)) {
+            return 0;
+        }
+        if (!graphe.liens[l].corequis &&
+            (!ensemble_bits_ajouter(&noeud->prerequis, requis->id_matiere) ||
+             !ensemble_bits_union(&noeud->prerequis, &requis->prerequis))) {
+            return 0;
+        }
+        if (requis->profondeur + 1 > noeud->profondeur) {
+            noeud->profondeur = requis->profondeur + 1;
+        }
+    }
+    graphe.noeuds[n].etat = 2;
+    return 1;
+}
+
+// Recompute every closure and depth (after a link was removed)
+static int calculer_fermetures(void) {
+    for (int n = 0; n < graphe.nb_noeuds; n++) {
+        ensemble_bits_vider(&graphe.noeuds[n].prerequis);
+        ensemble_bits_vider(&graphe.noeuds[n].accessibles);
+        graphe.noeuds[n].profondeur = 0;
+        graphe.noeuds[n].etat = 0;
+    }
+    for (int n = 0; n < graphe.nb_noeuds; n++) {
+        if (!visiter(n)) {
+            return 0;
+        }
+    }
+    graphe.profondeurs_valides = 1;
+    return 1;
+}
+
+// Add a link to the graph in memory: 1 if added, 0 if refused, -1 if error
+static int inserer_lien(int id_matiere, int id_requis, int corequis) {
+    if (id_matiere == id_requis) {
+        return 0;
+    }
+    int l = chercher_lien(id_matiere, id_requis);
+    if (l >= 0) {
+        if (graphe.liens[l].corequis == corequis) {
+            return 0;
+        }
+        // A co-requisite becoming a prerequisite only adds to the closures, the reverse removes from them
+        graphe.liens[l].corequis = corequis;
+        if (!corequis) {
+            int m = noeud_matiere(id_matiere);
+            int r = noeud_matiere(id_requis);
+            return propager_lien(m, r, 0) ? 1 : -1;
+        }
+        return calculer_fermetures() ? 1 : -1;
+    }
+
+    int m = noeud_matiere(id_matiere);
+    int r = noeud_matiere(id_requis);
+    if (m < 0 || r < 0) {
+        return -1;
+    }
+    // The link would close a cycle if the required subject already leads to the subject
+    if (ensemble_bits_contient(&graphe.noeuds[r].accessibles, id_matiere)) {
+        return 0;
+    }
+
+    if (graphe.nb_liens == graphe.capacite_liens) {
+        int capacite = graphe.capacite_liens ? graphe.capacite_liens * 2 : 32;
+        LienPrerequis *liens = (LienPrerequis*)realloc(graphe.liens, capacite * sizeof(LienPrerequis));
+        if (liens == NULL) {
+            return -1;
+        }
+        graphe.liens = liens;
+        int *suivant = (int*)realloc(graphe.suivant_lien, capacite * sizeof(int));
+        if (suivant == NULL) {
+            return -1;
+        }
+        graphe.suivant_lien = suivant;
+        graphe.capacite_liens = capacite;
+    }
+    l = graphe.nb_liens++;
+    graphe.liens[l].id_matiere = id_matiere;
+    graphe.liens[l].id_requis = id_requis;
+    graphe.liens[l].corequis = corequis;
+    graphe.suivant_lien[l] = graphe.noeuds[m].premier_lien;
+    graphe.noeuds[m].premier_lien = l;
+
+    graphe.profondeurs_valides = 0;
+    return propager_lien(m, r, corequis) ? 1 : -1;
+}
+
+// Load the graph on first use
+static int preparer_graphe(void) {
+    return graphe.charge || charger_prerequis(NULL);
+}
+
+/**
+ * Load the prerequisites graph from file
+ */
+int charger_prerequis(NodeMatiere* matieres) {
+    liberer_prerequis();
+    graphe.charge = 1;
+
+    if (!file_exists(PREREQUIS_FILE)) {
+        return 1;
+    }
+    FILE *file = fopen(PREREQUIS_FILE, "r");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier des prérequis.\n");
+        return 0;
+    }
+
+    // IDs of the known subjects
+    IndexId connues = {0};
+    int ok = 1;
+    for (NodeMatiere *courante = matieres; ok && courante != NULL; courante = courante->suivant) {
+        ok = index_id_inserer(&connues, courante->matiere.id, 0);
+    }
+
+    // id_matiere|id_requis|P (prerequisite) or C (co-requisite)
+    Tampon ligne = {0};
+    while (ok && tampon_lire_ligne(&ligne, file)) {
+        if (ligne.donnees[0] == '#' || ligne.donnees[0] == '\0') {
+            continue;
+        }
+        int id_matiere, id_requis;
+        char type;
+        if (sscanf(ligne.donnees, "%d|%d|%c", &id_matiere, &id_requis, &type) != 3) {
+            continue;
+        }
+        if (matieres != NULL && (!index_id_chercher(&connues, id_matiere, NULL) ||
+                                 !index_id_chercher(&connues, id_requis, NULL))) {
+            printf("Attention: lien de prérequis %d -> %d ignoré (matière inconnue).\n", id_matiere, id_requis);
+            continue;
+        }
+        int resultat = inserer_lien(id_matiere, id_requis, type == 'C');
+        if (resultat == 0) {
+            printf("Attention: lien de prérequis %d -> %d ignoré (doublon ou cycle).\n", id_matiere, id_requis);
+        }
+        ok = (resultat >= 0);
+    }
+    tampon_liberer(&ligne);
+    index_id_liberer(&connues);
+    fclose(file);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+    return ok;
+}
+
+/**
+ * Save the prerequisites graph to file
+ */
+int sauvegarder_prerequis(void) {
+    Tampon contenu = {0};
+    int ok = tampon_printf(&contenu, "%s\n", EN_TETE_PREREQUIS);
+    for (int l = 0; ok && l < graphe.nb_liens; l++) {
+        const LienPrerequis *lien = &graphe.liens[l];
+        ok = tampon_printf(&contenu, "%d|%d|%c\n", lien->id_matiere, lien->id_requis, lien->corequis ? 'C' : 'P');
+    }
+
+    if (!ok || !tampon_ecrire_fichier(PREREQUIS_FILE, &contenu)) {
+        printf("Erreur: Impossible d'écrire le fichier des prérequis.\n");
+        tampon_liberer(&contenu);
+        return 0;
+    }
+    tampon_liberer(&contenu);
+    return 1;
+}
+
+/**
+ * Add a prerequisite or co-requisite link, unless it would close a cycle
+ */
+int ajouter_prerequis(int id_matiere, int id_requis, int corequis) {
+    if (!preparer_graphe()) {
+        return 0;
+    }
+    int resultat = inserer_lien(id_matiere, id_requis, corequis);
+    if (resultat < 0) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    if (resultat == 0) {
+        if (id_matiere == id_requis) {
+            printf("Une matière ne peut pas être son propre prérequis.\n");
+        } else if (chercher_lien(id_matiere, id_requis) >= 0) {
+            printf("Ce lien existe déjà.\n");
+        } else {
+            printf("Ce lien créerait un cycle: la matière %d dépend déjà de la matière %d.\n",
+                   id_requis, id_matiere);
+        }
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Remove the link between two subjects
+ */
+int retirer_prerequis(int id_matiere, int id_requis) {
+    if (!preparer_graphe()) {
+        return 0;
+    }
+    int l = chercher_lien(id_matiere, id_requis);
+    if (l < 0) {
+        return 0;
+    }
+
+    // Compact the links and chain them again, then recompute the closures
+    memmove(&graphe.liens[l], &graphe.liens[l + 1], (graphe.nb_liens - l - 1) * sizeof(LienPrerequis));
+    graphe.nb_liens--;
+    for (int n = 0; n < graphe.nb_noeuds; n++) {
+        graphe.noeuds[n].premier_lien = -1;
+    }
+    for (int k = graphe.nb_liens - 1; k >= 0; k--) {
+        int m;
+        index_id_chercher(&graphe.index, graphe.liens[k].id_matiere, &m);
+        graphe.suivant_lien[k] = graphe.noeuds[m].premier_lien;
+        graphe.noeuds[m].premier_lien = k;
+    }
+    if (!calculer_fermetures()) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+    return 1;
+}
+
+/**
+ * Remove and save every link from or to a deleted subject
+ */
+int retirer_prerequis_matiere(int id_matiere) {
+    if (!preparer_graphe()) {
+        return -1;
+    }
+    int nb = 0;
+    for (int l = graphe.nb_liens - 1; l >= 0; l--) {
+        const LienPrerequis *lien = &graphe.liens[l];
+        if ((lien->id_matiere == id_matiere || lien->id_requis == id_matiere) &&
+            retirer_prerequis(lien->id_matiere, lien->id_requis)) {
+            nb++;
+        }
+    }
+    if (nb > 0 && !sauvegarder_prerequis()) {
+        return -1;
+    }
+    return nb;
+}
+
+/**
+ * Get every subject that must be passed before a subject
+ */
+const EnsembleBits* prerequis_transitifs(int id_matiere) {
+    int n;
+    if (!preparer_graphe() || !index_id_chercher(&graphe.index, id_matiere, &n)) {
+        return NULL;
+    }
+    return &graphe.noeuds[n].prerequis;
+}
+
+/**
+ * Get the depth of a subject in the graph
+ */
+int profondeur_prerequis(int id_matiere) {
+    int n;
+    if (!preparer_graphe() || !index_id_chercher(&graphe.index, id_matiere, &n)) {
+        return 0;
+    }
+    if (!graphe.profondeurs_valides && !calculer_fermetures()) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return 0;
+    }
+    return graphe.noeuds[n].profondeur;
+}
+
+/**
+ * Build the set of subjects a student passed
+ */
+int matieres_reussies(NodeNote* notes, NodeMatiere* matieres, int id_etudiant, EnsembleBits *reussies) {
+    ensemble_bits_vider(reussies);
+    const MoyenneEtudiant *moyenne = obtenir_moyenne_etudiant(notes, matieres, id_etudiant);
+    if (moyenne == NULL) {
+        return 1; // No grades, nothing passed
+    }
+    const MoyenneMatiereEtudiant *details = details_moyenne_etudiant(moyenne);
+    for (int i = 0; i < moyenne->nb_matieres; i++) {
+        if (details[i].nb_notes > 0 && details[i].moyenne >= NOTE_VALIDATION &&
+            !ensemble_bits_ajouter(reussies, details[i].id_matiere)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Check the prerequisites and co-requisites of a subject for a student
+ */
+int prerequis_satisfaits(int id_etudiant, int id_matiere, const EnsembleBits *reussies,
+                         NodeInscription* inscriptions, int afficher) {
+    int n;
+    if (!preparer_graphe() || !index_id_chercher(&graphe.index, id_matiere, &n)) {
+        return 1; // The subject requires nothing
+    }
+    const NoeudPrerequis *noeud = &graphe.noeuds[n];
+
+    int ok = ensemble_bits_inclus(&noeud->prerequis, reussies);
+    if (!ok && afficher) {
+        printf("Prérequis non validés (ID des matières):");
+        for (int id = ensemble_bits_suivant(&noeud->prerequis, 0); id >= 0;
+             id = ensemble_bits_suivant(&noeud->prerequis, id + 1)) {
+            if (!ensemble_bits_contient(reussies, id)) {
+                printf(" %d", id);
+            }
+        }
+        printf("\n");
+    }
+
+    // Co-requisites may also be followed at the same time
+    for (int l = noeud->premier_lien; l >= 0; l = graphe.suivant_lien[l]) {
+        const LienPrerequis *lien = &graphe.liens[l];
+        if (lien->corequis && !ensemble_bits_contient(reussies, lien->id_requis) &&
+            !est_inscrit(inscriptions, id_etudiant, lien->id_requis)) {
+            if (afficher) {
+                printf("Co-requis manquant: la matière %d doit être validée ou suivie en même temps.\n",
+                       lien->id_requis);
+            }
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+// Name of a subject for display
+static const char* nom_matiere(NodeMatiere* matieres, int id_matiere) {
+    NodeMatiere *matiere = trouver_matiere_par_id(matieres, id_matiere);
+    return (matiere != NULL) ? matiere->matiere.nom_matiere : "(inconnue)";
+}
+
+/**
+ * Display the prerequisites and co-requisites of every subject
+ */
+void afficher_prerequis(NodeMatiere* matieres) {
+    if (!preparer_graphe()) {
+        return;
+    }
+    if (graphe.nb_liens == 0) {
+        printf("Aucun prérequis n'est défini.\n");
+        return;
+    }
+
+    printf("\n=== Prérequis des Matières ===\n");
+    for (int n = 0; n < graphe.nb_noeuds; n++) {
+        const NoeudPrerequis *noeud = &graphe.noeuds[n];
+        if (noeud->premier_lien < 0) {
+            continue;
+        }
+        printf("\n%s (ID: %d)\n", nom_matiere(matieres, noeud->id_matiere), noeud->id_matiere);
+        for (int l = noeud->premier_lien; l >= 0; l = graphe.suivant_lien[l]) {
+            const LienPrerequis *lien = &graphe.liens[l];
+            printf("  - %s: %s (ID: %d)\n", lien->corequis ? "Co-requis" : "Prérequis",
+                   nom_matiere(matieres, lien->id_requis), lien->id_requis);
+        }
+        if (ensemble_bits_cardinal(&noeud->prerequis) > 0) {
+            printf("  Matières à valider au préalable:");
+            for (int id = ensemble_bits_suivant(&noeud->prerequis, 0); id >= 0;
+                 id = ensemble_bits_suivant(&noeud->prerequis, id + 1)) {
+                printf(" %d", id);
+            }
+            printf("\n");
+        }
+    }
+}
+
+/**
+ * Prerequisites management menu
+ */
+void menu_prerequis(NodeMatiere* matieres) {
+    int choix = 0;
+
+    do {
+        clear_screen();
+        printf("\n=== Prérequis des Matières ===\n");
+        printf("1. Afficher les prérequis\n");
+        printf("2. Ajouter un prérequis ou un co-requis\n");
+        printf("3. Retirer un prérequis\n");
+        printf("0. Retour\n");
+
+        choix = get_int_input("Choisissez une option: ", 0, 3);
+
+        switch (choix) {
+            case 1:
+                afficher_prerequis(matieres);
+                pause_screen();
+                break;
+
+            case 2: {
+                afficher_matieres(matieres);
+                int id_matiere = get_int_input("ID de la matière: ", 1, 9999);
+                int id_requis = get_int_input("ID de la matière requise: ", 1, 9999);
+                if (trouver_matiere_par_id(matieres, id_matiere) == NULL ||
+                    trouver_matiere_par_id(matieres, id_requis) == NULL) {
+                    printf("Matière non trouvée.\n");
+                } else {
+                    int type = get_int_input("1. Prérequis (à valider avant), 2. Co-requis (à suivre en même temps): ", 1, 2);
+                    if (ajouter_prerequis(id_matiere, id_requis, type == 2) && sauvegarder_prerequis()) {
+                        printf("Lien ajouté avec succès.\n");
+                    }
+                }
+                pause_screen();
+                break;
+            }
+
+            case 3: {
+                afficher_prerequis(matieres);
+                int id_matiere = get_int_input("ID de la matière: ", 1, 9999);
+                int id_requis = get_int_input("ID de la matière requise: ", 1, 9999);
+                if (!retirer_prerequis(id_matiere, id_requis)) {
+                    printf("Aucun lien entre ces matières.\n");
+                } else if (sauvegarder_prerequis()) {
+                    printf("Lien retiré avec succès.\n");
+                }
+                pause_screen();
+                break;
+            }
+        }
+    } while (choix != 0);
+}
+
+/**
+ * Free the prerequisites graph
+ */
+void liberer_prerequis(void) {
+    for (int n = 0; n < graphe.nb_noeuds; n++) {
+        ensemble_bits_liberer(&graphe.noeuds[n].prerequis);
+        ensemble_bits_liberer(&graphe.noeuds[n].accessibles);
+    }
+    free(graphe.noeuds);
+    free(graphe.liens);
+    free(graphe.suivant_lien);
+    index_id_liberer(&graphe.index);
+    memset(&graphe, 0, sizeof(graphe));
+}
@@ -0,0 +1,327 @@
+/**
+ * @file rapports.c
+ * @brief Implementation of the parallel end-of-term reports
+ */
+
+#include <time.h>
+#include "../include/rapports.h"
+#include "../include/moyennes.h"
+#include "../include/parallele.h"
+#include "../include/index.h"
+#include "../include/colonnes_notes.h"
+
+#define NOTES_PAR_TACHE 4096
+#define ETUDIANTS_PAR_TACHE 256
+
+/**
+ * Read-only snapshot of the data shared by the workers, plus their partial results
+ */
+typedef struct {
+    int nb_notes;
+    int *note_matiere;    // Dense subject position of each grade
+    const float *note_valeur; // Score column of the grade store
+    const MoyenneEtudiant **moyennes; // Cached averages of each dense student, NULL without grades
+    int nb_taches_notes;
+    StatistiquesNotes *partiels_matieres;  // [tache * nb_matieres + matiere]
+    int nb_taches_etudiants;
+    StatistiquesNotes *partiels_moyennes;  // [tache]
+    RapportFinSemestre *rapport;
+} ContexteRapport;
+
+// Milliseconds elapsed since a start time
+static double duree_depuis(const struct timespec *debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) * 1000.0 + (fin.tv_nsec - debut->tv_nsec) / 1000000.0;
+}
+
+// Task: subject statistics over one range of grades
+static void tache_statistiques_notes(int tache, void *arg) {
+    ContexteRapport *ctx = (ContexteRapport*)arg;
+    StatistiquesNotes *partiels = &ctx->partiels_matieres[(size_t)tache * ctx->rapport->nb_matieres];
+
+    int debut = tache * NOTES_PAR_TACHE;
+    int fin = debut + NOTES_PAR_TACHE;
+    if (fin > ctx->nb_notes) {
+        fin = ctx->nb_notes;
+    }
+
+    for (int i = debut; i < fin; i++) {
+        stats_ajouter(&partiels[ctx->note_matiere[i]], ctx->note_valeur[i]);
+    }
+}
+
+// Task: merge the partial statistics of one subject
+static void tache_fusion_matiere(int matiere, void *arg) {
+    ContexteRapport *ctx = (ContexteRapport*)arg;
+    StatistiquesNotes *stats = &ctx->rapport->matieres[matiere].stats;
+
+    for (int t = 0; t < ctx->nb_taches_notes; t++) {
+        stats_fusionner(stats, &ctx->partiels_matieres[(size_t)t * ctx->rapport->nb_matieres + matiere]);
+    }
+}
+
+// Task: weighted averages of one range of students, read from the averages cache
+static void tache_moyennes_etudiants(int tache, void *arg) {
+    ContexteRapport *ctx = (ContexteRapport*)arg;
+    RapportFinSemestre *rapport = ctx->rapport;
+
+    int debut = tache * ETUDIANTS_PAR_TACHE;
+    int fin = debut + ETUDIANTS_PAR_TACHE;
+    if (fin > rapport->nb_etudiants) {
+        fin = rapport->nb_etudiants;
+    }
+
+    for (int e = debut; e < fin; e++) {
+        const MoyenneEtudiant *moyenne = ctx->moyennes[e];
+        if (moyenne == NULL) {
+            continue;
+        }
+
+        RapportEtudiant *etudiant = &rapport->etudiants[e];
+        etudiant->moyenne_ponderee = moyenne->moyenne_ponderee;
+        etudiant->nb_notes = moyenne->nb_notes;
+        etudiant->nb_matieres = moyenne->nb_matieres;
+        stats_ajouter(&ctx->partiels_moyennes[tache], etudiant->moyenne_ponderee);
+    }
+}
+
+// Dense position of an ID, appended to the index if it was not known yet
+static int position_dense(IndexId *index, int id, int *nb) {
+    int pos;
+    if (!index_id_chercher(index, id, &pos)) {
+        pos = (*nb)++;
+        index_id_inserer(index, id, pos);
+    }
+    return pos;
+}
+
+/**
+ * Compute all end-of-term aggregates on a worker pool
+ */
+int generer_rapport_fin_semestre(RapportFinSemestre *rapport, NodeNote* notes,
+                                 NodeMatiere* matieres, NodeEtudiant* etudiants, int nb_threads) {
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    memset(rapport, 0, sizeof(RapportFinSemestre));
+
+    const ColonnesNotes *colonnes = obtenir_colonnes_notes(notes);
+    if (colonnes == NULL) {
+        return 0;
+    }
+
+    int nb_notes = colonnes->nb, nb_matieres_liste = 0, nb_etudiants_liste = 0;
+    for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) nb_matieres_liste++;
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) nb_etudiants_liste++;
+
+    // Grades may refer to subjects or students that were deleted: reserve room for them
+    ContexteRapport ctx = {0};
+    ctx.rapport = rapport;
+    ctx.nb_notes = nb_notes;
+    ctx.note_matiere = (int*)malloc((nb_notes + 1) * sizeof(int));
+    ctx.note_valeur = colonnes->note;
+    ctx.moyennes = (const MoyenneEtudiant**)malloc((nb_etudiants_liste + nb_notes + 1) * sizeof(MoyenneEtudiant*));
+    rapport->matieres = (RapportMatiere*)calloc(nb_matieres_liste + nb_notes + 1, sizeof(RapportMatiere));
+    rapport->etudiants = (RapportEtudiant*)calloc(nb_etudiants_liste + nb_notes + 1, sizeof(RapportEtudiant));
+
+    IndexId index_matieres = {0};
+    IndexId index_etudiants = {0};
+    int ok = ctx.note_matiere != NULL && ctx.moyennes != NULL &&
+             rapport->matieres != NULL && rapport->etudiants != NULL &&
+             index_id_initialiser(&index_matieres, nb_matieres_liste) &&
+             index_id_initialiser(&index_etudiants, nb_etudiants_liste);
+
+    if (ok) {
+        // Sequential snapshot of the lists into dense arrays
+        for (NodeMatiere* m = matieres; m != NULL; m = m->suivant) {
+            int pos = position_dense(&index_matieres, m->matiere.id, &rapport->nb_matieres);
+            rapport->matieres[pos].id_matiere = m->matiere.id;
+            rapport->matieres[pos].coefficient = m->matiere.coefficient;
+        }
+        for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) {
+            int pos = position_dense(&index_etudiants, e->etudiant.id, &rapport->nb_etudiants);
+            rapport->etudiants[pos].id_etudiant = e->etudiant.id;
+        }
+
+        // Map the ID columns of the grade store to dense positions
+        int i;
+        for (i = 0; i < nb_notes; i++) {
+            int nb_avant = rapport->nb_matieres;
+            int m = position_dense(&index_matieres, colonnes->id_matiere[i], &rapport->nb_matieres);
+            if (m == nb_avant) {
+                rapport->matieres[m].id_matiere = colonnes->id_matiere[i];
+                rapport->matieres[m].coefficient = COEFFICIENT_PAR_DEFAUT;
+            }
+
+            nb_avant = rapport->nb_etudiants;
+            int e = position_dense(&index_etudiants, colonnes->id_etudiant[i], &rapport->nb_etudiants);
+            if (e == nb_avant) {
+                rapport->etudiants[e].id_etudiant = colonnes->id_etudiant[i];
+            }
+
+            ctx.note_matiere[i] = m;
+        }
+
+        // Averages come from the shared cache, built here before the workers only read it
+        if (nb_notes > 0 && obtenir_moyenne_etudiant(notes, matieres, colonnes->id_etudiant[0]) == NULL) {
+            ok = 0;
+        }
+        for (int e = 0; ok && e < rapport->nb_etudiants; e++) {
+            ctx.moyennes[e] = obtenir_moyenne_etudiant(notes, matieres, rapport->etudiants[e].id_etudiant);
+        }
+    }
+
+    if (ok) {
+        ctx.nb_taches_notes = (nb_notes + NOTES_PAR_TACHE - 1) / NOTES_PAR_TACHE;
+        ctx.nb_taches_etudiants = (rapport->nb_etudiants + ETUDIANTS_PAR_TACHE - 1) / ETUDIANTS_PAR_TACHE;
+        ctx.partiels_matieres = (StatistiquesNotes*)calloc((size_t)ctx.nb_taches_notes * rapport->nb_matieres + 1,
+                                                           sizeof(StatistiquesNotes));
+        ctx.partiels_moyennes = (StatistiquesNotes*)calloc(ctx.nb_taches_etudiants + 1, sizeof(StatistiquesNotes));
+        ok = ctx.partiels_matieres != NULL && ctx.partiels_moyennes != NULL;
+    }
+
+    if (ok) {
+        // Subject statistics: partition the grades, then merge the partial aggregates per subject
+        rapport->nb_threads = executer_taches_paralleles(ctx.nb_taches_notes, nb_threads,
+                                                         tache_statistiques_notes, &ctx);
+        executer_taches_paralleles(rapport->nb_matieres, nb_threads, tache_fusion_matiere, &ctx);
+
+        // Weighted averages: partition the students
+        int utilises = executer_taches_paralleles(ctx.nb_taches_etudiants, nb_threads,
+                                                  tache_moyennes_etudiants, &ctx);
+        if (utilises > rapport->nb_threads) {
+            rapport->nb_threads = utilises;
+        }
+
+        for (int t = 0; t < ctx.nb_taches_etudiants; t++) {
+            stats_fusionner(&rapport->moyennes_etudiants, &ctx.partiels_moyennes[t]);
+        }
+    }
+
+    free(ctx.note_matiere);
+    free(ctx.moyennes);
+    free(ctx.partiels_matieres);
+    free(ctx.partiels_moyennes);
+    index_id_liberer(&index_matieres);
+    index_id_liberer(&index_etudiants);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        liberer_rapport_fin_semestre(rapport);
+        return 0;
+    }
+
+    rapport->duree_ms = duree_depuis(&debut);
+    return 1;
+}
+
+// Sort students by decreasing weighted average
+static int comparer_moyennes(const void *a, const void *b) {
+    const RapportEtudiant *ea = (const RapportEtudiant*)a;
+    const RapportEtudiant *eb = (const RapportEtudiant*)b;
+    if (ea->moyenne_ponderee < eb->moyenne_ponderee) return 1;
+    if (ea->moyenne_ponderee > eb->moyenne_ponderee) return -1;
+    return ea->id_etudiant - eb->id_etudiant;
+}
+
+/**
+ * Display the subject statistics, student statistics and student averages of a report
+ */
+void afficher_rapport_fin_semestre(const RapportFinSemestre *rapport, NodeMatiere* matieres, NodeEtudiant* etudiants) {
+    printf("\n=== Moyennes par Matière ===\n");
+    printf("%-4s | %-20s | %-5s | %-9s | %-7s | %-10s | %-7s | %-9s\n",
+           "ID", "Matière", "Coef.", "Nb. notes", "Moyenne", "Écart-type", "Médiane", "Réussite");
+    printf("----------------------------------------------------------------------------------------\n");
+
+    for (int m = 0; m < rapport->nb_matieres; m++) {
+        const RapportMatiere *rm = &rapport->matieres[m];
+        NodeMatiere* matiere = trouver_matiere_par_id(matieres, rm->id_matiere);
+        float reussite = (rm->stats.nb > 0) ? (float)rm->stats.nb_reussites / rm->stats.nb * 100 : 0.0f;
+
+        printf("%-4d | %-20s | %-5.2f | %-9d | %-7.2f | %-10.2f | %-7.2f | %-8.1f%%\n",
+               rm->id_matiere,
+               matiere != NULL ? matiere->matiere.nom_matiere : "(inconnue)",
+               rm->coefficient,
+               rm->stats.nb,
+               rm->stats.moyenne,
+               stats_ecart_type(&rm->stats),
+               stats_quantile(&rm->stats, 0.5),
+               reussite);
+    }
+
+    // Index the student list once to resolve names in O(1)
+    int nb_etudiants_liste = 0;
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) nb_etudiants_liste++;
+
+    NodeEtudiant **noeuds = (NodeEtudiant**)malloc((nb_etudiants_liste + 1) * sizeof(NodeEtudiant*));
+    RapportEtudiant *classement = (RapportEtudiant*)malloc((rapport->nb_etudiants + 1) * sizeof(RapportEtudiant));
+    IndexId index_etudiants = {0};
+    if (noeuds == NULL || classement == NULL || !index_id_initialiser(&index_etudiants, nb_etudiants_liste)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        free(noeuds);
+        free(classement);
+        index_id_liberer(&index_etudiants);
+        return;
+    }
+
+    int i = 0;
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant, i++) {
+        noeuds[i] = e;
+        index_id_inserer(&index_etudiants, e->etudiant.id, i);
+    }
+
+    const StatistiquesNotes *moyennes = &rapport->moyennes_etudiants;
+    printf("\n=== Statistiques des Étudiants ===\n");
+    printf("Nombre total d'étudiants: %d\n", nb_etudiants_liste);
+    printf("Étudiants avec notes: %d\n", moyennes->nb);
+    if (moyennes->nb > 0) {
+        printf("Moyenne des moyennes pondérées: %.2f (écart-type %.2f, médiane %.2f)\n",
+               moyennes->moyenne, stats_ecart_type(moyennes), stats_quantile(moyennes, 0.5));
+        printf("Taux de réussite (moyenne pondérée >= 10): %.1f%% (%d étudiants)\n",
+               (float)moyennes->nb_reussites / moyennes->nb * 100, moyennes->nb_reussites);
+    }
+
+    printf("\n=== Moyennes Pondérées des Étudiants ===\n");
+    printf("%-4s | %-30s | %-8s | %-8s | %-10s\n", "ID", "Nom", "Section", "Moyenne", "Nb. notes");
+    printf("----------------------------------------------------------------------\n");
+
+    int nb_classes = 0;
+    for (int e = 0; e < rapport->nb_etudiants; e++) {
+        if (rapport->etudiants[e].nb_notes > 0) {
+            classement[nb_classes++] = rapport->etudiants[e];
+        }
+    }
+    qsort(classement, nb_classes, sizeof(RapportEtudiant), comparer_moyennes);
+
+    for (int k = 0; k < nb_classes; k++) {
+        int pos;
+        char nom[101] = "(inconnu)";
+        const char *section = "";
+        if (index_id_chercher(&index_etudiants, classement[k].id_etudiant, &pos)) {
+            snprintf(nom, sizeof(nom), "%s %s", noeuds[pos]->etudiant.prenom, noeuds[pos]->etudiant.nom);
+            section = noeuds[pos]->etudiant.section;
+        }
+
+        printf("%-4d | %-30s | %-8s | %-8.2f | %-10d\n",
+               classement[k].id_etudiant, nom, section,
+               classement[k].moyenne_ponderee, classement[k].nb_notes);
+    }
+
+    printf("\nRapports générés avec %d thread(s) en %.2f ms.\n", rapport->nb_threads, rapport->duree_ms);
+
+    free(noeuds);
+    free(classement);
+    index_id_liberer(&index_etudiants);
+}
+
+/**
+ * Free memory allocated for a report
+ */
+void liberer_rapport_fin_semestre(RapportFinSemestre *rapport) {
+    free(rapport->matieres);
+    free(rapport->etudiants);
+    rapport->matieres = NULL;
+    rapport->etudiants = NULL;
+    rapport->nb_matieres = 0;
+    rapport->nb_etudiants = 0;
+}
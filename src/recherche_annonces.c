@@ -0,0 +1,597 @@
+/**
+ * @file recherche_annonces.c
+ * @brief Implementation of the full-text search over announcements
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include "../include/recherche_annonces.h"
+#include "../include/index.h"
+#include "../include/utils.h"
+
+/**
+ * Postings of one token: (ID delta, occurrences) pairs as variable-length
+ * integers, by increasing ID
+ */
+typedef struct {
+    unsigned char *octets;
+    size_t taille;
+    size_t capacite;
+    int nb_annonces; // Announcements containing the token
+    int dernier_id;  // ID of the last posting, to append without decoding
+} ListePostings;
+
+/**
+ * Weighted occurrences of a term in an announcement
+ */
+typedef struct {
+    int id;
+    int occurrences;
+} Posting;
+
+/**
+ * Announcement matching a query while it is evaluated
+ */
+typedef struct {
+    int id;
+    double score;
+} Candidat;
+
+static struct {
+    ListePostings *termes;
+    int nb_termes;
+    int capacite_termes;
+    IndexId dictionnaire;   // Token hash -> term number
+    NodeAnnonce **annonces; // Announcement of each slot, NULL once removed
+    int nb_emplacements;
+    int capacite_emplacements;
+    IndexId emplacements;   // Announcement ID -> slot
+    int nb_annonces;        // Announcements currently indexed
+    int construit;
+} index_texte;
+
+// Unaccented lowercase form of the Latin-1 letter encoded as 0xC3 then `c` ("" if not a letter)
+static const char* replier_latin1(unsigned char c) {
+    static const char *table[64] = {
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "",  "n", "o", "o", "o", "o", "o",  "",  "o", "u", "u", "u", "u", "y", "",  "ss",
+        "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+        "",  "n", "o", "o", "o", "o", "o",  "",  "o", "u", "u", "u", "u", "y", "",  "y"
+    };
+    return (c >= 0x80 && c <= 0xBF) ? table[c - 0x80] : "";
+}
+
+// Cut the next token of a UTF-8 text, lowercase and without accents; returns the position after it, NULL at the end
+static const char* token_suivant(const char *texte, char token[MAX_TOKEN_LEN + 1]) {
+    const unsigned char *p = (const unsigned char*)texte;
+    size_t longueur = 0;
+
+    while (*p != '\0') {
+        const char *pli = "";
+        char simple[2] = {0};
+        int avance = 1;
+
+        if (*p < 0x80 && isalnum(*p)) {
+            simple[0] = (char)tolower(*p);
+            pli = simple;
+        } else if (*p == 0xC3 && p[1] != '\0') {
+            pli = replier_latin1(p[1]);
+            avance = 2;
+        } else if (*p == 0xC5 && (p[1] == 0x92 || p[1] == 0x93)) {
+            pli = "oe";
+            avance = 2;
+        } else if (*p >= 0x80) {
+            // Any other character is a separator, skipped as a whole sequence
+            while ((p[avance] & 0xC0) == 0x80) {
+                avance++;
+            }
+        }
+
+        if (*pli != '\0') {
+            for (; *pli != '\0' && longueur < MAX_TOKEN_LEN; pli++) {
+                token[longueur++] = *pli;
+            }
+        } else if (longueur > 0) {
+            break;
+        }
+        p += avance;
+    }
+
+    token[longueur] = '\0';
+    return (longueur > 0) ? (const char*)p : NULL;
+}
+
+// Append a variable-length integer (7 bits per byte, high bit set on all but the last)
+static int ecrire_varint(ListePostings *liste, unsigned int valeur) {
+    if (liste->capacite - liste->taille < 5) {
+        size_t capacite = liste->capacite ? liste->capacite * 2 : 16;
+        unsigned char *octets = (unsigned char*)realloc(liste->octets, capacite);
+        if (octets == NULL) {
+            return 0;
+        }
+        liste->octets = octets;
+        liste->capacite = capacite;
+    }
+    while (valeur >= 0x80) {
+        liste->octets[liste->taille++] = (unsigned char)(valeur | 0x80);
+        valeur >>= 7;
+    }
+    liste->octets[liste->taille++] = (unsigned char)valeur;
+    return 1;
+}
+
+// Read a variable-length integer and move past it
+static unsigned int lire_varint(const unsigned char **p) {
+    unsigned int valeur = 0;
+    int decalage = 0;
+    while (**p & 0x80) {
+        valeur |= (unsigned int)(**p & 0x7F) << decalage;
+        decalage += 7;
+        (*p)++;
+    }
+    valeur |= (unsigned int)**p << decalage;
+    (*p)++;
+    return valeur;
+}
+
+// Append a posting whose ID is greater than every ID of the list
+static int ajouter_en_fin(ListePostings *liste, int id, int occurrences) {
+    if (!ecrire_varint(liste, (unsigned int)(id - liste->dernier_id)) ||
+        !ecrire_varint(liste, (unsigned int)occurrences)) {
+        return 0;
+    }
+    liste->dernier_id = id;
+    liste->nb_annonces++;
+    return 1;
+}
+
+// Decode a posting list into an array to free by the caller; -1 if error
+static int decoder_postings(const ListePostings *liste, Posting **postings) {
+    *postings = (Posting*)malloc((liste->nb_annonces > 0 ? liste->nb_annonces : 1) * sizeof(Posting));
+    if (*postings == NULL) {
+        return -1;
+    }
+
+    const unsigned char *p = liste->octets;
+    int id = 0;
+    for (int i = 0; i < liste->nb_annonces; i++) {
+        id += (int)lire_varint(&p);
+        (*postings)[i].id = id;
+        (*postings)[i].occurrences = (int)lire_varint(&p);
+    }
+    return liste->nb_annonces;
+}
+
+// Rebuild a posting list with the posting of `id` set to `occurrences`, or removed if 0
+static int reecrire_postings(ListePostings *liste, int id, int occurrences) {
+    Posting *anciens;
+    int nb = decoder_postings(liste, &anciens);
+    if (nb < 0) {
+        return 0;
+    }
+
+    liste->taille = 0;
+    liste->nb_annonces = 0;
+    liste->dernier_id = 0;
+
+    int ok = 1;
+    int insere = (occurrences == 0);
+    for (int i = 0; ok && i < nb; i++) {
+        if (!insere && id < anciens[i].id) {
+            ok = ajouter_en_fin(liste, id, occurrences);
+            insere = 1;
+        }
+        if (anciens[i].id != id) {
+            ok = ok && ajouter_en_fin(liste, anciens[i].id, anciens[i].occurrences);
+        }
+    }
+    if (ok && !insere) {
+        ok = ajouter_en_fin(liste, id, occurrences);
+    }
+
+    free(anciens);
+    return ok;
+}
+
+// Add a posting, appending when the ID is the greatest (the usual case for new announcements)
+static int ajouter_posting(ListePostings *liste, int id, int occurrences) {
+    if (liste->nb_annonces == 0 || id > liste->dernier_id) {
+        return ajouter_en_fin(liste, id, occurrences);
+    }
+    return reecrire_postings(liste, id, occurrences);
+}
+
+// Term number of a token, created if asked; -1 if unknown or error
+static int numero_terme(const char *token, int creer) {
+    long long cle = index_cle_chaine(token);
+    int terme;
+    if (index_id_chercher(&index_texte.dictionnaire, cle, &terme)) {
+        return terme;
+    }
+    if (!creer) {
+        return -1;
+    }
+
+    if (index_texte.nb_termes == index_texte.capacite_termes) {
+        int capacite = index_texte.capacite_termes ? index_texte.capacite_termes * 2 : 256;
+        ListePostings *termes = (ListePostings*)realloc(index_texte.termes, capacite * sizeof(ListePostings));
+        if (termes == NULL) {
+            return -1;
+        }
+        index_texte.termes = termes;
+        index_texte.capacite_termes = capacite;
+    }
+
+    terme = index_texte.nb_termes;
+    if (!index_id_inserer(&index_texte.dictionnaire, cle, terme)) {
+        return -1;
+    }
+    memset(&index_texte.termes[terme], 0, sizeof(ListePostings));
+    index_texte.nb_termes++;
+    return terme;
+}
+
+// Order postings by term number
+static int comparer_postings(const void *a, const void *b) {
+    return ((const Posting*)a)->id - ((const Posting*)b)->id;
+}
+
+// Add the tokens of a text to an array of (term, weight) pairs; 0 if error
+static int ajouter_tokens(const char *texte, int poids, int creer, Posting **termes, int *nb, int *capacite) {
+    char token[MAX_TOKEN_LEN + 1];
+    while ((texte = token_suivant(texte, token)) != NULL) {
+        if (strlen(token) < 2) {
+            continue;
+        }
+        int terme = numero_terme(token, creer);
+        if (terme < 0) {
+            if (creer) {
+                return 0;
+            }
+            continue;
+        }
+        if (*nb == *capacite) {
+            *capacite = *capacite ? *capacite * 2 : 64;
+            Posting *agrandi = (Posting*)realloc(*termes, *capacite * sizeof(Posting));
+            if (agrandi == NULL) {
+                return 0;
+            }
+            *termes = agrandi;
+        }
+        (*termes)[*nb].id = terme;
+        (*termes)[*nb].occurrences = poids;
+        (*nb)++;
+    }
+    return 1;
+}
+
+// Weighted occurrences of each distinct term of an announcement (term number in `id`); -1 if error
+static int compter_occurrences(const NodeAnnonce *annonce, int creer, Posting **termes) {
+    int nb = 0;
+    int capacite = 0;
+    *termes = NULL;
+    if (!ajouter_tokens(annonce_titre(annonce), POIDS_TITRE, creer, termes, &nb, &capacite) ||
+        !ajouter_tokens(annonce_contenu(annonce), 1, creer, termes, &nb, &capacite)) {
+        free(*termes);
+        *termes = NULL;
+        return -1;
+    }
+
+    qsort(*termes, nb, sizeof(Posting), comparer_postings);
+    int nb_distincts = 0;
+    for (int i = 0; i < nb; i++) {
+        if (nb_distincts > 0 && (*termes)[nb_distincts - 1].id == (*termes)[i].id) {
+            (*termes)[nb_distincts - 1].occurrences += (*termes)[i].occurrences;
+        } else {
+            (*termes)[nb_distincts++] = (*termes)[i];
+        }
+    }
+    return nb_distincts;
+}
+
+// Index an announcement and remember it in its slot
+static int indexer(NodeAnnonce *annonce) {
+    Posting *termes;
+    int nb = compter_occurrences(annonce, 1, &termes);
+    if (nb < 0) {
+        return 0;
+    }
+    int ok = 1;
+    for (int i = 0; ok && i < nb; i++) {
+        ok = ajouter_posting(&index_texte.termes[termes[i].id], annonce->annonce.id, termes[i].occurrences);
+    }
+    free(termes);
+    if (!ok) {
+        return 0;
+    }
+
+    int emplacement;
+    if (index_id_chercher(&index_texte.emplacements, annonce->annonce.id, &emplacement)) {
+        if (index_texte.annonces[emplacement] == NULL) {
+            index_texte.nb_annonces++;
+        }
+        index_texte.annonces[emplacement] = annonce;
+        return 1;
+    }
+
+    if (index_texte.nb_emplacements == index_texte.capacite_emplacements) {
+        int capacite = index_texte.capacite_emplacements ? index_texte.capacite_emplacements * 2 : 64;
+        NodeAnnonce **annonces = (NodeAnnonce**)realloc(index_texte.annonces, capacite * sizeof(NodeAnnonce*));
+        if (annonces == NULL) {
+            return 0;
+        }
+        index_texte.annonces = annonces;
+        index_texte.capacite_emplacements = capacite;
+    }
+    emplacement = index_texte.nb_emplacements;
+    if (!index_id_inserer(&index_texte.emplacements, annonce->annonce.id, emplacement)) {
+        return 0;
+    }
+    index_texte.nb_emplacements++;
+    index_texte.annonces[emplacement] = annonce;
+    index_texte.nb_annonces++;
+    return 1;
+}
+
+// Order announcements by increasing ID
+static int comparer_annonces_id(const void *a, const void *b) {
+    return (*(NodeAnnonce* const*)a)->annonce.id - (*(NodeAnnonce* const*)b)->annonce.id;
+}
+
+// Index every announcement of a list
+static int construire_index(NodeAnnonce* tete) {
+    recherche_invalider();
+
+    int nb = 0;
+    for (NodeAnnonce* courant = tete; courant != NULL; courant = courant->suivant) {
+        nb++;
+    }
+    NodeAnnonce **annonces = (NodeAnnonce**)malloc((nb > 0 ? nb : 1) * sizeof(NodeAnnonce*));
+    if (annonces == NULL) {
+        return 0;
+    }
+    nb = 0;
+    for (NodeAnnonce* courant = tete; courant != NULL; courant = courant->suivant) {
+        annonces[nb++] = courant;
+    }
+
+    // By increasing ID every posting is appended, nothing is decoded
+    qsort(annonces, nb, sizeof(NodeAnnonce*), comparer_annonces_id);
+    int ok = 1;
+    for (int i = 0; ok && i < nb; i++) {
+        ok = indexer(annonces[i]);
+    }
+    free(annonces);
+
+    if (!ok) {
+        recherche_invalider();
+        return 0;
+    }
+    index_texte.construit = 1;
+    return 1;
+}
+
+/**
+ * Add an announcement to the index (no-op until the index is built)
+ */
+int recherche_indexer_annonce(NodeAnnonce* annonce) {
+    if (!index_texte.construit) {
+        return 1;
+    }
+    if (!indexer(annonce)) {
+        recherche_invalider();
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Remove an announcement from the index, using its current texts (no-op until the index is built)
+ */
+void recherche_retirer_annonce(const NodeAnnonce* annonce) {
+    if (!index_texte.construit) {
+        return;
+    }
+
+    Posting *termes;
+    int nb = compter_occurrences(annonce, 0, &termes);
+    int ok = (nb >= 0);
+    for (int i = 0; ok && i < nb; i++) {
+        ok = reecrire_postings(&index_texte.termes[termes[i].id], annonce->annonce.id, 0);
+    }
+    free(termes);
+
+    int emplacement;
+    if (ok && index_id_chercher(&index_texte.emplacements, annonce->annonce.id, &emplacement) &&
+        index_texte.annonces[emplacement] != NULL) {
+        index_texte.annonces[emplacement] = NULL;
+        index_texte.nb_annonces--;
+    }
+
+    // A partial removal would leave stale postings: rebuild on the next search instead
+    if (!ok) {
+        recherche_invalider();
+    }
+}
+
+/**
+ * Drop the index (after a load or when the list is freed); the next search rebuilds it
+ */
+void recherche_invalider(void) {
+    for (int t = 0; t < index_texte.nb_termes; t++) {
+        free(index_texte.termes[t].octets);
+    }
+    free(index_texte.termes);
+    free(index_texte.annonces);
+    index_id_liberer(&index_texte.dictionnaire);
+    index_id_liberer(&index_texte.emplacements);
+    memset(&index_texte, 0, sizeof(index_texte));
+}
+
+// Order query terms from the rarest
+static int comparer_rarete(const void *a, const void *b) {
+    return index_texte.termes[*(const int*)a].nb_annonces - index_texte.termes[*(const int*)b].nb_annonces;
+}
+
+// Order results by decreasing score, then newest (greatest ID) first
+static int comparer_resultats(const void *a, const void *b) {
+    const ResultatRecherche *ra = (const ResultatRecherche*)a;
+    const ResultatRecherche *rb = (const ResultatRecherche*)b;
+    if (ra->score != rb->score) {
+        return (ra->score < rb->score) ? 1 : -1;
+    }
+    return rb->annonce->annonce.id - ra->annonce->annonce.id;
+}
+
+// Merge the postings of a term into the candidates (sorted by ID): intersection or union
+static int fusionner(Candidat **candidats, int nb_candidats, const Posting *postings, int nb_postings,
+                     double idf, ModeRecherche mode) {
+    Candidat *fusion = (Candidat*)malloc((nb_candidats + nb_postings + 1) * sizeof(Candidat));
+    if (fusion == NULL) {
+        return -1;
+    }
+
+    int i = 0, j = 0, nb = 0;
+    while (i < nb_candidats || j < nb_postings) {
+        if (j == nb_postings || (i < nb_candidats && (*candidats)[i].id < postings[j].id)) {
+            if (mode == RECHERCHE_OU) fusion[nb++] = (*candidats)[i];
+            i++;
+        } else if (i == nb_candidats || postings[j].id < (*candidats)[i].id) {
+            if (mode == RECHERCHE_OU) {
+                fusion[nb].id = postings[j].id;
+                fusion[nb++].score = idf * (1.0 + log(postings[j].occurrences));
+            }
+            j++;
+        } else {
+            fusion[nb].id = postings[j].id;
+            fusion[nb++].score = (*candidats)[i].score + idf * (1.0 + log(postings[j].occurrences));
+            i++;
+            j++;
+        }
+    }
+
+    free(*candidats);
+    *candidats = fusion;
+    return nb;
+}
+
+/**
+ * Search announcements, most relevant first (tf-idf, newest first on ties)
+ */
+int rechercher_annonces(NodeAnnonce* tete, const char *requete, ModeRecherche mode, ResultatRecherche **resultats) {
+    *resultats = NULL;
+    if (!index_texte.construit && !construire_index(tete)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+
+    // Distinct known terms of the query; an unknown word empties an AND query
+    int termes[64];
+    int nb_termes = 0;
+    char token[MAX_TOKEN_LEN + 1];
+    const char *p = requete;
+    while ((p = token_suivant(p, token)) != NULL && nb_termes < 64) {
+        if (strlen(token) < 2) {
+            continue;
+        }
+        int terme = numero_terme(token, 0);
+        if (terme < 0 || index_texte.termes[terme].nb_annonces == 0) {
+            if (mode == RECHERCHE_ET) {
+                return 0;
+            }
+            continue;
+        }
+        int doublon = 0;
+        for (int k = 0; k < nb_termes; k++) {
+            doublon |= (termes[k] == terme);
+        }
+        if (!doublon) {
+            termes[nb_termes++] = terme;
+        }
+    }
+    if (nb_termes == 0) {
+        return 0;
+    }
+
+    // From the rarest term, so that an AND query shrinks as early as possible
+    qsort(termes, nb_termes, sizeof(int), comparer_rarete);
+    Candidat *candidats = NULL;
+    int nb_candidats = 0;
+    for (int k = 0; k < nb_termes && (k == 0 || nb_candidats > 0 || mode == RECHERCHE_OU); k++) {
+        const ListePostings *liste = &index_texte.termes[termes[k]];
+        double idf = log(1.0 + (double)index_texte.nb_annonces / liste->nb_annonces);
+        Posting *postings;
+        int nb_postings = decoder_postings(liste, &postings);
+        if (nb_postings >= 0) {
+            nb_candidats = fusionner(&candidats, nb_candidats, postings, nb_postings, idf,
+                                     (k == 0) ? RECHERCHE_OU : mode);
+            free(postings);
+        }
+        if (nb_postings < 0 || nb_candidats < 0) {
+            free(candidats);
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            return -1;
+        }
+    }
+
+    *resultats = (ResultatRecherche*)malloc((nb_candidats > 0 ? nb_candidats : 1) * sizeof(ResultatRecherche));
+    if (*resultats == NULL) {
+        free(candidats);
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return -1;
+    }
+    int nb = 0;
+    for (int i = 0; i < nb_candidats; i++) {
+        int emplacement;
+        if (index_id_chercher(&index_texte.emplacements, candidats[i].id, &emplacement) &&
+            index_texte.annonces[emplacement] != NULL) {
+            (*resultats)[nb].annonce = index_texte.annonces[emplacement];
+            (*resultats)[nb++].score = candidats[i].score;
+        }
+    }
+    free(candidats);
+
+    qsort(*resultats, nb, sizeof(ResultatRecherche), comparer_resultats);
+    return nb;
+}
+
+/**
+ * Ask for a query and display the matching announcements
+ */
+void rechercher_et_afficher_annonces(NodeAnnonce* tete) {
+    char requete[256];
+    printf("\n=== Rechercher des annonces ===\n");
+    get_input("Mots recherchés: ", requete, sizeof(requete));
+    int choix = get_int_input("1. Tous les mots, 2. Au moins un des mots: ", 1, 2);
+
+    ResultatRecherche *resultats;
+    int nb = rechercher_annonces(tete, requete, (choix == 1) ? RECHERCHE_ET : RECHERCHE_OU, &resultats);
+    if (nb < 0) {
+        return;
+    }
+    if (nb == 0) {
+        printf("Aucune annonce ne correspond à votre recherche.\n");
+        free(resultats);
+        return;
+    }
+
+    printf("\n%d résultat(s):\n", nb);
+    printf("%-4s | %-6s | %-30s | %-16s\n", "ID", "Score", "Titre", "Date");
+    printf("---------------------------------------------------------------------\n");
+    NodeAnnonce **annonces = (NodeAnnonce**)malloc(nb * sizeof(NodeAnnonce*));
+    for (int i = 0; i < nb; i++) {
+        printf("%-4d | %6.2f | %-30.30s | %-16s\n", resultats[i].annonce->annonce.id, resultats[i].score,
+               annonce_titre(resultats[i].annonce),
+               date_annonce_to_string(resultats[i].annonce->annonce.date_creation));
+        if (annonces != NULL) {
+            annonces[i] = resultats[i].annonce;
+        }
+    }
+    printf("\n");
+
+    if (annonces != NULL) {
+        afficher_selection_annonces(annonces, nb);
+        free(annonces);
+    }
+    free(resultats);
+}
@@ -0,0 +1,513 @@
+/**
+ * @file reparation_edt.c
+ * @brief Implementation of the incremental timetable repair
+ */
+
+#include <time.h>
+#include "../include/reparation_edt.h"
+#include "../include/disponibilites.h"
+#include "../include/utils.h"
+
+// Soft costs of a new slot, same scale as the generator penalties
+#define COUT_DERNIER_CRENEAU 1 // Last slot of the day
+#define COUT_MEME_JOUR 5       // Same subject twice the same day for a section
+#define COUT_AUTRE_JOUR 1      // Session leaves its original day
+#define COUT_AUTRE_SALLE 1     // Session leaves its original room
+
+/**
+ * One session seen by the repair
+ */
+typedef struct {
+    int ressources[NB_TYPES_RESSOURCES]; // Teacher, room and section handles
+    int id_matiere;
+    int creneau;  // Current slot, -1 while being moved
+    int origine;  // Slot before the repair
+    int ref;      // ID or cell of the session in its timetable
+} SeanceReparation;
+
+/**
+ * One move decided by the repair, to replay in order on the timetable
+ */
+typedef struct {
+    int seance;
+    int creneau;
+    int salle;
+} Deplacement;
+
+/**
+ * State of a repair
+ */
+typedef struct {
+    Disponibilites *dispo;    // Every session reserved, plus fixed outside occupations
+    SeanceReparation *seances;
+    int nb_seances;
+    const int *salles;        // Room handles sessions may move to
+    int nb_salles;
+    IndexId occupant_section; // (section, slot) -> session
+    int enseignant;           // Teacher who became unavailable
+    MasqueCreneaux indisponibles;
+    Deplacement *deplacements;
+    int nb_deplacements;
+} Reparation;
+
+// Milliseconds elapsed since a start time
+static double duree_depuis(const struct timespec *debut) {
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) * 1000.0 + (fin.tv_nsec - debut->tv_nsec) / 1000000.0;
+}
+
+// Slots where every room is taken
+static MasqueCreneaux salles_pleines(const Reparation *rep) {
+    MasqueCreneaux pleines = rep->dispo->semaine;
+    for (int k = 0; k < rep->nb_salles; k++) {
+        pleines &= occupation_ressource(rep->dispo, RESSOURCE_SALLE, rep->salles[k]);
+    }
+    return pleines;
+}
+
+// Room free at a slot, the preferred one if possible, -1 if none
+static int salle_libre(const Reparation *rep, int creneau, int preferee) {
+    if (preferee >= 0 && !(occupation_ressource(rep->dispo, RESSOURCE_SALLE, preferee) >> creneau & 1ULL)) {
+        return preferee;
+    }
+    for (int k = 0; k < rep->nb_salles; k++) {
+        if (!(occupation_ressource(rep->dispo, RESSOURCE_SALLE, rep->salles[k]) >> creneau & 1ULL)) {
+            return rep->salles[k];
+        }
+    }
+    return -1;
+}
+
+// Slots where a session could go: teacher and section free, and one room left
+static MasqueCreneaux candidats_seance(const Reparation *rep, int s) {
+    int handles[NB_TYPES_RESSOURCES];
+    memcpy(handles, rep->seances[s].ressources, sizeof(handles));
+    handles[RESSOURCE_SALLE] = -1;
+    return creneaux_libres_communs(rep->dispo, handles) & ~salles_pleines(rep);
+}
+
+// Cheapest candidate slot of a session
+static int meilleur_creneau(const Reparation *rep, int s, MasqueCreneaux candidats) {
+    const SeanceReparation *seance = &rep->seances[s];
+    int nb_creneaux_jour = rep->dispo->nb_creneaux_jour;
+
+    // Days where the section already has this subject
+    unsigned int jours_matiere = 0;
+    for (int i = 0; i < rep->nb_seances; i++) {
+        const SeanceReparation *autre = &rep->seances[i];
+        if (i != s && autre->creneau >= 0 && autre->id_matiere == seance->id_matiere &&
+            autre->ressources[RESSOURCE_SECTION] == seance->ressources[RESSOURCE_SECTION]) {
+            jours_matiere |= 1u << (autre->creneau / nb_creneaux_jour);
+        }
+    }
+
+    int meilleur = -1;
+    int meilleur_cout = 0;
+    while (candidats) {
+        int c = __builtin_ctzll(candidats);
+        candidats &= candidats - 1;
+
+        int jour = c / nb_creneaux_jour;
+        int cout = 0;
+        if (c % nb_creneaux_jour == nb_creneaux_jour - 1 && nb_creneaux_jour > 1) cout += COUT_DERNIER_CRENEAU;
+        if (jours_matiere >> jour & 1u) cout += COUT_MEME_JOUR;
+        if (jour != seance->origine / nb_creneaux_jour) cout += COUT_AUTRE_JOUR;
+        if (salle_libre(rep, c, seance->ressources[RESSOURCE_SALLE]) != seance->ressources[RESSOURCE_SALLE]) {
+            cout += COUT_AUTRE_SALLE;
+        }
+
+        if (meilleur < 0 || cout < meilleur_cout) {
+            meilleur = c;
+            meilleur_cout = cout;
+        }
+    }
+    return meilleur;
+}
+
+// Take a session off its slot
+static void retirer(Reparation *rep, int s) {
+    SeanceReparation *seance = &rep->seances[s];
+    annuler_creneau(rep->dispo, seance->ressources, seance->creneau);
+    if (seance->ressources[RESSOURCE_ENSEIGNANT] == rep->enseignant) {
+        bloquer_creneaux(rep->dispo, RESSOURCE_ENSEIGNANT, rep->enseignant, rep->indisponibles); // Keep forbidden slots
+    }
+    index_id_supprimer(&rep->occupant_section,
+                       index_cle_composee(seance->ressources[RESSOURCE_SECTION], seance->creneau));
+    seance->creneau = -1;
+}
+
+// Put a session on a slot and room, recording the move if it is one
+static int poser(Reparation *rep, int s, int creneau, int salle, int deplacement) {
+    SeanceReparation *seance = &rep->seances[s];
+    seance->creneau = creneau;
+    seance->ressources[RESSOURCE_SALLE] = salle;
+    reserver_creneau(rep->dispo, seance->ressources, creneau);
+
+    if (deplacement) {
+        Deplacement *d = &rep->deplacements[rep->nb_deplacements++];
+        d->seance = s;
+        d->creneau = creneau;
+        d->salle = salle;
+    }
+    return index_id_inserer(&rep->occupant_section,
+                            index_cle_composee(seance->ressources[RESSOURCE_SECTION], creneau), s);
+}
+
+// Free a slot for a session by shifting the section's session already there
+static int ejecter(Reparation *rep, int s) {
+    const SeanceReparation *seance = &rep->seances[s];
+    MasqueCreneaux essais = rep->dispo->semaine &
+        ~occupation_ressource(rep->dispo, RESSOURCE_ENSEIGNANT, seance->ressources[RESSOURCE_ENSEIGNANT]) &
+        occupation_ressource(rep->dispo, RESSOURCE_SECTION, seance->ressources[RESSOURCE_SECTION]);
+
+    while (essais) {
+        int c = __builtin_ctzll(essais);
+        essais &= essais - 1;
+
+        int b;
+        if (!index_id_chercher(&rep->occupant_section,
+                               index_cle_composee(seance->ressources[RESSOURCE_SECTION], c), &b)) {
+            continue; // Section taken outside of the repaired timetable
+        }
+
+        int salle_b = rep->seances[b].ressources[RESSOURCE_SALLE];
+        retirer(rep, b);
+
+        MasqueCreneaux candidats_b = candidats_seance(rep, b) & ~(1ULL << c);
+        if (candidats_b && salle_libre(rep, c, seance->ressources[RESSOURCE_SALLE]) >= 0) {
+            int c_b = meilleur_creneau(rep, b, candidats_b);
+            int ok = poser(rep, b, c_b, salle_libre(rep, c_b, salle_b), 1);
+            retirer(rep, s);
+            return ok && poser(rep, s, c, salle_libre(rep, c, seance->ressources[RESSOURCE_SALLE]), 1);
+        }
+
+        poser(rep, b, c, salle_b, 0);
+    }
+    return 0;
+}
+
+// Move every session of a teacher out of the forbidden slots, the rest staying fixed
+static int reparer_seances(Reparation *rep, int enseignant, MasqueCreneaux indisponibles,
+                           ResultatReparation *resultat) {
+    int n = rep->nb_seances;
+    unsigned char *a_placer = (unsigned char*)calloc(n + 1, 1);
+    rep->deplacements = (Deplacement*)malloc((2 * n + 1) * sizeof(Deplacement));
+    if (a_placer == NULL || rep->deplacements == NULL || !index_id_initialiser(&rep->occupant_section, n)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        free(a_placer);
+        return 0;
+    }
+
+    int ok = 1;
+    for (int s = 0; ok && s < n; s++) {
+        SeanceReparation *seance = &rep->seances[s];
+        seance->origine = seance->creneau;
+        ok = index_id_inserer(&rep->occupant_section,
+                              index_cle_composee(seance->ressources[RESSOURCE_SECTION], seance->creneau), s);
+    }
+
+    // Sessions to move keep their slot until they get a new one, so nothing else takes it
+    for (int s = 0; ok && s < n; s++) {
+        SeanceReparation *seance = &rep->seances[s];
+        if (seance->ressources[RESSOURCE_ENSEIGNANT] == enseignant && (indisponibles >> seance->creneau & 1ULL)) {
+            a_placer[s] = 1;
+            resultat->nb_concernees++;
+        }
+    }
+    rep->enseignant = enseignant;
+    rep->indisponibles = indisponibles;
+    bloquer_creneaux(rep->dispo, RESSOURCE_ENSEIGNANT, enseignant, indisponibles);
+
+    for (int restantes = resultat->nb_concernees; ok && restantes > 0; restantes--) {
+        // Most constrained session first
+        int choisie = -1;
+        int min_candidats = MAX_CRENEAUX_SEMAINE + 1;
+        for (int s = 0; s < n; s++) {
+            if (a_placer[s]) {
+                int nb = __builtin_popcountll(candidats_seance(rep, s));
+                if (nb < min_candidats) {
+                    min_candidats = nb;
+                    choisie = s;
+                }
+            }
+        }
+        a_placer[choisie] = 0;
+
+        SeanceReparation *seance = &rep->seances[choisie];
+        MasqueCreneaux candidats = candidats_seance(rep, choisie);
+        if (candidats) {
+            int c = meilleur_creneau(rep, choisie, candidats);
+            retirer(rep, choisie);
+            ok = poser(rep, choisie, c, salle_libre(rep, c, seance->ressources[RESSOURCE_SALLE]), 1);
+            resultat->nb_deplacees++;
+        } else if (ejecter(rep, choisie)) {
+            resultat->nb_deplacees++;
+            resultat->nb_ejections++;
+        } else {
+            resultat->nb_echecs++; // Nowhere to go: the session stays where it was
+        }
+    }
+
+    free(a_placer);
+    index_id_liberer(&rep->occupant_section);
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+    return ok;
+}
+
+/**
+ * Move the sessions of a teacher out of slots where they became unavailable
+ */
+int reparer_planning(Planning *planning, int id_enseignant, MasqueCreneaux indisponibles,
+                     ResultatReparation *resultat) {
+    memset(resultat, 0, sizeof(ResultatReparation));
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    Disponibilites dispo;
+    if (!initialiser_disponibilites(&dispo, planning->nb_jours, planning->nb_creneaux_jour)) {
+        return 0;
+    }
+
+    int n = planning->nb_seances;
+    Reparation rep;
+    memset(&rep, 0, sizeof(Reparation));
+    rep.dispo = &dispo;
+    rep.seances = (SeanceReparation*)malloc((n + 1) * sizeof(SeanceReparation));
+    int *salles = (int*)malloc((planning->salles.nb + 1) * sizeof(int));
+    const char **noms_salles = (const char**)malloc((planning->salles.nb + 1) * sizeof(char*));
+
+    int ok = rep.seances != NULL && salles != NULL && noms_salles != NULL &&
+             disponibilites_planning(&dispo, planning);
+
+    // Every room of the planning is registered, handles follow the registry order
+    for (int k = 0; ok && k < planning->salles.nb; k++) {
+        salles[k] = ressource_disponibilites(&dispo, RESSOURCE_SALLE, index_cle_chaine(planning->salles.noms[k]));
+        ok = salles[k] >= 0 && salles[k] < planning->salles.nb;
+        if (ok) {
+            noms_salles[salles[k]] = planning->salles.noms[k];
+        }
+    }
+    rep.salles = salles;
+    rep.nb_salles = planning->salles.nb;
+
+    for (int i = 0; ok && i < n; i++) {
+        const Seance *seance = &planning->seances[i];
+        SeanceReparation *s = &rep.seances[i];
+        s->ressources[RESSOURCE_ENSEIGNANT] = chercher_ressource_disponibilites(&dispo, RESSOURCE_ENSEIGNANT,
+                                                                               seance->id_enseignant);
+        s->ressources[RESSOURCE_SALLE] = chercher_ressource_disponibilites(&dispo, RESSOURCE_SALLE,
+                                                                          index_cle_chaine(seance->salle));
+        s->ressources[RESSOURCE_SECTION] = chercher_ressource_disponibilites(&dispo, RESSOURCE_SECTION,
+                                                                            index_cle_chaine(seance->section));
+        s->id_matiere = seance->id_matiere;
+        s->creneau = seance->jour * planning->nb_creneaux_jour + seance->heure;
+        s->ref = seance->id;
+    }
+    rep.nb_seances = n;
+
+    int enseignant = chercher_ressource_disponibilites(&dispo, RESSOURCE_ENSEIGNANT, id_enseignant);
+    if (ok && enseignant >= 0) {
+        ok = reparer_seances(&rep, enseignant, indisponibles, resultat);
+
+        // Replay the moves in the order they were decided, so each target is free
+        for (int k = 0; ok && k < rep.nb_deplacements; k++) {
+            const Deplacement *d = &rep.deplacements[k];
+            ok = deplacer_seance(planning, rep.seances[d->seance].ref, noms_salles[d->salle],
+                                 d->creneau / planning->nb_creneaux_jour, d->creneau % planning->nb_creneaux_jour);
+        }
+    } else if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+    }
+
+    free(rep.seances);
+    free(rep.deplacements);
+    free(salles);
+    free(noms_salles);
+    liberer_disponibilites(&dispo);
+
+    resultat->duree_ms = duree_depuis(&debut);
+    return ok && resultat->nb_echecs == 0;
+}
+
+/**
+ * Move the slots of a teacher out of the grid where they became unavailable
+ */
+int reparer_emploi_du_temps(EmploiDuTemps *edt, const Planning *planning, int id_enseignant,
+                            MasqueCreneaux indisponibles, ResultatReparation *resultat) {
+    memset(resultat, 0, sizeof(ResultatReparation));
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+
+    Disponibilites dispo;
+    if (!initialiser_disponibilites(&dispo, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR)) {
+        return 0;
+    }
+
+    SeanceReparation seances[JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR];
+    int salles[JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR];
+    char noms_salles[JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR][MAX_SALLE_LEN];
+    int cellule[JOURS_PAR_SEMAINE * CRENEAUX_PAR_JOUR]; // Current cell of each session
+
+    int ok = disponibilites_emploi_du_temps(&dispo, edt, -1, -1);
+    if (ok && planning != NULL) {
+        disponibilites_planning(&dispo, planning); // Skipped if the slots differ
+    }
+
+    Reparation rep;
+    memset(&rep, 0, sizeof(Reparation));
+    rep.dispo = &dispo;
+    rep.seances = seances;
+    rep.salles = salles;
+
+    int section = chercher_ressource_disponibilites(&dispo, RESSOURCE_SECTION, index_cle_chaine(SECTION_GRILLE));
+    for (int j = 0; ok && j < JOURS_PAR_SEMAINE; j++) {
+        for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
+            const Creneau *creneau = &edt->creneaux[j][h];
+            if (creneau->id == 0) {
+                continue;
+            }
+
+            SeanceReparation *s = &seances[rep.nb_seances];
+            s->ressources[RESSOURCE_ENSEIGNANT] = chercher_ressource_disponibilites(&dispo, RESSOURCE_ENSEIGNANT,
+                                                                                   creneau->id_enseignant);
+            s->ressources[RESSOURCE_SALLE] = chercher_ressource_disponibilites(&dispo, RESSOURCE_SALLE,
+                                                                              index_cle_chaine(creneau->salle));
+            s->ressources[RESSOURCE_SECTION] = section;
+            s->id_matiere = creneau->id_matiere;
+            s->creneau = j * CRENEAUX_PAR_JOUR + h;
+            s->ref = creneau->id;
+            cellule[rep.nb_seances++] = s->creneau;
+
+            // Rooms of the grid are the ones sessions may move to
+            int salle = s->ressources[RESSOURCE_SALLE];
+            int connue = 0;
+            for (int k = 0; k < rep.nb_salles; k++) {
+                connue |= (salles[k] == salle);
+            }
+            if (salle >= 0 && !connue) {
+                strcpy(noms_salles[rep.nb_salles], creneau->salle);
+                salles[rep.nb_salles++] = salle;
+            }
+        }
+    }
+
+    int enseignant = chercher_ressource_disponibilites(&dispo, RESSOURCE_ENSEIGNANT, id_enseignant);
+    if (ok && enseignant >= 0) {
+        ok = reparer_seances(&rep, enseignant, indisponibles, resultat);
+
+        for (int k = 0; ok && k < rep.nb_deplacements; k++) {
+            const Deplacement *d = &rep.deplacements[k];
+            Creneau *source = &edt->creneaux[cellule[d->seance] / CRENEAUX_PAR_JOUR][cellule[d->seance] % CRENEAUX_PAR_JOUR];
+            Creneau *cible = &edt->creneaux[d->creneau / CRENEAUX_PAR_JOUR][d->creneau % CRENEAUX_PAR_JOUR];
+
+            Creneau deplace = *source;
+            memset(source, 0, sizeof(Creneau));
+            for (int k2 = 0; k2 < rep.nb_salles; k2++) {
+                if (salles[k2] == d->salle) {
+                    strcpy(deplace.salle, noms_salles[k2]);
+                }
+            }
+            deplace.jour = d->creneau / CRENEAUX_PAR_JOUR;
+            deplace.heure = d->creneau % CRENEAUX_PAR_JOUR;
+            *cible = deplace;
+            cellule[d->seance] = d->creneau;
+        }
+    }
+
+    free(rep.deplacements);
+    liberer_disponibilites(&dispo);
+
+    resultat->duree_ms = duree_depuis(&debut);
+    return ok && resultat->nb_echecs == 0;
+}
+
+// Forbidden slots of a week shape, a slot of -1 meaning the whole day
+static MasqueCreneaux masque_indisponibilites(const int *jours, const int *heures, int nb,
+                                              int nb_jours, int nb_creneaux_jour) {
+    MasqueCreneaux masque = 0;
+    for (int i = 0; i < nb; i++) {
+        if (jours[i] >= nb_jours) {
+            continue;
+        }
+        for (int h = 0; h < nb_creneaux_jour; h++) {
+            if (heures[i] < 0 || heures[i] == h) {
+                masque |= 1ULL << (jours[i] * nb_creneaux_jour + h);
+            }
+        }
+    }
+    return masque;
+}
+
+// Print the outcome of a repair
+static void afficher_resultat_reparation(const char *titre, const ResultatReparation *resultat) {
+    printf("%s: %d séance(s) concernée(s), %d déplacée(s), %d autre(s) décalée(s), %d sans solution (%.2f ms).\n",
+           titre, resultat->nb_concernees, resultat->nb_deplacees, resultat->nb_ejections,
+           resultat->nb_echecs, resultat->duree_ms);
+}
+
+/**
+ * Ask for the unavailability of a teacher and repair the grid and the planning
+ */
+void reparer_apres_indisponibilite(EmploiDuTemps *edt, Planning *planning, NodeEnseignant* enseignants) {
+    if (edt->nb_creneaux == 0 && planning->nb_seances == 0) {
+        printf("L'emploi du temps et le planning sont vides.\n");
+        return;
+    }
+
+    printf("\n=== Réparer après l'indisponibilité d'un enseignant ===\n");
+
+    afficher_enseignants(enseignants);
+    int id_enseignant = get_int_input("ID de l'enseignant: ", 1, 999);
+    if (trouver_enseignant_par_id(enseignants, id_enseignant) == NULL) {
+        printf("Enseignant avec ID %d non trouvé.\n", id_enseignant);
+        return;
+    }
+
+    int jours[MAX_CRENEAUX_SEMAINE];
+    int heures[MAX_CRENEAUX_SEMAINE];
+    int nb = 0;
+    while (nb < MAX_CRENEAUX_SEMAINE) {
+        int jour = get_int_input("Jour indisponible (0: Lundi ... 6: Dimanche, -1 pour terminer): ",
+                                 -1, MAX_JOURS_PLANNING - 1);
+        if (jour < 0) {
+            break;
+        }
+        jours[nb] = jour;
+        heures[nb] = get_int_input("Créneau de la journée (0 pour le premier, -1 pour toute la journée): ",
+                                   -1, MAX_CRENEAUX_JOUR_PLANNING - 1);
+        nb++;
+    }
+
+    if (nb == 0) {
+        printf("Aucune indisponibilité indiquée.\n");
+        return;
+    }
+
+    // The planning first: the grid must then avoid its teachers and rooms
+    ResultatReparation resultat;
+    if (planning->nb_seances > 0 && planning->nb_jours * planning->nb_creneaux_jour > MAX_CRENEAUX_SEMAINE) {
+        // A loaded planning may have a larger week than the slot masks can hold
+        printf("Erreur: Le planning compte plus de %d créneaux par semaine et ne peut pas être réparé.\n",
+               MAX_CRENEAUX_SEMAINE);
+    } else if (planning->nb_seances > 0) {
+        MasqueCreneaux masque = masque_indisponibilites(jours, heures, nb, planning->nb_jours,
+                                                        planning->nb_creneaux_jour);
+        reparer_planning(planning, id_enseignant, masque, &resultat);
+        afficher_resultat_reparation("Planning", &resultat);
+        if (resultat.nb_deplacees > 0 && !sauvegarder_planning(planning)) {
+            printf("Erreur lors de la sauvegarde du planning.\n");
+        }
+    }
+
+    if (edt->nb_creneaux > 0) {
+        MasqueCreneaux masque = masque_indisponibilites(jours, heures, nb, JOURS_PAR_SEMAINE, CRENEAUX_PAR_JOUR);
+        reparer_emploi_du_temps(edt, planning, id_enseignant, masque, &resultat);
+        afficher_resultat_reparation("Emploi du temps", &resultat);
+        if (resultat.nb_deplacees > 0 && !sauvegarder_emploi_du_temps(edt)) {
+            printf("Erreur lors de la sauvegarde de l'emploi du temps.\n");
+        }
+    }
+}
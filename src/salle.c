@@ -0,0 +1,292 @@
+/**
+ * @file salle.c
+ * @brief Implementation of the room catalogue
+ */
+
+#include "../include/salle.h"
+#include "../include/utils.h"
+
+#define SALLES_FILE "data/salles.txt"
+
+#define CAPACITE_SALLE_MAX 1000
+
+// Helper function to convert a room type to string
+const char* type_salle_to_string(TypeSalle type) {
+    return type == SALLE_TP ? "TP" : "Cours";
+}
+
+/**
+ * Load rooms from file into a linked list
+ */
+int charger_salles(NodeSalle** tete) {
+    FILE *file;
+    *tete = NULL;
+    
+    create_data_dir();
+    
+    if (!file_exists(SALLES_FILE)) {
+        // Create empty file if it doesn't exist
+        create_file_if_not_exists(SALLES_FILE);
+        return 1;
+    }
+    
+    file = fopen(SALLES_FILE, "r");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier des salles.\n");
+        return 0;
+    }
+    
+    char line[256];
+    NodeSalle *dernier = NULL;
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\n")] = '\0'; // Remove newline
+        
+        // Parse the line (nom|capacite|type)
+        Salle salle;
+        char type[10];
+        if (sscanf(line, "%9[^|]|%d|%9s", salle.nom, &salle.capacite, type) != 3) {
+            continue;
+        }
+        salle.type = strcmp(type, "TP") == 0 ? SALLE_TP : SALLE_COURS;
+        
+        NodeSalle *nouveau_node = (NodeSalle*)malloc(sizeof(NodeSalle));
+        if (nouveau_node == NULL) {
+            printf("Erreur: Échec d'allocation de mémoire.\n");
+            fclose(file);
+            return 0;
+        }
+        nouveau_node->salle = salle;
+        nouveau_node->suivant = NULL;
+        
+        // Keep the order of the file
+        if (dernier == NULL) {
+            *tete = nouveau_node;
+        } else {
+            dernier->suivant = nouveau_node;
+        }
+        dernier = nouveau_node;
+    }
+    
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Save rooms from linked list to file
+ */
+int sauvegarder_salles(NodeSalle* tete) {
+    FILE *file = fopen(SALLES_FILE, "w");
+    if (file == NULL) {
+        printf("Erreur: Impossible d'ouvrir le fichier des salles en écriture.\n");
+        return 0;
+    }
+    
+    NodeSalle* courant = tete;
+    while (courant != NULL) {
+        fprintf(file, "%s|%d|%s\n",
+                courant->salle.nom,
+                courant->salle.capacite,
+                type_salle_to_string(courant->salle.type));
+        
+        courant = courant->suivant;
+    }
+    
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Add a new room to the linked list
+ */
+void ajouter_salle(NodeSalle** tete) {
+    printf("\n=== Ajouter une nouvelle salle ===\n");
+    
+    Salle salle;
+    get_input("Nom de la salle: ", salle.nom, sizeof(salle.nom));
+    if (salle.nom[0] == '\0' || strchr(salle.nom, '|') != NULL || strchr(salle.nom, ',') != NULL) {
+        printf("Erreur: Nom de salle invalide.\n");
+        return;
+    }
+    if (trouver_salle(*tete, salle.nom) != NULL) {
+        printf("Erreur: La salle %s existe déjà.\n", salle.nom);
+        return;
+    }
+    
+    salle.capacite = get_int_input("Capacité (nombre de places): ", 1, CAPACITE_SALLE_MAX);
+    salle.type = get_int_input("Type (0: Cours, 1: TP): ", 0, 1) == 1 ? SALLE_TP : SALLE_COURS;
+    
+    NodeSalle *nouveau_node = (NodeSalle*)malloc(sizeof(NodeSalle));
+    if (nouveau_node == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return;
+    }
+    nouveau_node->salle = salle;
+    
+    // Add to the end of the list
+    nouveau_node->suivant = NULL;
+    NodeSalle **fin = tete;
+    while (*fin != NULL) {
+        fin = &(*fin)->suivant;
+    }
+    *fin = nouveau_node;
+    
+    // Save to file
+    if (sauvegarder_salles(*tete)) {
+        printf("Salle ajoutée avec succès.\n");
+    } else {
+        printf("Erreur lors de la sauvegarde des salles.\n");
+    }
+}
+
+/**
+ * Modify the capacity or type of an existing room
+ */
+void modifier_salle(NodeSalle* tete) {
+    if (tete == NULL) {
+        printf("Aucune salle n'est enregistrée.\n");
+        return;
+    }
+    
+    afficher_salles(tete);
+    
+    char nom[MAX_SALLE_LEN];
+    get_input("Nom de la salle à modifier: ", nom, sizeof(nom));
+    
+    NodeSalle* salle = trouver_salle(tete, nom);
+    if (salle == NULL) {
+        printf("Salle %s non trouvée.\n", nom);
+        return;
+    }
+    
+    printf("\n=== Modifier la salle %s ===\n", salle->salle.nom);
+    
+    char prompt[100];
+    snprintf(prompt, sizeof(prompt), "Capacité [actuelle: %d, 0 pour garder]: ", salle->salle.capacite);
+    int capacite = get_int_input(prompt, 0, CAPACITE_SALLE_MAX);
+    if (capacite > 0) {
+        salle->salle.capacite = capacite;
+    }
+    
+    snprintf(prompt, sizeof(prompt), "Type (0: Cours, 1: TP, 2: garder %s): ",
+             type_salle_to_string(salle->salle.type));
+    int type = get_int_input(prompt, 0, 2);
+    if (type != 2) {
+        salle->salle.type = type == 1 ? SALLE_TP : SALLE_COURS;
+    }
+    
+    // Save changes
+    if (sauvegarder_salles(tete)) {
+        printf("Salle modifiée avec succès.\n");
+    } else {
+        printf("Erreur lors de la sauvegarde des modifications.\n");
+    }
+}
+
+/**
+ * Delete a room from the linked list
+ */
+void supprimer_salle(NodeSalle** tete) {
+    if (*tete == NULL) {
+        printf("Aucune salle n'est enregistrée.\n");
+        return;
+    }
+    
+    afficher_salles(*tete);
+    
+    char nom[MAX_SALLE_LEN];
+    get_input("Nom de la salle à supprimer: ", nom, sizeof(nom));
+    
+    // Find and remove the room
+    NodeSalle *courant = *tete;
+    NodeSalle *precedent = NULL;
+    
+    while (courant != NULL && strcmp(courant->salle.nom, nom) != 0) {
+        precedent = courant;
+        courant = courant->suivant;
+    }
+    
+    if (courant == NULL) {
+        printf("Salle %s non trouvée.\n", nom);
+        return;
+    }
+    
+    // Confirmation
+    printf("Êtes-vous sûr de vouloir supprimer la salle %s?\n", courant->salle.nom);
+    int confirmation = get_int_input("1. Oui, 2. Non: ", 1, 2);
+    
+    if (confirmation == 1) {
+        if (precedent == NULL) {
+            *tete = courant->suivant;
+        } else {
+            precedent->suivant = courant->suivant;
+        }
+        
+        free(courant);
+        
+        // Save changes
+        if (sauvegarder_salles(*tete)) {
+            printf("Salle supprimée avec succès.\n");
+        } else {
+            printf("Erreur lors de la sauvegarde des modifications.\n");
+        }
+    } else {
+        printf("Opération annulée.\n");
+    }
+}
+
+/**
+ * Display all rooms in the linked list
+ */
+void afficher_salles(NodeSalle* tete) {
+    if (tete == NULL) {
+        printf("Aucune salle n'est enregistrée.\n");
+        return;
+    }
+    
+    printf("\n=== Liste des Salles ===\n");
+    printf("%-10s | %-8s | %-6s\n", "Salle", "Capacité", "Type");
+    printf("--------------------------------\n");
+    
+    NodeSalle* courant = tete;
+    while (courant != NULL) {
+        printf("%-10s | %-8d | %-6s\n",
+               courant->salle.nom,
+               courant->salle.capacite,
+               type_salle_to_string(courant->salle.type));
+        
+        courant = courant->suivant;
+    }
+    
+    printf("================================\n\n");
+}
+
+/**
+ * Find a room by name
+ */
+NodeSalle* trouver_salle(NodeSalle* tete, const char *nom) {
+    NodeSalle* courant = tete;
+    
+    while (courant != NULL) {
+        if (strcmp(courant->salle.nom, nom) == 0) {
+            return courant;
+        }
+        courant = courant->suivant;
+    }
+    
+    return NULL; // Not found
+}
+
+/**
+ * Free memory allocated for room linked list
+ */
+void liberer_salles(NodeSalle** tete) {
+    NodeSalle* courant = *tete;
+    
+    while (courant != NULL) {
+        NodeSalle* suivant = courant->suivant;
+        free(courant);
+        courant = suivant;
+    }
+    
+    *tete = NULL;
+}
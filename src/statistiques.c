@@ -0,0 +1,495 @@
+/**
+ * @file statistiques.c
+ * @brief Implementation of grade distribution statistics
+ */
+
+#include <math.h>
+#include "../include/statistiques.h"
+#include "../include/index.h"
+#include "../include/colonnes_notes.h"
+
+/**
+ * Aggregates per subject (all sections) and per (subject, section),
+ * kept in sync with the grades through the modification counters
+ */
+typedef struct {
+    int valide;
+    NodeEtudiant* etudiants;
+    unsigned long generation_notes;
+    unsigned long generation_etudiants;
+    StatistiquesNotes *groupes;
+    int nb_groupes;
+    int capacite_groupes;
+    IndexId index_groupes;   // (id_matiere, section + 1) -> group, section 0 meaning all sections
+    char (*sections)[MAX_SECTION_LEN];
+    int nb_sections;
+    IndexId index_etudiants; // id_etudiant -> section position
+} TableStatistiques;
+
+static TableStatistiques table = {0};
+
+// Bucket of a grade in the histogram
+static int tranche_note(float note) {
+    int tranche = (int)note;
+    if (tranche < 0) {
+        tranche = 0;
+    }
+    if (tranche >= NB_TRANCHES_NOTES) {
+        tranche = NB_TRANCHES_NOTES - 1;
+    }
+    return tranche;
+}
+
+/**
+ * Initialize an empty aggregate
+ */
+void stats_initialiser(StatistiquesNotes *stats) {
+    memset(stats, 0, sizeof(StatistiquesNotes));
+}
+
+/**
+ * Add a grade to an aggregate
+ */
+void stats_ajouter(StatistiquesNotes *stats, float note) {
+    if (stats->nb == 0 || note < stats->min) {
+        stats->min = note;
+    }
+    if (stats->nb == 0 || note > stats->max) {
+        stats->max = note;
+    }
+
+    // Welford update
+    stats->nb++;
+    double delta = note - stats->moyenne;
+    stats->moyenne += delta / stats->nb;
+    stats->m2 += delta * (note - stats->moyenne);
+
+    if (note >= 10.0f) {
+        stats->nb_reussites++;
+    }
+    stats->histogramme[tranche_note(note)]++;
+}
+
+/**
+ * Remove a grade previously added to an aggregate
+ */
+void stats_retirer(StatistiquesNotes *stats, float note) {
+    if (stats->nb <= 1) {
+        stats_initialiser(stats);
+        return;
+    }
+
+    // Reverse Welford update
+    double moyenne_precedente = (stats->nb * stats->moyenne - note) / (stats->nb - 1);
+    stats->m2 -= (note - moyenne_precedente) * (note - stats->moyenne);
+    if (stats->m2 < 0.0) {
+        stats->m2 = 0.0;
+    }
+    stats->moyenne = moyenne_precedente;
+    stats->nb--;
+
+    if (note >= 10.0f) {
+        stats->nb_reussites--;
+    }
+    stats->histogramme[tranche_note(note)]--;
+
+    // The next extreme is not known from the aggregate alone
+    if (note <= stats->min || note >= stats->max) {
+        stats->extremes_perimes = 1;
+    }
+}
+
+/**
+ * Merge an aggregate into another
+ */
+void stats_fusionner(StatistiquesNotes *dest, const StatistiquesNotes *src) {
+    if (src->nb == 0) {
+        return;
+    }
+    if (dest->nb == 0) {
+        *dest = *src;
+        return;
+    }
+
+    int nb = dest->nb + src->nb;
+    double delta = src->moyenne - dest->moyenne;
+    dest->moyenne += delta * src->nb / nb;
+    dest->m2 += src->m2 + delta * delta * ((double)dest->nb * src->nb / nb);
+    dest->nb = nb;
+
+    if (src->min < dest->min) {
+        dest->min = src->min;
+    }
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+    dest->extremes_perimes |= src->extremes_perimes;
+    dest->nb_reussites += src->nb_reussites;
+    for (int t = 0; t < NB_TRANCHES_NOTES; t++) {
+        dest->histogramme[t] += src->histogramme[t];
+    }
+}
+
+/**
+ * Get the standard deviation of an aggregate
+ */
+double stats_ecart_type(const StatistiquesNotes *stats) {
+    if (stats->nb == 0) {
+        return 0.0;
+    }
+    return sqrt(stats->m2 / stats->nb);
+}
+
+/**
+ * Estimate a quantile by interpolation inside the histogram buckets
+ */
+float stats_quantile(const StatistiquesNotes *stats, double q) {
+    if (stats->nb == 0) {
+        return 0.0f;
+    }
+
+    double rang = q * stats->nb;
+    int cumul = 0;
+    float valeur = stats->max;
+
+    for (int t = 0; t < NB_TRANCHES_NOTES; t++) {
+        int effectif = stats->histogramme[t];
+        if (effectif > 0 && cumul + effectif >= rang) {
+            double largeur = (t == NB_TRANCHES_NOTES - 1) ? 0.0 : 1.0;
+            valeur = (float)(t + largeur * (rang - cumul) / effectif);
+            break;
+        }
+        cumul += effectif;
+    }
+
+    // Interpolation cannot go beyond the observed extremes
+    if (valeur < stats->min) {
+        valeur = stats->min;
+    }
+    if (valeur > stats->max) {
+        valeur = stats->max;
+    }
+    return valeur;
+}
+
+// Release the arrays of the table
+static void vider_table(void) {
+    free(table.groupes);
+    free(table.sections);
+    table.groupes = NULL;
+    table.sections = NULL;
+    table.nb_groupes = 0;
+    table.capacite_groupes = 0;
+    table.nb_sections = 0;
+    index_id_liberer(&table.index_groupes);
+    index_id_liberer(&table.index_etudiants);
+    table.valide = 0;
+}
+
+// Find or create the aggregate of a (subject, section) pair
+static StatistiquesNotes* groupe(int id_matiere, int section, int creer) {
+    long long cle = index_cle_composee(id_matiere, section + 1);
+    int pos;
+
+    if (index_id_chercher(&table.index_groupes, cle, &pos)) {
+        return &table.groupes[pos];
+    }
+    if (!creer) {
+        return NULL;
+    }
+
+    if (table.nb_groupes == table.capacite_groupes) {
+        int capacite = (table.capacite_groupes == 0) ? 32 : table.capacite_groupes * 2;
+        StatistiquesNotes *groupes = (StatistiquesNotes*)realloc(table.groupes, capacite * sizeof(StatistiquesNotes));
+        if (groupes == NULL) {
+            return NULL;
+        }
+        table.groupes = groupes;
+        table.capacite_groupes = capacite;
+    }
+
+    pos = table.nb_groupes;
+    if (!index_id_inserer(&table.index_groupes, cle, pos)) {
+        return NULL;
+    }
+    table.nb_groupes++;
+    stats_initialiser(&table.groupes[pos]);
+    return &table.groupes[pos];
+}
+
+// Position of a section name, -1 if unknown
+static int position_section(const char *section) {
+    for (int s = 0; s < table.nb_sections; s++) {
+        if (strcmp(table.sections[s], section) == 0) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+// Add or remove a grade in one aggregate
+static int appliquer_groupe(int id_matiere, int section, float note, int ajout) {
+    StatistiquesNotes *stats = groupe(id_matiere, section, ajout);
+    if (stats == NULL) {
+        return !ajout; // Nothing to remove from a missing aggregate
+    }
+
+    if (ajout) {
+        stats_ajouter(stats, note);
+    } else {
+        stats_retirer(stats, note);
+    }
+    return 1;
+}
+
+// Add or remove a grade in its subject aggregate and its (subject, section) aggregate
+static int appliquer_note(int id_etudiant, int id_matiere, float note, int ajout) {
+    int section = -1;
+    index_id_chercher(&table.index_etudiants, id_etudiant, &section);
+
+    if (!appliquer_groupe(id_matiere, -1, note, ajout)) {
+        return 0;
+    }
+    if (section >= 0) {
+        return appliquer_groupe(id_matiere, section, note, ajout);
+    }
+    return 1;
+}
+
+// Rebuild every aggregate with one pass over the grades
+static int construire_table(NodeNote* notes, NodeEtudiant* etudiants) {
+    vider_table();
+
+    int nb_etudiants = 0;
+    for (NodeEtudiant* e = etudiants; e != NULL; e = e->suivant) {
+        nb_etudiants++;
+    }
+
+    table.sections = malloc((nb_etudiants + 1) * sizeof(*table.sections));
+    int ok = table.sections != NULL &&
+             index_id_initialiser(&table.index_etudiants, nb_etudiants) &&
+             index_id_initialiser(&table.index_groupes, 64);
+
+    // Index the section of every student
+    for (NodeEtudiant* e = etudiants; ok && e != NULL; e = e->suivant) {
+        int s = position_section(e->etudiant.section);
+        if (s < 0) {
+            s = table.nb_sections++;
+            snprintf(table.sections[s], MAX_SECTION_LEN, "%s", e->etudiant.section);
+        }
+        ok = index_id_inserer(&table.index_etudiants, e->etudiant.id, s);
+    }
+
+    // Scan only the ID and score columns
+    const ColonnesNotes *colonnes = ok ? obtenir_colonnes_notes(notes) : NULL;
+    ok = colonnes != NULL;
+    for (int n = 0; ok && n < colonnes->nb; n++) {
+        ok = appliquer_note(colonnes->id_etudiant[n], colonnes->id_matiere[n], colonnes->note[n], 1);
+    }
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        vider_table();
+        return 0;
+    }
+
+    table.etudiants = etudiants;
+    table.generation_notes = notes_generation();
+    table.generation_etudiants = etudiants_generation();
+    table.valide = 1;
+    return 1;
+}
+
+// Recompute the exact extremes of the aggregates of a subject from its grades
+static int recalculer_extremes(NodeNote* notes, int id_matiere) {
+    StatistiquesNotes *tous = groupe(id_matiere, -1, 0);
+    int perimes = tous != NULL && tous->extremes_perimes;
+    for (int s = 0; !perimes && s < table.nb_sections; s++) {
+        StatistiquesNotes *stats = groupe(id_matiere, s, 0);
+        perimes = stats != NULL && stats->extremes_perimes;
+    }
+    if (!perimes) {
+        return 1;
+    }
+
+    const ColonnesNotes *colonnes = obtenir_colonnes_notes(notes);
+    if (colonnes == NULL) {
+        return 0;
+    }
+
+    // Grades are between 0 and 20: any grade replaces these bounds
+    for (int s = -1; s < table.nb_sections; s++) {
+        StatistiquesNotes *stats = groupe(id_matiere, s, 0);
+        if (stats != NULL) {
+            stats->min = 21.0f;
+            stats->max = -1.0f;
+        }
+    }
+
+    for (int n = 0; n < colonnes->nb; n++) {
+        if (colonnes->id_matiere[n] != id_matiere) {
+            continue;
+        }
+
+        float note = colonnes->note[n];
+        int section = -1;
+        index_id_chercher(&table.index_etudiants, colonnes->id_etudiant[n], &section);
+        StatistiquesNotes *concernes[2] = {tous, section >= 0 ? groupe(id_matiere, section, 0) : NULL};
+        for (int g = 0; g < 2; g++) {
+            if (concernes[g] == NULL) {
+                continue;
+            }
+            if (note < concernes[g]->min) {
+                concernes[g]->min = note;
+            }
+            if (note > concernes[g]->max) {
+                concernes[g]->max = note;
+            }
+        }
+    }
+
+    for (int s = -1; s < table.nb_sections; s++) {
+        StatistiquesNotes *stats = groupe(id_matiere, s, 0);
+        if (stats != NULL) {
+            if (stats->nb == 0) {
+                stats->min = 0.0f;
+                stats->max = 0.0f;
+            }
+            stats->extremes_perimes = 0;
+        }
+    }
+    return 1;
+}
+
+// Make sure the table reflects the current grades and students
+static int table_a_jour(NodeNote* notes, NodeEtudiant* etudiants) {
+    if (table.valide && table.etudiants == etudiants &&
+        table.generation_notes == notes_generation() &&
+        table.generation_etudiants == etudiants_generation()) {
+        return 1;
+    }
+    return construire_table(notes, etudiants);
+}
+
+/**
+ * Get the statistics of a subject for all sections
+ */
+const StatistiquesNotes* statistiques_matiere(NodeNote* notes, NodeEtudiant* etudiants, int id_matiere) {
+    if (!table_a_jour(notes, etudiants) || !recalculer_extremes(notes, id_matiere)) {
+        return NULL;
+    }
+    return groupe(id_matiere, -1, 0);
+}
+
+/**
+ * Get the statistics of a subject restricted to one section
+ */
+const StatistiquesNotes* statistiques_matiere_section(NodeNote* notes, NodeEtudiant* etudiants,
+                                                      int id_matiere, const char *section) {
+    if (!table_a_jour(notes, etudiants) || !recalculer_extremes(notes, id_matiere)) {
+        return NULL;
+    }
+
+    int s = position_section(section);
+    if (s < 0) {
+        return NULL;
+    }
+    return groupe(id_matiere, s, 0);
+}
+
+/**
+ * Display count, mean, standard deviation, quartiles and histogram of an aggregate
+ */
+void afficher_statistiques_notes(const StatistiquesNotes *stats) {
+    if (stats == NULL || stats->nb == 0) {
+        printf("Aucune note enregistrée.\n");
+        return;
+    }
+
+    printf("Nombre de notes: %d\n", stats->nb);
+    printf("Moyenne: %.2f\n", stats->moyenne);
+    printf("Écart-type: %.2f\n", stats_ecart_type(stats));
+    printf("Note minimale: %.2f\n", stats->min);
+    printf("Note maximale: %.2f\n", stats->max);
+    printf("Quartiles (estimés): Q1 = %.2f | Médiane = %.2f | Q3 = %.2f\n",
+           stats_quantile(stats, 0.25), stats_quantile(stats, 0.5), stats_quantile(stats, 0.75));
+    printf("Taux de réussite: %.1f%% (%d sur %d)\n",
+           (float)stats->nb_reussites / stats->nb * 100, stats->nb_reussites, stats->nb);
+
+    // Scale the bars to at most 40 characters
+    int effectif_max = 0;
+    for (int t = 0; t < NB_TRANCHES_NOTES; t++) {
+        if (stats->histogramme[t] > effectif_max) {
+            effectif_max = stats->histogramme[t];
+        }
+    }
+
+    printf("\nHistogramme:\n");
+    for (int t = 0; t < NB_TRANCHES_NOTES; t++) {
+        if (t == NB_TRANCHES_NOTES - 1) {
+            printf("   20   | ");
+        } else {
+            printf("%2d-%-2d   | ", t, t + 1);
+        }
+
+        int longueur = stats->histogramme[t] * 40 / effectif_max;
+        if (stats->histogramme[t] > 0 && longueur == 0) {
+            longueur = 1;
+        }
+        for (int i = 0; i < longueur; i++) {
+            printf("#");
+        }
+        printf(" %d\n", stats->histogramme[t]);
+    }
+}
+
+/**
+ * Display the grade distribution of a subject, globally and per section
+ */
+void afficher_distribution_matiere(NodeNote* notes, NodeEtudiant* etudiants, int id_matiere) {
+    const StatistiquesNotes *stats = statistiques_matiere(notes, etudiants, id_matiere);
+    if (stats == NULL) {
+        printf("Aucune note enregistrée pour cette matière.\n");
+        return;
+    }
+
+    printf("=== Toutes sections ===\n");
+    afficher_statistiques_notes(stats);
+
+    for (int s = 0; s < table.nb_sections; s++) {
+        const StatistiquesNotes *stats_section = groupe(id_matiere, s, 0);
+        if (stats_section != NULL && stats_section->nb > 0) {
+            printf("\n=== Section %s ===\n", table.sections[s]);
+            afficher_statistiques_notes(stats_section);
+        }
+    }
+}
+
+/**
+ * Refresh the statistics after a single grade change
+ */
+void statistiques_note_modifiee(const Note *ancienne, const Note *nouvelle) {
+    // Only a table that was in sync right before this change can be patched
+    if (!table.valide || table.generation_notes + 1 != notes_generation() ||
+        table.generation_etudiants != etudiants_generation()) {
+        table.valide = 0;
+        return;
+    }
+
+    if (ancienne != NULL) {
+        appliquer_note(ancienne->id_etudiant, ancienne->id_matiere, ancienne->note, 0);
+    }
+    if (nouvelle != NULL && !appliquer_note(nouvelle->id_etudiant, nouvelle->id_matiere, nouvelle->note, 1)) {
+        table.valide = 0;
+        return;
+    }
+
+    table.generation_notes = notes_generation();
+}
+
+/**
+ * Free memory allocated for the statistics
+ */
+void liberer_statistiques(void) {
+    vider_table();
+}
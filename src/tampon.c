@@ -0,0 +1,198 @@
+/**
+ * @file tampon.c
+ * @brief Implementation of the growable output buffer
+ */
+
+#include <stdarg.h>
+#include "../include/tampon.h"
+
+// Make room for at least `besoin` more bytes (plus a terminating zero)
+static int tampon_reserver(Tampon *tampon, size_t besoin) {
+    if (tampon->capacite - tampon->taille > besoin) {
+        return 1;
+    }
+
+    size_t capacite = tampon->capacite ? tampon->capacite * 2 : TAILLE_TAMPON_INITIALE;
+    while (capacite - tampon->taille <= besoin) {
+        capacite *= 2;
+    }
+    char *donnees = (char*)realloc(tampon->donnees, capacite);
+    if (donnees == NULL) {
+        return 0;
+    }
+    tampon->donnees = donnees;
+    tampon->capacite = capacite;
+    return 1;
+}
+
+/**
+ * Append formatted text to a buffer, growing it if needed
+ */
+int tampon_printf(Tampon *tampon, const char *format, ...) {
+    va_list args;
+
+    while (1) {
+        size_t libre = tampon->capacite - tampon->taille;
+        va_start(args, format);
+        int n = vsnprintf(tampon->donnees + tampon->taille, libre, format, args);
+        va_end(args);
+
+        if (n < 0) {
+            return 0;
+        }
+        if ((size_t)n < libre) {
+            tampon->taille += n;
+            return 1;
+        }
+        if (!tampon_reserver(tampon, (size_t)n)) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * Append raw bytes to a buffer, growing it if needed
+ */
+int tampon_ajouter(Tampon *tampon, const char *octets, size_t taille) {
+    if (!tampon_reserver(tampon, taille)) {
+        return 0;
+    }
+    memcpy(tampon->donnees + tampon->taille, octets, taille);
+    tampon->taille += taille;
+    tampon->donnees[tampon->taille] = '\0';
+    return 1;
+}
+
+/**
+ * Read one line of any length from a file, replacing the buffer contents
+ */
+int tampon_lire_ligne(Tampon *tampon, FILE *fichier) {
+    tampon->taille = 0;
+
+    while (1) {
+        if (!tampon_reserver(tampon, 256)) {
+            return 0;
+        }
+        size_t libre = tampon->capacite - tampon->taille;
+        if (fgets(tampon->donnees + tampon->taille, (int)libre, fichier) == NULL) {
+            tampon->donnees[tampon->taille] = '\0';
+            return tampon->taille > 0;
+        }
+        tampon->taille += strlen(tampon->donnees + tampon->taille);
+
+        if (tampon->taille > 0 && tampon->donnees[tampon->taille - 1] == '\n') {
+            tampon->donnees[--tampon->taille] = '\0';
+            if (tampon->taille > 0 && tampon->donnees[tampon->taille - 1] == '\r') {
+                tampon->donnees[--tampon->taille] = '\0';
+            }
+            return 1;
+        }
+    }
+}
+
+/**
+ * Append a free-text field, escaping '\\', '|', newlines and carriage returns
+ */
+int tampon_ajouter_champ(Tampon *tampon, const char *texte) {
+    const char *debut = texte;
+
+    // Copy runs of plain bytes at once, escaping only the special ones
+    for (const char *p = texte; ; p++) {
+        const char *echappement;
+        switch (*p) {
+            case '\\': echappement = "\\\\"; break;
+            case '|':  echappement = "\\|"; break;
+            case '\n': echappement = "\\n"; break;
+            case '\r': echappement = "\\r"; break;
+            case '\0': return tampon_ajouter(tampon, debut, p - debut);
+            default: continue;
+        }
+        if (!tampon_ajouter(tampon, debut, p - debut) || !tampon_ajouter(tampon, echappement, 2)) {
+            return 0;
+        }
+        debut = p + 1;
+    }
+}
+
+/**
+ * Cut the next '|'-separated field of a record, unescaping it in place
+ */
+char* extraire_champ(char **curseur) {
+    char *lecture = *curseur;
+    if (lecture == NULL) {
+        return NULL;
+    }
+
+    // The unescaped field is never longer, so it is written over itself in one pass
+    char *champ = lecture;
+    char *ecriture = lecture;
+    while (*lecture != '\0' && *lecture != '|') {
+        if (*lecture == '\\' && lecture[1] != '\0') {
+            lecture++;
+            *ecriture++ = (*lecture == 'n') ? '\n' : (*lecture == 'r') ? '\r' : *lecture;
+        } else {
+            *ecriture++ = *lecture;
+        }
+        lecture++;
+    }
+
+    *curseur = (*lecture == '|') ? lecture + 1 : NULL;
+    *ecriture = '\0';
+    return champ;
+}
+
+/**
+ * Read a record of the old unescaped formats, whose free text may span several lines
+ */
+int tampon_lire_enregistrement(Tampon *tampon, FILE *fichier, int nb_separateurs) {
+    Tampon ligne = {0};
+    int nb_trouves = 0;
+    int lu = 0;
+
+    tampon->taille = 0;
+    while (nb_trouves < nb_separateurs && tampon_lire_ligne(&ligne, fichier)) {
+        if (lu && !tampon_ajouter(tampon, "\n", 1)) {
+            break;
+        }
+        // Backslashes were literal in these formats: escape them for extraire_champ
+        const char *debut = ligne.donnees;
+        const char *p;
+        for (p = ligne.donnees; *p != '\0'; p++) {
+            if (*p == '\\') {
+                if (!tampon_ajouter(tampon, debut, p + 1 - debut)) {
+                    break;
+                }
+                debut = p;
+            }
+            nb_trouves += (*p == '|');
+        }
+        if (*p != '\0' || !tampon_ajouter(tampon, debut, p - debut)) {
+            break;
+        }
+        lu = 1;
+    }
+
+    tampon_liberer(&ligne);
+    return lu;
+}
+
+/**
+ * Write a whole buffer to a file
+ */
+int tampon_ecrire_fichier(const char *chemin, const Tampon *tampon) {
+    FILE *fichier = fopen(chemin, "w");
+    if (fichier == NULL) {
+        return 0;
+    }
+
+    int ok = fwrite(tampon->donnees, 1, tampon->taille, fichier) == tampon->taille;
+    return (fclose(fichier) == 0) && ok;
+}
+
+/**
+ * Free memory allocated for a buffer
+ */
+void tampon_liberer(Tampon *tampon) {
+    free(tampon->donnees);
+    memset(tampon, 0, sizeof(Tampon));
+}
@@ -219,13 +219,20 @@ int validate_email(const char *email) {
  * Create data directory if it doesn't exist
  */
 int create_data_dir() {
+    return create_dir("data");
+}
+
+/**
+ * Create a directory if it doesn't exist
+ */
+int create_dir(const char *path) {
     struct stat st = {0};
     
-    if (stat("data", &st) == -1) {
+    if (stat(path, &st) == -1) {
         #ifdef _WIN32
-            return (mkdir("data") == 0);
+            return (mkdir(path) == 0);
         #else
-            return (mkdir("data", 0700) == 0);
+            return (mkdir(path, 0700) == 0);
         #endif
     }
     
@@ -0,0 +1,320 @@
+/**
+ * @file vues_edt.c
+ * @brief Implementation of the personal timetables
+ */
+
+#include "../include/vues_edt.h"
+#include "../include/index.h"
+
+/**
+ * Sessions of the grid and of the planning, chained by subject and by teacher
+ */
+static struct {
+    SeancePersonnelle *seances;
+    int nb;
+    int capacite;
+    int *suivant_matiere;   // Next session of the same subject, -1 at the end
+    int *suivant_enseignant; // Next session of the same teacher, -1 at the end
+    IndexId tete_matiere;
+    IndexId tete_enseignant;
+    const EmploiDuTemps *edt;
+    const Planning *planning;
+    unsigned long generation_edt;
+    unsigned long generation_planning;
+    unsigned long version;  // Incremented on every rebuild, 0 before the first one
+} catalogue;
+
+/**
+ * Personal timetables already computed, keyed by (teacher flag, ID)
+ */
+static struct {
+    EmploiDuTempsPersonnel *vues;
+    int nb;
+    int capacite;
+    IndexId index;
+} cache;
+
+// Append a session to the catalogue
+static int ajouter_au_catalogue(const SeancePersonnelle *seance) {
+    if (catalogue.nb == catalogue.capacite) {
+        int capacite = catalogue.capacite ? catalogue.capacite * 2 : 64;
+        SeancePersonnelle *seances = (SeancePersonnelle*)realloc(catalogue.seances, capacite * sizeof(SeancePersonnelle));
+        if (seances != NULL) catalogue.seances = seances;
+        int *suivant_matiere = (int*)realloc(catalogue.suivant_matiere, capacite * sizeof(int));
+        if (suivant_matiere != NULL) catalogue.suivant_matiere = suivant_matiere;
+        int *suivant_enseignant = (int*)realloc(catalogue.suivant_enseignant, capacite * sizeof(int));
+        if (suivant_enseignant != NULL) catalogue.suivant_enseignant = suivant_enseignant;
+        if (seances == NULL || suivant_matiere == NULL || suivant_enseignant == NULL) {
+            return 0;
+        }
+        catalogue.capacite = capacite;
+    }
+
+    int pos = catalogue.nb++;
+    int tete;
+    catalogue.seances[pos] = *seance;
+    catalogue.suivant_matiere[pos] = index_id_chercher(&catalogue.tete_matiere, seance->id_matiere, &tete) ? tete : -1;
+    catalogue.suivant_enseignant[pos] = index_id_chercher(&catalogue.tete_enseignant, seance->id_enseignant, &tete)
+                                        ? tete : -1;
+    return index_id_inserer(&catalogue.tete_matiere, seance->id_matiere, pos) &&
+           index_id_inserer(&catalogue.tete_enseignant, seance->id_enseignant, pos);
+}
+
+// Rebuild the catalogue if the grid or the planning changed
+static int actualiser_catalogue(const EmploiDuTemps *edt, const Planning *planning) {
+    if (catalogue.version != 0 && catalogue.edt == edt && catalogue.planning == planning &&
+        catalogue.generation_edt == emploi_du_temps_generation() &&
+        catalogue.generation_planning == planning_generation()) {
+        return 1;
+    }
+
+    catalogue.nb = 0;
+    index_id_vider(&catalogue.tete_matiere);
+    index_id_vider(&catalogue.tete_enseignant);
+    catalogue.version++;
+    catalogue.edt = edt;
+    catalogue.planning = planning;
+    catalogue.generation_edt = emploi_du_temps_generation();
+    catalogue.generation_planning = planning_generation();
+
+    SeancePersonnelle seance;
+    for (int j = 0; j < JOURS_PAR_SEMAINE; j++) {
+        for (int h = 0; h < CRENEAUX_PAR_JOUR; h++) {
+            const Creneau *creneau = &edt->creneaux[j][h];
+            if (creneau->id == 0) {
+                continue;
+            }
+            memset(&seance, 0, sizeof(SeancePersonnelle));
+            seance.id_matiere = creneau->id_matiere;
+            seance.id_enseignant = creneau->id_enseignant;
+            strcpy(seance.salle, creneau->salle);
+            seance.jour = j;
+            seance.heure = h;
+            strncpy(seance.horaire, heure_to_string(h), MAX_NOM_CRENEAU_LEN - 1);
+            if (!ajouter_au_catalogue(&seance)) {
+                catalogue.version = 0;
+                return 0;
+            }
+        }
+    }
+
+    for (int i = 0; planning != NULL && i < planning->nb_seances; i++) {
+        const Seance *s = &planning->seances[i];
+        memset(&seance, 0, sizeof(SeancePersonnelle));
+        seance.id_matiere = s->id_matiere;
+        seance.id_enseignant = s->id_enseignant;
+        strcpy(seance.salle, s->salle);
+        strcpy(seance.section, s->section);
+        seance.jour = s->jour;
+        seance.heure = s->heure;
+        strcpy(seance.horaire, planning->noms_creneaux[s->heure]);
+        if (!ajouter_au_catalogue(&seance)) {
+            catalogue.version = 0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Cached view of a person, created empty if needed
+static EmploiDuTempsPersonnel* vue_en_cache(int est_enseignant, int id_personne) {
+    long long cle = index_cle_composee(est_enseignant, id_personne);
+    int pos;
+    if (index_id_chercher(&cache.index, cle, &pos)) {
+        return &cache.vues[pos];
+    }
+
+    if (cache.nb == cache.capacite) {
+        int capacite = cache.capacite ? cache.capacite * 2 : 8;
+        EmploiDuTempsPersonnel *vues = (EmploiDuTempsPersonnel*)realloc(cache.vues,
+                                                                        capacite * sizeof(EmploiDuTempsPersonnel));
+        if (vues == NULL) {
+            return NULL;
+        }
+        cache.vues = vues;
+        cache.capacite = capacite;
+    }
+
+    pos = cache.nb;
+    if (!index_id_inserer(&cache.index, cle, pos)) {
+        return NULL;
+    }
+    cache.nb++;
+
+    EmploiDuTempsPersonnel *vue = &cache.vues[pos];
+    memset(vue, 0, sizeof(EmploiDuTempsPersonnel));
+    vue->id_personne = id_personne;
+    vue->est_enseignant = est_enseignant;
+    return vue;
+}
+
+// Append a catalogue session to a view
+static int ajouter_a_la_vue(EmploiDuTempsPersonnel *vue, const SeancePersonnelle *seance) {
+    if (vue->nb_seances == vue->capacite) {
+        int capacite = vue->capacite ? vue->capacite * 2 : 16;
+        SeancePersonnelle *seances = (SeancePersonnelle*)realloc(vue->seances, capacite * sizeof(SeancePersonnelle));
+        if (seances == NULL) {
+            return 0;
+        }
+        vue->seances = seances;
+        vue->capacite = capacite;
+    }
+    vue->seances[vue->nb_seances++] = *seance;
+    return 1;
+}
+
+// Order sessions by day, then slot
+static int comparer_seances_personnelles(const void *a, const void *b) {
+    const SeancePersonnelle *sa = (const SeancePersonnelle*)a;
+    const SeancePersonnelle *sb = (const SeancePersonnelle*)b;
+    if (sa->jour != sb->jour) {
+        return sa->jour - sb->jour;
+    }
+    return sa->heure - sb->heure;
+}
+
+/**
+ * Get the timetable of a student
+ */
+const EmploiDuTempsPersonnel* emploi_du_temps_etudiant(const Etudiant *etudiant, const EmploiDuTemps *edt,
+                                                       const Planning *planning, NodeInscription* inscriptions) {
+    if (!actualiser_catalogue(edt, planning)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+
+    EmploiDuTempsPersonnel *vue = vue_en_cache(0, etudiant->id);
+    if (vue == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+    if (vue->version_seances == catalogue.version && vue->generation_inscriptions == inscriptions_generation()) {
+        return vue;
+    }
+
+    // Subjects of the active enrollments, from the per-student chain of the enrollments index
+    int *matieres;
+    int nb_matieres = matieres_inscrites_etudiant(inscriptions, etudiant->id, &matieres);
+    if (nb_matieres < 0) {
+        return NULL;
+    }
+
+    // Join with the sessions of each subject; planning sessions must be for the student's section
+    vue->nb_seances = 0;
+    int ok = 1;
+    for (int k = 0; ok && k < nb_matieres; k++) {
+        int pos;
+        if (!index_id_chercher(&catalogue.tete_matiere, matieres[k], &pos)) {
+            continue;
+        }
+        for (; ok && pos >= 0; pos = catalogue.suivant_matiere[pos]) {
+            const SeancePersonnelle *seance = &catalogue.seances[pos];
+            if (seance->section[0] == '\0' || strcmp(seance->section, etudiant->section) == 0) {
+                ok = ajouter_a_la_vue(vue, seance);
+            }
+        }
+    }
+    free(matieres);
+
+    if (!ok) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        vue->version_seances = 0;
+        return NULL;
+    }
+
+    qsort(vue->seances, vue->nb_seances, sizeof(SeancePersonnelle), comparer_seances_personnelles);
+    vue->version_seances = catalogue.version;
+    vue->generation_inscriptions = inscriptions_generation();
+    return vue;
+}
+
+/**
+ * Get the timetable of a teacher
+ */
+const EmploiDuTempsPersonnel* emploi_du_temps_enseignant(int id_enseignant, const EmploiDuTemps *edt,
+                                                         const Planning *planning) {
+    if (!actualiser_catalogue(edt, planning)) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+
+    EmploiDuTempsPersonnel *vue = vue_en_cache(1, id_enseignant);
+    if (vue == NULL) {
+        printf("Erreur: Échec d'allocation de mémoire.\n");
+        return NULL;
+    }
+    if (vue->version_seances == catalogue.version) {
+        return vue;
+    }
+
+    vue->nb_seances = 0;
+    int pos;
+    if (index_id_chercher(&catalogue.tete_enseignant, id_enseignant, &pos)) {
+        for (; pos >= 0; pos = catalogue.suivant_enseignant[pos]) {
+            if (!ajouter_a_la_vue(vue, &catalogue.seances[pos])) {
+                printf("Erreur: Échec d'allocation de mémoire.\n");
+                vue->version_seances = 0;
+                return NULL;
+            }
+        }
+    }
+
+    qsort(vue->seances, vue->nb_seances, sizeof(SeancePersonnelle), comparer_seances_personnelles);
+    vue->version_seances = catalogue.version;
+    return vue;
+}
+
+/**
+ * Display a personal timetable day by day
+ */
+void afficher_emploi_du_temps_personnel(const EmploiDuTempsPersonnel *vue, NodeMatiere* matieres,
+                                        NodeEnseignant* enseignants) {
+    printf("\n=== Mon Emploi du Temps ===\n");
+
+    if (vue == NULL || vue->nb_seances == 0) {
+        printf("Aucune séance dans votre emploi du temps.\n");
+        return;
+    }
+
+    int jour_courant = -1;
+    for (int i = 0; i < vue->nb_seances; i++) {
+        const SeancePersonnelle *seance = &vue->seances[i];
+        if (seance->jour != jour_courant) {
+            jour_courant = seance->jour;
+            printf("\n%s\n", nom_jour_planning(jour_courant));
+        }
+
+        NodeMatiere* matiere = trouver_matiere_par_id(matieres, seance->id_matiere);
+        NodeEnseignant* enseignant = trouver_enseignant_par_id(enseignants, seance->id_enseignant);
+        char nom_enseignant[100] = "Inconnu";
+        if (enseignant != NULL) {
+            snprintf(nom_enseignant, sizeof(nom_enseignant), "%s %s",
+                     enseignant->enseignant.prenom, enseignant->enseignant.nom);
+        }
+
+        printf("  %-10s %-25s %-22s Salle %-8s %s%s\n", seance->horaire,
+               matiere != NULL ? matiere->matiere.nom_matiere : "Inconnue", nom_enseignant, seance->salle,
+               seance->section[0] != '\0' ? "Section " : "", seance->section);
+    }
+
+    printf("\n%d séance(s) par semaine.\n", vue->nb_seances);
+}
+
+/**
+ * Free the session indexes and every cached personal timetable
+ */
+void liberer_emplois_du_temps_personnels(void) {
+    free(catalogue.seances);
+    free(catalogue.suivant_matiere);
+    free(catalogue.suivant_enseignant);
+    index_id_liberer(&catalogue.tete_matiere);
+    index_id_liberer(&catalogue.tete_enseignant);
+    memset(&catalogue, 0, sizeof(catalogue));
+
+    for (int i = 0; i < cache.nb; i++) {
+        free(cache.vues[i].seances);
+    }
+    free(cache.vues);
+    index_id_liberer(&cache.index);
+    memset(&cache, 0, sizeof(cache));
+}